@@ -38,6 +38,13 @@ void ConcurrentIotivityUtils::startWorkerThreads()
     {
         throw "Work Queue Processor already started";
     }
+    m_processEvent = oc_event_new();
+    if (!m_processEvent)
+    {
+        throw "Failed to create OCProcess event";
+    }
+    m_shutDownOCProcessThread = false;
+    OCRegisterProcessEvent(m_processEvent);
     m_processWorkQueueThread = std::thread(&ConcurrentIotivityUtils::processWorkQueue, this);
     m_ocProcessThread = std::thread(&ConcurrentIotivityUtils::callOCProcess, this);
     m_threadStarted = true;
@@ -48,7 +55,12 @@ void ConcurrentIotivityUtils::stopWorkerThreads()
     m_shutDownOCProcessThread = true;
     m_queue->shutdown();
     m_processWorkQueueThread.join();
+    oc_event_signal(m_processEvent);
     m_ocProcessThread.join();
+    // the stack no longer signals the event once unregistering returns.
+    OCRegisterProcessEvent(NULL);
+    oc_event_free(m_processEvent);
+    m_processEvent = NULL;
     m_threadStarted = false;
 }
 
@@ -68,10 +80,16 @@ OCStackResult ConcurrentIotivityUtils::queueCreateResource(const std::string &ur
 
 OCStackResult ConcurrentIotivityUtils::respondToRequest(OCEntityHandlerRequest *request,
         OCRepPayload *payload, OCEntityHandlerResult responseCode)
+{
+    return respondToRequest(request->requestHandle, payload, responseCode);
+}
+
+OCStackResult ConcurrentIotivityUtils::respondToRequest(OCRequestHandle requestHandle,
+        OCRepPayload *payload, OCEntityHandlerResult responseCode)
 {
     std::unique_ptr<OCEntityHandlerResponse> response = make_unique<OCEntityHandlerResponse>();
 
-    response->requestHandle = request->requestHandle;
+    response->requestHandle = requestHandle;
     response->ehResult = responseCode;
 
     // Clone a copy since this allocation is going across thread boundaries.
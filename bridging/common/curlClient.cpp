@@ -73,6 +73,21 @@ int CurlClient::decomposeHeader(const char *header, std::vector<std::string> &he
     return MPM_RESULT_OK;
 }
 
+int CurlClient::sendAsync(CurlCompletionCallback callback)
+{
+    std::unique_ptr<CurlTransfer> transfer(new CurlTransfer());
+
+    transfer->url = m_url;
+    transfer->method = m_method;
+    transfer->requestHeaders = m_requestHeaders;
+    transfer->requestBody = m_requestBody;
+    transfer->username = m_username;
+    transfer->useSsl = m_useSsl;
+    transfer->callback = callback;
+
+    return CurlMultiClient::getInstance().submit(std::move(transfer));
+}
+
 int CurlClient::doInternalRequest(const std::string &url,
                                   const std::string &method,
                                   const std::vector<std::string> &inHeaders,
@@ -0,0 +1,409 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+#include "iotivity_config.h"
+
+#include "curlMultiClient.h"
+#include "curlClient.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include "experimental/logger.h"
+
+using namespace OC::Bridging;
+
+#define TAG "CURL_MULTI_CLIENT"
+
+#define DEFAULT_CURL_TIMEOUT_SECONDS     60L
+#define MULTI_WAIT_TIMEOUT_MS            1000
+#define MAX_IDLE_EASY_HANDLES            16
+#define DEFAULT_MAX_HOST_CONNECTIONS     4L
+
+CurlMultiClient &CurlMultiClient::getInstance()
+{
+    static CurlMultiClient instance;
+    return instance;
+}
+
+CurlMultiClient::CurlMultiClient()
+    : m_multi(NULL)
+    , m_shutdown(false)
+    , m_workerStarted(false)
+    , m_maxHostConnections(DEFAULT_MAX_HOST_CONNECTIONS)
+    , m_maxHostConnectionsChanged(false)
+{
+    m_wakeupPipe[0] = -1;
+    m_wakeupPipe[1] = -1;
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    m_multi = curl_multi_init();
+    if (m_multi == NULL)
+    {
+        OIC_LOG(ERROR, TAG, "curl_multi_init failed");
+        return;
+    }
+    curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, DEFAULT_MAX_HOST_CONNECTIONS);
+
+    if (pipe(m_wakeupPipe) != 0)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create wakeup pipe");
+        m_wakeupPipe[0] = -1;
+        m_wakeupPipe[1] = -1;
+        return;
+    }
+    fcntl(m_wakeupPipe[0], F_SETFL, fcntl(m_wakeupPipe[0], F_GETFL) | O_NONBLOCK);
+    fcntl(m_wakeupPipe[1], F_SETFL, fcntl(m_wakeupPipe[1], F_GETFL) | O_NONBLOCK);
+}
+
+CurlMultiClient::~CurlMultiClient()
+{
+    shutdown();
+
+    for (auto easy : m_idleHandles)
+    {
+        curl_easy_cleanup(easy);
+    }
+    m_idleHandles.clear();
+
+    if (m_multi != NULL)
+    {
+        curl_multi_cleanup(m_multi);
+    }
+
+    if (m_wakeupPipe[0] != -1)
+    {
+        close(m_wakeupPipe[0]);
+        close(m_wakeupPipe[1]);
+    }
+}
+
+void CurlMultiClient::setMaxConnectionsPerHost(long maxConnections)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // m_multi is only driven by the worker, which applies the limit on its next pass.
+        m_maxHostConnections = maxConnections;
+        m_maxHostConnectionsChanged = true;
+    }
+    wakeup();
+}
+
+int CurlMultiClient::submit(std::unique_ptr<CurlTransfer> transfer)
+{
+    if (!transfer || transfer->url.empty() || !transfer->callback)
+    {
+        return MPM_RESULT_INVALID_PARAMETER;
+    }
+
+    if (m_multi == NULL || m_wakeupPipe[0] == -1)
+    {
+        return MPM_RESULT_INTERNAL_ERROR;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_shutdown)
+        {
+            return MPM_RESULT_NOT_STARTED;
+        }
+
+        m_pendingTransfers.push_back(std::move(transfer));
+
+        if (!m_workerStarted)
+        {
+            m_workerThread = std::thread(&CurlMultiClient::run, this);
+            m_workerStarted = true;
+        }
+    }
+
+    wakeup();
+    return MPM_RESULT_OK;
+}
+
+void CurlMultiClient::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown)
+        {
+            return;
+        }
+        m_shutdown = true;
+    }
+
+    wakeup();
+
+    if (m_workerThread.joinable())
+    {
+        m_workerThread.join();
+    }
+
+    // Anything queued after the worker exited, or if it never ran.
+    failAllTransfers(MPM_RESULT_NOT_STARTED);
+}
+
+void CurlMultiClient::wakeup()
+{
+    const char signal = 1;
+    if (write(m_wakeupPipe[1], &signal, sizeof(signal)) < 0)
+    {
+        // Pipe is full, so the worker already has a wakeup pending.
+    }
+}
+
+size_t CurlMultiClient::appendToString(void *contents, size_t size, size_t nmemb, void *userp)
+{
+    size_t realsize = size * nmemb;
+    std::string *data = static_cast<std::string *>(userp);
+    data->append(static_cast<char *>(contents), realsize);
+    return realsize;
+}
+
+CURL *CurlMultiClient::acquireEasyHandle()
+{
+    if (!m_idleHandles.empty())
+    {
+        CURL *easy = m_idleHandles.back();
+        m_idleHandles.pop_back();
+        curl_easy_reset(easy);
+        return easy;
+    }
+    return curl_easy_init();
+}
+
+void CurlMultiClient::releaseEasyHandle(CURL *easy)
+{
+    if (m_idleHandles.size() < MAX_IDLE_EASY_HANDLES)
+    {
+        m_idleHandles.push_back(easy);
+    }
+    else
+    {
+        curl_easy_cleanup(easy);
+    }
+}
+
+void CurlMultiClient::attachPendingTransfers()
+{
+    std::vector<std::unique_ptr<CurlTransfer>> pending;
+    bool maxHostConnectionsChanged = false;
+    long maxHostConnections = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending.swap(m_pendingTransfers);
+        maxHostConnectionsChanged = m_maxHostConnectionsChanged;
+        maxHostConnections = m_maxHostConnections;
+        m_maxHostConnectionsChanged = false;
+    }
+
+    if (maxHostConnectionsChanged)
+    {
+        curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, maxHostConnections);
+    }
+
+    for (auto &transfer : pending)
+    {
+        std::unique_ptr<ActiveTransfer> active(new ActiveTransfer());
+        active->headers = NULL;
+
+        CURL *easy = acquireEasyHandle();
+        if (easy == NULL)
+        {
+            OIC_LOG(ERROR, TAG, "curl_easy_init failed");
+            transfer->callback(MPM_RESULT_INTERNAL_ERROR, INVALID_RESPONSE_CODE, "",
+                               std::vector<std::string>());
+            continue;
+        }
+
+        bool headersOk = true;
+        for (const auto &header : transfer->requestHeaders)
+        {
+            struct curl_slist *headers = curl_slist_append(active->headers, header.c_str());
+            if (headers == NULL)
+            {
+                headersOk = false;
+                break;
+            }
+            active->headers = headers;
+        }
+
+        if (!headersOk)
+        {
+            OIC_LOG(ERROR, TAG, "curl_slist_append failed");
+            curl_slist_free_all(active->headers);
+            releaseEasyHandle(easy);
+            transfer->callback(MPM_RESULT_OUT_OF_MEMORY, INVALID_RESPONSE_CODE, "",
+                               std::vector<std::string>());
+            continue;
+        }
+
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT, DEFAULT_CURL_TIMEOUT_SECONDS);
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, active->headers);
+        curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, false);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->requestBody.c_str());
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, appendToString);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, appendToString);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &active->responseBody);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &active->responseHeader);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, active.get());
+        if (CURLUSESSL_NONE != transfer->useSsl)
+        {
+            curl_easy_setopt(easy, CURLOPT_USE_SSL, transfer->useSsl);
+        }
+
+        if (!transfer->username.empty())
+        {
+            curl_easy_setopt(easy, CURLOPT_USERNAME, transfer->username.c_str());
+        }
+
+        if (!transfer->method.empty())
+        {
+            curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, transfer->method.c_str());
+        }
+
+        active->transfer = std::move(transfer);
+
+        CURLMcode mcode = curl_multi_add_handle(m_multi, easy);
+        if (mcode != CURLM_OK)
+        {
+            OIC_LOG_V(ERROR, TAG, "curl_multi_add_handle failed with %d", (int) mcode);
+            curl_slist_free_all(active->headers);
+            releaseEasyHandle(easy);
+            active->transfer->callback(MPM_RESULT_INTERNAL_ERROR, INVALID_RESPONSE_CODE, "",
+                                       std::vector<std::string>());
+            continue;
+        }
+
+        m_activeTransfers[easy] = std::move(active);
+    }
+}
+
+void CurlMultiClient::completeTransfer(CURL *easy, CURLcode code)
+{
+    auto it = m_activeTransfers.find(easy);
+    if (it == m_activeTransfers.end())
+    {
+        OIC_LOG(ERROR, TAG, "Completed transfer is unknown");
+        return;
+    }
+
+    std::unique_ptr<ActiveTransfer> active = std::move(it->second);
+    m_activeTransfers.erase(it);
+
+    curl_multi_remove_handle(m_multi, easy);
+
+    int result = MPM_RESULT_OK;
+    long responseCode = INVALID_RESPONSE_CODE;
+    std::vector<std::string> responseHeaders;
+
+    if (code != CURLE_OK)
+    {
+        OIC_LOG_V(ERROR, TAG, "transfer to %s failed with %lu", active->transfer->url.c_str(),
+                  (unsigned long) code);
+        result = MPM_RESULT_NETWORK_ERROR;
+    }
+    else
+    {
+        if (CURLE_OK != curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &responseCode))
+        {
+            OIC_LOG(WARNING, TAG, "curl_easy_getinfo(CURLINFO_RESPONSE_CODE) failed.");
+            responseCode = INVALID_RESPONSE_CODE;
+        }
+        CurlClient::decomposeHeader(active->responseHeader.c_str(), responseHeaders);
+    }
+
+    curl_slist_free_all(active->headers);
+    releaseEasyHandle(easy);
+
+    active->transfer->callback(result, responseCode, active->responseBody, responseHeaders);
+}
+
+void CurlMultiClient::failAllTransfers(int result)
+{
+    for (auto &entry : m_activeTransfers)
+    {
+        curl_multi_remove_handle(m_multi, entry.first);
+        curl_slist_free_all(entry.second->headers);
+        curl_easy_cleanup(entry.first);
+        entry.second->transfer->callback(result, INVALID_RESPONSE_CODE, "",
+                                         std::vector<std::string>());
+    }
+    m_activeTransfers.clear();
+
+    std::vector<std::unique_ptr<CurlTransfer>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending.swap(m_pendingTransfers);
+    }
+
+    for (auto &transfer : pending)
+    {
+        transfer->callback(result, INVALID_RESPONSE_CODE, "", std::vector<std::string>());
+    }
+}
+
+void CurlMultiClient::run()
+{
+    while (!m_shutdown)
+    {
+        attachPendingTransfers();
+
+        int runningTransfers = 0;
+        curl_multi_perform(m_multi, &runningTransfers);
+
+        CURLMsg *msg = NULL;
+        int msgsLeft = 0;
+        while ((msg = curl_multi_info_read(m_multi, &msgsLeft)) != NULL)
+        {
+            if (msg->msg == CURLMSG_DONE)
+            {
+                completeTransfer(msg->easy_handle, msg->data.result);
+            }
+        }
+
+        // Block until a socket is ready, a curl timer expires or a transfer is submitted.
+        struct curl_waitfd wakeupFd;
+        wakeupFd.fd = m_wakeupPipe[0];
+        wakeupFd.events = CURL_WAIT_POLLIN;
+        wakeupFd.revents = 0;
+
+        int numFds = 0;
+        CURLMcode mcode = curl_multi_wait(m_multi, &wakeupFd, 1, MULTI_WAIT_TIMEOUT_MS, &numFds);
+        if (mcode != CURLM_OK)
+        {
+            OIC_LOG_V(ERROR, TAG, "curl_multi_wait failed with %d", (int) mcode);
+        }
+
+        if (wakeupFd.revents != 0)
+        {
+            char buffer[64];
+            while (read(m_wakeupPipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+        }
+    }
+
+    failAllTransfers(MPM_RESULT_NOT_STARTED);
+}
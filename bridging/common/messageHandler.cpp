@@ -95,7 +95,7 @@ MPMResult MPMSendResponse(const void *response, size_t size, MPMMessageType type
     pipe_message.msgType = type;
     pipe_message.payload = (uint8_t *)response;
 
-    result = MPMWritePipeMessage(g_com_ctx->parent_reads_fds.write_fd, &pipe_message);
+    result = MPMWriteChannelMessage(&g_com_ctx->parent_reads_fds, &pipe_message);
 
     return result;
 }
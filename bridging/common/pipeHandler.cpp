@@ -28,6 +28,7 @@
 #include <string.h>
 #include <errno.h>
 #include "messageHandler.h"
+#include "pluginIf.h"
 #include "iotivity_config.h"
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -129,3 +130,42 @@ ssize_t MPMReadPipeMessage(int fd, MPMPipeMessage *pipe_message)
     }
     return bytesRead;
 }
+
+MPMResult MPMWriteChannelMessage(const MPMPipe *channel, const MPMPipeMessage *pipe_message)
+{
+    if (channel->ring)
+    {
+        return MPMShmRingWrite(channel->ring, pipe_message);
+    }
+    return MPMWritePipeMessage(channel->write_fd, pipe_message);
+}
+
+ssize_t MPMReadChannelMessage(const MPMPipe *channel, MPMPipeMessage *pipe_message)
+{
+    if (channel->ring)
+    {
+        return MPMShmRingRead(channel->ring, pipe_message);
+    }
+    return MPMReadPipeMessage(channel->read_fd, pipe_message);
+}
+
+void MPMReleaseChannelMessage(const MPMPipe *channel, MPMPipeMessage *pipe_message)
+{
+    if (channel->ring)
+    {
+        MPMShmRingRelease(channel->ring, pipe_message);
+        return;
+    }
+    OICFree((void*)pipe_message->payload);
+    pipe_message->payload = NULL;
+    pipe_message->payloadSize = 0;
+}
+
+int MPMGetChannelReadFd(const MPMPipe *channel)
+{
+    if (channel->ring)
+    {
+        return MPMShmRingGetEventFd(channel->ring);
+    }
+    return channel->read_fd;
+}
@@ -49,12 +49,12 @@ static void waitForChildProcessToComplete(pid_t child_pid, int32_t timeout);
 
 
 /* This is a timed wait for pipe write; the written value is returned in the passed
- * in message buffer.
- * @param[in]  fd_to_parent       File descriptor
+ * in message buffer and must be released with MPMReleaseChannelMessage.
+ * @param[in]  channel_to_parent  Channel from the child
  * @param[out] message            Message from the child
  * @param[in]  timeout            Time to wait for pipe write in seconds
  */
-static void timedWaitForPipeWrite(int fd_to_parent, MPMPipeMessage *message,
+static void timedWaitForPipeWrite(const MPMPipe *channel_to_parent, MPMPipeMessage *message,
                                   int32_t timeout);
 
 
@@ -122,6 +122,18 @@ static int start(MPMCommonPluginCtx *ctx)
             return result;
         }
 
+        /* Messages from the plugin go through a shared memory ring when the
+         * platform supports it; the pipe remains as fallback. Setting
+         * MPM_IPC_PIPE_ONLY in the environment forces the pipe.
+         */
+        MPMShmRingDestroy(ctx->parent_reads_fds.ring);
+        ctx->parent_reads_fds.ring = NULL;
+        ctx->child_reads_fds.ring = NULL;
+        if (getenv("MPM_IPC_PIPE_ONLY") == NULL)
+        {
+            ctx->parent_reads_fds.ring = MPMShmRingCreate(MPM_SHM_RING_SIZE);
+        }
+
         switch (pid = fork())
         {
             case 0:
@@ -133,6 +145,7 @@ static int start(MPMCommonPluginCtx *ctx)
                  */
                 close(ctx->child_reads_fds.write_fd);
                 close(ctx->parent_reads_fds.read_fd);
+                MPMShmRingSetSpillFd(ctx->parent_reads_fds.ring, ctx->parent_reads_fds.write_fd);
 
                 /* Start the OCF server. This is a blocking call and will
                    return only when the plugin stops*/
@@ -160,12 +173,13 @@ static int start(MPMCommonPluginCtx *ctx)
                  */
                 close(ctx->child_reads_fds.read_fd);
                 close(ctx->parent_reads_fds.write_fd);
+                MPMShmRingSetSpillFd(ctx->parent_reads_fds.ring, ctx->parent_reads_fds.read_fd);
 
                 /* The plugin may fail to create or start.
                  * The parent must wait here for some time to
                  * learn what happened.
                  */
-                timedWaitForPipeWrite(ctx->parent_reads_fds.read_fd,
+                timedWaitForPipeWrite(&ctx->parent_reads_fds,
                                       &pipe_message,
                                       MPM_TIMEOUT_VAL_IN_SEC);
                 if (pipe_message.msgType == MPM_DONE)
@@ -197,13 +211,29 @@ static int start(MPMCommonPluginCtx *ctx)
                     close(ctx->parent_reads_fds.read_fd);
                 }
 
-                OICFree((void*)pipe_message.payload);
+                MPMReleaseChannelMessage(&ctx->parent_reads_fds, &pipe_message);
+
+                if (!ctx->started)
+                {
+                    MPMShmRingDestroy(ctx->parent_reads_fds.ring);
+                    ctx->parent_reads_fds.ring = NULL;
+                }
+                else if (ctx->parent_reads_fds.ring)
+                {
+                    /* The plugin signals only when it finds the ring empty, so
+                     * the messages sent after MPM_DONE are handed to the
+                     * response thread with a new signal.
+                     */
+                    MPMShmRingNotifyPending(ctx->parent_reads_fds.ring);
+                }
 
                 break;
 
             case -1:
                 perror("fork");
                 OIC_LOG(ERROR, TAG, "Fork returned error.");
+                MPMShmRingDestroy(ctx->parent_reads_fds.ring);
+                ctx->parent_reads_fds.ring = NULL;
                 break;
         }
     }
@@ -265,6 +295,10 @@ static void destroy(MPMCommonPluginCtx *ctx)
     {
         stop(ctx);
     }
+    if (ctx)
+    {
+        MPMShmRingDestroy(ctx->parent_reads_fds.ring);
+    }
     OICFree(ctx);
 }
 
@@ -308,15 +342,18 @@ static void waitForChildProcessToComplete(pid_t child_pid, int32_t timeout)
     }
 }
 
-static void timedWaitForPipeWrite(int fd, MPMPipeMessage *msg, int32_t timeout)
+static void timedWaitForPipeWrite(const MPMPipe *channel, MPMPipeMessage *msg, int32_t timeout)
 {
     if (NULL != msg)
     {
+        int fd = MPMGetChannelReadFd(channel);
+        int maxFd = (fd > channel->read_fd) ? fd : channel->read_fd;
         struct timeval tv;
         fd_set fdset;
         int nfd = -1;
         int32_t waittime = 0;
         ssize_t nbytes = 0;
+        bool isChildGone = false;
 
         /* wait for 1 second on each time through the loop for up to timeout */
         tv.tv_sec = 0;
@@ -326,8 +363,10 @@ static void timedWaitForPipeWrite(int fd, MPMPipeMessage *msg, int32_t timeout)
         {
             FD_ZERO(&(fdset));
             FD_SET(fd, &(fdset));
+            /* With a ring, the pipe still reports the exit of the child as EOF */
+            FD_SET(channel->read_fd, &(fdset));
             sleep(1);  /* tried to set the timeout on select and it was not reliable */
-            nfd = select(fd + 1, &(fdset), NULL, NULL, &tv);
+            nfd = select(maxFd + 1, &(fdset), NULL, NULL, &tv);
             if (nfd == -1)
             {
                 OIC_LOG_V(ERROR, TAG, "select error :[%s]", strerror(errno));
@@ -335,9 +374,26 @@ static void timedWaitForPipeWrite(int fd, MPMPipeMessage *msg, int32_t timeout)
             }
             else if (nfd)
             {
-                if (FD_ISSET(fd, &(fdset)))
+                if (channel->ring)
                 {
-                    nbytes = MPMReadPipeMessage(fd, msg);
+                    if (FD_ISSET(fd, &(fdset)))
+                    {
+                        MPMShmRingClearEvent(channel->ring);
+                    }
+                    /* A spilled message is announced in the ring before it is
+                     * written to the pipe, so the ring is read first.
+                     */
+                    nbytes = MPMReadChannelMessage(channel, msg);
+
+                    if ((nbytes == 0) && FD_ISSET(channel->read_fd, &(fdset)))
+                    {
+                        char byte = 0;
+                        isChildGone = (read(channel->read_fd, &byte, 1) <= 0);
+                    }
+                }
+                else if (FD_ISSET(fd, &(fdset)))
+                {
+                    nbytes = MPMReadChannelMessage(channel, msg);
                 }
             }
             else
@@ -349,7 +405,12 @@ static void timedWaitForPipeWrite(int fd, MPMPipeMessage *msg, int32_t timeout)
             waittime++;
 
         }
-        while ((nbytes == 0) && (waittime <= timeout));
+        while ((nbytes == 0) && !isChildGone && (waittime <= timeout));
+
+        if (isChildGone)
+        {
+            OIC_LOG(ERROR, TAG, "Child closed the pipe before it started");
+        }
     }
 }
 
@@ -367,14 +367,14 @@ MPMResult maintainInfrastructure(MPMResult result, MPMCommonPluginCtx *ctx)
             pipe_message.msgType = MPM_DONE;
             pipe_message.payloadSize = 0;
             pipe_message.payload = NULL;
-            result = MPMWritePipeMessage(ctx->parent_reads_fds.write_fd, &pipe_message);
+            result = MPMWriteChannelMessage(&ctx->parent_reads_fds, &pipe_message);
         }
         else
         {
             pipe_message.msgType = MPM_ERROR;
             pipe_message.payloadSize = 0;
             pipe_message.payload = NULL;
-            result = MPMWritePipeMessage(ctx->parent_reads_fds.write_fd, &pipe_message);
+            result = MPMWriteChannelMessage(&ctx->parent_reads_fds, &pipe_message);
         }
 
         if (result == MPM_RESULT_OK)
@@ -0,0 +1,387 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+
+/**
+ * This file implements the shared memory ring used by a plugin process to
+ * send messages to the mini plugin manager.
+ *
+ * Positions in the ring grow monotonically; a frame starts at position % capacity
+ * and never wraps around the end of the ring. When the space left before the end
+ * is too small, the producer marks it as padding and continues at the start.
+ * Messages which do not fit in half of the ring are sent over the spill pipe,
+ * preceded by a marker frame so the consumer reads them in order.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include "iotivity_config.h"
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/mman.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#include "shmRingHandler.h"
+#include "platform_features.h"
+#include "oic_malloc.h"
+#include "experimental/logger.h"
+
+#define TAG "SHM_RING_HANDLER"
+
+#define MPM_SHM_FRAME_ALIGN          8
+#define MPM_SHM_FRAME_PADDING        UINT32_MAX
+#define MPM_SHM_FRAME_SPILLED        (UINT32_MAX - 1)
+#define MPM_SHM_WRITE_WAIT_US        100
+#define MPM_SHM_WRITE_TIMEOUT_US     (60 * 1000000)
+#define MPM_SHM_CACHE_LINE           64
+
+/* Shared between both processes at the start of the mapping. */
+typedef struct
+{
+    /* Next write position, only advanced by the producer. */
+    uint64_t head;
+    uint8_t headPadding[MPM_SHM_CACHE_LINE - sizeof(uint64_t)];
+
+    /* Next read position, only advanced by the consumer. */
+    uint64_t tail;
+    uint8_t tailPadding[MPM_SHM_CACHE_LINE - sizeof(uint64_t)];
+
+    uint64_t capacity;
+} MPMShmRingHeader;
+
+typedef struct
+{
+    uint32_t frameSize;
+    uint32_t msgType;
+    uint64_t payloadSize;
+} MPMShmFrameHeader;
+
+/* Process local handle of the ring. */
+struct MPMShmRing
+{
+    MPMShmRingHeader *header;
+    uint8_t *data;
+    size_t mapSize;
+    int eventFd;
+    int spillFd;
+
+    /* Serializes producer threads; the ring itself has a single producer. */
+    pthread_mutex_t writeMutex;
+
+    /* Size of the frame handed out by MPMShmRingRead, 0 if none. */
+    uint32_t readFrameSize;
+
+    /* Whether the message handed out by MPMShmRingRead came from the spill pipe. */
+    bool readSpilled;
+};
+
+static uint64_t alignFrameSize(uint64_t size)
+{
+    return (size + MPM_SHM_FRAME_ALIGN - 1) & ~((uint64_t)MPM_SHM_FRAME_ALIGN - 1);
+}
+
+MPMShmRing *MPMShmRingCreate(size_t capacity)
+{
+#ifdef __linux__
+    capacity = alignFrameSize(capacity);
+    if (capacity < 2 * sizeof(MPMShmFrameHeader))
+    {
+        OIC_LOG(ERROR, TAG, "Ring capacity is too small");
+        return NULL;
+    }
+
+    MPMShmRing *ring = (MPMShmRing *) OICCalloc(1, sizeof(MPMShmRing));
+    if (!ring)
+    {
+        OIC_LOG(ERROR, TAG, "failed to allocate memory");
+        return NULL;
+    }
+
+    ring->mapSize = sizeof(MPMShmRingHeader) + capacity;
+    void *map = mmap(NULL, ring->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                     -1, 0);
+    if (map == MAP_FAILED)
+    {
+        OIC_LOG_V(ERROR, TAG, "Error mapping shared memory - [%s]", strerror(errno));
+        OICFree(ring);
+        return NULL;
+    }
+
+    ring->eventFd = eventfd(0, EFD_NONBLOCK);
+    if (ring->eventFd == -1)
+    {
+        OIC_LOG_V(ERROR, TAG, "Error creating eventfd - [%s]", strerror(errno));
+        munmap(map, ring->mapSize);
+        OICFree(ring);
+        return NULL;
+    }
+
+    pthread_mutex_init(&ring->writeMutex, NULL);
+
+    ring->header = (MPMShmRingHeader *) map;
+    ring->data = (uint8_t *) map + sizeof(MPMShmRingHeader);
+    ring->header->head = 0;
+    ring->header->tail = 0;
+    ring->header->capacity = capacity;
+    ring->spillFd = -1;
+    ring->readFrameSize = 0;
+    ring->readSpilled = false;
+
+    return ring;
+#else
+    (void) capacity;
+    OIC_LOG(INFO, TAG, "Shared memory IPC is not supported on this platform");
+    return NULL;
+#endif
+}
+
+void MPMShmRingDestroy(MPMShmRing *ring)
+{
+    if (!ring)
+    {
+        return;
+    }
+
+    munmap(ring->header, ring->mapSize);
+    close(ring->eventFd);
+    pthread_mutex_destroy(&ring->writeMutex);
+    OICFree(ring);
+}
+
+void MPMShmRingSetSpillFd(MPMShmRing *ring, int spill_fd)
+{
+    if (ring)
+    {
+        ring->spillFd = spill_fd;
+    }
+}
+
+int MPMShmRingGetEventFd(const MPMShmRing *ring)
+{
+    return ring ? ring->eventFd : -1;
+}
+
+void MPMShmRingClearEvent(MPMShmRing *ring)
+{
+    uint64_t count = 0;
+    if (ring && read(ring->eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        OIC_LOG_V(ERROR, TAG, "Error reading eventfd - [%s]", strerror(errno));
+    }
+}
+
+void MPMShmRingNotifyPending(MPMShmRing *ring)
+{
+    uint64_t one = 1;
+    if (!MPMShmRingIsEmpty(ring) && write(ring->eventFd, &one, sizeof(one)) < 0)
+    {
+        OIC_LOG_V(ERROR, TAG, "Error signaling eventfd - [%s]", strerror(errno));
+    }
+}
+
+bool MPMShmRingIsEmpty(const MPMShmRing *ring)
+{
+    return !ring || (__atomic_load_n(&ring->header->head, __ATOMIC_SEQ_CST) ==
+                     __atomic_load_n(&ring->header->tail, __ATOMIC_SEQ_CST));
+}
+
+/* Waits until the consumer has freed 'needed' bytes after position 'head'. */
+static bool waitForSpace(MPMShmRing *ring, uint64_t head, uint64_t needed)
+{
+    uint64_t capacity = ring->header->capacity;
+    uint32_t waited = 0;
+
+    while (capacity - (head - __atomic_load_n(&ring->header->tail, __ATOMIC_SEQ_CST)) < needed)
+    {
+        if (waited >= MPM_SHM_WRITE_TIMEOUT_US)
+        {
+            OIC_LOG(ERROR, TAG, "Timed out waiting for space in the ring");
+            return false;
+        }
+        usleep(MPM_SHM_WRITE_WAIT_US);
+        waited += MPM_SHM_WRITE_WAIT_US;
+    }
+    return true;
+}
+
+/* Makes the frames up to 'newHead' visible and wakes the consumer if it may be idle. */
+static void publishFrames(MPMShmRing *ring, uint64_t oldHead, uint64_t newHead)
+{
+    __atomic_store_n(&ring->header->head, newHead, __ATOMIC_SEQ_CST);
+
+    // The consumer checks head after advancing tail, so it only needs a wakeup when
+    // it had already read everything written before these frames.
+    if (__atomic_load_n(&ring->header->tail, __ATOMIC_SEQ_CST) == oldHead)
+    {
+        uint64_t one = 1;
+        if (write(ring->eventFd, &one, sizeof(one)) < 0)
+        {
+            OIC_LOG_V(ERROR, TAG, "Error signaling eventfd - [%s]", strerror(errno));
+        }
+    }
+}
+
+MPMResult MPMShmRingWrite(MPMShmRing *ring, const MPMPipeMessage *pipe_message)
+{
+    if (!ring || !pipe_message)
+    {
+        return MPM_RESULT_INVALID_PARAMETER;
+    }
+
+    OIC_LOG_V(DEBUG, TAG, "Message type = %d, payload size = %" PRIuPTR, pipe_message->msgType,
+              pipe_message->payloadSize);
+
+    uint64_t capacity = ring->header->capacity;
+    uint64_t frameSize = alignFrameSize(sizeof(MPMShmFrameHeader) + pipe_message->payloadSize);
+    bool spill = false;
+
+    if (frameSize > capacity / 2)
+    {
+        if (ring->spillFd == -1)
+        {
+            OIC_LOG(ERROR, TAG, "Message too big for the ring");
+            return MPM_RESULT_INSUFFICIENT_BUFFER;
+        }
+        spill = true;
+        frameSize = sizeof(MPMShmFrameHeader);
+    }
+
+    pthread_mutex_lock(&ring->writeMutex);
+
+    uint64_t oldHead = __atomic_load_n(&ring->header->head, __ATOMIC_RELAXED);
+    uint64_t head = oldHead;
+    uint64_t offset = head % capacity;
+    uint64_t contiguous = capacity - offset;
+    uint64_t needed = (contiguous < frameSize) ? contiguous + frameSize : frameSize;
+
+    if (!waitForSpace(ring, head, needed))
+    {
+        pthread_mutex_unlock(&ring->writeMutex);
+        return MPM_RESULT_INTERNAL_ERROR;
+    }
+
+    if (contiguous < frameSize)
+    {
+        if (contiguous >= sizeof(MPMShmFrameHeader))
+        {
+            MPMShmFrameHeader *padding = (MPMShmFrameHeader *)(ring->data + offset);
+            padding->frameSize = (uint32_t) contiguous;
+            padding->msgType = MPM_SHM_FRAME_PADDING;
+            padding->payloadSize = 0;
+        }
+        head += contiguous;
+        offset = 0;
+    }
+
+    MPMShmFrameHeader *frame = (MPMShmFrameHeader *)(ring->data + offset);
+    frame->frameSize = (uint32_t) frameSize;
+    frame->msgType = spill ? MPM_SHM_FRAME_SPILLED : (uint32_t) pipe_message->msgType;
+    frame->payloadSize = pipe_message->payloadSize;
+
+    if (!spill && pipe_message->payloadSize > 0)
+    {
+        memcpy(frame + 1, pipe_message->payload, pipe_message->payloadSize);
+    }
+
+    publishFrames(ring, oldHead, head + frameSize);
+
+    MPMResult result = MPM_RESULT_OK;
+    if (spill)
+    {
+        result = MPMWritePipeMessage(ring->spillFd, pipe_message);
+    }
+
+    pthread_mutex_unlock(&ring->writeMutex);
+    return result;
+}
+
+ssize_t MPMShmRingRead(MPMShmRing *ring, MPMPipeMessage *pipe_message)
+{
+    if (!ring || !pipe_message || ring->readFrameSize != 0 || ring->readSpilled)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid parameter or previous message not released");
+        return -1;
+    }
+
+    uint64_t capacity = ring->header->capacity;
+    uint64_t tail = __atomic_load_n(&ring->header->tail, __ATOMIC_RELAXED);
+    MPMShmFrameHeader *frame = NULL;
+
+    while (true)
+    {
+        if (__atomic_load_n(&ring->header->head, __ATOMIC_SEQ_CST) == tail)
+        {
+            return 0;
+        }
+
+        uint64_t offset = tail % capacity;
+        uint64_t contiguous = capacity - offset;
+        frame = (MPMShmFrameHeader *)(ring->data + offset);
+
+        if (contiguous < sizeof(MPMShmFrameHeader) || frame->msgType == MPM_SHM_FRAME_PADDING)
+        {
+            tail += contiguous;
+            __atomic_store_n(&ring->header->tail, tail, __ATOMIC_SEQ_CST);
+            continue;
+        }
+        break;
+    }
+
+    if (frame->msgType == MPM_SHM_FRAME_SPILLED)
+    {
+        __atomic_store_n(&ring->header->tail, tail + frame->frameSize, __ATOMIC_SEQ_CST);
+        ssize_t bytesRead = MPMReadPipeMessage(ring->spillFd, pipe_message);
+        ring->readSpilled = (bytesRead > 0);
+        return bytesRead;
+    }
+
+    pipe_message->msgType = (MPMMessageType) frame->msgType;
+    pipe_message->payloadSize = (size_t) frame->payloadSize;
+    pipe_message->payload = (frame->payloadSize > 0) ? (const uint8_t *)(frame + 1) : NULL;
+    ring->readFrameSize = frame->frameSize;
+
+    return (ssize_t)(sizeof(MPMShmFrameHeader) + frame->payloadSize);
+}
+
+void MPMShmRingRelease(MPMShmRing *ring, MPMPipeMessage *pipe_message)
+{
+    if (!ring || !pipe_message)
+    {
+        return;
+    }
+
+    if (ring->readSpilled)
+    {
+        OICFree((void *) pipe_message->payload);
+        ring->readSpilled = false;
+    }
+    else if (ring->readFrameSize != 0)
+    {
+        uint64_t tail = __atomic_load_n(&ring->header->tail, __ATOMIC_RELAXED);
+        __atomic_store_n(&ring->header->tail, tail + ring->readFrameSize, __ATOMIC_SEQ_CST);
+        ring->readFrameSize = 0;
+    }
+
+    pipe_message->payload = NULL;
+    pipe_message->payloadSize = 0;
+}
@@ -28,6 +28,7 @@
 #include <memory>
 #include <condition_variable>
 #include <thread>
+#include <atomic>
 #include <unistd.h>
 #include <iostream>
 #include <string>
@@ -37,6 +38,7 @@
 #include "WorkQueue.h"
 #include "ocstack.h"
 #include "octypes.h"
+#include "ocevent.h"
 
 namespace OC
 {
@@ -52,7 +54,8 @@ namespace OC
          * Provides a synchronized C++ wrapper over the Iotivity CSDK.
          * Accepts workItems from the plugins for common operations.
          * A consumer thread processes these worker items and makes calls into Iotivity.
-         * Another thread calls OCProcess() to check for network requests.
+         * Another thread calls OCProcessEvent() whenever the stack signals pending
+         * network input, a work item has been processed or a stack timer expires.
          */
         class ConcurrentIotivityUtils
         {
@@ -63,8 +66,9 @@ namespace OC
 
                 std::thread m_processWorkQueueThread, m_ocProcessThread;
                 bool m_threadStarted;
-                bool m_shutDownOCProcessThread;
-                static const int OCPROCESS_SLEEP_MICROSECONDS = 200000;
+                std::atomic<bool> m_shutDownOCProcessThread;
+                oc_event m_processEvent;
+                static const uint32_t OCPROCESS_RETRY_MILLISECONDS = 200;
 
                 // Fetches work item from queue and processes it.
                 void processWorkQueue()
@@ -76,8 +80,12 @@ namespace OC
 
                         if (fetchedWorkItem)
                         {
-                            std::lock_guard<std::mutex> lock(m_iotivityApiCallMutex);
-                            workItem->process();
+                            {
+                                std::lock_guard<std::mutex> lock(m_iotivityApiCallMutex);
+                                workItem->process();
+                            }
+                            // The call into the stack may have left work for OCProcessEvent().
+                            oc_event_signal(m_processEvent);
                         }
                         else
                         {
@@ -90,13 +98,16 @@ namespace OC
                 {
                     while (!m_shutDownOCProcessThread)
                     {
+                        uint32_t nextEventTime = OCPROCESS_RETRY_MILLISECONDS;
                         {
                             std::lock_guard<std::mutex> lock(m_iotivityApiCallMutex);
-                            OCProcess();
+                            if (OCProcessEvent(&nextEventTime) != OC_STACK_OK)
+                            {
+                                nextEventTime = OCPROCESS_RETRY_MILLISECONDS;
+                            }
                         }
-                        // Hopefully it's enough for other threads to be scheduled
-                        // instead of the spin here. OCProcess is very lightweight though.
-                        usleep(OCPROCESS_SLEEP_MICROSECONDS);
+                        // Sleep until the stack has something to do instead of polling.
+                        oc_event_wait_for(m_processEvent, nextEventTime);
                     }
                 }
 
@@ -109,11 +120,12 @@ namespace OC
                     m_queue = std::move(queueToMonitor);
                     m_threadStarted = false;
                     m_shutDownOCProcessThread = false;
+                    m_processEvent = NULL;
                 }
 
                 /**
                  * Starts 2 worker threads. One to service the concurrent work queue to call
-                 * into Iotivity. One to process network requests by calling OCProcess()
+                 * into Iotivity. One to process network requests by calling OCProcessEvent()
                  */
                 void startWorkerThreads();
 
@@ -187,6 +199,22 @@ namespace OC
                 respondToRequest(OCEntityHandlerRequest *request, OCRepPayload *payload,
                                  OCEntityHandlerResult responseCode);
 
+                /**
+                 * Send a response to a request that was deferred by returning OC_EH_SLOW
+                 * from the entity handler, e.g. from a CurlClient::sendAsync() callback.
+                 *
+                 * @param[in] requestHandle The requestHandle of the OCEntityHandlerRequest that
+                 *                          was handed in the entityhandler.
+                 * @param[in] payload The response payload. This is cloned and callee still has
+                 *                ownership and the onus to free this.
+                 * @param[in] responseCode The response code of type OCEntityHandlerResult in ocstack.h
+                 *
+                 * @return OCStackResult OC_STACK_OK on success, some other value upon failure.
+                 */
+                OCStackResult static
+                respondToRequest(OCRequestHandle requestHandle, OCRepPayload *payload,
+                                 OCEntityHandlerResult responseCode);
+
                 /**
                  * Respond with an error message. Internally calls
                  * ConcurrentIotivityUtils::respondToRequest() after creating
@@ -35,6 +35,7 @@
 #include <stdexcept>
 #include "mpmErrorCode.h"
 #include "StringConstants.h"
+#include "curlMultiClient.h"
 
 namespace OC
 {
@@ -120,6 +121,23 @@ namespace OC
                     return m_outHeaders;
                 }
 
+                /**
+                 * Performs the request on the shared CurlMultiClient instead of
+                 * blocking the calling thread. The response is handed to the
+                 * callback and is not available from getResponseBody().
+                 *
+                 * @param[in] callback  Called on the CurlMultiClient thread once the
+                 *                      transfer completes or fails.
+                 *
+                 * @return MPM_RESULT_OK if the request was queued, else an error code.
+                 */
+                int sendAsync(CurlCompletionCallback callback);
+
+                /**
+                 * Splits a raw HTTP header block into individual header lines.
+                 */
+                static int decomposeHeader(const char *header, std::vector<std::string> &headers);
+
 
             private:
 
@@ -167,8 +185,6 @@ namespace OC
 
                 } MemoryChunk;
 
-                int decomposeHeader(const char *header, std::vector<std::string> &headers);
-
 
                 int doInternalRequest(const std::string &url,
                                       const std::string &method,
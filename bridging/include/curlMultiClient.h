@@ -0,0 +1,156 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+
+#ifndef _CURLMULTICLIENT_H_
+#define _CURLMULTICLIENT_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <curl/curl.h>
+#include "mpmErrorCode.h"
+
+namespace OC
+{
+    namespace Bridging
+    {
+        /**
+         * Called once an asynchronous transfer has completed.
+         *
+         * @param[in] result          MPM_RESULT_OK if the transfer completed, else an error code.
+         * @param[in] responseCode    HTTP response code or INVALID_RESPONSE_CODE.
+         * @param[in] responseBody    Body of the HTTP response.
+         * @param[in] responseHeaders Headers of the HTTP response, one per entry.
+         */
+        typedef std::function<void(int result, long responseCode, const std::string &responseBody,
+                                   const std::vector<std::string> &responseHeaders)>
+                CurlCompletionCallback;
+
+        /**
+         * Describes one asynchronous transfer handed to CurlMultiClient.
+         */
+        struct CurlTransfer
+        {
+            std::string url;
+            std::string method;
+            std::vector<std::string> requestHeaders;
+            std::string requestBody;
+            std::string username;
+            curl_usessl useSsl;
+            CurlCompletionCallback callback;
+        };
+
+        /**
+         * Runs HTTP transfers of a plugin process on a single curl_multi handle.
+         *
+         * Transfers are driven by one worker thread, so a slow vendor API no longer
+         * blocks the thread that issued the request. Connections are kept alive and
+         * pooled per host by the multi handle and reused by later transfers to the
+         * same host.
+         *
+         * Completion callbacks run on the worker thread and must not block. Entity
+         * handlers typically return OC_EH_SLOW and answer the request from the
+         * callback through ConcurrentIotivityUtils::respondToRequest().
+         */
+        class CurlMultiClient
+        {
+            public:
+                /**
+                 * Client shared by the transfers of the plugin process.
+                 */
+                static CurlMultiClient &getInstance();
+
+                /**
+                 * Creates a client with its own worker thread and connection pool,
+                 * independent of the one returned by getInstance().
+                 */
+                CurlMultiClient();
+
+                ~CurlMultiClient();
+
+                /**
+                 * Queues a transfer. The worker thread is started on first use.
+                 *
+                 * @param[in] transfer  Transfer to perform. Must have a url and callback.
+                 *
+                 * @return MPM_RESULT_OK if the transfer was queued, else an error code.
+                 */
+                int submit(std::unique_ptr<CurlTransfer> transfer);
+
+                /**
+                 * Limits the number of simultaneous connections opened to one host.
+                 * Transfers beyond the limit wait for a pooled connection. The limit
+                 * applies to transfers the worker attaches after this call.
+                 *
+                 * @param[in] maxConnections  Connection limit, 0 for no limit.
+                 */
+                void setMaxConnectionsPerHost(long maxConnections);
+
+                /**
+                 * Stops the worker thread. Queued and running transfers are completed
+                 * with MPM_RESULT_NOT_STARTED, and later submit() calls fail with it.
+                 */
+                void shutdown();
+
+            private:
+                CurlMultiClient(const CurlMultiClient &) = delete;
+                CurlMultiClient &operator=(const CurlMultiClient &) = delete;
+
+                // State of a transfer attached to the multi handle.
+                struct ActiveTransfer
+                {
+                    std::unique_ptr<CurlTransfer> transfer;
+                    struct curl_slist *headers;
+                    std::string responseBody;
+                    std::string responseHeader;
+                };
+
+                static size_t appendToString(void *contents, size_t size, size_t nmemb, void *userp);
+
+                void run();
+                void wakeup();
+                void attachPendingTransfers();
+                void completeTransfer(CURL *easy, CURLcode code);
+                void failAllTransfers(int result);
+                CURL *acquireEasyHandle();
+                void releaseEasyHandle(CURL *easy);
+
+                CURLM *m_multi;
+                std::thread m_workerThread;
+                std::mutex m_mutex;
+                std::atomic<bool> m_shutdown;
+                bool m_workerStarted;
+                int m_wakeupPipe[2];
+                long m_maxHostConnections;
+                bool m_maxHostConnectionsChanged;
+
+                std::vector<std::unique_ptr<CurlTransfer>> m_pendingTransfers;
+                std::map<CURL *, std::unique_ptr<ActiveTransfer>> m_activeTransfers;
+                std::vector<CURL *> m_idleHandles;
+        };
+    } // namespace Bridging
+}  // namespace OC
+#endif // _CURLMULTICLIENT_H_
@@ -33,6 +33,7 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include "messageHandler.h"
+#include "shmRingHandler.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,6 +47,13 @@ struct MPMPipe
 {
     int read_fd;
     int write_fd;
+
+    /**
+     * Optional shared memory ring carrying the messages of this direction.
+     * When present the pipe only carries messages too big for the ring and
+     * signals the exit of the writing process. NULL when the pipe is used.
+     */
+    MPMShmRing *ring;
 };
 
 /**
@@ -90,6 +98,41 @@ struct MPMCommonPluginCtx
 /** time out value */
 #define MPM_TIMEOUT_VAL_IN_SEC  60
 
+/**
+ * This function writes a message to the channel, using the shared memory
+ * ring if there is one and the pipe otherwise.
+ * @param[in] channel       channel to write to
+ * @param[in] pipe_message  message to be written
+ *
+ * @return MPM_RESULT_OK on success, error code on failure
+ */
+MPMResult MPMWriteChannelMessage(const MPMPipe *channel, const MPMPipeMessage *pipe_message);
+
+/**
+ * This function reads a message from the channel. The message must be
+ * handed back with MPMReleaseChannelMessage once it has been processed.
+ * @param[in] channel           channel to read from
+ * @param[in,out] pipe_message  for storing the read message.
+ *
+ * @return number of bytes read, 0 if the ring is empty or the pipe is closed
+ */
+ssize_t MPMReadChannelMessage(const MPMPipe *channel, MPMPipeMessage *pipe_message);
+
+/**
+ * This function releases a message read with MPMReadChannelMessage.
+ * @param[in] channel           channel the message was read from
+ * @param[in,out] pipe_message  message to release
+ */
+void MPMReleaseChannelMessage(const MPMPipe *channel, MPMPipeMessage *pipe_message);
+
+/**
+ * This function returns the descriptor to wait on for messages on the channel.
+ * @param[in] channel       channel
+ *
+ * @return eventfd of the ring if there is one, else the read end of the pipe
+ */
+int MPMGetChannelReadFd(const MPMPipe *channel);
+
 /**
  * This function is a OCF server.  The function does not return unless there is an
  * error or this main thread was signaled by the parent process main thread.
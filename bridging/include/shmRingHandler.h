@@ -0,0 +1,134 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+
+/* This file contains the shared memory ring used for messages from a plugin
+ * process to the mini plugin manager. The ring is a single producer, single
+ * consumer queue of framed messages placed in an anonymous shared mapping
+ * created before the plugin process is forked. The consumer is woken through
+ * an eventfd and reads message payloads in place without copying them.
+ */
+
+#ifndef _SHMRINGHANDLER_H_
+#define _SHMRINGHANDLER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include "messageHandler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default size of the shared memory ring in bytes. */
+#define MPM_SHM_RING_SIZE    (256 * 1024)
+
+typedef struct MPMShmRing MPMShmRing;
+
+/**
+ * This function creates a shared memory ring. It must be called before fork
+ * so both processes share the mapping and the eventfd.
+ * @param[in] capacity      size of the ring in bytes
+ *
+ * @return the ring on success, NULL if shared memory IPC is not available.
+ */
+MPMShmRing *MPMShmRingCreate(size_t capacity);
+
+/**
+ * This function unmaps the ring and closes its eventfd.
+ * @param[in] ring          ring to be destroyed
+ */
+void MPMShmRingDestroy(MPMShmRing *ring);
+
+/**
+ * This function sets the pipe used for messages too big for the ring. The
+ * producer and the consumer each set their own end of the same pipe after
+ * the fork. A marker frame in the ring keeps such messages in order.
+ * @param[in] ring          ring
+ * @param[in] spill_fd      pipe file descriptor
+ */
+void MPMShmRingSetSpillFd(MPMShmRing *ring, int spill_fd);
+
+/**
+ * This function returns the eventfd which becomes readable when the ring
+ * holds messages.
+ * @param[in] ring          ring
+ *
+ * @return file descriptor to wait on with select.
+ */
+int MPMShmRingGetEventFd(const MPMShmRing *ring);
+
+/**
+ * This function resets the eventfd after it was found readable. All the
+ * messages in the ring must be read afterwards.
+ * @param[in] ring          ring
+ */
+void MPMShmRingClearEvent(MPMShmRing *ring);
+
+/**
+ * This function signals the eventfd again if the ring still holds messages,
+ * for a consumer which stops reading before the ring is empty.
+ * @param[in] ring          ring
+ */
+void MPMShmRingNotifyPending(MPMShmRing *ring);
+
+/**
+ * This function checks whether the ring holds no message.
+ * @param[in] ring          ring
+ *
+ * @return true if the ring is empty
+ */
+bool MPMShmRingIsEmpty(const MPMShmRing *ring);
+
+/**
+ * This function writes a message to the ring, waiting for space if the
+ * ring is full.
+ * @param[in] ring          ring
+ * @param[in] pipe_message  message to be written
+ *
+ * @return MPM_RESULT_OK on success, error code on failure
+ */
+MPMResult MPMShmRingWrite(MPMShmRing *ring, const MPMPipeMessage *pipe_message);
+
+/**
+ * This function reads the next message from the ring. The payload points
+ * into the ring and stays valid until MPMShmRingRelease is called.
+ * @param[in] ring              ring
+ * @param[in,out] pipe_message  for storing the read message.
+ *
+ * @return number of bytes read, 0 if the ring is empty, -1 on error
+ */
+ssize_t MPMShmRingRead(MPMShmRing *ring, MPMPipeMessage *pipe_message);
+
+/**
+ * This function releases the message returned by MPMShmRingRead so the
+ * producer can reuse its space.
+ * @param[in] ring              ring
+ * @param[in,out] pipe_message  message read from the ring
+ */
+void MPMShmRingRelease(MPMShmRing *ring, MPMPipeMessage *pipe_message);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif /* _SHMRINGHANDLER_H_ */
@@ -31,6 +31,7 @@
 #include <signal.h>
 #include <pthread.h>
 #include <sys/wait.h>
+#include <poll.h>
 #include <iostream>
 #include <vector>
 
@@ -101,6 +102,76 @@ void startReadResponseThread();
  */
 void stopReadResponseThread();
 
+/**
+ * This function delivers all the messages queued in the shared memory ring of
+ * a plugin and detects the exit of the plugin through its pipe.
+ *
+ * @param[in] plugin     plugin whose messages are to be read
+ * @param[in] readfds    descriptors found readable by select
+ */
+static void readRingResponses(MPMPluginContext *plugin, fd_set *readfds)
+{
+    MPMCommonPluginCtx *ctx = plugin->plugin_ctx;
+    MPMPipe *channel = &ctx->parent_reads_fds;
+    int status = 0;
+
+    if (FD_ISSET(MPMGetChannelReadFd(channel), readfds))
+    {
+        MPMShmRingClearEvent(channel->ring);
+    }
+
+    /* Drain the ring on every pass; the plugin only signals the eventfd
+     * when it finds the ring empty.
+     */
+    while (true)
+    {
+        MPMPipeMessage pipe_message;
+
+        pipe_message.payloadSize = 0;
+        pipe_message.msgType = MPM_NOMSG;
+        pipe_message.payload = NULL;
+
+        if (MPMReadChannelMessage(channel, &pipe_message) <= 0)
+        {
+            break;
+        }
+
+        plugin->callbackClient((uint32_t)pipe_message.msgType,
+                               (MPMMessage)pipe_message.payload,
+                               pipe_message.payloadSize,
+                               plugin->shared_object_name);
+
+        MPMReleaseChannelMessage(channel, &pipe_message);
+    }
+
+    /* While the ring is used the pipe only carries messages too big for the
+     * ring, and those were read with the ring above. A spilled message is
+     * announced in the ring before it is written to the pipe, so if the pipe
+     * is still readable once the ring is empty, it is at EOF.
+     */
+    if (FD_ISSET(channel->read_fd, readfds))
+    {
+        struct pollfd pfd;
+        char byte = 0;
+        bool isEof = false;
+
+        pfd.fd = channel->read_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if ((poll(&pfd, 1, 0) == 1) && (pfd.revents & (POLLIN | POLLHUP)) &&
+            MPMShmRingIsEmpty(channel->ring))
+        {
+            isEof = (read(channel->read_fd, &byte, 1) == 0);
+        }
+
+        if (isEof || (waitpid(ctx->child_pid, &status, WNOHANG) != 0))
+        {
+            OIC_LOG_V(DEBUG, TAG, "Plugin %s is exited", plugin->shared_object_name);
+            ctx->started = false;
+        }
+    }
+}
+
 /**
  * This function runs as a thread which is running to handle
  * the response messages from the plugins(child processes)
@@ -115,9 +186,6 @@ static void *readResponse(void *)
 
     std::vector<MPMPluginContext> *loadedPlugins = &g_LoadedPlugins;
 
-    tv.tv_sec = 5;
-    tv.tv_usec = 0;
-
     while (true)
     {
         if (exitResponseThread == true)
@@ -141,10 +209,21 @@ static void *readResponse(void *)
                 {
                     maxFd = ctx->parent_reads_fds.read_fd;
                 }
+
+                int channelFd = MPMGetChannelReadFd(&ctx->parent_reads_fds);
+                FD_SET(channelFd, &(readfds));
+                if (maxFd < channelFd)
+                {
+                    maxFd = channelFd;
+                }
             }
             loadedPluginsItr++;
         }
 
+        /* select may modify the timeout, so it is set again on every pass */
+        tv.tv_sec = 5;
+        tv.tv_usec = 0;
+
         if (-1 == select(maxFd + 1, &(readfds), NULL, NULL, &tv))
         {
             continue;
@@ -160,7 +239,11 @@ static void *readResponse(void *)
                 loadedPluginsItr++;
                 continue;
             }
-            if (ctx->started)
+            if (ctx->started && ctx->parent_reads_fds.ring)
+            {
+                readRingResponses(&(*loadedPluginsItr), &readfds);
+            }
+            else if (ctx->started)
             {
                 if (FD_ISSET(ctx->parent_reads_fds.read_fd, &(readfds)))
                 {
@@ -204,8 +287,6 @@ static void *readResponse(void *)
             }
             loadedPluginsItr++;
         }
-
-        sleep(1);
     }
 
     return (void *)loadedPlugins;
@@ -419,7 +500,7 @@ MPMResult MPMSendPipeMessage(MPMPluginHandle pluginHandle, MPMMessage message, s
         pipe_message.payloadSize = size;
         pipe_message.payload = (uint8_t *)message;
         MPMCommonPluginCtx *ctx = (MPMCommonPluginCtx *) (plugin_instance->plugin_ctx);
-        result = MPMWritePipeMessage(ctx->child_reads_fds.write_fd, &pipe_message);
+        result = MPMWriteChannelMessage(&ctx->child_reads_fds, &pipe_message);
 
         pipe_message.msgType = MPM_NOMSG;
         pipe_message.payloadSize = 0;
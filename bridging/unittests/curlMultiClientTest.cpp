@@ -0,0 +1,380 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "curlMultiClient.h"
+#include "curlClient.h"
+
+using namespace OC::Bridging;
+
+static const std::chrono::seconds g_waitForCompletion(10);
+
+/*
+ * HTTP/1.1 server on the loopback interface answering every request with 200 and a body
+ * naming the request path. Each connection is served by its own thread and kept alive.
+ * Requests are held until the configured delay passes or release() is called.
+ */
+class StubHttpServer
+{
+    public:
+        StubHttpServer()
+            : m_listenFd(-1)
+            , m_port(0)
+            , m_stopped(false)
+            , m_released(false)
+            , m_delay(0)
+            , m_inFlight(0)
+            , m_maxInFlight(0)
+            , m_received(0)
+        {
+            m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+            int reuse = 1;
+            setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+            struct sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            bind(m_listenFd, (struct sockaddr *) &addr, sizeof(addr));
+            listen(m_listenFd, 16);
+
+            socklen_t len = sizeof(addr);
+            getsockname(m_listenFd, (struct sockaddr *) &addr, &len);
+            m_port = ntohs(addr.sin_port);
+
+            m_acceptThread = std::thread(&StubHttpServer::acceptLoop, this);
+        }
+
+        ~StubHttpServer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopped = true;
+                for (int fd : m_clientFds)
+                {
+                    ::shutdown(fd, SHUT_RDWR);
+                }
+            }
+            m_cond.notify_all();
+            ::shutdown(m_listenFd, SHUT_RDWR);
+            close(m_listenFd);
+            m_acceptThread.join();
+            for (auto &thread : m_clientThreads)
+            {
+                thread.join();
+            }
+            for (int fd : m_clientFds)
+            {
+                close(fd);
+            }
+        }
+
+        std::string url(const std::string &path) const
+        {
+            return "http://127.0.0.1:" + std::to_string(m_port) + path;
+        }
+
+        void setDelay(std::chrono::milliseconds delay)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_delay = delay;
+        }
+
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_released = true;
+            }
+            m_cond.notify_all();
+        }
+
+        bool waitForRequests(int count)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_cond.wait_for(lock, g_waitForCompletion,
+                                   [this, count] { return m_received >= count; });
+        }
+
+        int maxInFlight()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_maxInFlight;
+        }
+
+    private:
+        void acceptLoop()
+        {
+            while (true)
+            {
+                int fd = accept(m_listenFd, NULL, NULL);
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (fd < 0 || m_stopped)
+                {
+                    if (fd >= 0)
+                    {
+                        close(fd);
+                    }
+                    return;
+                }
+                m_clientFds.push_back(fd);
+                m_clientThreads.push_back(std::thread(&StubHttpServer::serve, this, fd));
+            }
+        }
+
+        void serve(int fd)
+        {
+            std::string buffer;
+            char chunk[1024];
+            while (true)
+            {
+                size_t end = buffer.find("\r\n\r\n");
+                if (end == std::string::npos)
+                {
+                    ssize_t n = read(fd, chunk, sizeof(chunk));
+                    if (n <= 0)
+                    {
+                        return;
+                    }
+                    buffer.append(chunk, n);
+                    continue;
+                }
+
+                std::string request = buffer.substr(0, end);
+                buffer.erase(0, end + 4);
+                size_t pathStart = request.find(' ') + 1;
+                std::string path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_received++;
+                    m_inFlight++;
+                    m_maxInFlight = std::max(m_maxInFlight, m_inFlight);
+                    m_cond.notify_all();
+                    m_cond.wait_for(lock, m_delay, [this] { return m_released || m_stopped; });
+                    m_inFlight--;
+                    if (m_stopped)
+                    {
+                        return;
+                    }
+                }
+
+                std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                                       std::to_string(path.size()) + "\r\n\r\n" + path;
+                if (write(fd, response.c_str(), response.size()) < 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        int m_listenFd;
+        uint16_t m_port;
+        std::thread m_acceptThread;
+        std::vector<std::thread> m_clientThreads;
+        std::vector<int> m_clientFds;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        bool m_stopped;
+        bool m_released;
+        std::chrono::milliseconds m_delay;
+        int m_inFlight;
+        int m_maxInFlight;
+        int m_received;
+};
+
+/*
+ * Collects the completions of the transfers of a test.
+ */
+class Completions
+{
+    public:
+        CurlCompletionCallback callback()
+        {
+            return [this](int result, long responseCode, const std::string &responseBody,
+                          const std::vector<std::string> &)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_results.push_back(result);
+                m_responseCodes.push_back(responseCode);
+                m_bodies.push_back(responseBody);
+                m_cond.notify_all();
+            };
+        }
+
+        bool waitFor(size_t count)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_cond.wait_for(lock, g_waitForCompletion,
+                                   [this, count] { return m_results.size() >= count; });
+        }
+
+        std::vector<int> results()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_results;
+        }
+
+        std::vector<long> responseCodes()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_responseCodes;
+        }
+
+        std::vector<std::string> bodies()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_bodies;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::vector<int> m_results;
+        std::vector<long> m_responseCodes;
+        std::vector<std::string> m_bodies;
+};
+
+static std::unique_ptr<CurlTransfer> makeTransfer(const std::string &url,
+                                                  const CurlCompletionCallback &callback)
+{
+    std::unique_ptr<CurlTransfer> transfer(new CurlTransfer());
+    transfer->url = url;
+    transfer->method = OC::PlatformCommands::GET;
+    transfer->useSsl = CURLUSESSL_NONE;
+    transfer->callback = callback;
+    return transfer;
+}
+
+/*
+ * A client can't be restarted once shut down, so each test runs its own client rather than
+ * the one of getInstance(). It is declared last, so it is shut down first and completes its
+ * transfers while the server and the completions are still there.
+ */
+class CurlMultiClientTest : public testing::Test
+{
+    protected:
+        StubHttpServer m_server;
+        Completions m_completions;
+        CurlMultiClient m_client;
+};
+
+TEST_F(CurlMultiClientTest, ConcurrentTransfersComplete)
+{
+    const int numOfTransfers = 8;
+    m_client.setMaxConnectionsPerHost(numOfTransfers);
+    m_server.setDelay(std::chrono::milliseconds(200));
+
+    for (int i = 0; i < numOfTransfers; i++)
+    {
+        std::string path = "/light/" + std::to_string(i);
+        EXPECT_EQ(MPM_RESULT_OK, m_client.submit(makeTransfer(m_server.url(path),
+                                                            m_completions.callback())));
+    }
+
+    ASSERT_TRUE(m_completions.waitFor(numOfTransfers));
+
+    std::vector<int> results = m_completions.results();
+    std::vector<long> responseCodes = m_completions.responseCodes();
+    std::vector<std::string> bodies = m_completions.bodies();
+    for (int i = 0; i < numOfTransfers; i++)
+    {
+        EXPECT_EQ(MPM_RESULT_OK, results[i]);
+        EXPECT_EQ(200, responseCodes[i]);
+        std::string path = "/light/" + std::to_string(i);
+        EXPECT_NE(bodies.end(), std::find(bodies.begin(), bodies.end(), path));
+    }
+
+    // The transfers were held by the server at the same time, not one after the other.
+    EXPECT_LT(1, m_server.maxInFlight());
+}
+
+TEST_F(CurlMultiClientTest, MaxConnectionsPerHostIsHonoured)
+{
+    const int numOfTransfers = 6;
+    const long maxConnections = 2;
+    m_client.setMaxConnectionsPerHost(maxConnections);
+    m_server.setDelay(std::chrono::milliseconds(100));
+
+    for (int i = 0; i < numOfTransfers; i++)
+    {
+        EXPECT_EQ(MPM_RESULT_OK, m_client.submit(makeTransfer(m_server.url("/capped"),
+                                                            m_completions.callback())));
+    }
+
+    ASSERT_TRUE(m_completions.waitFor(numOfTransfers));
+
+    for (int result : m_completions.results())
+    {
+        EXPECT_EQ(MPM_RESULT_OK, result);
+    }
+    EXPECT_GE(maxConnections, m_server.maxInFlight());
+}
+
+TEST_F(CurlMultiClientTest, InvalidTransferIsRejected)
+{
+
+    EXPECT_EQ(MPM_RESULT_INVALID_PARAMETER, m_client.submit(nullptr));
+    EXPECT_EQ(MPM_RESULT_INVALID_PARAMETER,
+              m_client.submit(makeTransfer("", m_completions.callback())));
+    EXPECT_EQ(MPM_RESULT_INVALID_PARAMETER,
+              m_client.submit(makeTransfer(m_server.url("/"), CurlCompletionCallback())));
+}
+
+TEST_F(CurlMultiClientTest, ShutdownCompletesInFlightTransfers)
+{
+    const int numOfTransfers = 3;
+    m_client.setMaxConnectionsPerHost(numOfTransfers);
+    // Held until the server is released, well past the end of the test.
+    m_server.setDelay(std::chrono::minutes(1));
+
+    for (int i = 0; i < numOfTransfers; i++)
+    {
+        EXPECT_EQ(MPM_RESULT_OK, m_client.submit(makeTransfer(m_server.url("/held"),
+                                                            m_completions.callback())));
+    }
+    ASSERT_TRUE(m_server.waitForRequests(numOfTransfers));
+
+    m_client.shutdown();
+
+    // Every in-flight transfer completes, once, before shutdown() returns.
+    std::vector<int> results = m_completions.results();
+    ASSERT_EQ((size_t) numOfTransfers, results.size());
+    for (int result : results)
+    {
+        EXPECT_EQ(MPM_RESULT_NOT_STARTED, result);
+    }
+
+    EXPECT_EQ(MPM_RESULT_NOT_STARTED, m_client.submit(makeTransfer(m_server.url("/late"),
+                                                                 m_completions.callback())));
+    m_server.release();
+}
@@ -0,0 +1,216 @@
+//******************************************************************
+//
+// Copyright 2017 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+
+#include "shmRingHandler.h"
+
+/*
+ * Frames are a 16 byte header followed by the payload, rounded up to 8 bytes,
+ * so a ring of 128 bytes holds a frame of at most 64 bytes (48 bytes of payload)
+ * before the message is spilled.
+ */
+static const size_t RING_CAPACITY = 128;
+static const size_t FRAME_HEADER_SIZE = 16;
+
+class ShmRingTest : public testing::Test
+{
+    protected:
+        ShmRingTest() : m_ring(NULL)
+        {
+            m_spillFds[0] = -1;
+            m_spillFds[1] = -1;
+        }
+
+        virtual void SetUp()
+        {
+            m_ring = MPMShmRingCreate(RING_CAPACITY);
+            ASSERT_TRUE(m_ring != NULL);
+        }
+
+        virtual void TearDown()
+        {
+            MPMShmRingDestroy(m_ring);
+            for (int i = 0; i < 2; i++)
+            {
+                if (m_spillFds[i] != -1)
+                {
+                    close(m_spillFds[i]);
+                }
+            }
+        }
+
+        // The producer and the consumer share the pipe as they do after the fork.
+        void setSpillPipe()
+        {
+            ASSERT_EQ(0, pipe(m_spillFds));
+            MPMShmRingSetSpillFd(m_ring, m_spillFds[0]);
+        }
+
+        MPMResult write(MPMMessageType type, const std::string &payload)
+        {
+            if (m_spillFds[1] != -1)
+            {
+                MPMShmRingSetSpillFd(m_ring, m_spillFds[1]);
+            }
+
+            MPMPipeMessage message;
+            message.msgType = type;
+            message.payloadSize = payload.size();
+            message.payload = (const uint8_t *) payload.data();
+            MPMResult result = MPMShmRingWrite(m_ring, &message);
+
+            if (m_spillFds[0] != -1)
+            {
+                MPMShmRingSetSpillFd(m_ring, m_spillFds[0]);
+            }
+            return result;
+        }
+
+        void expectRead(MPMMessageType type, const std::string &payload)
+        {
+            MPMPipeMessage message = {0, MPM_NOMSG, NULL};
+            ASSERT_LT(0, MPMShmRingRead(m_ring, &message));
+            EXPECT_EQ(type, message.msgType);
+            ASSERT_EQ(payload.size(), message.payloadSize);
+            EXPECT_EQ(payload, std::string((const char *) message.payload, message.payloadSize));
+            MPMShmRingRelease(m_ring, &message);
+        }
+
+        // Writes and reads a message whose frame takes frameSize bytes of the ring.
+        void passFrame(size_t frameSize)
+        {
+            std::string payload(frameSize - FRAME_HEADER_SIZE, 'p');
+            ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, payload));
+            expectRead(MPM_ADD, payload);
+        }
+
+        MPMShmRing *m_ring;
+        int m_spillFds[2];
+};
+
+TEST_F(ShmRingTest, NewRingIsEmpty)
+{
+    MPMPipeMessage message = {0, MPM_NOMSG, NULL};
+
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+    EXPECT_EQ(0, MPMShmRingRead(m_ring, &message));
+}
+
+TEST_F(ShmRingTest, RingIsEmptyOnlyAfterRelease)
+{
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_SCAN, "scan"));
+    EXPECT_FALSE(MPMShmRingIsEmpty(m_ring));
+
+    MPMPipeMessage message = {0, MPM_NOMSG, NULL};
+    ASSERT_LT(0, MPMShmRingRead(m_ring, &message));
+    EXPECT_FALSE(MPMShmRingIsEmpty(m_ring));
+
+    MPMShmRingRelease(m_ring, &message);
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+    EXPECT_EQ(0, MPMShmRingRead(m_ring, &message));
+}
+
+TEST_F(ShmRingTest, WriteToEmptyRingSignalsEvent)
+{
+    struct pollfd pfd = { MPMShmRingGetEventFd(m_ring), POLLIN, 0 };
+    EXPECT_EQ(0, poll(&pfd, 1, 0));
+
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_SCAN, "scan"));
+    EXPECT_EQ(1, poll(&pfd, 1, 0));
+
+    MPMShmRingClearEvent(m_ring);
+    EXPECT_EQ(0, poll(&pfd, 1, 0));
+
+    // A consumer stopping before the ring is empty signals itself again.
+    MPMShmRingNotifyPending(m_ring);
+    EXPECT_EQ(1, poll(&pfd, 1, 0));
+}
+
+TEST_F(ShmRingTest, MessagesKeepOrderAcrossWraparound)
+{
+    std::vector<std::string> payloads;
+    for (size_t i = 0; i < 40; i++)
+    {
+        payloads.push_back(std::string(i % 17, (char)('a' + i % 26)));
+    }
+
+    // Two messages at a time, so frames are read back while others wait in the ring.
+    for (size_t i = 0; i + 1 < payloads.size(); i += 2)
+    {
+        ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, payloads[i]));
+        ASSERT_EQ(MPM_RESULT_OK, write(MPM_DELETE, payloads[i + 1]));
+        expectRead(MPM_ADD, payloads[i]);
+        expectRead(MPM_DELETE, payloads[i + 1]);
+    }
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+}
+
+TEST_F(ShmRingTest, FrameNotFittingBeforeEndIsPadded)
+{
+    passFrame(48);
+    passFrame(48);
+
+    // 32 bytes are left before the end, the frame continues at the start of the ring.
+    std::string payload(32, 'w');
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, payload));
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_DELETE, "next"));
+    expectRead(MPM_ADD, payload);
+    expectRead(MPM_DELETE, "next");
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+}
+
+TEST_F(ShmRingTest, SpaceTooSmallForPaddingHeaderIsSkipped)
+{
+    passFrame(56);
+    passFrame(64);
+
+    // Only 8 bytes are left before the end, too few for a padding frame header.
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, "after"));
+    expectRead(MPM_ADD, "after");
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+}
+
+TEST_F(ShmRingTest, BigMessageWithoutSpillPipeFails)
+{
+    std::string payload(RING_CAPACITY, 'b');
+
+    EXPECT_EQ(MPM_RESULT_INSUFFICIENT_BUFFER, write(MPM_ADD, payload));
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+}
+
+TEST_F(ShmRingTest, SpilledMessageKeepsOrder)
+{
+    setSpillPipe();
+    std::string big(RING_CAPACITY, 'b');
+
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, "before"));
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_ADD, big));
+    ASSERT_EQ(MPM_RESULT_OK, write(MPM_DELETE, "after"));
+
+    expectRead(MPM_ADD, "before");
+    expectRead(MPM_ADD, big);
+    expectRead(MPM_DELETE, "after");
+    EXPECT_TRUE(MPMShmRingIsEmpty(m_ring));
+}
@@ -26,6 +26,8 @@
 #include <vector>
 #include <atomic>
 #include <map>
+#include <queue>
+#include <functional>
 #include <memory>
 #include <condition_variable>
 
@@ -27,6 +27,65 @@ struct IPCAAppInfoInternal;
 // Map's key is resource path obtained from resource->uri() (e.g.: /oic/d).
 typedef std::map<std::string, std::shared_ptr<OCResource>> ResourceMap;
 
+// Events of a device that the worker thread handles when their deadline is reached.
+typedef enum
+{
+    LivenessEvent_CloseExpiry = 0,         // Device may have been closed long enough to drop.
+    LivenessEvent_DiscoveryExpiry,         // Device may have stopped responding to discovery.
+    LivenessEvent_CommonResourcesRetry,    // Device info, platform info or maintenance resource
+                                           // is still missing.
+    LivenessEvent_Count
+} LivenessEventType;
+
+// GET request sent on behalf of every app request for the same resource that arrives
+// before the response.
+typedef struct CoalescedGetRequest
+{
+    typedef std::shared_ptr<CoalescedGetRequest> Ptr;
+
+    std::string deviceId;
+    std::string requestKey;     // See GetRequestKey().
+    uint64_t sentTime;          // Value returned by OICGetCurrentTime(TIME_IN_MS).
+    std::vector<CallbackInfo::Ptr> callbackInfos;
+} CoalescedGetRequest;
+
+// Observe request shared by every app observing the same resource.
+typedef struct SharedObserveRequest
+{
+    typedef std::shared_ptr<SharedObserveRequest> Ptr;
+
+    std::string deviceId;
+    std::string requestKey;     // See GetRequestKey().
+    std::shared_ptr<OCResource> ocResource; // The OCResource that holds the observe handle.
+    std::vector<CallbackInfo::Ptr> callbackInfos;
+
+    // Latest notification, given to apps that join the observe.
+    bool isRepresentationAvailable;
+    OCRepresentation lastRepresentation;
+} SharedObserveRequest;
+
+typedef struct CachedRepresentation
+{
+    uint64_t receivedTime;      // Value returned by OICGetCurrentTime(TIME_IN_MS).
+    OCRepresentation rep;
+} CachedRepresentation;
+
+// How the GET and observe requests of apps for a device were served.
+typedef struct RequestCacheStats
+{
+    size_t cacheHitCount;       // Served from a cached representation.
+    size_t coalescedCount;      // Joined a GET in flight or an existing observe.
+    size_t missCount;           // Sent to the device.
+} RequestCacheStats;
+
+// Response to an app request that is not from the stack, e.g. a cached representation.
+typedef struct DeferredResponse
+{
+    IPCAStatus status;
+    OCRepresentation rep;
+    CallbackInfo::Ptr callbackInfo;
+} DeferredResponse;
+
 // Some information about an OCF device.
 typedef struct DeviceDetails
 {
@@ -47,6 +106,10 @@ typedef struct DeviceDetails
     // Timestamp of last ping call to device.
     uint64_t lastPingTime;
 
+    // Set while the worker thread has a pending event of the type for this device, so that
+    // frequent timestamp updates do not queue an event each.
+    bool isLivenessEventScheduled[LivenessEvent_Count];
+
     // Device ID in OnResourceFound().
     std::string deviceId;
 
@@ -83,8 +146,29 @@ typedef struct DeviceDetails
     // List of resource interfaces, not necessarily a complete list, depending on the resource
     // type in discovery.
     std::vector<std::string> discoveredResourceInterfaces;
+
+    // Requests shared by apps and representations served to GET requests.
+    // Key to the maps is from GetRequestKey().
+    std::map<std::string, CoalescedGetRequest::Ptr> pendingGetRequests;
+    std::map<std::string, SharedObserveRequest::Ptr> sharedObserveRequests;
+    std::map<std::string, CachedRepresentation> cachedRepresentations;
+    RequestCacheStats requestCacheStats;
 } DeviceDetails;
 
+typedef struct LivenessEvent
+{
+    uint64_t deadline;  // Value comparable to OICGetCurrentTime(TIME_IN_MS).
+    LivenessEventType type;
+
+    // The device may be deleted or replaced by a rediscovered one while the event is pending.
+    std::weak_ptr<DeviceDetails> deviceDetails;
+
+    bool operator>(const LivenessEvent& other) const
+    {
+        return deadline > other.deadline;
+    }
+} LivenessEvent;
+
 typedef struct RequestAccessContext
 {
     std::string deviceId;
@@ -105,6 +189,11 @@ class OCFFramework
         IPCAStatus Stop(InputPinCallbackHandle passwordInputCallbackHandle,
                         DisplayPinCallbackHandle passwordDisplayCallbackHandle);
 
+        // Used by unit tests to shorten how long a closed device is kept and how long a device
+        // may miss discovery.  Applies to devices discovered afterwards.  0 restores the default.
+        void SetLivenessTimeouts(uint64_t allowedTimeSinceLastCloseMs,
+                                 uint64_t allowedTimeSinceLastDiscoveryResponseMs);
+
         IPCAStatus RegisterAppCallbackObject(Callback::Ptr cb);
         void UnregisterAppCallbackObject(Callback::Ptr cb);
 
@@ -156,6 +245,9 @@ class OCFFramework
         IPCAStatus StartObserve(std::string& deviceId, CallbackInfo::Ptr callbackInfo);
         void StopObserve(CallbackInfo::Ptr callbackInfo);
 
+        // How the GET and observe requests for the device were served.
+        IPCAStatus GetRequestCacheStats(const std::string& deviceId, RequestCacheStats& stats);
+
         void IsResourceObservable(std::string& deviceId,
                         const char* resourcePath,
                         bool* isObservable);
@@ -177,17 +269,18 @@ class OCFFramework
                         CallbackInfo::Ptr passwordInputCallbackInfo);
 
     private:
-        // Callback from OCF for OCResource->get()
+        // Callback from OCF for OCResource->observe()
         void OnObserve(const HeaderOptions headerOptions,
                 const OCRepresentation &rep,
                 const int &eCode,
                 const int &sequenceNumber,
-                CallbackInfo::Ptr callbackInfo);
+                SharedObserveRequest::Ptr observeRequest);
 
+        // Callback from OCF for OCResource->get()
         void OnGet(const HeaderOptions& headerOptions,
                 const OCRepresentation& rep,
                 const int eCode,
-                CallbackInfo::Ptr callbackInfo);
+                CoalescedGetRequest::Ptr getRequest);
 
         void OnDelete(const HeaderOptions& headerOptions,
                 const int eCode,
@@ -224,12 +317,47 @@ class OCFFramework
                     size_t passwordBufferSize,
                     CallbackInfo::Ptr callbackInfo);
 
+        // Requests that apps share.  A GET is served from a fresh cached representation or
+        // joins an identical GET in flight, an observe joins an existing observe.
+        OCStackResult SendGetRequest(const DeviceDetails::Ptr& deviceDetails,
+                    const std::shared_ptr<OCResource>& ocResource,
+                    const QueryParamsMap& queryParamsMap,
+                    CallbackInfo::Ptr callbackInfo);
+
+        OCStackResult SendObserveRequest(const DeviceDetails::Ptr& deviceDetails,
+                    const std::shared_ptr<OCResource>& ocResource,
+                    const QueryParamsMap& queryParamsMap,
+                    CallbackInfo::Ptr callbackInfo);
+
+        // Requests with the same key are identical.
+        static std::string GetRequestKey(const std::shared_ptr<OCResource>& ocResource,
+                    const CallbackInfo::Ptr& callbackInfo);
+
+        // Forget the representations of the device and stop joining its GET requests in
+        // flight, e.g. when the app changes the device.
+        void InvalidateCachedRepresentations(const std::string& deviceId);
+
+        // Queue a response for the worker thread, so the app is not called back in its request.
+        void QueueDeferredResponse(IPCAStatus status,
+                    const OCRepresentation& rep,
+                    CallbackInfo::Ptr callbackInfo);
+        void DeliverDeferredResponses(const std::vector<DeferredResponse>& responses);
+
         // A device is formed when all its device info and platform info are known.
         IPCAStatus GetCommonResources(DeviceDetails::Ptr deviceDetails);
 
         // See m_workerThread variable below.
         static void WorkerThread(OCFFramework* ocfFramework);
 
+        // Queue an event of the device for the worker thread, unless one of the type is
+        // already pending.  Caller holds m_OCFFrameworkMutex.
+        void ScheduleLivenessEvent(const DeviceDetails::Ptr& deviceDetails,
+                    LivenessEventType type,
+                    uint64_t deadline);
+
+        // Handle the events whose deadline is reached.
+        void ProcessLivenessEvents(const std::vector<LivenessEvent>& events);
+
         // Entry point for the thread that will request access to a device.
         static void RequestAccessWorkerThread(RequestAccessContext* requestContext);
 
@@ -280,6 +408,20 @@ class OCFFramework
         std::condition_variable m_workerThreadCV;
         std::mutex m_workerThreadMutex;
 
+        // Pending events of the worker thread, earliest deadline on top.  Protected by
+        // m_workerThreadMutex, which may be taken while holding m_OCFFrameworkMutex but not
+        // the other way around.
+        std::priority_queue<LivenessEvent,
+                    std::vector<LivenessEvent>,
+                    std::greater<LivenessEvent>> m_livenessEvents;
+
+        // Responses the worker thread delivers to apps.  Protected by m_workerThreadMutex.
+        std::vector<DeferredResponse> m_deferredResponses;
+
+        // See SetLivenessTimeouts().  Protected by m_OCFFrameworkMutex.
+        uint64_t m_allowedTimeSinceLastCloseMs;
+        uint64_t m_allowedTimeSinceLastDiscoveryResponseMs;
+
         // Synchronize Start()/Stop()
         std::mutex m_startStopMutex;
         bool m_isStarted;
@@ -34,6 +34,8 @@ size_t g_nextAppKey = 1;
 std::recursive_mutex g_ipcaAppMutex;
 bool g_unitTestMode = false;
 
+extern OCFFramework ocfFramework;
+
 // Return App with matching appId.
 App::Ptr FindApp(size_t appId)
 {
@@ -535,3 +537,10 @@ void IPCA_CALL IPCASetUnitTestMode()
 {
     g_unitTestMode = true;
 }
+
+void IPCA_CALL IPCASetUnitTestLivenessTimeouts(uint64_t allowedTimeSinceLastCloseMs,
+                                               uint64_t allowedTimeSinceLastDiscoveryResponseMs)
+{
+    ocfFramework.SetLivenessTimeouts(allowedTimeSinceLastCloseMs,
+                                     allowedTimeSinceLastDiscoveryResponseMs);
+}
@@ -40,6 +40,23 @@ using namespace std::placeholders;
 const unsigned short c_discoveryTimeout = 5;  // Max number of seconds to discover
                                               // security information for a device
 
+// Devices not opened by app for this long are deleted.
+const uint64_t c_allowedTimeSinceLastCloseMs = 300000;
+
+// Apps are told a device is not responding after it missed discovery for this long.
+const uint64_t c_allowedTimeSinceLastDiscoveryResponseMs = 60000;
+
+// Interval between requests for device info, platform info and maintenance resource
+// that the device has not returned yet.
+const uint64_t c_commonResourcesRetryIntervalMs = 2000;
+
+// GET requests are served from representations received within this time.
+const uint64_t c_cachedRepresentationTtlMs = 1000;
+
+// A GET request in flight is joined until the stack gives up on it, i.e. EXCHANGE_LIFETIME
+// defined in RFC7252.
+const uint64_t c_getRequestLifetimeMs = 247000;
+
 // Path for Persistent Storage (Ends with backslash (\) or forward slash (/))
 std::string  g_psPath;
 
@@ -59,6 +76,8 @@ FILE* server_fopen(const char *path, const char *mode)
 OCPersistentStorage ps = {server_fopen, fread, fwrite, fclose, unlink};
 
 OCFFramework::OCFFramework() :
+    m_allowedTimeSinceLastCloseMs(c_allowedTimeSinceLastCloseMs),
+    m_allowedTimeSinceLastDiscoveryResponseMs(c_allowedTimeSinceLastDiscoveryResponseMs),
     m_isStarted(false),
     m_isStopping(false)
 {
@@ -378,7 +397,11 @@ IPCAStatus OCFFramework::Stop(InputPinCallbackHandle passwordInputCallbackHandle
     OCSecure::deregisterDisplayPinCallback(passwordDisplayCallbackHandle);
     OCSecure::provisionClose();
 
-    m_isStopping = true;
+    {
+        // The worker thread may wait without a deadline, so the flag is set under its mutex.
+        std::lock_guard<std::mutex> workerThreadLock(m_workerThreadMutex);
+        m_isStopping = true;
+    }
 
     m_workerThreadCV.notify_all();
     if (m_workerThread.joinable())
@@ -396,6 +419,11 @@ IPCAStatus OCFFramework::Stop(InputPinCallbackHandle passwordInputCallbackHandle
     std::lock_guard<std::recursive_mutex> ocfFrameworkLock(m_OCFFrameworkMutex);
     m_OCFDevices.clear();
     m_OCFDevicesIndexedByDeviceURI.clear();
+    {
+        std::lock_guard<std::mutex> workerThreadLock(m_workerThreadMutex);
+        m_livenessEvents = decltype(m_livenessEvents)();
+        m_deferredResponses.clear();
+    }
 
     m_isStopping = false;
     m_isStarted = false;
@@ -403,104 +431,218 @@ IPCAStatus OCFFramework::Stop(InputPinCallbackHandle passwordInputCallbackHandle
     return status;
 }
 
+void OCFFramework::SetLivenessTimeouts(uint64_t allowedTimeSinceLastCloseMs,
+                                       uint64_t allowedTimeSinceLastDiscoveryResponseMs)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+    m_allowedTimeSinceLastCloseMs = (allowedTimeSinceLastCloseMs != 0) ?
+        allowedTimeSinceLastCloseMs : c_allowedTimeSinceLastCloseMs;
+
+    m_allowedTimeSinceLastDiscoveryResponseMs = (allowedTimeSinceLastDiscoveryResponseMs != 0) ?
+        allowedTimeSinceLastDiscoveryResponseMs : c_allowedTimeSinceLastDiscoveryResponseMs;
+}
+
 void OCFFramework::WorkerThread(OCFFramework* ocfFramework)
 {
     std::unique_lock<std::mutex> workerThreadLock(ocfFramework->m_workerThreadMutex);
 
-    const size_t WorkerThreadSleepTimeSeconds = 2;
-    std::chrono::seconds workerThreadSleepTime(WorkerThreadSleepTimeSeconds);
-
     while (false == ocfFramework->m_isStopping)
     {
+        if (!ocfFramework->m_deferredResponses.empty())
+        {
+            std::vector<DeferredResponse> responses;
+            responses.swap(ocfFramework->m_deferredResponses);
+
+            workerThreadLock.unlock();
+            ocfFramework->DeliverDeferredResponses(responses);
+            workerThreadLock.lock();
+            continue;
+        }
+
         uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
-        std::vector<DeviceDetails::Ptr> devicesThatAreNotResponding;
-        std::vector<DeviceDetails::Ptr> devicesThatAreNotOpened;
-        std::vector<DeviceDetails::Ptr> devicesToGetCommonResources;
+        std::vector<LivenessEvent> dueEvents;
 
-        // Collect devices that are not used, i.e. discovered a while back and those that are not
-        // used by app for a while.
+        while (!ocfFramework->m_livenessEvents.empty() &&
+               (ocfFramework->m_livenessEvents.top().deadline <= currentTime))
         {
-            std::lock_guard<std::recursive_mutex> lock(ocfFramework->m_OCFFrameworkMutex);
-            const unsigned int AllowedTimeSincLastCloseMs = 300000;
-            const unsigned int AllowedTimeSinceLastDiscoveryResponseMs = 60000;
+            dueEvents.push_back(ocfFramework->m_livenessEvents.top());
+            ocfFramework->m_livenessEvents.pop();
+        }
 
-            // Walk through each device.
-            for (auto const& device : ocfFramework->m_OCFDevices)
+        if (dueEvents.empty())
+        {
+            // Sleep until the earliest deadline, or until an earlier event or a response
+            // is queued.
+            if (ocfFramework->m_livenessEvents.empty())
+            {
+                ocfFramework->m_workerThreadCV.wait(workerThreadLock);
+            }
+            else
             {
-                // Is device opened by app?
-                if ((device.second->deviceOpenCount == 0) &&
-                    (currentTime - device.second->lastCloseDeviceTime > AllowedTimeSincLastCloseMs))
+                std::chrono::milliseconds timeToDeadline(
+                    ocfFramework->m_livenessEvents.top().deadline - currentTime);
+                ocfFramework->m_workerThreadCV.wait_for(workerThreadLock, timeToDeadline);
+            }
+            continue;
+        }
+
+        // Handling the events takes m_OCFFrameworkMutex, which is never taken while holding
+        // m_workerThreadMutex.
+        workerThreadLock.unlock();
+        ocfFramework->ProcessLivenessEvents(dueEvents);
+        workerThreadLock.lock();
+    }
+}
+
+void OCFFramework::ScheduleLivenessEvent(const DeviceDetails::Ptr& deviceDetails,
+                                         LivenessEventType type,
+                                         uint64_t deadline)
+{
+    if (deviceDetails->isLivenessEventScheduled[type])
+    {
+        // The pending event is due no later than this one, and reschedules itself then.
+        return;
+    }
+
+    deviceDetails->isLivenessEventScheduled[type] = true;
+
+    LivenessEvent livenessEvent = { deadline, type, deviceDetails };
+    bool isEarliest;
+    {
+        std::lock_guard<std::mutex> lock(m_workerThreadMutex);
+        m_livenessEvents.push(livenessEvent);
+        isEarliest = (m_livenessEvents.top().deadline == deadline);
+    }
+
+    if (isEarliest)
+    {
+        m_workerThreadCV.notify_all();
+    }
+}
+
+void OCFFramework::ProcessLivenessEvents(const std::vector<LivenessEvent>& events)
+{
+    uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
+    std::vector<DeviceDetails::Ptr> devicesThatAreNotResponding;
+    std::vector<DeviceDetails::Ptr> devicesToGetCommonResources;
+
+    for (const auto& livenessEvent : events)
+    {
+        DeviceDetails::Ptr device = livenessEvent.deviceDetails.lock();
+        if (device == nullptr)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+        // Ignore the event if the device was deleted in the meantime.
+        auto it = m_OCFDevices.find(device->deviceId);
+        if ((it == m_OCFDevices.end()) || (it->second != device))
+        {
+            continue;
+        }
+
+        device->isLivenessEventScheduled[livenessEvent.type] = false;
+
+        switch (livenessEvent.type)
+        {
+            case LivenessEvent_CloseExpiry:
+                // Opening the device cancels the expiry, the final close schedules it again.
+                if (device->deviceOpenCount != 0)
                 {
-                    devicesThatAreNotOpened.push_back(device.second);
-                    continue;  // device details is about to be deleted.
+                    break;
                 }
 
-                // Has device responded to Discovery?
-                if ((device.second->deviceNotRespondingIndicated == false) &&
-                    (currentTime - device.second->lastResponseTimeToDiscovery > AllowedTimeSinceLastDiscoveryResponseMs))
+                if (currentTime - device->lastCloseDeviceTime > m_allowedTimeSinceLastCloseMs)
+                {
+                    for (auto const& deviceUri : device->deviceUris)
+                    {
+                        m_OCFDevicesIndexedByDeviceURI.erase(deviceUri);
+                    }
+
+                    m_OCFDevices.erase(it);
+                    OIC_LOG_V(INFO, TAG, "Device deleted from m_OCFDevices: %s",
+                        device->deviceId.c_str());
+                }
+                else
                 {
-                    device.second->deviceNotRespondingIndicated = true;
-                    devicesThatAreNotResponding.push_back(device.second);
+                    ScheduleLivenessEvent(device, LivenessEvent_CloseExpiry,
+                        device->lastCloseDeviceTime + m_allowedTimeSinceLastCloseMs + 1);
                 }
+                break;
 
-                // Are there common resources that are not yet obtained.
-                if (!device.second->deviceInfoAvailable ||
-                    !device.second->platformInfoAvailable ||
-                    !device.second->maintenanceResourceAvailable)
+            case LivenessEvent_DiscoveryExpiry:
+                // Discovery response schedules the expiry again once not responding is indicated.
+                if (device->deviceNotRespondingIndicated)
                 {
-                     devicesToGetCommonResources.push_back(device.second);
+                    break;
                 }
-            }
 
-            // Erase unopened devices from the m_OCFDevices.
-            for (auto& device : devicesThatAreNotOpened)
-            {
-                for (auto const& deviceUri : ocfFramework->m_OCFDevices[device->deviceId]->deviceUris)
+                if (currentTime - device->lastResponseTimeToDiscovery >
+                        m_allowedTimeSinceLastDiscoveryResponseMs)
+                {
+                    device->deviceNotRespondingIndicated = true;
+                    devicesThatAreNotResponding.push_back(device);
+                }
+                else
                 {
-                    ocfFramework->m_OCFDevicesIndexedByDeviceURI.erase(deviceUri);
+                    ScheduleLivenessEvent(device, LivenessEvent_DiscoveryExpiry,
+                        device->lastResponseTimeToDiscovery +
+                            m_allowedTimeSinceLastDiscoveryResponseMs + 1);
                 }
+                break;
 
-                ocfFramework->m_OCFDevices.erase(device->deviceId);
-                OIC_LOG_V(INFO, TAG, "Device deleted from m_OCFDevices: %s",
-                    device->deviceId.c_str());
-            }
-        }
+            case LivenessEvent_CommonResourcesRetry:
+                if (!device->deviceInfoAvailable ||
+                    !device->platformInfoAvailable ||
+                    !device->maintenanceResourceAvailable)
+                {
+                    devicesToGetCommonResources.push_back(device);
+                }
+                break;
 
-        // Get common resources.
-        for (const auto& device : devicesToGetCommonResources)
-        {
-            ocfFramework->GetCommonResources(device);
+            default:
+                assert(false);
+                break;
         }
+    }
 
-        // Take a snapshot of callbacks for thread safe iteration.
-        std::vector<Callback::Ptr> callbackSnapshot;
-        ocfFramework->ThreadSafeCopy(ocfFramework->m_callbacks, callbackSnapshot);
+    // Get common resources.
+    for (const auto& device : devicesToGetCommonResources)
+    {
+        GetCommonResources(device);
+    }
 
-        // Callback to apps.
-        for (const auto& device : devicesThatAreNotResponding)
-        {
-            // Take a snapshot of device->discoveredResourceTypes and deviceInfo
-            // for thread safe use by the callee.
-            std::vector<std::string> resourceTypesSnapshot;
-            ocfFramework->ThreadSafeCopy(device->discoveredResourceTypes, resourceTypesSnapshot);
+    if (devicesThatAreNotResponding.empty())
+    {
+        return;
+    }
 
-            InternalDeviceInfo deviceInfoSnapshot;
-            ocfFramework->ThreadSafeCopy(device->deviceInfo, deviceInfoSnapshot);
+    // Take a snapshot of callbacks for thread safe iteration.
+    std::vector<Callback::Ptr> callbackSnapshot;
+    ThreadSafeCopy(m_callbacks, callbackSnapshot);
 
-            for (const auto& callback : callbackSnapshot)
-            {
-                callback->DeviceDiscoveryCallback(
-                                        false, /* device is no longer responding to discovery */
-                                        false,
-                                        deviceInfoSnapshot,
-                                        resourceTypesSnapshot);
-            }
-        }
+    // Callback to apps.
+    for (const auto& device : devicesThatAreNotResponding)
+    {
+        // Take a snapshot of device->discoveredResourceTypes and deviceInfo
+        // for thread safe use by the callee.
+        std::vector<std::string> resourceTypesSnapshot;
+        ThreadSafeCopy(device->discoveredResourceTypes, resourceTypesSnapshot);
 
-        ocfFramework->m_workerThreadCV.wait_for(
-                            workerThreadLock,
-                            workerThreadSleepTime,
-                            [ocfFramework]() { return ocfFramework->m_isStopping; });
+        InternalDeviceInfo deviceInfoSnapshot;
+        ThreadSafeCopy(device->deviceInfo, deviceInfoSnapshot);
+
+        for (const auto& callback : callbackSnapshot)
+        {
+            callback->DeviceDiscoveryCallback(
+                                    false, /* device is no longer responding to discovery */
+                                    false,
+                                    deviceInfoSnapshot,
+                                    resourceTypesSnapshot);
+        }
     }
 }
 
@@ -536,6 +678,8 @@ IPCAStatus OCFFramework::IPCADeviceCloseCalled(std::string& deviceId)
         if (--deviceDetails->deviceOpenCount == 0)
         {
             deviceDetails->lastCloseDeviceTime = OICGetCurrentTime(TIME_IN_MS);
+            ScheduleLivenessEvent(deviceDetails, LivenessEvent_CloseExpiry,
+                deviceDetails->lastCloseDeviceTime + m_allowedTimeSinceLastCloseMs + 1);
         }
     }
 
@@ -602,9 +746,18 @@ void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
             deviceDetails->securityInfo.isStarted = false; // set to true in RequestAccess()
             deviceDetails->deviceOpenCount = 0;
             deviceDetails->lastPingTime = 0;
+            deviceDetails->requestCacheStats.cacheHitCount = 0;
+            deviceDetails->requestCacheStats.coalescedCount = 0;
+            deviceDetails->requestCacheStats.missCount = 0;
+            for (auto& isScheduled : deviceDetails->isLivenessEventScheduled)
+            {
+                isScheduled = false;
+            }
 
             // Device is not opened at this time.
             deviceDetails->lastCloseDeviceTime = OICGetCurrentTime(TIME_IN_MS);
+            ScheduleLivenessEvent(deviceDetails, LivenessEvent_CloseExpiry,
+                deviceDetails->lastCloseDeviceTime + m_allowedTimeSinceLastCloseMs + 1);
 
             // Device ID is known at this time.
             deviceDetails->deviceInfo.deviceId = resource->sid();
@@ -622,6 +775,9 @@ void OCFFramework::OnResourceFound(std::shared_ptr<OCResource> resource)
         // Device is discovered.
         deviceDetails->deviceNotRespondingIndicated = false;
         deviceDetails->lastResponseTimeToDiscovery = OICGetCurrentTime(TIME_IN_MS);
+        ScheduleLivenessEvent(deviceDetails, LivenessEvent_DiscoveryExpiry,
+            deviceDetails->lastResponseTimeToDiscovery +
+                m_allowedTimeSinceLastDiscoveryResponseMs + 1);
 
         if (deviceDetails->resourceMap.find(resourcePath) == deviceDetails->resourceMap.end())
         {
@@ -968,6 +1124,21 @@ IPCAStatus OCFFramework::GetCommonResources(DeviceDetails::Ptr deviceDetails)
         deviceDetails->maintenanceResourceRequestCount++;
     }
 
+    // Ask again later for what is still missing, until the request limit is reached.
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+        if (((deviceDetails->platformInfoAvailable == false) &&
+             (deviceDetails->platformInfoRequestCount < MAX_REQUEST_COUNT)) ||
+            ((deviceDetails->deviceInfoAvailable == false) &&
+             (deviceDetails->deviceInfoRequestCount < MAX_REQUEST_COUNT)) ||
+            ((deviceDetails->maintenanceResourceAvailable == false) &&
+             (deviceDetails->maintenanceResourceRequestCount < MAX_REQUEST_COUNT)))
+        {
+            ScheduleLivenessEvent(deviceDetails, LivenessEvent_CommonResourcesRetry,
+                OICGetCurrentTime(TIME_IN_MS) + c_commonResourcesRetryIntervalMs);
+        }
+    }
+
     return IPCA_OK;
 }
 
@@ -1025,6 +1196,12 @@ void OCFFramework::OnPostPut(const HeaderOptions& headerOptions,
 
     IPCAStatus status = MapOCStackResultToIPCAStatus((OCStackResult)eCode);
 
+    // GET requests sent while the change was in flight may have read the old properties.
+    if (callbackInfo->device != nullptr)
+    {
+        InvalidateCachedRepresentations(callbackInfo->device->GetDeviceId());
+    }
+
     // Take a snapshot of callbacks for thread safe iteration.
     std::vector<Callback::Ptr> callbackSnapshot;
     ThreadSafeCopy(m_callbacks, callbackSnapshot);
@@ -1039,7 +1216,7 @@ void OCFFramework::OnPostPut(const HeaderOptions& headerOptions,
 void OCFFramework::OnGet(const HeaderOptions& headerOptions,
                         const OCRepresentation& rep,
                         const int eCode,
-                        CallbackInfo::Ptr callbackInfo)
+                        CoalescedGetRequest::Ptr getRequest)
 {
     OC_UNUSED(headerOptions);
 
@@ -1050,13 +1227,43 @@ void OCFFramework::OnGet(const HeaderOptions& headerOptions,
         status = IPCA_FAIL;
     }
 
+    // Complete every app request that joined this GET.
+    std::vector<CallbackInfo::Ptr> callbackInfos;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+        callbackInfos.swap(getRequest->callbackInfos);
+
+        // Cache the representation unless the request was invalidated meanwhile.
+        DeviceDetails::Ptr deviceDetails;
+        if (FindDeviceDetails(getRequest->deviceId, deviceDetails) == IPCA_OK)
+        {
+            auto pendingRequest = deviceDetails->pendingGetRequests.find(getRequest->requestKey);
+            if ((pendingRequest != deviceDetails->pendingGetRequests.end()) &&
+                (pendingRequest->second == getRequest))
+            {
+                deviceDetails->pendingGetRequests.erase(pendingRequest);
+
+                if (status == IPCA_OK)
+                {
+                    CachedRepresentation& cachedRepresentation =
+                        deviceDetails->cachedRepresentations[getRequest->requestKey];
+                    cachedRepresentation.receivedTime = OICGetCurrentTime(TIME_IN_MS);
+                    cachedRepresentation.rep = rep;
+                }
+            }
+        }
+    }
+
     // Take a snapshot of callbacks for thread safe iteration.
     std::vector<Callback::Ptr> callbackSnapshot;
     ThreadSafeCopy(m_callbacks, callbackSnapshot);
 
-    for (const auto& callback : callbackSnapshot)
+    for (const auto& callbackInfo : callbackInfos)
     {
-        callback->GetCallback(status, rep, callbackInfo);
+        for (const auto& callback : callbackSnapshot)
+        {
+            callback->GetCallback(status, rep, callbackInfo);
+        }
     }
 }
 
@@ -1065,7 +1272,7 @@ void OCFFramework::OnObserve(
                         const OCRepresentation &rep,
                         const int &eCode,
                         const int &sequenceNumber,
-                        CallbackInfo::Ptr callbackInfo)
+                        SharedObserveRequest::Ptr observeRequest)
 {
     OC_UNUSED(headerOptions);
     OC_UNUSED(sequenceNumber);
@@ -1076,13 +1283,54 @@ void OCFFramework::OnObserve(
         status = IPCA_FAIL;
     }
 
+    // Notify every app observing the resource.
+    std::vector<CallbackInfo::Ptr> callbackInfos;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+        callbackInfos = observeRequest->callbackInfos;
+
+        if (status == IPCA_OK)
+        {
+            observeRequest->isRepresentationAvailable = true;
+            observeRequest->lastRepresentation = rep;
+
+            // The notification also serves GET requests for the resource.
+            DeviceDetails::Ptr deviceDetails;
+            if (FindDeviceDetails(observeRequest->deviceId, deviceDetails) == IPCA_OK)
+            {
+                CachedRepresentation& cachedRepresentation =
+                    deviceDetails->cachedRepresentations[observeRequest->requestKey];
+                cachedRepresentation.receivedTime = OICGetCurrentTime(TIME_IN_MS);
+                cachedRepresentation.rep = rep;
+            }
+        }
+        else
+        {
+            // The observe is dead, later apps start a new one instead of joining it.
+            DeviceDetails::Ptr deviceDetails;
+            if (FindDeviceDetails(observeRequest->deviceId, deviceDetails) == IPCA_OK)
+            {
+                auto sharedRequest =
+                    deviceDetails->sharedObserveRequests.find(observeRequest->requestKey);
+                if ((sharedRequest != deviceDetails->sharedObserveRequests.end()) &&
+                    (sharedRequest->second == observeRequest))
+                {
+                    deviceDetails->sharedObserveRequests.erase(sharedRequest);
+                }
+            }
+        }
+    }
+
     // Take a snapshot of callbacks for thread safe iteration.
     std::vector<Callback::Ptr> callbackSnapshot;
     ThreadSafeCopy(m_callbacks, callbackSnapshot);
 
-    for (const auto& callback : callbackSnapshot)
+    for (const auto& callbackInfo : callbackInfos)
     {
-        callback->ObserveCallback(status, rep, callbackInfo);
+        for (const auto& callback : callbackSnapshot)
+        {
+            callback->ObserveCallback(status, rep, callbackInfo);
+        }
     }
 }
 
@@ -1094,6 +1342,11 @@ void OCFFramework::OnDelete(const HeaderOptions& headerOptions,
 
     IPCAStatus status = MapOCStackResultToIPCAStatus((OCStackResult)eCode);
 
+    if (callbackInfo->device != nullptr)
+    {
+        InvalidateCachedRepresentations(callbackInfo->device->GetDeviceId());
+    }
+
     // Take a snapshot of callbacks for thread safe iteration.
     std::vector<Callback::Ptr> callbackSnapshot;
     ThreadSafeCopy(m_callbacks, callbackSnapshot);
@@ -1140,14 +1393,13 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
     {
         case CallbackType_GetPropertiesComplete:
         {
-            result = ocResource->get(
-                        queryParamsMap,
-                        std::bind(&OCFFramework::OnGet, this, _1, _2, _3, callbackInfo));
+            result = SendGetRequest(deviceDetails, ocResource, queryParamsMap, callbackInfo);
             break;
         }
 
         case CallbackType_SetPropertiesComplete:
         {
+            InvalidateCachedRepresentations(deviceId);
             result = ocResource->post(
                             *rep,
                             queryParamsMap,
@@ -1157,6 +1409,7 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
 
         case CallbackType_CreateResourceComplete:
         {
+            InvalidateCachedRepresentations(deviceId);
             result = ocResource->post(
                             *rep,
                             queryParamsMap,
@@ -1166,6 +1419,7 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
 
         case CallbackType_DeleteResourceComplete:
         {
+            InvalidateCachedRepresentations(deviceId);
             result = ocResource->deleteResource(
                             std::bind(&OCFFramework::OnDelete, this, _1, _2, callbackInfo));
             break;
@@ -1173,12 +1427,7 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
 
         case CallbackType_ResourceChange:
         {
-            callbackInfo->ocResource = ocResource;
-            result = ocResource->observe(
-                                    ObserveType::Observe,
-                                    queryParamsMap,
-                                    std::bind(&OCFFramework::OnObserve, this,
-                                            _1, _2, _3, _4, callbackInfo));
+            result = SendObserveRequest(deviceDetails, ocResource, queryParamsMap, callbackInfo);
             break;
         }
 
@@ -1200,10 +1449,279 @@ IPCAStatus OCFFramework::SendCommandToDevice(std::string& deviceId,
     }
 }
 
+std::string OCFFramework::GetRequestKey(const std::shared_ptr<OCResource>& ocResource,
+                                        const CallbackInfo::Ptr& callbackInfo)
+{
+    std::ostringstream requestKey;
+    requestKey << ocResource->uri();
+    requestKey << "?rt=" << callbackInfo->resourceType;
+    requestKey << "&if=" << callbackInfo->resourceInterface;
+    return requestKey.str();
+}
+
+OCStackResult OCFFramework::SendGetRequest(const DeviceDetails::Ptr& deviceDetails,
+                        const std::shared_ptr<OCResource>& ocResource,
+                        const QueryParamsMap& queryParamsMap,
+                        CallbackInfo::Ptr callbackInfo)
+{
+    std::string requestKey = GetRequestKey(ocResource, callbackInfo);
+    uint64_t currentTime = OICGetCurrentTime(TIME_IN_MS);
+    CoalescedGetRequest::Ptr getRequest;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+        auto cachedRepresentation = deviceDetails->cachedRepresentations.find(requestKey);
+        if ((cachedRepresentation != deviceDetails->cachedRepresentations.end()) &&
+            (currentTime - cachedRepresentation->second.receivedTime <=
+                c_cachedRepresentationTtlMs))
+        {
+            deviceDetails->requestCacheStats.cacheHitCount++;
+            QueueDeferredResponse(IPCA_OK, cachedRepresentation->second.rep, callbackInfo);
+            return OC_STACK_OK;
+        }
+
+        auto pendingRequest = deviceDetails->pendingGetRequests.find(requestKey);
+        if ((pendingRequest != deviceDetails->pendingGetRequests.end()) &&
+            (currentTime - pendingRequest->second->sentTime <= c_getRequestLifetimeMs))
+        {
+            deviceDetails->requestCacheStats.coalescedCount++;
+            pendingRequest->second->callbackInfos.push_back(callbackInfo);
+            return OC_STACK_OK;
+        }
+
+        deviceDetails->requestCacheStats.missCount++;
+
+        getRequest = std::make_shared<CoalescedGetRequest>();
+        getRequest->deviceId = deviceDetails->deviceId;
+        getRequest->requestKey = requestKey;
+        getRequest->sentTime = currentTime;
+        getRequest->callbackInfos.push_back(callbackInfo);
+        deviceDetails->pendingGetRequests[requestKey] = getRequest;
+    }
+
+    OCStackResult result = ocResource->get(
+                                queryParamsMap,
+                                std::bind(&OCFFramework::OnGet, this, _1, _2, _3, getRequest));
+
+    if (result != OC_STACK_OK)
+    {
+        // The caller fails its own request, the requests that joined meanwhile fail here.
+        std::vector<CallbackInfo::Ptr> joinedCallbackInfos;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+            auto pendingRequest = deviceDetails->pendingGetRequests.find(requestKey);
+            if ((pendingRequest != deviceDetails->pendingGetRequests.end()) &&
+                (pendingRequest->second == getRequest))
+            {
+                deviceDetails->pendingGetRequests.erase(pendingRequest);
+            }
+
+            joinedCallbackInfos.swap(getRequest->callbackInfos);
+        }
+
+        for (const auto& joinedCallbackInfo : joinedCallbackInfos)
+        {
+            if (joinedCallbackInfo != callbackInfo)
+            {
+                QueueDeferredResponse(IPCA_FAIL, OCRepresentation(), joinedCallbackInfo);
+            }
+        }
+    }
+
+    return result;
+}
+
+OCStackResult OCFFramework::SendObserveRequest(const DeviceDetails::Ptr& deviceDetails,
+                        const std::shared_ptr<OCResource>& ocResource,
+                        const QueryParamsMap& queryParamsMap,
+                        CallbackInfo::Ptr callbackInfo)
+{
+    std::string requestKey = GetRequestKey(ocResource, callbackInfo);
+    SharedObserveRequest::Ptr observeRequest;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+        auto sharedRequest = deviceDetails->sharedObserveRequests.find(requestKey);
+        if (sharedRequest != deviceDetails->sharedObserveRequests.end())
+        {
+            deviceDetails->requestCacheStats.coalescedCount++;
+            sharedRequest->second->callbackInfos.push_back(callbackInfo);
+            callbackInfo->ocResource = sharedRequest->second->ocResource;
+
+            // The first notification of the observe is already given to the other apps.
+            if (sharedRequest->second->isRepresentationAvailable)
+            {
+                QueueDeferredResponse(IPCA_OK,
+                    sharedRequest->second->lastRepresentation,
+                    callbackInfo);
+            }
+            return OC_STACK_OK;
+        }
+
+        deviceDetails->requestCacheStats.missCount++;
+
+        observeRequest = std::make_shared<SharedObserveRequest>();
+        observeRequest->deviceId = deviceDetails->deviceId;
+        observeRequest->requestKey = requestKey;
+        observeRequest->ocResource = ocResource;
+        observeRequest->callbackInfos.push_back(callbackInfo);
+        observeRequest->isRepresentationAvailable = false;
+        deviceDetails->sharedObserveRequests[requestKey] = observeRequest;
+        callbackInfo->ocResource = ocResource;
+    }
+
+    OCStackResult result = ocResource->observe(
+                                    ObserveType::Observe,
+                                    queryParamsMap,
+                                    std::bind(&OCFFramework::OnObserve, this,
+                                            _1, _2, _3, _4, observeRequest));
+
+    if (result != OC_STACK_OK)
+    {
+        std::vector<CallbackInfo::Ptr> joinedCallbackInfos;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+            auto sharedRequest = deviceDetails->sharedObserveRequests.find(requestKey);
+            if ((sharedRequest != deviceDetails->sharedObserveRequests.end()) &&
+                (sharedRequest->second == observeRequest))
+            {
+                deviceDetails->sharedObserveRequests.erase(sharedRequest);
+            }
+
+            joinedCallbackInfos.swap(observeRequest->callbackInfos);
+        }
+
+        for (const auto& joinedCallbackInfo : joinedCallbackInfos)
+        {
+            if (joinedCallbackInfo != callbackInfo)
+            {
+                QueueDeferredResponse(IPCA_FAIL, OCRepresentation(), joinedCallbackInfo);
+            }
+        }
+    }
+
+    return result;
+}
+
 void OCFFramework::StopObserve(CallbackInfo::Ptr cbInfo)
 {
-    std::shared_ptr<OCResource> ocResource = cbInfo->ocResource;
-    ocResource->cancelObserve();
+    std::shared_ptr<OCResource> ocResourceToCancel;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+        DeviceDetails::Ptr deviceDetails;
+        if ((cbInfo->device == nullptr) ||
+            (FindDeviceDetails(cbInfo->device->GetDeviceId(), deviceDetails) != IPCA_OK))
+        {
+            // The device is gone with its shared requests.
+            ocResourceToCancel = cbInfo->ocResource;
+        }
+        else
+        {
+            // Cancel the observe when its last app stops observing.
+            auto sharedRequest = deviceDetails->sharedObserveRequests.find(
+                                        GetRequestKey(cbInfo->ocResource, cbInfo));
+            if (sharedRequest != deviceDetails->sharedObserveRequests.end())
+            {
+                std::vector<CallbackInfo::Ptr>& callbackInfos =
+                    sharedRequest->second->callbackInfos;
+
+                callbackInfos.erase(
+                    std::remove(callbackInfos.begin(), callbackInfos.end(), cbInfo),
+                    callbackInfos.end());
+
+                if (callbackInfos.empty())
+                {
+                    ocResourceToCancel = sharedRequest->second->ocResource;
+                    deviceDetails->sharedObserveRequests.erase(sharedRequest);
+                }
+            }
+        }
+    }
+
+    if (ocResourceToCancel != nullptr)
+    {
+        ocResourceToCancel->cancelObserve();
+    }
+}
+
+void OCFFramework::InvalidateCachedRepresentations(const std::string& deviceId)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+    DeviceDetails::Ptr deviceDetails;
+    if (FindDeviceDetails(deviceId, deviceDetails) != IPCA_OK)
+    {
+        return;
+    }
+
+    // GET requests in flight still complete their apps, but later requests are sent again.
+    deviceDetails->cachedRepresentations.clear();
+    deviceDetails->pendingGetRequests.clear();
+
+    // Apps joining an observe wait for its next notification.
+    for (auto& sharedRequest : deviceDetails->sharedObserveRequests)
+    {
+        sharedRequest.second->isRepresentationAvailable = false;
+        sharedRequest.second->lastRepresentation = OCRepresentation();
+    }
+}
+
+IPCAStatus OCFFramework::GetRequestCacheStats(const std::string& deviceId,
+                                              RequestCacheStats& stats)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_OCFFrameworkMutex);
+
+    DeviceDetails::Ptr deviceDetails;
+    IPCAStatus status = FindDeviceDetails(deviceId, deviceDetails);
+    if (status != IPCA_OK)
+    {
+        return status;
+    }
+
+    stats = deviceDetails->requestCacheStats;
+    return IPCA_OK;
+}
+
+void OCFFramework::QueueDeferredResponse(IPCAStatus status,
+                        const OCRepresentation& rep,
+                        CallbackInfo::Ptr callbackInfo)
+{
+    DeferredResponse response = { status, rep, callbackInfo };
+
+    {
+        std::lock_guard<std::mutex> lock(m_workerThreadMutex);
+        m_deferredResponses.push_back(response);
+    }
+
+    m_workerThreadCV.notify_all();
+}
+
+void OCFFramework::DeliverDeferredResponses(const std::vector<DeferredResponse>& responses)
+{
+    // Take a snapshot of callbacks for thread safe iteration.
+    std::vector<Callback::Ptr> callbackSnapshot;
+    ThreadSafeCopy(m_callbacks, callbackSnapshot);
+
+    for (const auto& response : responses)
+    {
+        for (const auto& callback : callbackSnapshot)
+        {
+            if (response.callbackInfo->type == CallbackType_ResourceChange)
+            {
+                callback->ObserveCallback(response.status, response.rep, response.callbackInfo);
+            }
+            else
+            {
+                callback->GetCallback(response.status, response.rep, response.callbackInfo);
+            }
+        }
+    }
 }
 
 void OCFFramework::IsResourceObservable(std::string& deviceId,
@@ -1609,6 +2127,10 @@ void OCFFramework::DebugOutputOCFDevices()
         std::cout << "Device URI    : " << device.first << std::endl;
         std::cout << "Device id     : " << device.second->deviceInfo.deviceId << std::endl;
         std::cout << "Device name   : " << device.second->deviceInfo.deviceName << std::endl;
+        std::cout << "Request cache : " << device.second->requestCacheStats.cacheHitCount
+                  << " hit, " << device.second->requestCacheStats.coalescedCount
+                  << " coalesced, " << device.second->requestCacheStats.missCount
+                  << " miss" << std::endl;
         std::cout << "Resource Types: " << std::endl;
         for (auto const& res : device.second->discoveredResourceTypes)
         {
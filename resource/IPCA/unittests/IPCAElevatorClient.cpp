@@ -303,6 +303,69 @@ void IPCAElevatorClient::StopObserve()
     }
 }
 
+void IPCA_CALL C_CountedGetPropertiesCb(
+                        IPCAStatus result,
+                        void* context,
+                        IPCAPropertyBagHandle propertyBagHandle)
+{
+    IPCAElevatorClient* ipcaTest = (IPCAElevatorClient*)context;
+    ipcaTest->CountedGetPropertiesCallback(result, propertyBagHandle);
+}
+
+// Send count GET requests for the elevator resource without waiting for their responses.
+bool IPCAElevatorClient::SendGetRequests(size_t count)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_getResponseCountMutex);
+        m_getResponseCount = 0;
+        m_targetFloorOfLastResponse = 0;
+    }
+
+    for (size_t i = 0 ; i < count ; i++)
+    {
+        IPCAStatus status = IPCAGetProperties(
+                                m_deviceHandle,
+                                &C_CountedGetPropertiesCb,
+                                (void*)this,
+                                ELEVATOR_RESOURCE_PATH,
+                                nullptr,
+                                nullptr,
+                                nullptr);
+
+        if (status != IPCA_OK)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Wait for count responses to the requests of SendGetRequests(). Return the number received.
+size_t IPCAElevatorClient::WaitForGetResponses(size_t count)
+{
+    std::unique_lock<std::mutex> lock(m_getResponseCountMutex);
+    m_getResponseCountCV.wait_for(
+            lock,
+            std::chrono::seconds(10),
+            [this, count] { return m_getResponseCount >= count; });
+
+    return m_getResponseCount;
+}
+
+bool IPCAElevatorClient::StartAnotherObserve(IPCAHandle* observeHandle)
+{
+    IPCAStatus status = IPCAObserveResource(
+                                m_deviceHandle,
+                                &C_ResourceChangeNotificationCb,
+                                (void*)this,
+                                ELEVATOR_RESOURCE_PATH,
+                                nullptr,
+                                observeHandle);
+
+    return (status == IPCA_OK ? true : false);
+}
+
 IPCAStatus IPCAElevatorClient::GetUnknownResource()
 {
     // Get the data.
@@ -374,6 +437,7 @@ bool IPCAElevatorClient::SetUnknoownInterface()
 void IPCAElevatorClient::SetUp()
 {
     m_elevator1Discovered = false;
+    m_elevator1StoppedResponding = false;
     m_discoveredElevator1DeviceId.clear();
     m_discoveredElevator1DeviceName.clear();
 
@@ -382,6 +446,8 @@ void IPCAElevatorClient::SetUp()
     m_deviceHandle = nullptr;
     m_observeHandle = nullptr;
     m_newResourcePath = "";
+    m_getResponseCount = 0;
+    m_targetFloorOfLastResponse = 0;
 
     IPCAAppInfo ipcaAppInfo = { IPCATestAppUuid, IPCATestAppName, "1.0.0", "Microsoft" };
 
@@ -595,10 +661,20 @@ void IPCAElevatorClient::DiscoverElevator1Callback(
                             IPCADeviceStatus deviceStatus,
                             const IPCADiscoveredDeviceInfo* discoveredDeviceInfo)
 {
-    OC_UNUSED(deviceStatus);
     OC_UNUSED(context);
 
-    if (g_elevator1Name.compare(discoveredDeviceInfo->deviceName) == 0)
+    if (g_elevator1Name.compare(discoveredDeviceInfo->deviceName) != 0)
+    {
+        return;
+    }
+
+    if (deviceStatus == IPCA_DEVICE_STOPPED_RESPONDING)
+    {
+        std::lock_guard<std::mutex> lock(m_deviceDiscoveredCVMutex);
+        m_elevator1StoppedResponding = true;
+        m_deviceDiscoveredCV.notify_all();
+    }
+    else
     {
         m_discoveredElevator1DeviceUris.clear();
         for (size_t i = 0; i < discoveredDeviceInfo->deviceUriCount; i++)
@@ -613,6 +689,40 @@ void IPCAElevatorClient::DiscoverElevator1Callback(
     }
 }
 
+bool IPCAElevatorClient::WaitForElevator1ToStopResponding()
+{
+    std::unique_lock<std::mutex> lock(m_deviceDiscoveredCVMutex);
+    m_deviceDiscoveredCV.wait_for(
+            lock,
+            std::chrono::seconds(10),
+            [this] { return m_elevator1StoppedResponding; });
+
+    return m_elevator1StoppedResponding;
+}
+
+void IPCAElevatorClient::StopDiscovery()
+{
+    if (m_deviceDiscoveryHandle != nullptr)
+    {
+        IPCACloseHandle(m_deviceDiscoveryHandle, nullptr, 0);
+        m_deviceDiscoveryHandle = nullptr;
+    }
+}
+
+void IPCAElevatorClient::CloseElevator1()
+{
+    if (m_deviceHandle != nullptr)
+    {
+        IPCACloseDevice(m_deviceHandle);
+        m_deviceHandle = nullptr;
+    }
+}
+
+IPCAStatus IPCAElevatorClient::ReopenElevator1()
+{
+    return IPCAOpenDevice(m_ipcaAppHandle, m_discoveredElevator1DeviceId.c_str(), &m_deviceHandle);
+}
+
 void IPCA_CALL C_DiscoverElevator1Cb(
                             void* context,
                             IPCADeviceStatus deviceStatus,
@@ -694,6 +804,23 @@ void IPCAElevatorClient::GetPropertiesCallback(
     m_getDataCompleteCbCV.notify_all();
 }
 
+void IPCAElevatorClient::CountedGetPropertiesCallback(
+                                IPCAStatus result,
+                                IPCAPropertyBagHandle propertyBagHandle)
+{
+    EXPECT_EQ(IPCA_OK, result);
+
+    std::lock_guard<std::mutex> lock(m_getResponseCountMutex);
+    if (propertyBagHandle != nullptr)
+    {
+        EXPECT_EQ(IPCA_OK, IPCAPropertyBagGetValueInt(propertyBagHandle,
+                                ELEVATOR_PROPERTY_TARGET_FLOOR, &m_targetFloorOfLastResponse));
+    }
+
+    m_getResponseCount++;
+    m_getResponseCountCV.notify_all();
+}
+
 void IPCAElevatorClient::CreateResourceCallback(
                                 IPCAStatus result,
                                 const char* newResourcePath,
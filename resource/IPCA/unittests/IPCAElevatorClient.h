@@ -55,6 +55,18 @@ public:
     bool StartObserve();
     void StopObserve();
 
+    // Requests that IPCA shares between app requests for the same resource.
+    bool SendGetRequests(size_t count);
+    size_t WaitForGetResponses(size_t count);
+    int GetTargetFloorOfLastResponse() { return m_targetFloorOfLastResponse; }
+    bool StartAnotherObserve(IPCAHandle* observeHandle);
+
+    // Liveness of the discovered elevator.
+    bool WaitForElevator1ToStopResponding();
+    void StopDiscovery();
+    void CloseElevator1();
+    IPCAStatus ReopenElevator1();
+
     // Helper functions
     IPCAStatus FactoryResetElevator();
     IPCAStatus RebootElevator();
@@ -82,6 +94,10 @@ public:
 
     void DeleteResourceCallback(IPCAStatus result);
 
+    void CountedGetPropertiesCallback(
+            IPCAStatus result,
+            IPCAPropertyBagHandle propertyBagHandle);
+
     void ResourceChangeNotificationCallback(
         IPCAStatus result,
         IPCAPropertyBagHandle propertyBagHandle);
@@ -115,6 +131,7 @@ private:
 
     // Used by IPCADiscoverDevices() tests.
     bool m_elevator1Discovered;
+    bool m_elevator1StoppedResponding;
     std::string m_discoveredElevator1DeviceName;
     std::string m_discoveredElevator1DeviceId;
     std::vector<std::string> m_discoveredElevator1DeviceUris;
@@ -144,6 +161,12 @@ private:
     std::mutex m_deleteResourceCompleteCbMutex;
     std::condition_variable m_deleteResourceCompleteCV;
 
+    // Used by SendGetRequests().
+    size_t m_getResponseCount;
+    int m_targetFloorOfLastResponse;
+    std::mutex m_getResponseCountMutex;
+    std::condition_variable m_getResponseCountCV;
+
     bool GetElevatorProperties();
     bool SetElevatorProperties(IPCAPropertyBagHandle propertyBagHandle);
     bool CreateElevatorResource(
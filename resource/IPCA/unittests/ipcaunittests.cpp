@@ -23,6 +23,8 @@
 #include <chrono>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <future>
 
 #include <gtest/gtest.h>
 #include "experimental/ocrandom.h"
@@ -37,6 +39,8 @@ using namespace std::placeholders;
 
 // Implemented in ipca.dll.
 void IPCA_CALL IPCASetUnitTestMode();
+void IPCA_CALL IPCASetUnitTestLivenessTimeouts(uint64_t allowedTimeSinceLastCloseMs,
+                                               uint64_t allowedTimeSinceLastDiscoveryResponseMs);
 
 // IPCA test app info.
 IPCAUuid IPCATestAppUuid = {
@@ -492,6 +496,26 @@ TEST_F(IPCAMiscTest, ShouldFailOpenDeviceWithoutDiscoveryFirst)
                                                 &deviceHandle));
 }
 
+TEST_F(IPCAMiscTest, IPCACloseReturnsWhenNoDeviceIsKnown)
+{
+    // Nothing is discovered, so the IPCA worker thread waits without a deadline.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    IPCAAppHandle ipcaAppHandle = m_ipcaAppHandle;
+    m_ipcaAppHandle = NULL;
+
+    // IPCAClose() is called on another thread so a lost wakeup fails the test instead of
+    // hanging it.
+    auto closeComplete = std::make_shared<std::promise<void>>();
+    std::future<void> isClosed = closeComplete->get_future();
+    std::thread([ipcaAppHandle, closeComplete] {
+        IPCAClose(ipcaAppHandle);
+        closeComplete->set_value();
+    }).detach();
+
+    EXPECT_EQ(std::future_status::ready, isClosed.wait_for(std::chrono::seconds(10)));
+}
+
 TEST_F(IPCAElevatorClient, DiscoveryShouldFindElevatorServer)
 {
     EXPECT_TRUE(IsElevator1Discovered());
@@ -627,6 +651,125 @@ TEST_F(IPCAElevatorClient, SuccessfulReboot)
     EXPECT_EQ(IPCA_OK, RebootElevator());
 }
 
+// Wait for the count kept by the elevator server to reach target. Return the last count.
+size_t WaitForElevatorCount(std::function<size_t()> getCount, size_t target)
+{
+    int loopCount = 0;
+    while ((loopCount++ < 50) && (getCount() != target))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    return getCount();
+}
+
+TEST_F(IPCAElevatorClient, IdenticalGetRequestsAreSentOnce)
+{
+    // Setting the target floor also drops the representations cached by earlier tests.
+    bool result;
+    SetTargetFloor(4, &result);
+    ASSERT_TRUE(result);
+
+    // The server holds the response, so the second request arrives while the first is in flight.
+    size_t getRequestCount = g_testElevator1.GetGetRequestCount();
+    g_testElevator1.HoldGetResponses();
+    bool isSent = SendGetRequests(2);
+    EXPECT_EQ(getRequestCount + 1, WaitForElevatorCount(
+                    [] { return g_testElevator1.GetGetRequestCount(); }, getRequestCount + 1));
+    g_testElevator1.ReleaseGetResponses();
+    ASSERT_TRUE(isSent);
+
+    // Both requests are completed by the one response.
+    EXPECT_EQ(static_cast<size_t>(2), WaitForGetResponses(2));
+    EXPECT_EQ(4, GetTargetFloorOfLastResponse());
+    EXPECT_EQ(getRequestCount + 1, g_testElevator1.GetGetRequestCount());
+}
+
+TEST_F(IPCAElevatorClient, GetWithinCacheLifetimeIsNotSent)
+{
+    bool result;
+    SetTargetFloor(5, &result);
+    ASSERT_TRUE(result);
+
+    int targetFloor;
+    size_t getRequestCount = g_testElevator1.GetGetRequestCount();
+    GetTargetFloor(&targetFloor, &result);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(5, targetFloor);
+    EXPECT_EQ(getRequestCount + 1, g_testElevator1.GetGetRequestCount());
+
+    // Changed behind IPCA's back, so only a request sent to the elevator sees floor 6.
+    g_testElevator1.SetTargetFloor(6);
+    GetTargetFloor(&targetFloor, &result);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(5, targetFloor);
+    EXPECT_EQ(getRequestCount + 1, g_testElevator1.GetGetRequestCount());
+
+    // The cached representation lives for 1 second.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    GetTargetFloor(&targetFloor, &result);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(6, targetFloor);
+    EXPECT_EQ(getRequestCount + 2, g_testElevator1.GetGetRequestCount());
+}
+
+TEST_F(IPCAElevatorClient, SetPropertiesInvalidatesCachedRepresentation)
+{
+    bool result;
+    SetTargetFloor(2, &result);
+    ASSERT_TRUE(result);
+
+    int targetFloor;
+    size_t getRequestCount = g_testElevator1.GetGetRequestCount();
+    GetTargetFloor(&targetFloor, &result);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(2, targetFloor);
+
+    // Within the cache lifetime, but the set changed the elevator.
+    SetTargetFloor(7, &result);
+    ASSERT_TRUE(result);
+    GetTargetFloor(&targetFloor, &result);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(7, targetFloor);
+    EXPECT_EQ(getRequestCount + 2, g_testElevator1.GetGetRequestCount());
+}
+
+TEST_F(IPCAElevatorClient, LastObserverCancelsSharedObserve)
+{
+    g_testElevator1.SetTargetFloor(1);
+    auto observerCount = [] { return g_testElevator1.GetObserverCount(); };
+    size_t initialObserverCount = observerCount();
+    size_t observeRegisterCount = g_testElevator1.GetObserveRegisterCount();
+
+    // Two observers share one observe of the elevator.
+    ASSERT_TRUE(StartObserve());
+    IPCAHandle anotherObserveHandle;
+    ASSERT_TRUE(StartAnotherObserve(&anotherObserveHandle));
+    EXPECT_EQ(initialObserverCount + 1, WaitForElevatorCount(observerCount,
+                                                             initialObserverCount + 1));
+    EXPECT_EQ(observeRegisterCount + 1, g_testElevator1.GetObserveRegisterCount());
+
+    // The observe stays while an observer is left, and it still receives notifications.
+    IPCACloseHandle(anotherObserveHandle, nullptr, 0);
+    bool result;
+    SetTargetFloor(3, &result);
+    ASSERT_TRUE(result);
+
+    std::unique_lock<std::mutex> lock(m_resourceChangeCbMutex);
+    m_resourceChangeCbCV.wait_for(
+            lock,
+            std::chrono::seconds(10),
+            [this] { return GetObservedCurrentFloor() == 3; });
+    lock.unlock();
+
+    EXPECT_EQ(3, GetObservedCurrentFloor());
+    EXPECT_EQ(initialObserverCount + 1, observerCount());
+
+    // The last observer cancels the observe.
+    StopObserve();
+    EXPECT_EQ(initialObserverCount, WaitForElevatorCount(observerCount, initialObserverCount));
+}
+
 TEST_F(IPCAElevatorClient, TestCloseHandleTimingForGet)
 {
     EXPECT_EQ(IPCA_OK, TestCloseHandleForGet());
@@ -662,6 +805,44 @@ TEST_F(IPCAElevatorClient, TestMultipleCallsToCloseHandle)
     EXPECT_EQ(IPCA_OK, TestMultipleCallsToCloseSameHandle());
 }
 
+/*
+ * Device liveness checks of the IPCA worker thread, with timeouts short enough for a unit test.
+ */
+class IPCALivenessTest : public IPCAElevatorClient
+{
+    protected:
+        virtual void SetUp()
+        {
+            // Shorter than the 2 seconds between the first periodic discovery requests.
+            IPCASetUnitTestLivenessTimeouts(500, 500);
+            IPCAElevatorClient::SetUp();
+        }
+
+        virtual void TearDown()
+        {
+            IPCAElevatorClient::TearDown();
+            IPCASetUnitTestLivenessTimeouts(0, 0);
+        }
+};
+
+TEST_F(IPCALivenessTest, DeviceMissingDiscoveryStopsResponding)
+{
+    ASSERT_TRUE(IsElevator1Discovered());
+    EXPECT_TRUE(WaitForElevator1ToStopResponding());
+}
+
+TEST_F(IPCALivenessTest, ClosedDeviceIsForgotten)
+{
+    ASSERT_TRUE(IsElevator1Discovered());
+
+    // Without discovery the device is not found again once forgotten.
+    StopDiscovery();
+    CloseElevator1();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    EXPECT_EQ(IPCA_DEVICE_NOT_DISCOVERED, ReopenElevator1());
+}
+
 TEST(ElevatorServerStop, Stop)
 {
     StopElevator1();
@@ -62,6 +62,9 @@ ElevatorServer::ElevatorServer() :
     m_relativePathResourceCreateCount = 0;
     m_explicitPathResourceCreateCount = 0;
     m_deleteResourceCount = 0;
+    m_getRequestCount = 0;
+    m_observeRegisterCount = 0;
+    m_isHoldingGetResponses = false;
 }
 
 ElevatorServer::~ElevatorServer()
@@ -132,7 +135,18 @@ OCEntityHandlerResult ElevatorServer::ElevatorEntityHandler(
             {
                 if (resourceUri.compare(ELEVATOR_RESOURCE_PATH) == 0)
                 {
-                    if (SendResponse(request) == OC_STACK_OK)
+                    bool isHeld;
+                    {
+                        std::lock_guard<std::mutex> lock(m_requestMutex);
+                        m_getRequestCount++;
+                        isHeld = m_isHoldingGetResponses;
+                        if (isHeld)
+                        {
+                            m_heldGetRequests.push_back(request);
+                        }
+                    }
+
+                    if (isHeld || (SendResponse(request) == OC_STACK_OK))
                     {
                         ehResult = OC_EH_OK;
                     }
@@ -295,12 +309,15 @@ OCEntityHandlerResult ElevatorServer::ElevatorEntityHandler(
             {
                 OIC_LOG_V(INFO, TAG, "ElevatorEntityHandler(): new observer ID: %d",
                     observationInfo.obsId);
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                m_observeRegisterCount++;
                 m_observers.push_back(observationInfo.obsId);
             }
             else if (ObserveAction::ObserveUnregister == observationInfo.action)
             {
                 OIC_LOG_V(INFO, TAG, "ElevatorEntityHandler(): removing observer ID: %d",
                     observationInfo.obsId);
+                std::lock_guard<std::mutex> lock(m_requestMutex);
                 m_observers.erase(std::remove(
                                     m_observers.begin(),
                                     m_observers.end(),
@@ -316,6 +333,45 @@ OCEntityHandlerResult ElevatorServer::ElevatorEntityHandler(
 }
 
 
+size_t ElevatorServer::GetGetRequestCount()
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    return m_getRequestCount;
+}
+
+size_t ElevatorServer::GetObserveRegisterCount()
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    return m_observeRegisterCount;
+}
+
+size_t ElevatorServer::GetObserverCount()
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    return m_observers.size();
+}
+
+void ElevatorServer::HoldGetResponses()
+{
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    m_isHoldingGetResponses = true;
+}
+
+void ElevatorServer::ReleaseGetResponses()
+{
+    std::vector<std::shared_ptr<OCResourceRequest>> heldGetRequests;
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        m_isHoldingGetResponses = false;
+        heldGetRequests.swap(m_heldGetRequests);
+    }
+
+    for (const auto& request : heldGetRequests)
+    {
+        SendResponse(request);
+    }
+}
+
 // Copy from std::string to char array.  Return true if source is truncated at dest.
 bool CopyStringToBuffer(std::string& source, char* dest, size_t destSize)
 {
@@ -21,6 +21,8 @@
 #define _ELEVATOR_SERVER_H
 
 #include <string>
+#include <mutex>
+#include <vector>
 #include "OCPlatform.h"
 #include "OCApi.h"
 
@@ -57,6 +59,16 @@ public:
     size_t GetDeleteResourceCount() { return m_deleteResourceCount; }
     size_t GetIncorrectInterfaceCount() { return m_IncorrectInterfaceCount; }
 
+    // Number of GET requests and observe registrations received for the elevator resource, and
+    // number of observers currently registered.
+    size_t GetGetRequestCount();
+    size_t GetObserveRegisterCount();
+    size_t GetObserverCount();
+
+    // While held, GET requests for the elevator resource are not responded until released.
+    void HoldGetResponses();
+    void ReleaseGetResponses();
+
 private:
     // List of observers, when client app calls resource->Observer().
     ObservationIds m_observers;
@@ -120,6 +132,13 @@ private:
 
     // Number of times entity handler is called with incorrect resource interface.
     size_t m_IncorrectInterfaceCount;
+
+    // Requests seen by the entity handler.  Protected by m_requestMutex.
+    std::mutex m_requestMutex;
+    size_t m_getRequestCount;
+    size_t m_observeRegisterCount;
+    bool m_isHoldingGetResponses;
+    std::vector<std::shared_ptr<OCResourceRequest>> m_heldGetRequests;
 };
 
 #endif // _ELEVATOR_SERVER_H
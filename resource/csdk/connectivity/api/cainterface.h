@@ -32,6 +32,7 @@
  */
 #include "cacommon.h"
 #include "casecurityinterface.h"
+#include "ocevent.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -231,6 +232,15 @@ CATransportAdapter_t CAGetSelectedNetwork(void);
  */
 CAResult_t CAHandleRequestResponse(void);
 
+/**
+ * Register an event to be signaled whenever received data is pending for
+ * ::CAHandleRequestResponse. This lets the application block on the event
+ * instead of polling. Once this returns, the previously registered event is
+ * no longer signaled and may be freed.
+ * @param[in]   event      event to signal, or NULL to unregister.
+ */
+void CARegisterProcessEvent(oc_event event);
+
 #ifdef RA_ADAPTER
 /**
  * Set Remote Access information for XMPP Client.
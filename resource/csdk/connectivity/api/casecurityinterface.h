@@ -238,6 +238,13 @@ typedef void (*CAgetPkixInfoHandler)(PkiInfo_t * inf);
  */
 CAResult_t CAregisterPkixInfoHandler(CAgetPkixInfoHandler getPkixInfoHandler);
 
+/**
+ * Notify that the PKIX related info has changed.
+ * The info is loaded and parsed once, and kept until this is called or
+ * another callback is registered.
+ */
+void CAinvalidatePkixInfo(void);
+
 /**
  * Select the cipher suite for dtls handshake.
  *
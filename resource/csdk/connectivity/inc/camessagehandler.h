@@ -28,6 +28,7 @@
 
 #include "cacommon.h"
 #include <coap/coap.h>
+#include "ocevent.h"
 
 #define CA_MEMORY_ALLOC_CHECK(arg) { if (NULL == arg) {OIC_LOG(ERROR, TAG, "Out of memory"); \
 goto memory_error_exit;} }
@@ -92,6 +93,13 @@ void CATerminateMessageHandler(void);
  */
 void CAHandleRequestResponseCallbacks(void);
 
+/**
+ * Register an event which is signaled whenever received data is queued
+ * for CAHandleRequestResponseCallbacks.
+ * @param[in] event    event to signal, or NULL to unregister.
+ */
+void CARegisterMessageProcessEvent(oc_event event);
+
 /**
  * Setting the Callback funtion for network state change callback.
  * @param[in] nwMonitorHandler    callback for network state change.
@@ -38,6 +38,7 @@
 #include "experimental/ocrandom.h"
 #include "experimental/byte_array.h"
 #include "octhread.h"
+#include "ocatomic.h"
 #include "octimer.h"
 #include "utlist.h"
 #include "parsechain.h"
@@ -359,6 +360,16 @@ typedef struct TlsCallBacks
     CAErrorHandleCallback errorCallback;    /**< Callback used to pass error to upper layer. */
 } SslCallbacks_t;
 
+/**
+ * Slot of the hash set of the certificates revoked by the parsed CRLs.
+ */
+typedef struct SslRevokedCert
+{
+    const mbedtls_x509_crl *crl;            /**< CRL which revokes the certificate. */
+    const mbedtls_x509_crl_entry *entry;    /**< serial of the certificate, NULL if the
+                                                 slot is empty. */
+} SslRevokedCert_t;
+
 /**
  * Data structure for holding the mbedTLS interface related info.
  */
@@ -383,6 +394,17 @@ typedef struct SslContext
     bool cipherFlag[2];
     int selectedCipher;
 
+    int32_t pkixInfoVersion;       /**< version of the PKIX info parsed into ca, crt, pkey
+                                        and crl, 0 if none is parsed yet. */
+    int pkixInfoResult;            /**< result of parsing that version. */
+    bool hasOwnCert;               /**< crt and pkey were parsed successfully. */
+    bool hasCrl;                   /**< crl was parsed successfully. */
+    SslRevokedCert_t *revokedCerts; /**< hash set of the serials revoked by crl, NULL if
+                                         mbedTLS checks crl itself. */
+    size_t revokedCertsSize;       /**< number of slots of revokedCerts, a power of two. */
+    int32_t pkixConfVersion[2];    /**< version of the PKIX info set to the TLS and to the
+                                        DTLS configurations. */
+
 #ifdef __WITH_DTLS__
     mbedtls_ssl_cookie_ctx cookieCtx;
     int timerId;
@@ -412,6 +434,13 @@ static CAgetCredentialTypesHandler g_getCredentialTypesCallback = NULL;
  * @brief callback to get X.509-based Public Key Infrastructure
  */
 static CAgetPkixInfoHandler g_getPkixInfoCallback = NULL;
+/**
+ * @var g_pkixInfoVersion
+ *
+ * @brief version of the info provided by g_getPkixInfoCallback.
+ * It changes whenever that info needs to be loaded again.
+ */
+static volatile int32_t g_pkixInfoVersion = 1;
 /**
  * @var g_getIdentityCallback
  *
@@ -482,6 +511,16 @@ void CAsetPkixInfoCallback(CAgetPkixInfoHandler infoCallback)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
     g_getPkixInfoCallback = infoCallback;
+    CAinvalidatePkixInfo();
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+}
+
+void CAinvalidatePkixInfo(void)
+{
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
+    // SRM calls it from any thread, even from a handshake callback, so it only
+    // changes the version and the info is loaded again by the next InitPKIX().
+    oc_atomic_increment(&g_pkixInfoVersion);
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
 }
 
@@ -689,11 +728,189 @@ static void DeInitPkixInfo(PkiInfo_t * inf)
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
 }
 
-//Loads PKIX related information from SRM
-static int InitPKIX(CATransportAdapter_t adapter)
+/**
+ * Hashes the serial of a certificate (FNV-1a).
+ */
+static size_t HashSerial(const mbedtls_x509_buf *serial)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < serial->len; i++)
+    {
+        hash = (hash ^ serial->p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool IsSameBuf(const mbedtls_x509_buf *buf1, const mbedtls_x509_buf *buf2)
+{
+    return (buf1->len == buf2->len) && (0 == memcmp(buf1->p, buf2->p, buf1->len));
+}
+
+/**
+ * Checks that the CRL is signed by one of the trusted CAs, as mbedTLS does before it
+ * looks up a certificate in the CRL.
+ */
+static bool IsCrlSignedByCa(const mbedtls_x509_crl *crl, mbedtls_x509_crt *caList)
+{
+    unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+    const mbedtls_md_info_t *mdInfo = mbedtls_md_info_from_type(crl->sig_md);
+    if (NULL == mdInfo || 0 != mbedtls_md(mdInfo, crl->tbs.p, crl->tbs.len, hash))
+    {
+        return false;
+    }
+
+    for (mbedtls_x509_crt *ca = caList; NULL != ca && 0 != ca->raw.len; ca = ca->next)
+    {
+        if (!IsSameBuf(&ca->subject_raw, &crl->issuer_raw))
+        {
+            continue;
+        }
+#ifdef MBEDTLS_X509_CHECK_KEY_USAGE
+        if (0 != mbedtls_x509_crt_check_key_usage(ca, MBEDTLS_X509_KU_CRL_SIGN))
+        {
+            continue;
+        }
+#endif
+        if (0 == mbedtls_pk_verify_ext(crl->sig_pk, crl->sig_opts, &ca->pk, crl->sig_md,
+                                       hash, mbedtls_md_get_size(mdInfo),
+                                       crl->sig.p, crl->sig.len))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void FreeRevokedCerts(void)
+{
+    OICFree(g_caSslContext->revokedCerts);
+    g_caSslContext->revokedCerts = NULL;
+    g_caSslContext->revokedCertsSize = 0;
+}
+
+/**
+ * Builds the hash set of the serials revoked by the parsed CRLs, so that the revocation
+ * of a certificate is checked in constant time instead of by a walk of the CRL entries.
+ * The set is built only if all the CRLs are signed by trusted CAs. Otherwise mbedTLS
+ * keeps checking the CRLs, which are then verified against the peer's chain too.
+ */
+static void IndexRevokedCerts(void)
+{
+    FreeRevokedCerts();
+
+    size_t count = 0;
+    for (const mbedtls_x509_crl *crl = &g_caSslContext->crl;
+         NULL != crl && 0 != crl->version; crl = crl->next)
+    {
+        if (!IsCrlSignedByCa(crl, &g_caSslContext->ca))
+        {
+            OIC_LOG(INFO, NET_SSL_TAG, "CRL is not signed by a trusted CA, not indexed");
+            return;
+        }
+        for (const mbedtls_x509_crl_entry *entry = &crl->entry;
+             NULL != entry && 0 != entry->serial.len; entry = entry->next)
+        {
+            count++;
+        }
+    }
+
+    // keep the load factor at or below one half.
+    size_t size = 16;
+    while (size < 2 * count)
+    {
+        size *= 2;
+    }
+    SslRevokedCert_t *revokedCerts = (SslRevokedCert_t *) OICCalloc(size, sizeof(*revokedCerts));
+    if (NULL == revokedCerts)
+    {
+        OIC_LOG(WARNING, NET_SSL_TAG, "Can't allocate revoked certificates, CRL not indexed");
+        return;
+    }
+
+    for (const mbedtls_x509_crl *crl = &g_caSslContext->crl;
+         NULL != crl && 0 != crl->version; crl = crl->next)
+    {
+        for (const mbedtls_x509_crl_entry *entry = &crl->entry;
+             NULL != entry && 0 != entry->serial.len; entry = entry->next)
+        {
+            size_t i = HashSerial(&entry->serial) & (size - 1);
+            while (NULL != revokedCerts[i].entry)
+            {
+                i = (i + 1) & (size - 1);
+            }
+            revokedCerts[i].crl = crl;
+            revokedCerts[i].entry = entry;
+        }
+    }
+
+    g_caSslContext->revokedCerts = revokedCerts;
+    g_caSslContext->revokedCertsSize = size;
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "Indexed %" PRIuPTR " revoked certificates", count);
+}
+
+/**
+ * Checks the certificate against the indexed CRLs of its issuer, and sets the
+ * verification flags that mbedTLS would set for them.
+ */
+static void CheckRevocation(const mbedtls_x509_crt *crt, uint32_t *flags)
+{
+    if (NULL == g_caSslContext || NULL == g_caSslContext->revokedCerts)
+    {
+        return;
+    }
+
+    for (const mbedtls_x509_crl *crl = &g_caSslContext->crl;
+         NULL != crl && 0 != crl->version; crl = crl->next)
+    {
+        if (!IsSameBuf(&crl->issuer_raw, &crt->issuer_raw))
+        {
+            continue;
+        }
+        if (mbedtls_x509_time_is_past(&crl->next_update))
+        {
+            *flags |= MBEDTLS_X509_BADCRL_EXPIRED;
+        }
+        if (mbedtls_x509_time_is_future(&crl->this_update))
+        {
+            *flags |= MBEDTLS_X509_BADCRL_FUTURE;
+        }
+    }
+
+    size_t mask = g_caSslContext->revokedCertsSize - 1;
+    for (size_t i = HashSerial(&crt->serial) & mask;
+         NULL != g_caSslContext->revokedCerts[i].entry; i = (i + 1) & mask)
+    {
+        const SslRevokedCert_t *revokedCert = &g_caSslContext->revokedCerts[i];
+        if (IsSameBuf(&revokedCert->entry->serial, &crt->serial) &&
+            IsSameBuf(&revokedCert->crl->issuer_raw, &crt->issuer_raw) &&
+            mbedtls_x509_time_is_past(&revokedCert->entry->revocation_date))
+        {
+            OIC_LOG(WARNING, NET_SSL_TAG, "Certificate is revoked");
+            *flags |= MBEDTLS_X509_BADCERT_REVOKED;
+            return;
+        }
+    }
+}
+
+/**
+ * Loads PKIX related information from SRM and parses it into the SSL context,
+ * unless the parsed information is of the current version already.
+ *
+ * @return  0 on success or -1 if the CA chain could not be loaded
+ */
+static int LoadPKIX(void)
 {
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
-    VERIFY_NON_NULL_RET(g_getPkixInfoCallback, NET_SSL_TAG, "PKIX info callback is NULL", -1);
+
+    // read before the callback, so that a change made while loading is not missed.
+    int32_t version = g_pkixInfoVersion;
+    if (version == g_caSslContext->pkixInfoVersion)
+    {
+        OIC_LOG(DEBUG, NET_SSL_TAG, "PKIX info is already loaded");
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return g_caSslContext->pkixInfoResult;
+    }
+
     // load pk key, cert, trust chain and crl
     PkiInfo_t pkiInfo = {
         CERT_CHAIN_INITIALIZER,
@@ -702,11 +919,7 @@ static int InitPKIX(CATransportAdapter_t adapter)
         BYTE_ARRAY_INITIALIZER
     };
 
-    if (g_getPkixInfoCallback)
-    {
-        g_getPkixInfoCallback(&pkiInfo);
-    }
-    VERIFY_NON_NULL_RET(g_caSslContext, NET_SSL_TAG, "SSL Context is NULL", -1);
+    g_getPkixInfoCallback(&pkiInfo);
 
     mbedtls_x509_crt_free(&g_caSslContext->ca);
     mbedtls_x509_crt_free(&g_caSslContext->crt);
@@ -717,12 +930,14 @@ static int InitPKIX(CATransportAdapter_t adapter)
     mbedtls_x509_crt_init(&g_caSslContext->crt);
     mbedtls_pk_init(&g_caSslContext->pkey);
     mbedtls_x509_crl_init(&g_caSslContext->crl);
-    mbedtls_ssl_config * serverConf = (adapter == CA_ADAPTER_IP ||
-                                   adapter == CA_ADAPTER_GATT_BTLE ?
-                                   &g_caSslContext->serverDtlsConf : &g_caSslContext->serverTlsConf);
-    mbedtls_ssl_config * clientConf = (adapter == CA_ADAPTER_IP ||
-                                   adapter == CA_ADAPTER_GATT_BTLE ?
-                                   &g_caSslContext->clientDtlsConf : &g_caSslContext->clientTlsConf);
+
+    FreeRevokedCerts();
+
+    g_caSslContext->pkixInfoVersion = version;
+    g_caSslContext->pkixInfoResult = -1;
+    g_caSslContext->hasOwnCert = false;
+    g_caSslContext->hasCrl = false;
+
     // optional
     int ret;
     int errNum;
@@ -757,35 +972,7 @@ static int InitPKIX(CATransportAdapter_t adapter)
         OIC_LOG(WARNING, NET_SSL_TAG, "Key parsing error");
         goto required;
     }
-
-    ret = mbedtls_ssl_conf_own_cert(serverConf, &g_caSslContext->crt, &g_caSslContext->pkey);
-    if (0 != ret)
-    {
-        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate parsing error");
-        goto required;
-    }
-    ret = mbedtls_ssl_conf_own_cert(clientConf, &g_caSslContext->crt, &g_caSslContext->pkey);
-    if(0 != ret)
-    {
-        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate configuration error");
-        goto required;
-    }
-
-    /* If we get here, certificates could be used, so configure OCF EKUs. */
-    ret = mbedtls_ssl_conf_ekus(serverConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
-        (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
-    if (0 == ret)
-    {
-        ret = mbedtls_ssl_conf_ekus(clientConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
-            (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
-    }
-    if (0 != ret)
-    {
-        /* Cert-based ciphersuites will fail, but if PSK ciphersuites are in
-         * the list they might work, so don't return error.
-         */
-        OIC_LOG(WARNING, NET_SSL_TAG, "EKU configuration error");
-    }
+    g_caSslContext->hasOwnCert = true;
 
     required:
     count = ParseChain(&g_caSslContext->ca, &(pkiInfo.ca), &errNum);
@@ -823,6 +1010,89 @@ static int InitPKIX(CATransportAdapter_t adapter)
     if(0 != ret)
     {
         OIC_LOG(WARNING, NET_SSL_TAG, "CRL parsing error");
+    }
+    else
+    {
+        g_caSslContext->hasCrl = true;
+        IndexRevokedCerts();
+    }
+    g_caSslContext->pkixInfoResult = 0;
+
+    DeInitPkixInfo(&pkiInfo);
+
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+    return 0;
+}
+
+//Loads PKIX related information from SRM
+static int InitPKIX(CATransportAdapter_t adapter)
+{
+    OIC_LOG_V(DEBUG, NET_SSL_TAG, "In %s", __func__);
+    VERIFY_NON_NULL_RET(g_getPkixInfoCallback, NET_SSL_TAG, "PKIX info callback is NULL", -1);
+    VERIFY_NON_NULL_RET(g_caSslContext, NET_SSL_TAG, "SSL Context is NULL", -1);
+
+    bool isDtls = (adapter == CA_ADAPTER_IP || adapter == CA_ADAPTER_GATT_BTLE);
+    mbedtls_ssl_config * serverConf = (isDtls ?
+                                   &g_caSslContext->serverDtlsConf : &g_caSslContext->serverTlsConf);
+    mbedtls_ssl_config * clientConf = (isDtls ?
+                                   &g_caSslContext->clientDtlsConf : &g_caSslContext->clientTlsConf);
+
+    int result = LoadPKIX();
+
+    int32_t * confVersion = &g_caSslContext->pkixConfVersion[isDtls ? 1 : 0];
+    if (*confVersion == g_caSslContext->pkixInfoVersion)
+    {
+        OIC_LOG(DEBUG, NET_SSL_TAG, "PKIX info is already configured");
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return result;
+    }
+    *confVersion = g_caSslContext->pkixInfoVersion;
+
+    int ret;
+    if (!g_caSslContext->hasOwnCert)
+    {
+        goto required;
+    }
+
+    ret = mbedtls_ssl_conf_own_cert(serverConf, &g_caSslContext->crt, &g_caSslContext->pkey);
+    if (0 != ret)
+    {
+        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate parsing error");
+        goto required;
+    }
+    ret = mbedtls_ssl_conf_own_cert(clientConf, &g_caSslContext->crt, &g_caSslContext->pkey);
+    if(0 != ret)
+    {
+        OIC_LOG(WARNING, NET_SSL_TAG, "Own certificate configuration error");
+        goto required;
+    }
+
+    /* If we get here, certificates could be used, so configure OCF EKUs. */
+    ret = mbedtls_ssl_conf_ekus(serverConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
+        (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
+    if (0 == ret)
+    {
+        ret = mbedtls_ssl_conf_ekus(clientConf, (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY),
+            (const char*)EKU_IDENTITY, sizeof(EKU_IDENTITY));
+    }
+    if (0 != ret)
+    {
+        /* Cert-based ciphersuites will fail, but if PSK ciphersuites are in
+         * the list they might work, so don't return error.
+         */
+        OIC_LOG(WARNING, NET_SSL_TAG, "EKU configuration error");
+    }
+
+    required:
+    if (0 != result)
+    {
+        OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
+        return result;
+    }
+
+    // an indexed crl is checked by verifyIdentity instead of mbedTLS.
+    if (!g_caSslContext->hasCrl || NULL != g_caSslContext->revokedCerts)
+    {
         CONF_SSL(clientConf, serverConf, mbedtls_ssl_conf_ca_chain, &g_caSslContext->ca, NULL);
     }
     else
@@ -831,8 +1101,6 @@ static int InitPKIX(CATransportAdapter_t adapter)
                  &g_caSslContext->ca, &g_caSslContext->crl);
     }
 
-    DeInitPkixInfo(&pkiInfo);
-
     OIC_LOG_V(DEBUG, NET_SSL_TAG, "Out %s", __func__);
     return 0;
 }
@@ -1353,11 +1621,11 @@ const char UUID_WILDCARD[UUID_STRING_SIZE] = "2a000000-0000-0000-0000-0000000000
 
 static int verifyIdentity( void *data, mbedtls_x509_crt *crt, int depth, uint32_t *flags ) {
     OC_UNUSED(data); // no need to pass extra data
-    OC_UNUSED(flags); // we do not remove any flags
     static UuidContext_t ctx = { NULL };
+    CheckRevocation(crt, flags); // we only add flags, never remove any
     if (NULL == g_getIdentityCallback)
     {
-        return MBEDTLS_ERR_X509_FEATURE_UNAVAILABLE;
+        return 0;
     }
     g_getIdentityCallback(&ctx, crt->raw.p, crt->raw.len);
     if (0 == depth) // leaf certificate
@@ -1439,7 +1707,7 @@ static SslEndPoint_t * NewSslEndPoint(const CAEndpoint_t * endpoint, mbedtls_ssl
     tep->sep.endpoint = *endpoint;
     tep->sep.endpoint.flags = (CATransportFlags_t)(tep->sep.endpoint.flags | CA_SECURE);
 
-    mbedtls_ssl_conf_verify(config, g_getIdentityCallback ? verifyIdentity : NULL, NULL);
+    mbedtls_ssl_conf_verify(config, verifyIdentity, NULL);
 
     if(0 != mbedtls_ssl_setup(&tep->ssl, config))
     {
@@ -1714,8 +1982,11 @@ void CAdeinitSslAdapter(void)
     DeletePeerList();
 
     // De-initialize mbedTLS
+    mbedtls_x509_crt_free(&g_caSslContext->ca);
     mbedtls_x509_crt_free(&g_caSslContext->crt);
     mbedtls_pk_free(&g_caSslContext->pkey);
+    mbedtls_x509_crl_free(&g_caSslContext->crl);
+    FreeRevokedCerts();
 #ifdef __WITH_TLS__
     mbedtls_ssl_config_free(&g_caSslContext->clientTlsConf);
     mbedtls_ssl_config_free(&g_caSslContext->serverTlsConf);
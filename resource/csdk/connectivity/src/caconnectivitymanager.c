@@ -529,6 +529,11 @@ CAResult_t CAHandleRequestResponse(void)
     return CA_STATUS_OK;
 }
 
+void CARegisterProcessEvent(oc_event event)
+{
+    CARegisterMessageProcessEvent(event);
+}
+
 CAResult_t CASelectCipherSuite(const uint16_t cipher, CATransportAdapter_t adapter)
 {
     (void)(adapter); // prevent unused-parameter warning when building release variant
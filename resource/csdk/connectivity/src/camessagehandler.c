@@ -52,6 +52,7 @@
 #include "uqueue.h"
 #include "cathreadpool.h" /* for thread pool */
 #include "caqueueingthread.h"
+#include "ocevent.h"
 
 #if defined(TCP_ADAPTER) && defined(WITH_CLOUD)
 #include "caconnectionmanager.h"
@@ -77,6 +78,13 @@ static CAResponseCallback g_responseHandler = NULL;
 static CAErrorCallback g_errorHandler = NULL;
 static CANetworkMonitorCallback g_nwMonitorHandler = NULL;
 
+// event signaled whenever received data is waiting for CAHandleRequestResponseCallbacks
+static oc_event g_processEvent = NULL;
+
+// held while g_processEvent is changed or signaled, so that a caller of
+// CARegisterMessageProcessEvent() may free the previous event once it returns
+static oc_mutex g_processEventMutex = NULL;
+
 static void CAErrorHandler(const CAEndpoint_t *endpoint,
                            const void *data, size_t dataLen,
                            CAResult_t result);
@@ -89,6 +97,8 @@ static void CASendErrorInfo(const CAEndpoint_t *endpoint, const CAInfo_t *info,
                             CAResult_t result);
 
 static void CADestroyData(void *data, uint32_t size);
+static void CAAddDataToReceiveQueue(CAData_t *data);
+static void CASignalProcessEvent(void);
 static void CALogPayloadInfo(CAInfo_t *info);
 static bool CADropSecondMessage(CAHistory_t *history, const CAEndpoint_t *endpoint, uint16_t id,
                                 CAToken_t token, uint8_t tokenLength);
@@ -114,10 +124,49 @@ void CAAddDataToReceiveThread(CAData_t *data)
     VERIFY_NON_NULL_VOID(data, TAG, "data");
 
     // add thread
-    CAQueueingThreadAddData(&g_receiveThread, data, sizeof(CAData_t));
+    CAAddDataToReceiveQueue(data);
 }
 #endif
 
+static void CAAddDataToReceiveQueue(CAData_t *data)
+{
+    CAQueueingThreadAddData(&g_receiveThread, data, sizeof(CAData_t));
+
+#ifdef SINGLE_HANDLE
+    // wake up the application thread which drives CAHandleRequestResponse
+    CASignalProcessEvent();
+#endif
+}
+
+static void CASignalProcessEvent(void)
+{
+    if (!g_processEventMutex)
+    {
+        return;
+    }
+
+    oc_mutex_lock(g_processEventMutex);
+    if (g_processEvent)
+    {
+        oc_event_signal(g_processEvent);
+    }
+    oc_mutex_unlock(g_processEventMutex);
+}
+
+void CARegisterMessageProcessEvent(oc_event event)
+{
+    if (!g_processEventMutex)
+    {
+        // the message handler is not initialized, so no thread signals the event.
+        g_processEvent = event;
+        return;
+    }
+
+    oc_mutex_lock(g_processEventMutex);
+    g_processEvent = event;
+    oc_mutex_unlock(g_processEventMutex);
+}
+
 static bool CAIsSelectedNetworkAvailable(void)
 {
     u_arraylist_t *list = CAGetSelectedNetworkList();
@@ -358,7 +407,7 @@ static void CATimeoutCallback(const CAEndpoint_t *endpoint, const void *pdu, uin
     }
 #endif // WITH_BWT
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveQueue(cadata);
 }
 
 static void CADestroyData(void *data, uint32_t size)
@@ -881,7 +930,7 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
         if (CA_NOT_SUPPORTED == res || CA_REQUEST_TIMEOUT == res)
         {
             OIC_LOG(DEBUG, TAG, "this message does not have block option");
-            CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+            CAAddDataToReceiveQueue(cadata);
         }
         else
         {
@@ -891,7 +940,7 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
     else
 #endif
     {
-        CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+        CAAddDataToReceiveQueue(cadata);
     }
 
     coap_delete_pdu(pdu);
@@ -913,9 +962,17 @@ void CAHandleRequestResponseCallbacks(void)
     oc_mutex_lock(g_receiveThread.threadMutex);
 
     u_queue_message_t *item = u_queue_get_element(g_receiveThread.dataQueue);
+    bool hasPendingData = (0 < u_queue_get_size(g_receiveThread.dataQueue));
 
     oc_mutex_unlock(g_receiveThread.threadMutex);
 
+    // only one message is handled per call, so keep the event loop running
+    // until the receive queue is drained.
+    if (hasPendingData)
+    {
+        CASignalProcessEvent();
+    }
+
     if (NULL == item || NULL == item->msg)
     {
         return;
@@ -1086,7 +1143,7 @@ CAResult_t CADetachSendMessage(const CAEndpoint_t *endpoint, const void *sendMsg
     {
         OIC_LOG(DEBUG, TAG,
                 "This is a loopback message. Transfer it to the receive queue directly");
-        CAQueueingThreadAddData(&g_receiveThread, data, sizeof(CAData_t));
+        CAAddDataToReceiveQueue(data);
         return CA_STATUS_OK;
     }
 #ifdef WITH_BWT
@@ -1133,6 +1190,16 @@ CAResult_t CAInitializeMessageHandler(CATransportAdapter_t transportType)
     CASetPacketReceivedCallback(CAReceivedPacketCallback);
     CASetErrorHandleCallback(CAErrorHandler);
 
+    if (!g_processEventMutex)
+    {
+        g_processEventMutex = oc_mutex_new();
+        if (!g_processEventMutex)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to create process event mutex");
+            return CA_MEMORY_ALLOC_FAILED;
+        }
+    }
+
     // create thread pool
     CAResult_t res = ca_thread_pool_init(MAX_THREAD_POOL_SIZE, &g_threadPoolHandle);
     if (CA_STATUS_OK != res)
@@ -1258,6 +1325,12 @@ void CATerminateMessageHandler(void)
 
     // terminate interface adapters by controller
     CATerminateAdapters();
+
+    if (g_processEventMutex)
+    {
+        oc_mutex_free(g_processEventMutex);
+        g_processEventMutex = NULL;
+    }
 }
 
 static void CALogPayloadInfo(CAInfo_t *info)
@@ -1362,7 +1435,7 @@ void CAErrorHandler(const CAEndpoint_t *endpoint,
 
     cadata->errorInfo->result = result;
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveQueue(cadata);
     coap_delete_pdu(pdu);
 
     OIC_LOG(DEBUG, TAG, "CAErrorHandler OUT");
@@ -1411,7 +1484,7 @@ static void CASendErrorInfo(const CAEndpoint_t *endpoint, const CAInfo_t *info,
     cadata->errorInfo = errorInfo;
     cadata->dataType = CA_ERROR_DATA;
 
-    CAQueueingThreadAddData(&g_receiveThread, cadata, sizeof(CAData_t));
+    CAAddDataToReceiveQueue(cadata);
     OIC_LOG(DEBUG, TAG, "CASendErrorInfo OUT");
 }
 
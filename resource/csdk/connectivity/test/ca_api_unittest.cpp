@@ -505,6 +505,94 @@ TEST_F(CATests, HandlerRequestResponseTest)
     EXPECT_EQ(CA_STATUS_OK, CAHandleRequestResponse());
 }
 
+static CAResult_t sendRequestToSelf()
+{
+    size_t tempSize = 0;
+    CAEndpoint_t *tempInfo = NULL;
+    CAResult_t res = CAGetNetworkInformation(&tempInfo, &tempSize);
+    if (CA_STATUS_OK != res)
+    {
+        return res;
+    }
+
+    uint16_t port = 0;
+    for (size_t index = 0; index < tempSize; index++)
+    {
+        if ((tempInfo[index].flags & CA_IPV4) && !(tempInfo[index].flags & CA_SECURE))
+        {
+            port = tempInfo[index].port;
+            break;
+        }
+    }
+    free(tempInfo);
+
+    if (0 == port)
+    {
+        return CA_STATUS_FAILED;
+    }
+
+    CAEndpoint_t *self = NULL;
+    res = CACreateEndpoint(CA_IPV4, CA_ADAPTER_IP, "127.0.0.1", port, &self);
+    if (CA_STATUS_OK != res)
+    {
+        return res;
+    }
+
+    CAToken_t token = NULL;
+    CAGenerateToken(&token, tokenLength);
+
+    CARequestInfo_t request;
+    memset(&request, 0, sizeof(CARequestInfo_t));
+    request.method = CA_GET;
+    request.info.type = CA_MSG_NONCONFIRM;
+    request.info.token = token;
+    request.info.tokenLength = tokenLength;
+
+    res = CASendRequest(self, &request);
+
+    CADestroyToken(token);
+    CADestroyEndpoint(self);
+    return res;
+}
+
+// the registered process event is signaled when received data is pending
+TEST_F(CATests, ProcessEventSignaledWhenDataIsReceived)
+{
+    CARegisterHandler(request_handler, response_handler, error_handler);
+    EXPECT_EQ(CA_STATUS_OK, CASelectNetwork(CA_ADAPTER_IP));
+    EXPECT_EQ(CA_STATUS_OK, CAStartListeningServer());
+
+    oc_event event = oc_event_new();
+    ASSERT_TRUE(NULL != event);
+    CARegisterProcessEvent(event);
+
+    EXPECT_EQ(CA_STATUS_OK, sendRequestToSelf());
+    EXPECT_EQ(OC_WAIT_SUCCESS, oc_event_wait_for(event, 2000));
+    EXPECT_EQ(CA_STATUS_OK, CAHandleRequestResponse());
+
+    CARegisterProcessEvent(NULL);
+    oc_event_free(event);
+}
+
+// an unregistered process event is not signaled anymore and may be freed
+TEST_F(CATests, UnregisteredProcessEventNotSignaled)
+{
+    CARegisterHandler(request_handler, response_handler, error_handler);
+    EXPECT_EQ(CA_STATUS_OK, CASelectNetwork(CA_ADAPTER_IP));
+    EXPECT_EQ(CA_STATUS_OK, CAStartListeningServer());
+
+    oc_event event = oc_event_new();
+    ASSERT_TRUE(NULL != event);
+    CARegisterProcessEvent(event);
+    CARegisterProcessEvent(NULL);
+
+    EXPECT_EQ(CA_STATUS_OK, sendRequestToSelf());
+    EXPECT_EQ(OC_WAIT_TIMEDOUT, oc_event_wait_for(event, 500));
+    EXPECT_EQ(CA_STATUS_OK, CAHandleRequestResponse());
+
+    oc_event_free(event);
+}
+
 // CAGetNetworkInformation TC
 TEST_F(CATests, GetNetworkInformationTest)
 {
@@ -24,6 +24,9 @@
 #endif
 
 #include <cinttypes>
+#include <chrono>
+#include <utility>
+#include <vector>
 #include "iotivity_config.h"
 #include <gtest/gtest.h>
 #include "time.h"
@@ -50,6 +53,7 @@
 #define GetCASecureEndpointAttributes GetCASecureEndpointAttributesTest
 #define CAsetPeerCNVerifyCallback CAsetPeerCNVerifyCallbackTest
 #define CAsetCloseSslConnectionCallback CAsetCloseSslConnectionCallbackTest
+#define CAinvalidatePkixInfo CAinvalidatePkixInfoTest
 
 #include "../src/adapter_util/ca_adapter_net_ssl.c"
 
@@ -2939,6 +2943,388 @@ TEST(TLSAdapter, Test_9_2)
     EXPECT_EQ(0, ret);
 }
 
+static int g_pkixInfoLoadCount = 0;
+
+static void countingInfoCallback(PkiInfo_t * inf)
+{
+    g_pkixInfoLoadCount++;
+    infoCallback_that_loads_x509(inf);
+}
+
+// InitPKIX() loads PKIX info only when it has changed
+TEST(TLSAdapter, Test_9_3)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(countingInfoCallback);
+    g_pkixInfoLoadCount = 0;
+
+    InitPKIX(CA_ADAPTER_TCP);
+    InitPKIX(CA_ADAPTER_TCP);
+    InitPKIX(CA_ADAPTER_IP);
+    EXPECT_EQ(1, g_pkixInfoLoadCount);
+
+    CAinvalidatePkixInfo();
+    InitPKIX(CA_ADAPTER_TCP);
+    EXPECT_EQ(2, g_pkixInfoLoadCount);
+
+    CAdeinitSslAdapter();
+}
+
+/*
+ * CRL fixtures generated with openssl: a root CA, certificates of serial 0x1001 and 0x1002
+ * issued by it, a certificate of serial 0x1001 issued by another root CA, and CRLs revoking
+ * serial 0x1001 since 2017. crlCurrent is valid from 2017 to 2099, crlExpired until 2018
+ * and crlFuture from 2090. crlUntrusted is signed by the other root CA.
+ */
+static const char crlCaCert[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBkDCCATWgAwIBAgIBATAKBggqhkjOPQQDAjAuMREwDwYDVQQKDAhJb1Rpdml0\n"
+    "eTEZMBcGA1UEAwwQQ1JMIFRlc3QgUm9vdCBDQTAgFw0xNzAxMDEwMDAwMDBaGA8y\n"
+    "MDk5MTIzMTAwMDAwMFowLjERMA8GA1UECgwISW9UaXZpdHkxGTAXBgNVBAMMEENS\n"
+    "TCBUZXN0IFJvb3QgQ0EwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAAQfCeGxx5nc\n"
+    "+rK/863Hq/TKpj4bLJqfTYVFkZUYOQEmtuWmYtQGrObM3eEcsen8rwPUnD52hcf2\n"
+    "wkCrdXk29srBo0IwQDAPBgNVHRMBAf8EBTADAQH/MA4GA1UdDwEB/wQEAwIBBjAd\n"
+    "BgNVHQ4EFgQUpYGLRQi2Ocgu+7wTdAyRGctHNAIwCgYIKoZIzj0EAwIDSQAwRgIh\n"
+    "ANE6EuMg2id5ZLuxlzDoJOQD/S1plFZVueEYXwX1Xn1sAiEAlxtywvnxVJ18+KqV\n"
+    "LYupw7aFfil+emDAVsq2ZPTKw1A=\n"
+    "-----END CERTIFICATE-----\n";
+
+static const char crlRevokedCert[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBrTCCAVKgAwIBAgICEAEwCgYIKoZIzj0EAwIwLjERMA8GA1UECgwISW9UaXZp\n"
+    "dHkxGTAXBgNVBAMMEENSTCBUZXN0IFJvb3QgQ0EwIBcNMTcwMTAxMDAwMDAwWhgP\n"
+    "MjA5OTEyMzEwMDAwMDBaMCwxETAPBgNVBAoMCElvVGl2aXR5MRcwFQYDVQQDDA5S\n"
+    "ZXZva2VkIERldmljZTBZMBMGByqGSM49AgEGCCqGSM49AwEHA0IABHcXJ+2oVnb2\n"
+    "sLg+9pOR/gufP9IfuIu0yTxv6UcnfwDT3kWMt8bnXgvm7vDO9fkOVaHnT5cGDI6r\n"
+    "ISk7YLQs9IajYDBeMAwGA1UdEwEB/wQCMAAwDgYDVR0PAQH/BAQDAgOIMB0GA1Ud\n"
+    "DgQWBBTkNMzrm9GxD4IMNA2UoTAv3f8iazAfBgNVHSMEGDAWgBSlgYtFCLY5yC77\n"
+    "vBN0DJEZy0c0AjAKBggqhkjOPQQDAgNJADBGAiEAvFUtC6tk+37PgBU9xKOdgtWW\n"
+    "1rBqNdH/bUlUUu5Uh2UCIQCK5/KPs/oC9tn2Yl3hRct+S6wRIVpb5MxCoKh/WhHN\n"
+    "AA==\n"
+    "-----END CERTIFICATE-----\n";
+
+static const char crlValidCert[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBqzCCAVCgAwIBAgICEAIwCgYIKoZIzj0EAwIwLjERMA8GA1UECgwISW9UaXZp\n"
+    "dHkxGTAXBgNVBAMMEENSTCBUZXN0IFJvb3QgQ0EwIBcNMTcwMTAxMDAwMDAwWhgP\n"
+    "MjA5OTEyMzEwMDAwMDBaMCoxETAPBgNVBAoMCElvVGl2aXR5MRUwEwYDVQQDDAxW\n"
+    "YWxpZCBEZXZpY2UwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAAR3FyftqFZ29rC4\n"
+    "PvaTkf4Lnz/SH7iLtMk8b+lHJ38A095FjLfG514L5u7wzvX5DlWh50+XBgyOqyEp\n"
+    "O2C0LPSGo2AwXjAMBgNVHRMBAf8EAjAAMA4GA1UdDwEB/wQEAwIDiDAdBgNVHQ4E\n"
+    "FgQU5DTM65vRsQ+CDDQNlKEwL93/ImswHwYDVR0jBBgwFoAUpYGLRQi2Ocgu+7wT\n"
+    "dAyRGctHNAIwCgYIKoZIzj0EAwIDSQAwRgIhANHgeI6RsnsZ9ZvCJvbulC7786c5\n"
+    "NMw60gvQBgD23vWZAiEAk75U3p2e8SQyMTZWxGJoUx+vgvbIDtpOwoJjX+mpoo8=\n"
+    "-----END CERTIFICATE-----\n";
+
+static const char crlOtherIssuerCert[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBrTCCAVKgAwIBAgICEAEwCgYIKoZIzj0EAwIwMDERMA8GA1UECgwISW9UaXZp\n"
+    "dHkxGzAZBgNVBAMMEk90aGVyIFRlc3QgUm9vdCBDQTAgFw0xNzAxMDEwMDAwMDBa\n"
+    "GA8yMDk5MTIzMTAwMDAwMFowKjERMA8GA1UECgwISW9UaXZpdHkxFTATBgNVBAMM\n"
+    "DE90aGVyIERldmljZTBZMBMGByqGSM49AgEGCCqGSM49AwEHA0IABHcXJ+2oVnb2\n"
+    "sLg+9pOR/gufP9IfuIu0yTxv6UcnfwDT3kWMt8bnXgvm7vDO9fkOVaHnT5cGDI6r\n"
+    "ISk7YLQs9IajYDBeMAwGA1UdEwEB/wQCMAAwDgYDVR0PAQH/BAQDAgOIMB0GA1Ud\n"
+    "DgQWBBTkNMzrm9GxD4IMNA2UoTAv3f8iazAfBgNVHSMEGDAWgBTLR73kFrmuPUFy\n"
+    "I/Q52BiR9O1gETAKBggqhkjOPQQDAgNJADBGAiEA/QcsMvY7fcrjRbjTY+coNxt/\n"
+    "1Yp7NJvg7mVmuxssvFECIQDNx/nWtyKuLm3WNvpJClV+sLOUbVNaIaFNnBiMluNi\n"
+    "ow==\n"
+    "-----END CERTIFICATE-----\n";
+
+static const unsigned char crlCurrent[] = {
+    0x30, 0x81, 0xcb, 0x30, 0x73, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x30, 0x2e, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x49, 0x6f,
+    0x54, 0x69, 0x76, 0x69, 0x74, 0x79, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x10, 0x43, 0x52, 0x4c, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43,
+    0x41, 0x17, 0x0d, 0x31, 0x37, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a,
+    0x18, 0x0f, 0x32, 0x30, 0x39, 0x39, 0x31, 0x32, 0x33, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x5a, 0x30, 0x15, 0x30, 0x13, 0x02, 0x02, 0x10, 0x01, 0x17, 0x0d, 0x31, 0x37, 0x30, 0x31, 0x30,
+    0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce,
+    0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30, 0x45, 0x02, 0x20, 0x3e, 0x7f, 0xbd, 0xd5, 0xa8,
+    0xc4, 0x02, 0xda, 0xa9, 0x02, 0x14, 0x35, 0xb2, 0x57, 0xd7, 0x1c, 0xe5, 0x8c, 0xbb, 0x41, 0x11,
+    0xc6, 0x96, 0xbd, 0x01, 0xfb, 0x50, 0x3c, 0xda, 0xf6, 0xff, 0x0c, 0x02, 0x21, 0x00, 0x9f, 0x6a,
+    0xb4, 0x86, 0xbc, 0xe2, 0xd4, 0x8e, 0xdb, 0x3a, 0x99, 0xb9, 0x52, 0x5f, 0x32, 0x1b, 0x7b, 0x71,
+    0x49, 0xd4, 0x5b, 0xc3, 0x0f, 0xdc, 0xe3, 0x1e, 0x12, 0x26, 0xb1, 0xa8, 0xf5, 0x05
+};
+
+static const unsigned char crlExpired[] = {
+    0x30, 0x81, 0xc8, 0x30, 0x71, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x30, 0x2e, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x49, 0x6f,
+    0x54, 0x69, 0x76, 0x69, 0x74, 0x79, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x10, 0x43, 0x52, 0x4c, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43,
+    0x41, 0x17, 0x0d, 0x31, 0x37, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a,
+    0x17, 0x0d, 0x31, 0x38, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30,
+    0x15, 0x30, 0x13, 0x02, 0x02, 0x10, 0x01, 0x17, 0x0d, 0x31, 0x37, 0x30, 0x31, 0x30, 0x31, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04,
+    0x03, 0x02, 0x03, 0x47, 0x00, 0x30, 0x44, 0x02, 0x20, 0x5e, 0xd3, 0x75, 0x8e, 0xef, 0xce, 0x7a,
+    0x07, 0xc9, 0xe6, 0x30, 0x79, 0x8e, 0xfc, 0xa9, 0x80, 0xab, 0x11, 0xd7, 0xc8, 0x1c, 0x4c, 0xcf,
+    0x41, 0x8b, 0xb2, 0x62, 0x07, 0xe5, 0xb0, 0xe2, 0xb2, 0x02, 0x20, 0x32, 0x57, 0x63, 0xd9, 0x7f,
+    0xb6, 0x74, 0x6b, 0x78, 0x24, 0xf3, 0x86, 0x58, 0x3e, 0x22, 0x5c, 0x17, 0xbc, 0x34, 0x7f, 0xab,
+    0x82, 0x49, 0xf0, 0xc6, 0x22, 0xf1, 0x50, 0x22, 0xb5, 0x84, 0x57
+};
+
+static const unsigned char crlFuture[] = {
+    0x30, 0x81, 0xce, 0x30, 0x75, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x30, 0x2e, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x49, 0x6f,
+    0x54, 0x69, 0x76, 0x69, 0x74, 0x79, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x10, 0x43, 0x52, 0x4c, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43,
+    0x41, 0x18, 0x0f, 0x32, 0x30, 0x39, 0x30, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x39, 0x39, 0x31, 0x32, 0x33, 0x31, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x5a, 0x30, 0x15, 0x30, 0x13, 0x02, 0x02, 0x10, 0x01, 0x17, 0x0d, 0x31, 0x37, 0x30,
+    0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xb7, 0x2b,
+    0xef, 0x29, 0x2c, 0xfd, 0xb1, 0x67, 0xcb, 0x64, 0xfb, 0x78, 0x11, 0x37, 0xbf, 0x1e, 0x6a, 0xd9,
+    0x5b, 0x10, 0x92, 0xb1, 0x5c, 0x12, 0x9d, 0x7c, 0x7b, 0xd9, 0xeb, 0x5c, 0x88, 0xd2, 0x02, 0x21,
+    0x00, 0x84, 0xa4, 0xa1, 0xc4, 0x09, 0x75, 0x2d, 0x9a, 0x85, 0xa0, 0xdd, 0x63, 0x81, 0xed, 0xd3,
+    0xf3, 0x83, 0x25, 0x3d, 0xb4, 0x57, 0xfa, 0xcf, 0x10, 0x45, 0xaf, 0xbc, 0x7f, 0xf8, 0x91, 0x37,
+    0x32
+};
+
+static const unsigned char crlUntrusted[] = {
+    0x30, 0x81, 0xce, 0x30, 0x75, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03,
+    0x02, 0x30, 0x30, 0x31, 0x11, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x08, 0x49, 0x6f,
+    0x54, 0x69, 0x76, 0x69, 0x74, 0x79, 0x31, 0x1b, 0x30, 0x19, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c,
+    0x12, 0x4f, 0x74, 0x68, 0x65, 0x72, 0x20, 0x54, 0x65, 0x73, 0x74, 0x20, 0x52, 0x6f, 0x6f, 0x74,
+    0x20, 0x43, 0x41, 0x17, 0x0d, 0x31, 0x37, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x5a, 0x18, 0x0f, 0x32, 0x30, 0x39, 0x39, 0x31, 0x32, 0x33, 0x31, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x5a, 0x30, 0x15, 0x30, 0x13, 0x02, 0x02, 0x10, 0x01, 0x17, 0x0d, 0x31, 0x37, 0x30,
+    0x31, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5a, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86,
+    0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xcf, 0xb6,
+    0xea, 0x9a, 0xd6, 0x83, 0xed, 0xb5, 0x05, 0xd0, 0x0c, 0xab, 0xb7, 0xca, 0xcb, 0x0c, 0x7d, 0xd4,
+    0x91, 0x2b, 0xa1, 0xbf, 0xa7, 0xe9, 0xf5, 0x5c, 0x0c, 0x28, 0x05, 0x58, 0x81, 0x3b, 0x02, 0x21,
+    0x00, 0xe9, 0x21, 0x49, 0xab, 0x84, 0x96, 0xca, 0x76, 0x91, 0x9d, 0xc7, 0xdb, 0x93, 0xdc, 0x53,
+    0xbe, 0x0d, 0xf3, 0x74, 0x6f, 0xa7, 0x76, 0x95, 0x44, 0xfd, 0xc2, 0x7b, 0xc9, 0xff, 0x2d, 0xdf,
+    0x7c
+};
+
+static const unsigned char *g_testCrl = NULL;
+static size_t g_testCrlLen = 0;
+
+static void crlInfoCallback(PkiInfo_t * inf)
+{
+    ByteArray_t * ca = (ByteArray_t *)OICMalloc(sizeof(ByteArray_t));
+    ASSERT_TRUE(ca != NULL);
+    ca->data = (uint8_t *)OICMalloc(sizeof(crlCaCert));
+    ASSERT_TRUE(ca->data != NULL);
+    memcpy(ca->data, crlCaCert, sizeof(crlCaCert));
+    ca->len = sizeof(crlCaCert);
+
+    inf->ca.cert = ca;
+    inf->ca.next = NULL;
+
+    inf->crl.data = (uint8_t *)OICMalloc(g_testCrlLen);
+    ASSERT_TRUE(inf->crl.data != NULL);
+    memcpy(inf->crl.data, g_testCrl, g_testCrlLen);
+    inf->crl.len = g_testCrlLen;
+}
+
+// Loads the root CA and the CRL, as an update of /oic/sec/crl does.
+static void loadTestCrl(const unsigned char *crl, size_t crlLen)
+{
+    g_testCrl = crl;
+    g_testCrlLen = crlLen;
+    CAinvalidatePkixInfo();
+    EXPECT_EQ(0, InitPKIX(CA_ADAPTER_TCP));
+    EXPECT_TRUE(g_caSslContext->hasCrl);
+}
+
+static uint32_t revocationFlags(const char *pem, size_t len)
+{
+    mbedtls_x509_crt crt;
+    mbedtls_x509_crt_init(&crt);
+    EXPECT_EQ(0, mbedtls_x509_crt_parse(&crt, (const unsigned char *)pem, len));
+
+    uint32_t flags = 0;
+    CheckRevocation(&crt, &flags);
+    mbedtls_x509_crt_free(&crt);
+    return flags;
+}
+
+// A serial revoked by a CRL of a trusted CA is found in the index
+TEST(TLSAdapter, Test_9_4)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    loadTestCrl(crlCurrent, sizeof(crlCurrent));
+    // indexed, so verifyIdentity checks revocation instead of mbedTLS.
+    EXPECT_TRUE(g_caSslContext->revokedCerts != NULL);
+    EXPECT_TRUE(g_caSslContext->clientTlsConf.ca_crl == NULL);
+
+    EXPECT_EQ((uint32_t)MBEDTLS_X509_BADCERT_REVOKED,
+              revocationFlags(crlRevokedCert, sizeof(crlRevokedCert)));
+
+    CAdeinitSslAdapter();
+}
+
+// A serial the CRL does not list is not revoked
+TEST(TLSAdapter, Test_9_5)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    loadTestCrl(crlCurrent, sizeof(crlCurrent));
+    EXPECT_EQ(0u, revocationFlags(crlValidCert, sizeof(crlValidCert)));
+
+    CAdeinitSslAdapter();
+}
+
+// A revoked serial issued by another CA is not revoked
+TEST(TLSAdapter, Test_9_6)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    loadTestCrl(crlCurrent, sizeof(crlCurrent));
+    EXPECT_EQ(0u, revocationFlags(crlOtherIssuerCert, sizeof(crlOtherIssuerCert)));
+
+    CAdeinitSslAdapter();
+}
+
+// An expired or not yet valid CRL flags the certificates of its issuer
+TEST(TLSAdapter, Test_9_7)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    loadTestCrl(crlExpired, sizeof(crlExpired));
+    EXPECT_TRUE(g_caSslContext->revokedCerts != NULL);
+    EXPECT_EQ((uint32_t)(MBEDTLS_X509_BADCERT_REVOKED | MBEDTLS_X509_BADCRL_EXPIRED),
+              revocationFlags(crlRevokedCert, sizeof(crlRevokedCert)));
+    EXPECT_EQ((uint32_t)MBEDTLS_X509_BADCRL_EXPIRED,
+              revocationFlags(crlValidCert, sizeof(crlValidCert)));
+    EXPECT_EQ(0u, revocationFlags(crlOtherIssuerCert, sizeof(crlOtherIssuerCert)));
+
+    loadTestCrl(crlFuture, sizeof(crlFuture));
+    EXPECT_TRUE(g_caSslContext->revokedCerts != NULL);
+    EXPECT_EQ((uint32_t)(MBEDTLS_X509_BADCERT_REVOKED | MBEDTLS_X509_BADCRL_FUTURE),
+              revocationFlags(crlRevokedCert, sizeof(crlRevokedCert)));
+    EXPECT_EQ((uint32_t)MBEDTLS_X509_BADCRL_FUTURE,
+              revocationFlags(crlValidCert, sizeof(crlValidCert)));
+
+    CAdeinitSslAdapter();
+}
+
+// A CRL not signed by a trusted CA is left to mbedTLS
+TEST(TLSAdapter, Test_9_8)
+{
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    loadTestCrl(crlCurrent, sizeof(crlCurrent));
+    EXPECT_TRUE(g_caSslContext->revokedCerts != NULL);
+
+    loadTestCrl(crlUntrusted, sizeof(crlUntrusted));
+    EXPECT_TRUE(g_caSslContext->revokedCerts == NULL);
+    EXPECT_TRUE(g_caSslContext->clientTlsConf.ca_crl == &g_caSslContext->crl);
+    EXPECT_TRUE(g_caSslContext->serverTlsConf.ca_crl == &g_caSslContext->crl);
+    EXPECT_EQ(0u, revocationFlags(crlRevokedCert, sizeof(crlRevokedCert)));
+    EXPECT_EQ(0u, revocationFlags(crlOtherIssuerCert, sizeof(crlOtherIssuerCert)));
+
+    CAdeinitSslAdapter();
+}
+
+static double elapsedMicros(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Benchmark of CRL updates and revocation checks, against the walk of the CRL by mbedTLS.
+// The CRL is grown with unsigned entries after it is parsed, the signature covers the
+// parsed DER only.
+TEST(TLSAdapter, CrlBenchmark)
+{
+    const int numOfUpdates = 100;
+    const int numOfLookups = 10000;
+    const size_t sizes[] = { 16, 1024, 16384 };
+
+    CAinitSslAdapter();
+    CAsetPkixInfoCallback(crlInfoCallback);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numOfUpdates; i++)
+    {
+        loadTestCrl(crlCurrent, sizeof(crlCurrent));
+    }
+    printf("CRL update (parse and index): %.1f us\n", elapsedMicros(start) / numOfUpdates);
+
+    mbedtls_x509_crt revoked, valid;
+    mbedtls_x509_crt_init(&revoked);
+    mbedtls_x509_crt_init(&valid);
+    ASSERT_EQ(0, mbedtls_x509_crt_parse(&revoked, (const unsigned char *)crlRevokedCert,
+                                        sizeof(crlRevokedCert)));
+    ASSERT_EQ(0, mbedtls_x509_crt_parse(&valid, (const unsigned char *)crlValidCert,
+                                        sizeof(crlValidCert)));
+
+    mbedtls_x509_crl_entry *last = &g_caSslContext->crl.entry;
+    while (NULL != last->next)
+    {
+        last = last->next;
+    }
+
+    for (size_t size : sizes)
+    {
+        std::vector<mbedtls_x509_crl_entry> entries(size);
+        std::vector<unsigned char> serials(size * 4);
+        for (size_t i = 0; i < size; i++)
+        {
+            unsigned char *serial = &serials[i * 4];
+            serial[0] = 0x7f;
+            serial[1] = (unsigned char)(i >> 16);
+            serial[2] = (unsigned char)(i >> 8);
+            serial[3] = (unsigned char)i;
+
+            memset(&entries[i], 0, sizeof(entries[i]));
+            entries[i].serial.tag = MBEDTLS_ASN1_INTEGER;
+            entries[i].serial.len = 4;
+            entries[i].serial.p = serial;
+            entries[i].revocation_date = g_caSslContext->crl.entry.revocation_date;
+            entries[i].next = (i + 1 < size) ? &entries[i + 1] : NULL;
+        }
+        // the revoked serial goes last, where the walk of mbedTLS finds it last.
+        last->next = &entries[0];
+        std::swap(g_caSslContext->crl.entry.serial, entries[size - 1].serial);
+
+        start = std::chrono::steady_clock::now();
+        IndexRevokedCerts();
+        double indexTime = elapsedMicros(start);
+        ASSERT_TRUE(g_caSslContext->revokedCerts != NULL);
+
+        uint32_t flags = 0;
+        int revokedCount = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numOfLookups; i++)
+        {
+            flags = 0;
+            CheckRevocation(((i & 1) ? &revoked : &valid), &flags);
+            revokedCount += (0 != (flags & MBEDTLS_X509_BADCERT_REVOKED));
+        }
+        double indexLookupTime = elapsedMicros(start);
+        EXPECT_EQ(numOfLookups / 2, revokedCount);
+
+        int walkRevokedCount = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numOfLookups; i++)
+        {
+            walkRevokedCount += mbedtls_x509_crt_is_revoked(((i & 1) ? &revoked : &valid),
+                                                            &g_caSslContext->crl);
+        }
+        double walkLookupTime = elapsedMicros(start);
+        EXPECT_EQ(revokedCount, walkRevokedCount);
+
+        printf("CRL of %" PRIuPTR " entries: index %.1f us, check %.3f us indexed, "
+               "%.3f us walked\n", size + 1, indexTime,
+               indexLookupTime / numOfLookups, walkLookupTime / numOfLookups);
+
+        std::swap(g_caSslContext->crl.entry.serial, entries[size - 1].serial);
+        last->next = NULL;
+        FreeRevokedCerts();
+    }
+
+    mbedtls_x509_crt_free(&revoked);
+    mbedtls_x509_crt_free(&valid);
+    CAdeinitSslAdapter();
+}
+
 /* **************************
  *
  *
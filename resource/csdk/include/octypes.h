@@ -444,6 +444,16 @@ extern "C" {
 /** Resource URI used to discover Proxy */
 #define OC_RSRVD_PROXY_OPTION_ID 35
 
+/**
+ * CoAP option carrying the ETag of a resource representation.
+ * A client revalidates a cached representation by sending its ETag back in a GET
+ * request. The answer is then 2.03 Valid without payload, or the new representation.
+ * The stack does not cache representations on the client side: the application keeps the
+ * ETag from the received header options of the last response next to its copy of the
+ * representation, and treats a response without payload to such a GET as a cache hit.
+ */
+#define OC_RSRVD_ETAG_OPTION_ID 4
+
 /** Unique value per collection/link. */
 #define OC_RSRVD_INS                     "ins"
 
@@ -1029,7 +1039,14 @@ typedef enum
     /** When this bit is set, the resource is allowed to be discovered only
      *  if discovery request contains an explicit querystring.
      *  Ex: GET /oic/res?rt=oic.sec.acl */
-    OC_EXPLICIT_DISCOVERABLE   = (1 << 5)
+    OC_EXPLICIT_DISCOVERABLE   = (1 << 5),
+
+    /** When this bit is set, responses to GET requests carry an ETag, and a GET
+     *  request carrying the current ETag is answered with 2.03 Valid without
+     *  calling the entity handler. The ETag changes on OCNotifyAllObservers,
+     *  OCNotifyListOfObservers and on every request other than GET. The server
+     *  calls OCInvalidateResourceETag when the representation changes otherwise. */
+    OC_ETAG          = (1 << 7)
 
 #ifdef WITH_MQ
     /** When this bit is set, the resource is allowed to be published */
@@ -36,6 +36,295 @@
  */
 #define RM_TAG "OIC_RM_RAP"
 
+/**
+ * Minimum number of slots of a routing table index.
+ */
+#define RTM_INDEX_MIN_CAPACITY 16
+
+/**
+ * Slot of a routing table index. The slot is empty if data is NULL.
+ */
+typedef struct
+{
+    uint32_t key;                           /**< Key of the entry. */
+    void *data;                             /**< Entry of the routing table. */
+} RTMIndexSlot_t;
+
+/**
+ * Hash index of a routing table, which maps a key to an entry of the table.
+ * The index is built from the table on the first lookup after entries are added
+ * to or removed from the table.
+ */
+typedef struct
+{
+    const u_linklist_t *table;              /**< Indexed table. */
+    bool isValid;                           /**< false if the table has changed. */
+    size_t capacity;                        /**< Number of slots, a power of 2. */
+    RTMIndexSlot_t *slots;                  /**< Slots with linear probing. */
+} RTMIndex_t;
+
+/**
+ * Gets the key of a routing table entry.
+ */
+typedef uint32_t (*RTMIndexKey_t)(const void *data);
+
+/**
+ * Checks if a routing table entry matches the argument of a lookup.
+ */
+typedef bool (*RTMIndexMatch_t)(const void *data, const void *arg);
+
+/**
+ * Gateway entries indexed by destination gateway id.
+ */
+static RTMIndex_t g_gatewayIndex = { .table = NULL };
+
+/**
+ * Endpoint entries indexed by endpoint id.
+ */
+static RTMIndex_t g_endpointIdIndex = { .table = NULL };
+
+/**
+ * Endpoint entries indexed by destination interface address.
+ */
+static RTMIndex_t g_endpointAddrIndex = { .table = NULL };
+
+/**
+ * Oldest time a neighbour interface was alive at, as of the last validity check.
+ * Times only move forward, so no interface can expire before this time plus
+ * GATEWAY_ALIVE_TIMEOUT.
+ */
+static uint64_t g_oldestAliveTime = 0;
+
+static size_t RTMIndexSlotOf(const RTMIndex_t *index, uint32_t key)
+{
+    // Knuth's multiplicative hash, ids are often sequential.
+    return (size_t)(key * 2654435761u) & (index->capacity - 1);
+}
+
+static void *RTMIndexFind(const RTMIndex_t *index, uint32_t key,
+                          RTMIndexMatch_t match, const void *arg)
+{
+    for (size_t i = RTMIndexSlotOf(index, key); NULL != index->slots[i].data;
+         i = (i + 1) & (index->capacity - 1))
+    {
+        if (key == index->slots[i].key && (NULL == match || match(index->slots[i].data, arg)))
+        {
+            return index->slots[i].data;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Keeps the first entry of the table for a key, as a walk over the table would find it.
+ * Entries with the same key are kept if match is given, to be told apart by match.
+ */
+static bool RTMIndexBuild(RTMIndex_t *index, const u_linklist_t *table, RTMIndexKey_t getKey,
+                          RTMIndexMatch_t match)
+{
+    size_t capacity = RTM_INDEX_MIN_CAPACITY;
+    while (capacity < 2 * u_linklist_length(table))
+    {
+        capacity *= 2;
+    }
+
+    if (capacity != index->capacity)
+    {
+        RTMIndexSlot_t *slots = (RTMIndexSlot_t *) OICCalloc(capacity, sizeof(RTMIndexSlot_t));
+        if (NULL == slots)
+        {
+            OIC_LOG(ERROR, TAG, "Calloc failed for index slots");
+            return false;
+        }
+        OICFree(index->slots);
+        index->slots = slots;
+        index->capacity = capacity;
+    }
+    else
+    {
+        memset(index->slots, 0, capacity * sizeof(RTMIndexSlot_t));
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(table, &iterTable);
+    while (NULL != iterTable)
+    {
+        void *data = u_linklist_get_data(iterTable);
+        u_linklist_get_next(&iterTable);
+
+        if (NULL == data)
+        {
+            continue;
+        }
+
+        uint32_t key = getKey(data);
+        if (NULL == match && NULL != RTMIndexFind(index, key, NULL, NULL))
+        {
+            continue;
+        }
+
+        size_t i = RTMIndexSlotOf(index, key);
+        while (NULL != index->slots[i].data)
+        {
+            i = (i + 1) & (index->capacity - 1);
+        }
+        index->slots[i].key = key;
+        index->slots[i].data = data;
+    }
+
+    index->table = table;
+    index->isValid = true;
+    return true;
+}
+
+/*
+ * Returns false if the index can't be built, in which case the table is walked instead.
+ */
+static bool RTMIndexPrepare(RTMIndex_t *index, const u_linklist_t *table, RTMIndexKey_t getKey,
+                            RTMIndexMatch_t match)
+{
+    if (index->isValid && index->table == table)
+    {
+        return true;
+    }
+    return RTMIndexBuild(index, table, getKey, match);
+}
+
+static void RTMIndexFree(RTMIndex_t *index)
+{
+    OICFree(index->slots);
+    index->slots = NULL;
+    index->capacity = 0;
+    index->table = NULL;
+    index->isValid = false;
+}
+
+static void RTMInvalidateGatewayIndex()
+{
+    g_gatewayIndex.isValid = false;
+}
+
+static void RTMInvalidateEndpointIndexes()
+{
+    g_endpointIdIndex.isValid = false;
+    g_endpointAddrIndex.isValid = false;
+}
+
+static uint32_t RTMGetGatewayEntryKey(const void *data)
+{
+    const RTMGatewayEntry_t *entry = (const RTMGatewayEntry_t *) data;
+    return (NULL != entry->destination) ? entry->destination->gatewayId : 0;
+}
+
+static uint32_t RTMGetEndpointIdKey(const void *data)
+{
+    return ((const RTMEndpointEntry_t *) data)->endpointId;
+}
+
+static uint32_t RTMHashAddress(const CAEndpoint_t *addr)
+{
+    // FNV-1a over the address and the port.
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(addr->addr) && '\0' != addr->addr[i]; i++)
+    {
+        hash = (hash ^ (uint8_t) addr->addr[i]) * 16777619u;
+    }
+    hash = (hash ^ (uint8_t) (addr->port & 0xFF)) * 16777619u;
+    hash = (hash ^ (uint8_t) (addr->port >> 8)) * 16777619u;
+    return hash;
+}
+
+static uint32_t RTMGetEndpointAddrKey(const void *data)
+{
+    return RTMHashAddress(&((const RTMEndpointEntry_t *) data)->destIntfAddr);
+}
+
+static bool RTMIsSameEndpointAddr(const void *data, const void *arg)
+{
+    const CAEndpoint_t *entryAddr = &((const RTMEndpointEntry_t *) data)->destIntfAddr;
+    const CAEndpoint_t *addr = (const CAEndpoint_t *) arg;
+    return 0 == strncmp(entryAddr->addr, addr->addr, sizeof(addr->addr))
+           && entryAddr->port == addr->port;
+}
+
+/*
+ * Finds the entry with given gateway id as destination.
+ */
+static RTMGatewayEntry_t *RTMFindGatewayEntry(uint32_t gatewayId, const u_linklist_t *gatewayTable)
+{
+    if (RTMIndexPrepare(&g_gatewayIndex, gatewayTable, RTMGetGatewayEntryKey, NULL))
+    {
+        RTMGatewayEntry_t *entry = RTMIndexFind(&g_gatewayIndex, gatewayId, NULL, NULL);
+        return (NULL != entry && NULL != entry->destination) ? entry : NULL;
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(gatewayTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && NULL != entry->destination &&
+            gatewayId == entry->destination->gatewayId)
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
+/*
+ * Finds the endpoint entry with given endpoint id.
+ */
+static RTMEndpointEntry_t *RTMFindEndpointEntry(uint16_t endpointId,
+                                                const u_linklist_t *endpointTable)
+{
+    if (RTMIndexPrepare(&g_endpointIdIndex, endpointTable, RTMGetEndpointIdKey, NULL))
+    {
+        return RTMIndexFind(&g_endpointIdIndex, endpointId, NULL, NULL);
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(endpointTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && endpointId == entry->endpointId)
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
+/*
+ * Finds the endpoint entry with given destination interface address.
+ */
+static RTMEndpointEntry_t *RTMFindEndpointEntryByAddr(const CAEndpoint_t *destAddr,
+                                                      const u_linklist_t *endpointTable)
+{
+    if (RTMIndexPrepare(&g_endpointAddrIndex, endpointTable, RTMGetEndpointAddrKey,
+                        RTMIsSameEndpointAddr))
+    {
+        return RTMIndexFind(&g_endpointAddrIndex, RTMHashAddress(destAddr),
+                            RTMIsSameEndpointAddr, destAddr);
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(endpointTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && RTMIsSameEndpointAddr(entry, destAddr))
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
 OCStackResult RTMInitialize(u_linklist_t **gatewayTable, u_linklist_t **endpointTable)
 {
     OIC_LOG(DEBUG, TAG, "RTMInitialize IN");
@@ -77,6 +366,8 @@ OCStackResult RTMFreeGatewayRouteTable(u_linklist_t **gatewayTable)
         return OC_STACK_OK;
     }
 
+    RTMInvalidateGatewayIndex();
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -121,6 +412,8 @@ OCStackResult RTMFreeEndpointRouteTable(u_linklist_t **endpointTable)
         return OC_STACK_OK;
     }
 
+    RTMInvalidateEndpointIndexes();
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*endpointTable, &iterTable);
     while (NULL != iterTable)
@@ -213,6 +506,11 @@ OCStackResult RTMTerminate(u_linklist_t **gatewayTable, u_linklist_t **endpointT
     {
         *endpointTable = NULL;
     }
+
+    RTMIndexFree(&g_gatewayIndex);
+    RTMIndexFree(&g_endpointIdIndex);
+    RTMIndexFree(&g_endpointAddrIndex);
+    g_oldestAliveTime = 0;
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
 }
@@ -486,6 +784,7 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
             OICFree(hopEntry);
             return OC_STACK_ERROR;
         }
+        RTMInvalidateGatewayIndex();
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -508,23 +807,12 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
         }
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*endpointTable, &iterTable);
-    // Iterate over gateway list to find if already entry with this gatewayid is present.
-    while (NULL != iterTable)
+    RTMEndpointEntry_t *entry = RTMFindEndpointEntryByAddr(destAddr, *endpointTable);
+    if (NULL != entry)
     {
-        RTMEndpointEntry_t *entry =
-            (RTMEndpointEntry_t *) u_linklist_get_data(iterTable);
-
-        if (NULL != entry && (0 == memcmp(destAddr->addr, entry->destIntfAddr.addr,
-                              strlen(entry->destIntfAddr.addr)))
-            && destAddr->port == entry->destIntfAddr.port)
-        {
-            *endpointId = entry->endpointId;
-            OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
-            return OC_STACK_DUPLICATE_REQUEST;
-        }
-        u_linklist_get_next(&iterTable);
+        *endpointId = entry->endpointId;
+        OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
+        return OC_STACK_DUPLICATE_REQUEST;
     }
 
     // Filling Entry.
@@ -546,6 +834,7 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
        OICFree(hopEntry);
        return OC_STACK_ERROR;
     }
+    RTMInvalidateEndpointIndexes();
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
 }
@@ -659,6 +948,7 @@ OCStackResult RTMRemoveGatewayEntry(uint32_t gatewayId, u_linklist_t **removedGa
             (gatewayId == entry->nextHop->gatewayId)))
         {
             OIC_LOG_V(DEBUG, TAG, "Removing the gateway entry: %u", entry->destination->gatewayId);
+            RTMInvalidateGatewayIndex();
             ret = u_linklist_remove(*gatewayTable, &iterTable);
             if (OC_STACK_OK != ret)
             {
@@ -727,6 +1017,7 @@ OCStackResult RTMRemoveGatewayDestEntry(uint32_t gatewayId, uint32_t nextHop,
             OIC_LOG_V(INFO, TAG, "Remove the gateway ID: %u", entry->destination->gatewayId);
             if (NULL != entry->nextHop && nextHop == entry->nextHop->gatewayId)
             {
+                RTMInvalidateGatewayIndex();
                 ret = u_linklist_remove(*gatewayTable, &iterTable);
                 if (OC_STACK_OK != ret)
                 {
@@ -761,6 +1052,7 @@ OCStackResult RTMRemoveEndpointEntry(uint16_t endpointId, u_linklist_t **endpoin
         RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
         if (NULL !=  entry && endpointId == entry->endpointId)
         {
+            RTMInvalidateEndpointIndexes();
             OCStackResult ret = u_linklist_remove(*endpointTable, &iterTable);
             if (OC_STACK_OK != ret)
             {
@@ -880,22 +1172,16 @@ RTMGatewayId_t *RTMGetNextHop(uint32_t gatewayId, const u_linklist_t *gatewayTab
         return NULL;
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && gatewayId == entry->destination->gatewayId)
+        if (1 == entry->routeCost)
         {
-            if (1 == entry->routeCost)
-            {
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return entry->destination;
-            }
             OIC_LOG(DEBUG, TAG, "OUT");
-            return entry->nextHop;
+            return entry->destination;
         }
-        u_linklist_get_next(&iterTable);
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return entry->nextHop;
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return NULL;
@@ -910,18 +1196,11 @@ CAEndpoint_t *RTMGetEndpointEntry(uint16_t endpointId, const u_linklist_t *endpo
         return NULL;
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(endpointTable, &iterTable);
-
-    while (NULL != iterTable)
+    RTMEndpointEntry_t *entry = RTMFindEndpointEntry(endpointId, endpointTable);
+    if (NULL != entry)
     {
-        RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && (endpointId == entry->endpointId))
-        {
-            OIC_LOG(DEBUG, TAG, "OUT");
-            return &(entry->destIntfAddr);
-        }
-        u_linklist_get_next(&iterTable);
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return &(entry->destIntfAddr);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return NULL;
@@ -978,79 +1257,72 @@ OCStackResult RTMUpdateDestinationIntfAdr(uint32_t gatewayId, RTMDestIntfInfo_t
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && NULL != entry->destination &&
-            gatewayId == entry->destination->gatewayId)
+        if (addAdr)
         {
-            if (addAdr)
+            for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
             {
-                for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+                RTMDestIntfInfo_t *destCheck =
+                    u_arraylist_get(entry->destination->destIntfAddr, i);
+                if (NULL == destCheck)
                 {
-                    RTMDestIntfInfo_t *destCheck =
-                        u_arraylist_get(entry->destination->destIntfAddr, i);
-                    if (NULL == destCheck)
-                    {
-                        OIC_LOG(ERROR, TAG, "Destination adr get failed");
-                        continue;
-                    }
-
-                    if (0 == memcmp(destCheck->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
-                        strlen(destInterfaces.destIntfAddr.addr))
-                        && destInterfaces.destIntfAddr.port == destCheck->destIntfAddr.port)
-                    {
-                        destCheck->timeElapsed = RTMGetCurrentTime();
-                        destCheck->isValid = true;
-                        OIC_LOG(ERROR, TAG, "destInterfaces already present");
-                        return OC_STACK_ERROR;
-                    }
+                    OIC_LOG(ERROR, TAG, "Destination adr get failed");
+                    continue;
                 }
 
-                RTMDestIntfInfo_t *destAdr =
-                        (RTMDestIntfInfo_t *) OICCalloc(1, sizeof(RTMDestIntfInfo_t));
-                if (NULL == destAdr)
-                {
-                    OIC_LOG(ERROR, TAG, "Calloc destAdr failed");
-                    return OC_STACK_ERROR;
-                }
-                *destAdr = destInterfaces;
-                destAdr->timeElapsed = RTMGetCurrentTime();
-                destAdr->isValid = true;
-                bool result =
-                    u_arraylist_add(entry->destination->destIntfAddr, (void *)destAdr);
-                if (!result)
+                if (0 == memcmp(destCheck->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
+                    strlen(destInterfaces.destIntfAddr.addr))
+                    && destInterfaces.destIntfAddr.port == destCheck->destIntfAddr.port)
                 {
-                    OIC_LOG(ERROR, TAG, "Updating Destinterface address failed");
-                    OICFree(destAdr);
+                    destCheck->timeElapsed = RTMGetCurrentTime();
+                    destCheck->isValid = true;
+                    OIC_LOG(ERROR, TAG, "destInterfaces already present");
                     return OC_STACK_ERROR;
                 }
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return OC_STACK_DUPLICATE_REQUEST;
             }
 
-            for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+            RTMDestIntfInfo_t *destAdr =
+                    (RTMDestIntfInfo_t *) OICCalloc(1, sizeof(RTMDestIntfInfo_t));
+            if (NULL == destAdr)
             {
-                RTMDestIntfInfo_t *removeAdr =
-                    u_arraylist_get(entry->destination->destIntfAddr, i);
-                if (!removeAdr)
-                {
-                    continue;
-                }
-                if (0 == memcmp(removeAdr->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
-                    strlen(destInterfaces.destIntfAddr.addr))
-                    && destInterfaces.destIntfAddr.port == removeAdr->destIntfAddr.port)
-                {
-                    RTMDestIntfInfo_t *data =
-                        u_arraylist_remove(entry->destination->destIntfAddr, i);
-                    OICFree(data);
-                    break;
-                }
+                OIC_LOG(ERROR, TAG, "Calloc destAdr failed");
+                return OC_STACK_ERROR;
+            }
+            *destAdr = destInterfaces;
+            destAdr->timeElapsed = RTMGetCurrentTime();
+            destAdr->isValid = true;
+            bool result =
+                u_arraylist_add(entry->destination->destIntfAddr, (void *)destAdr);
+            if (!result)
+            {
+                OIC_LOG(ERROR, TAG, "Updating Destinterface address failed");
+                OICFree(destAdr);
+                return OC_STACK_ERROR;
+            }
+            OIC_LOG(DEBUG, TAG, "OUT");
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+
+        for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+        {
+            RTMDestIntfInfo_t *removeAdr =
+                u_arraylist_get(entry->destination->destIntfAddr, i);
+            if (!removeAdr)
+            {
+                continue;
+            }
+            if (0 == memcmp(removeAdr->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
+                strlen(destInterfaces.destIntfAddr.addr))
+                && destInterfaces.destIntfAddr.port == removeAdr->destIntfAddr.port)
+            {
+                RTMDestIntfInfo_t *data =
+                    u_arraylist_remove(entry->destination->destIntfAddr, i);
+                OICFree(data);
+                break;
             }
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -1063,29 +1335,22 @@ OCStackResult RTMUpdateMcastSeqNumber(uint32_t gatewayId, uint16_t seqNum,
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && NULL != entry->destination &&
-            gatewayId == entry->destination->gatewayId)
+        if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
         {
-            if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
-            {
-                entry->mcastMessageSeqNum = seqNum;
-                return OC_STACK_OK;
-            }
-            else if (entry->mcastMessageSeqNum == seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else
-            {
-                return OC_STACK_COMM_ERROR;
-            }
+            entry->mcastMessageSeqNum = seqNum;
+            return OC_STACK_OK;
+        }
+        else if (entry->mcastMessageSeqNum == seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else
+        {
+            return OC_STACK_COMM_ERROR;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -1132,6 +1397,14 @@ OCStackResult RTMUpdateDestAddrValidity(u_linklist_t **invalidTable, u_linklist_
     u_linklist_iterator_t *iterTable = NULL;
     uint64_t presentTime = RTMGetCurrentTime();
 
+    // Skips the walk while even the oldest interface can't have expired.
+    if (GATEWAY_ALIVE_TIMEOUT >= presentTime - g_oldestAliveTime)
+    {
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return OC_STACK_OK;
+    }
+
+    uint64_t oldestAliveTime = presentTime;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
     {
@@ -1155,6 +1428,10 @@ OCStackResult RTMUpdateDestAddrValidity(u_linklist_t **invalidTable, u_linklist_
                     destCheck->isValid = false;
                     u_linklist_add(*invalidTable, (void *)destCheck);
                 }
+                if (destCheck->timeElapsed < oldestAliveTime)
+                {
+                    oldestAliveTime = destCheck->timeElapsed;
+                }
             }
         }
         else if (1 < entry->routeCost)
@@ -1163,6 +1440,7 @@ OCStackResult RTMUpdateDestAddrValidity(u_linklist_t **invalidTable, u_linklist_
         }
         u_linklist_get_next(&iterTable);
     }
+    g_oldestAliveTime = oldestAliveTime;
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
 }
@@ -1244,49 +1522,37 @@ OCStackResult RTMUpdateEntryParameters(uint32_t gatewayId, uint32_t seqNum,
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
     RM_NULL_CHECK_WITH_RET(destAdr, TAG, "destAdr");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-
-        if (NULL == entry)
-        {
-            u_linklist_get_next(&iterTable);
-            continue;
-        }
-        if (NULL != entry->destination && gatewayId == entry->destination->gatewayId)
+        for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
         {
-            for (size_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+            RTMDestIntfInfo_t *destCheck =
+                u_arraylist_get(entry->destination->destIntfAddr, i);
+            if (NULL != destCheck &&
+                (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
+                 strlen(destAdr->destIntfAddr.addr)))
+                 && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
             {
-                RTMDestIntfInfo_t *destCheck =
-                    u_arraylist_get(entry->destination->destIntfAddr, i);
-                if (NULL != destCheck &&
-                    (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
-                     strlen(destAdr->destIntfAddr.addr)))
-                     && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
-                {
-                    destCheck->timeElapsed = RTMGetCurrentTime();
-                    destCheck->isValid = true;
-                }
+                destCheck->timeElapsed = RTMGetCurrentTime();
+                destCheck->isValid = true;
             }
+        }
 
-            if (0 != entry->seqNum && seqNum == entry->seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
-            {
-                return OC_STACK_COMM_ERROR;
-            }
-            else
-            {
-                entry->seqNum = seqNum;
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return OC_STACK_OK;
-            }
+        if (0 != entry->seqNum && seqNum == entry->seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
+        {
+            return OC_STACK_COMM_ERROR;
+        }
+        else
+        {
+            entry->seqNum = seqNum;
+            OIC_LOG(DEBUG, TAG, "OUT");
+            return OC_STACK_OK;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
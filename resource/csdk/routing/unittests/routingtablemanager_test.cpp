@@ -0,0 +1,253 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "routingtablemanager.h"
+#include "oic_malloc.h"
+
+static CAEndpoint_t MakeAddress(const char *addr, uint16_t port)
+{
+    CAEndpoint_t endpoint = CAEndpoint_t();
+    endpoint.adapter = CA_ADAPTER_IP;
+    strncpy(endpoint.addr, addr, sizeof(endpoint.addr) - 1);
+    endpoint.port = port;
+    return endpoint;
+}
+
+static RTMDestIntfInfo_t MakeInterface(uint32_t gatewayId)
+{
+    char addr[MAX_ADDR_STR_SIZE_CA];
+    snprintf(addr, sizeof(addr), "192.168.1.%u", gatewayId);
+
+    RTMDestIntfInfo_t destInterface = RTMDestIntfInfo_t();
+    destInterface.destIntfAddr = MakeAddress(addr, 5683);
+    return destInterface;
+}
+
+/*
+ * Finds the first entry of the table for gatewayId by walking the list, which is
+ * what the indexed lookups must agree with.
+ */
+static RTMGatewayEntry_t *WalkGatewayTable(uint32_t gatewayId, const u_linklist_t *gatewayTable)
+{
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(gatewayTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMGatewayEntry_t *entry = (RTMGatewayEntry_t *) u_linklist_get_data(iterTable);
+        if (NULL != entry && NULL != entry->destination &&
+            gatewayId == entry->destination->gatewayId)
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
+class RoutingTableManagerTest : public testing::Test
+{
+    public:
+        RoutingTableManagerTest()
+            : m_gatewayTable(NULL)
+            , m_endpointTable(NULL)
+        {
+        }
+
+    protected:
+        virtual void SetUp()
+        {
+            ASSERT_EQ(OC_STACK_OK, RTMInitialize(&m_gatewayTable, &m_endpointTable));
+        }
+
+        virtual void TearDown()
+        {
+            RTMTerminate(&m_gatewayTable, &m_endpointTable);
+        }
+
+        void AddNeighbour(uint32_t gatewayId)
+        {
+            RTMDestIntfInfo_t destInterface = MakeInterface(gatewayId);
+            ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(gatewayId, 0, 1, &destInterface,
+                                                      &m_gatewayTable));
+        }
+
+        u_linklist_t *m_gatewayTable;
+        u_linklist_t *m_endpointTable;
+};
+
+TEST_F(RoutingTableManagerTest, GatewayLookupSeesAddAndRemove)
+{
+    const uint32_t numOfNeighbours = 20;
+    for (uint32_t id = 1; id <= numOfNeighbours; id++)
+    {
+        AddNeighbour(id);
+    }
+    for (uint32_t id = 1; id <= numOfNeighbours; id++)
+    {
+        RTMGatewayId_t *nextHop = RTMGetNextHop(id, m_gatewayTable);
+        ASSERT_TRUE(NULL != nextHop);
+        EXPECT_EQ(id, nextHop->gatewayId);
+    }
+    EXPECT_EQ(NULL, RTMGetNextHop(100, m_gatewayTable));
+
+    // Added after the lookups above built the index.
+    ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(100, 3, 2, NULL, &m_gatewayTable));
+    RTMGatewayId_t *nextHop = RTMGetNextHop(100, m_gatewayTable);
+    ASSERT_TRUE(NULL != nextHop);
+    EXPECT_EQ(3u, nextHop->gatewayId);
+
+    // A cheaper route updates the entry in place.
+    ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(101, 4, 3, NULL, &m_gatewayTable));
+    ASSERT_EQ(OC_STACK_OK, RTMAddGatewayEntry(101, 5, 2, NULL, &m_gatewayTable));
+    nextHop = RTMGetNextHop(101, m_gatewayTable);
+    ASSERT_TRUE(NULL != nextHop);
+    EXPECT_EQ(5u, nextHop->gatewayId);
+
+    // Removing gateway 3 removes the routes through it too.
+    u_linklist_t *removedGatewayNodes = NULL;
+    ASSERT_EQ(OC_STACK_OK, RTMRemoveGatewayEntry(3, &removedGatewayNodes, &m_gatewayTable));
+    EXPECT_EQ(2, u_linklist_length(removedGatewayNodes));
+    RTMFreeGatewayRouteTable(&removedGatewayNodes);
+
+    EXPECT_EQ(NULL, RTMGetNextHop(3, m_gatewayTable));
+    EXPECT_EQ(NULL, RTMGetNextHop(100, m_gatewayTable));
+    for (uint32_t id = 1; id <= numOfNeighbours; id++)
+    {
+        if (3 != id)
+        {
+            nextHop = RTMGetNextHop(id, m_gatewayTable);
+            ASSERT_TRUE(NULL != nextHop);
+            EXPECT_EQ(id, nextHop->gatewayId);
+        }
+    }
+
+    // Added again under the same id.
+    AddNeighbour(3);
+    nextHop = RTMGetNextHop(3, m_gatewayTable);
+    ASSERT_TRUE(NULL != nextHop);
+    EXPECT_EQ(3u, nextHop->gatewayId);
+}
+
+TEST_F(RoutingTableManagerTest, DuplicateGatewayIdsKeepListOrder)
+{
+    AddNeighbour(1);
+    AddNeighbour(2);
+    RTMGatewayId_t *hop1 = WalkGatewayTable(1, m_gatewayTable)->destination;
+    RTMGatewayId_t *hop2 = WalkGatewayTable(2, m_gatewayTable)->destination;
+
+    // Two routes to gateway 7 in the table, the first one through gateway 2.
+    const RTMGatewayId_t *hops[] = { hop2, hop1 };
+    for (size_t i = 0; i < sizeof(hops) / sizeof(hops[0]); i++)
+    {
+        RTMGatewayEntry_t *entry = (RTMGatewayEntry_t *) OICCalloc(1, sizeof(RTMGatewayEntry_t));
+        ASSERT_TRUE(NULL != entry);
+        entry->destination = (RTMGatewayId_t *) OICCalloc(1, sizeof(RTMGatewayId_t));
+        ASSERT_TRUE(NULL != entry->destination);
+        entry->destination->gatewayId = 7;
+        entry->nextHop = (RTMGatewayId_t *) hops[i];
+        entry->routeCost = 2;
+        ASSERT_EQ(OC_STACK_OK, u_linklist_add(m_gatewayTable, entry));
+    }
+
+    // The index answers like the walk over the list: the first entry wins.
+    RTMGatewayId_t *nextHop = RTMGetNextHop(7, m_gatewayTable);
+    ASSERT_TRUE(NULL != nextHop);
+    EXPECT_EQ(WalkGatewayTable(7, m_gatewayTable)->nextHop, nextHop);
+    EXPECT_EQ(2u, nextHop->gatewayId);
+
+    // Still the first entry once the index is rebuilt after a change.
+    AddNeighbour(3);
+    nextHop = RTMGetNextHop(7, m_gatewayTable);
+    ASSERT_TRUE(NULL != nextHop);
+    EXPECT_EQ(2u, nextHop->gatewayId);
+}
+
+TEST_F(RoutingTableManagerTest, EndpointLookupSeesAddAndRemove)
+{
+    const uint16_t numOfEndpoints = 40;
+    for (uint16_t id = 1; id <= numOfEndpoints; id++)
+    {
+        char addr[MAX_ADDR_STR_SIZE_CA];
+        snprintf(addr, sizeof(addr), "10.0.0.%u", id);
+        CAEndpoint_t destAddr = MakeAddress(addr, 5683);
+        uint16_t endpointId = id;
+        ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &destAddr, &m_endpointTable));
+    }
+    for (uint16_t id = 1; id <= numOfEndpoints; id++)
+    {
+        ASSERT_TRUE(NULL != RTMGetEndpointEntry(id, m_endpointTable));
+    }
+
+    ASSERT_EQ(OC_STACK_OK, RTMRemoveEndpointEntry(10, &m_endpointTable));
+    EXPECT_EQ(NULL, RTMGetEndpointEntry(10, m_endpointTable));
+    CAEndpoint_t *endpoint = RTMGetEndpointEntry(11, m_endpointTable);
+    ASSERT_TRUE(NULL != endpoint);
+    EXPECT_STREQ("10.0.0.11", endpoint->addr);
+
+    // The address of the removed entry is free again.
+    CAEndpoint_t destAddr = MakeAddress("10.0.0.10", 5683);
+    uint16_t endpointId = 50;
+    ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &destAddr, &m_endpointTable));
+    endpoint = RTMGetEndpointEntry(50, m_endpointTable);
+    ASSERT_TRUE(NULL != endpoint);
+    EXPECT_STREQ("10.0.0.10", endpoint->addr);
+
+    // An address already in the table gives back its endpoint id.
+    destAddr = MakeAddress("10.0.0.20", 5683);
+    endpointId = 60;
+    EXPECT_EQ(OC_STACK_DUPLICATE_REQUEST,
+              RTMAddEndpointEntry(&endpointId, &destAddr, &m_endpointTable));
+    EXPECT_EQ(20, endpointId);
+}
+
+TEST_F(RoutingTableManagerTest, EndpointAddressIsComparedExactly)
+{
+    CAEndpoint_t longAddr = MakeAddress("10.0.0.12", 5683);
+    uint16_t endpointId = 1;
+    ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &longAddr, &m_endpointTable));
+
+    // A prefix of a known address is another endpoint.
+    CAEndpoint_t shortAddr = MakeAddress("10.0.0.1", 5683);
+    endpointId = 2;
+    ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &shortAddr, &m_endpointTable));
+
+    // So is the same address on another port.
+    CAEndpoint_t otherPort = MakeAddress("10.0.0.1", 5684);
+    endpointId = 3;
+    ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &otherPort, &m_endpointTable));
+
+    endpointId = 4;
+    EXPECT_EQ(OC_STACK_DUPLICATE_REQUEST,
+              RTMAddEndpointEntry(&endpointId, &shortAddr, &m_endpointTable));
+    EXPECT_EQ(2, endpointId);
+
+    CAEndpoint_t *endpoint = RTMGetEndpointEntry(1, m_endpointTable);
+    ASSERT_TRUE(NULL != endpoint);
+    EXPECT_STREQ("10.0.0.12", endpoint->addr);
+    endpoint = RTMGetEndpointEntry(2, m_endpointTable);
+    ASSERT_TRUE(NULL != endpoint);
+    EXPECT_STREQ("10.0.0.1", endpoint->addr);
+    EXPECT_EQ(5683, endpoint->port);
+}
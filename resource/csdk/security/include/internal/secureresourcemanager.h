@@ -28,6 +28,8 @@
 extern "C" {
 #endif
 
+struct OCResource;
+
 typedef enum SubjectIdentityType
 {
     SUBJECT_ID_TYPE_ERROR = 0,
@@ -44,6 +46,8 @@ typedef struct SRMRequestContext
     const CAEndpoint_t      *endPoint;                          // ptr to the Endpoint for this request
     OicSecSvrType_t         resourceType;                       // SVR type (or "not an SVR")
     char                    resourceUri[MAX_URI_LENGTH + 1];    // URI of the requested resource
+    struct OCResource       *resource;                          // The requested resource, or NULL
+                                                                // if it is not found.
     uint16_t                requestedPermission;                // bitmask permissions of request
     CAResponseInfo_t        responseInfo;                       // The response for this request
     bool                    responseSent;                       // Is servicing this request complete?
@@ -123,6 +127,14 @@ typedef bool (*SPResponseCallback) (const CAEndpoint_t *object,
  */
 OicSecSvrType_t GetSvrTypeFromUri(const char* uri);
 
+/**
+ * Get the resource resolved by SRM for the request which SRM is passing to the stack.
+ * @param[in]   uri URI of the requested resource, without query.
+ * @return  The requested resource, or NULL if there is no such request or the resource
+ *          was not found. The stack must then look up the resource itself.
+ */
+struct OCResource *SRMGetRequestedResource(const char* uri);
+
 extern const OicSecRole_t EMPTY_ROLE;
 
 /**
@@ -35,6 +35,7 @@ extern "C" {
 
 typedef struct OTMCallbackData OTMCallbackData_t;
 typedef struct OTMContext OTMContext_t;
+typedef struct OTMBatch OTMBatch_t;
 
 /**
  * Do ownership transfer for the unowned devices.
@@ -47,6 +48,22 @@ typedef struct OTMContext OTMContext_t;
 OCStackResult OTMDoOwnershipTransfer(void* ctx,
                                      OCProvisionDev_t* selectedDeviceList, OCProvisionResultCB resultCB);
 
+/**
+ * Do ownership transfer for the unowned devices, keeping up to windowSize devices in progress.
+ *
+ * @param[in] ctx Application context would be returned in callbacks
+ * @param[in] selectedDeviceList linked list of ownership transfer candidate devices.
+ * @param[in] windowSize Maximum number of devices in progress at a time.
+ * @param[in] progressCB Callback function to be invoked whenever a device finishes, can be NULL.
+ * @param[in] resultCB Result callback function to be invoked when ownership transfer finished.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OTMDoOwnershipTransferConcurrently(void* ctx,
+                                                 OCProvisionDev_t* selectedDeviceList,
+                                                 size_t windowSize,
+                                                 OCOwnershipTransferProgressCB progressCB,
+                                                 OCProvisionResultCB resultCB);
+
 /**
  * API to set a allow status of OxM
  *
@@ -106,6 +123,7 @@ struct OTMContext{
     OicSecCred_t* cred;                       /**< Credential data. */
 #endif // MULTIPLE_OWNER
     int attemptCnt;
+    OTMBatch_t* batch;                        /**< Concurrent OT the device belongs to, or NULL. */
 };
 
 // TODO: Remove this OTMSetOwnershipTransferCallbackData, Please see the jira ticket IOT-1484
@@ -86,6 +86,17 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* uuidOfDevice, bool* result);
  */
 OCStackResult PDMAddDevice(const OicUuid_t* uuidOfDevice);
 
+/**
+ * This method is used by provisioning manager to add several owned devices' Device IDs
+ * in a single transaction. Either all of the devices are added or none of them.
+ *
+ * @param[in] uuidList array of the owned devices' uuids.
+ * @param[in] numOfDevices number of entries of uuidList.
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult PDMAddDevices(const OicUuid_t* uuidList, size_t numOfDevices);
+
 /**
  * This method is used by provisioning manager to update linked status of owned devices.
  *
@@ -96,6 +107,16 @@ OCStackResult PDMAddDevice(const OicUuid_t* uuidOfDevice);
  */
 OCStackResult PDMLinkDevices(const OicUuid_t *uuidOfDevice1, const OicUuid_t *uuidOfDevice2);
 
+/**
+ * This method is used by provisioning manager to link several pairs of owned devices
+ * in a single transaction. Either all of the pairs are linked or none of them.
+ *
+ * @param[in] pairList list of the pairs of devices to be linked.
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult PDMLinkDevicePairs(const OCPairList_t *pairList);
+
 /**
  * This method is used by provisioning manager to unlink pairwise devices.
  *
@@ -146,6 +167,20 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t** uuidList, size_t* numOfDevices);
 OCStackResult PDMGetLinkedDevices(const OicUuid_t* uuidOfDevice, OCUuidList_t** uuidList,
                                     size_t* numOfDevices);
 
+/**
+ * This method is used by provisioning manager to get the linked devices of several devices
+ * at once. Each pair of the list holds a device of uuidList and one of its linked devices.
+ *
+ * @param[in] uuidList list of the target devices' uuids.
+ * @param[out] pairList list of the pairs of linked devices, to be freed by
+ *                      PDMDestoryStaleLinkList().
+ * @param[out] numOfPairs total number of pairs.
+ *
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult PDMGetLinkedDevicePairs(const OCUuidList_t* uuidList, OCPairList_t** pairList,
+                                      size_t* numOfPairs);
+
 /**
  * This method is used by provisioning manager to update linked status as stale.
  *
@@ -118,6 +118,29 @@ OCStackResult OC_CALL OCDoOwnershipTransfer(void* ctx,
                                     OCProvisionDev_t *targetDevices,
                                     OCProvisionResultCB resultCallback);
 
+/**
+ * Do ownership transfer for un-owned devices concurrently.
+ * Up to windowSize devices are in progress at a time, and the next device is started
+ * as soon as a device finishes. The handshakes of the temporal and the owner credential
+ * sessions still take turns, as they change the (D)TLS settings of the stack, also with
+ * the devices of OCDoOwnershipTransfer running at the same time.
+ * A failure of a device does not affect the others.
+ *
+ * @param[in] ctx Application context would be returned in callbacks
+ * @param[in] targetDevices List of devices to perform ownership transfer.
+ * @param[in] windowSize Maximum number of devices in progress at a time.
+ * @param[in] progressCallback Callback function to be invoked whenever a device finishes,
+ *                             it can be NULL.
+ * @param[in] resultCallback Result callback function to be invoked when ownership transfer
+ *                           of all devices finished.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCDoOwnershipTransferConcurrently(void* ctx,
+                                    OCProvisionDev_t *targetDevices,
+                                    size_t windowSize,
+                                    OCOwnershipTransferProgressCB progressCallback,
+                                    OCProvisionResultCB resultCallback);
+
 /**
  * API to set a allow status of OxM
  *
@@ -162,6 +185,34 @@ OCStackResult OC_CALL OCSetOwnerTransferCallbackData(OicSecOxm_t oxm, OTMCallbac
  */
 OCStackResult OC_CALL OCDiscoverOwnedDevices(unsigned short timeout, OCProvisionDev_t **ppList);
 
+/**
+ * The function is responsible for incremental discovery of owned or unowned devices in current
+ * subnet. Each device is reported to discoveredCallback as soon as its doxm, secure port and
+ * spec version are resolved, and the follow-up queries of the devices run concurrently.
+ * The function returns before the timeout once all expected devices, or the expected number of
+ * devices, are resolved.
+ *
+ * @param[in] timeout Timeout in seconds, value till which function will listen to responses from
+ *                    server if the expected devices are not resolved.
+ * @param[in] isOwned true to discover the devices owned by calling provisioning client,
+ *                    false to discover unowned devices.
+ * @param[in] expectedIds deviceIDs of the expected devices. It can be NULL.
+ * @param[in] nOfExpectedIds Number of expectedIds.
+ * @param[in] expectedCount Number of expected devices, 0 to wait for the timeout unless
+ *                          expectedIds are resolved.
+ * @param[in] ctx Application context returned in discoveredCallback.
+ * @param[in] discoveredCallback Callback invoked for each resolved device. It can be NULL.
+ * @param[out] ppList List of discovered devices, including the ones reported to
+ *                    discoveredCallback.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCDiscoverDevicesIncrementally(unsigned short timeout, bool isOwned,
+                                                     const OicUuid_t *expectedIds,
+                                                     size_t nOfExpectedIds, size_t expectedCount,
+                                                     void *ctx,
+                                                     OCDeviceDiscoveredCB discoveredCallback,
+                                                     OCProvisionDev_t **ppList);
+
 #ifdef MULTIPLE_OWNER
 /**
  * The function is responsible for the discovery of an MOT-enabled device with the specified deviceID.
@@ -228,6 +279,31 @@ OCStackResult OC_CALL OCProvisionPairwiseDevices(void* ctx, OicSecCredType_t typ
                                          const OCProvisionDev_t *pDev2, OicSecAcl_t *pDev2Acl,
                                          OCProvisionResultCB resultCallback);
 
+/**
+ * API to run a provisioning plan of ACLs and credentials over several devices.
+ * The steps of a device run in the order of the plan, so they reuse the secure session
+ * to the device. The steps on different devices run concurrently, up to windowSize steps
+ * at a time, and the next step is started as soon as a step finishes.
+ * A failure of a step does not affect the others.
+ * As with OCProvisionPairwiseDevices, a credentials step of two devices which are already
+ * linked fails, and the devices are linked in the PDM when the step succeeds.
+ *
+ * e.g. pairing N devices is a credentials step and up to two ACL steps per pair, taking
+ * about N round trips instead of N^2.
+ *
+ * @param[in] ctx Application context returned in the callbacks.
+ * @param[in] plan Array of the steps to run, which must be kept until the result callback.
+ * @param[in] nOfSteps Number of steps of the plan.
+ * @param[in] windowSize Maximum number of steps in progress at a time.
+ * @param[in] progressCallback Callback invoked whenever a step finishes, it can be NULL.
+ * @param[in] resultCallback Callback invoked once with the results and timings of all steps.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCProvisionPlan(void* ctx, const OCProvisionStep_t *plan, size_t nOfSteps,
+                                      size_t windowSize,
+                                      OCProvisionStepProgressCB progressCallback,
+                                      OCProvisionPlanResultCB resultCallback);
+
 /**
  * API to send version 1 ACL information to device.
  *
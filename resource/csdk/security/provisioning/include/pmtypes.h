@@ -116,6 +116,42 @@ typedef struct OCPMGetRolesResult
     size_t              chainsLength;   /**< length of chains array (if res is OC_STACK_OK */
 } OCPMGetRolesResult_t;
 
+/**
+ * Type of a step of a provisioning plan.
+ */
+typedef enum OCProvisionStepType
+{
+    OC_PROVISION_STEP_CREDENTIALS = 0,  /**< provisions credentials to pDev1 and pDev2 */
+    OC_PROVISION_STEP_ACL               /**< provisions acl to pDev1 */
+} OCProvisionStepType_t;
+
+/**
+ * Step of a provisioning plan. The steps of a device run in the order of the plan,
+ * and the steps on different devices run concurrently.
+ */
+typedef struct OCProvisionStep
+{
+    OCProvisionStepType_t   type;       /**< type of the step */
+    const OCProvisionDev_t  *pDev1;     /**< target device */
+    const OCProvisionDev_t  *pDev2;     /**< peer device of credentials, NULL for other steps */
+    OicSecAcl_t             *acl;       /**< ACL to provision, for OC_PROVISION_STEP_ACL */
+    OicSecCredType_t        credType;   /**< type of credentials, for OC_PROVISION_STEP_CREDENTIALS */
+    size_t                  keySize;    /**< key size of pair-wise credentials */
+} OCProvisionStep_t;
+
+/**
+ * Result of a step of a provisioning plan.
+ */
+typedef struct OCProvisionStepResult
+{
+    size_t              stepIndex;      /**< index of the step in the plan */
+    OCStackResult       res;            /**< OC_STACK_OK if all devices of the step succeeded */
+    OCProvisionResult_t devResults[2];  /**< result of pDev1 and pDev2 of the step */
+    size_t              nOfDevResults;  /**< number of valid entries of devResults */
+    uint64_t            startTime;      /**< start of the step, in ms since the plan started */
+    uint64_t            elapsedTime;    /**< duration of the step in ms */
+} OCProvisionStepResult_t;
+
 /**
  * Owner device type
  */
@@ -152,6 +188,51 @@ typedef enum OxmAllowTableIdx {
  */
 typedef void (*OCProvisionResultCB)(void* ctx, size_t nOfRes, OCProvisionResult_t *arr, bool hasError);
 
+/**
+ * Callback function definition of the progress of concurrent ownership transfer
+ *
+ * @param[in] ctx - If user set his/her context, it will be returned here.
+ * @param[in] result - Result of the device whose ownership transfer has just finished.
+ * @param[in] nOfDone - number of devices whose ownership transfer has finished.
+ * @param[in] nOfDevices - total number of devices.
+ */
+typedef void (*OCOwnershipTransferProgressCB)(void* ctx, const OCProvisionResult_t *result,
+                                              size_t nOfDone, size_t nOfDevices);
+
+/**
+ * Callback function definition of incremental device discovery
+ *
+ * @param[in] ctx - If user set his/her context, it will be returned here.
+ * @param[in] device - Device whose doxm, secure port and spec version are resolved. It is
+ *                     an entry of the device list returned by the discovery.
+ */
+typedef void (*OCDeviceDiscoveredCB)(void* ctx, const OCProvisionDev_t *device);
+
+/**
+ * Callback function definition of the progress of a provisioning plan
+ *
+ * @param[in] ctx - If user set his/her context, it will be returned here.
+ * @param[in] result - Result of the step which has just finished.
+ * @param[in] nOfDone - number of steps which have finished.
+ * @param[in] nOfSteps - total number of steps.
+ */
+typedef void (*OCProvisionStepProgressCB)(void* ctx, const OCProvisionStepResult_t *result,
+                                          size_t nOfDone, size_t nOfSteps);
+
+/**
+ * Callback function definition of a provisioning plan
+ *
+ * @param[in] ctx - If user set his/her context, it will be returned here.
+ * @param[in] nOfSteps - total number of steps.
+ * @param[in] arr - Array of OCProvisionStepResult_t, in the order of the steps of the plan.
+ * @param[in] elapsedTime - duration of the whole plan in ms.
+ * @param[in] hasError - If there is no error, it's returned with 'false' but if a step or more
+ *                       failed, it will be 'true'.
+ */
+typedef void (*OCProvisionPlanResultCB)(void* ctx, size_t nOfSteps,
+                                        const OCProvisionStepResult_t *arr,
+                                        uint64_t elapsedTime, bool hasError);
+
 /**
  * Callback function definition of CSR retrieve API
  *
@@ -84,6 +84,28 @@ OCStackResult PMSingleDeviceDiscoveryInUnicast(unsigned short waittime, const Oi
  */
 OCStackResult PMDeviceDiscovery(unsigned short waittime, bool isOwned, OCProvisionDev_t **ppList);
 
+/**
+ * Discover owned/unowned devices in the same IP subnet, reporting each device as soon as
+ * it is resolved. The discovery finishes before the timeout once all expected devices or
+ * the expected number of devices are resolved.
+ *
+ * @param[in] waittime            Timeout in seconds.
+ * @param[in] isOwned             bool flag for owned / unowned discovery
+ * @param[in] expectedIds         deviceIDs of the expected devices, it can be NULL.
+ * @param[in] nOfExpectedIds      number of expectedIds.
+ * @param[in] expectedCount       number of expected devices, 0 if not expected.
+ * @param[in] ctx                 context returned in discoveredCallback.
+ * @param[in] discoveredCallback  callback invoked for each resolved device, it can be NULL.
+ * @param[in] ppList              List of OCProvisionDev_t.
+ *
+ * @return OC_STACK_OK on success otherwise error.
+ */
+OCStackResult PMDeviceDiscoveryWithCallback(unsigned short waittime, bool isOwned,
+                                            const OicUuid_t *expectedIds, size_t nOfExpectedIds,
+                                            size_t expectedCount, void *ctx,
+                                            OCDeviceDiscoveredCB discoveredCallback,
+                                            OCProvisionDev_t **ppList);
+
 #ifdef MULTIPLE_OWNER
 /**
  * The function is responsible for the discovery of an MOT-enabled device with the specified deviceID.
@@ -18,6 +18,7 @@
  *
  * *****************************************************************/
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include "ocprovisioningmanager.h"
@@ -28,6 +29,7 @@
 #include "multipleownershiptransfermanager.h"
 #endif //MULTIPLE_OWNER
 #include "oic_malloc.h"
+#include "oic_time.h"
 #include "experimental/logger.h"
 #include "secureresourceprovider.h"
 #include "provisioningdatabasemanager.h"
@@ -66,6 +68,54 @@ struct ProvPreconfPINCtx
 };
 #endif //MULTIPLE_OWNER
 
+/** Index of no device in a provisioning plan. */
+#define PLAN_NO_DEVICE SIZE_MAX
+
+typedef enum
+{
+    PLAN_STEP_PENDING = 0,
+    PLAN_STEP_RUNNING,
+    PLAN_STEP_DONE
+} PlanStepState_t;
+
+typedef struct ProvisionPlan ProvisionPlan_t;
+
+/**
+ * Context of a step of a provisioning plan, returned in the result callback of the step.
+ */
+typedef struct PlanStepCtx PlanStepCtx_t;
+struct PlanStepCtx
+{
+    ProvisionPlan_t *plan;
+    size_t stepIndex;
+    size_t devIdx[2];                               /**< Devices of the step in the plan. */
+    PlanStepState_t state;
+};
+
+/**
+ * Context of a provisioning plan in progress.
+ */
+struct ProvisionPlan
+{
+    void *ctx;
+    const OCProvisionStep_t *steps;
+    size_t numOfSteps;
+    size_t windowSize;
+    OCProvisionStepProgressCB progressCallback;
+    OCProvisionPlanResultCB resultCallback;
+    PlanStepCtx_t *stepCtxs;
+    OCProvisionStepResult_t *results;
+    size_t numOfDevices;                            /**< Number of distinct devices. */
+    bool *isBusy;                                   /**< Does the device have a step running. */
+    bool *isBlocked;                                /**< Scratch of ProceedPlan. */
+    size_t firstPending;                            /**< No step before it is pending. */
+    size_t numOfInProgress;
+    size_t numOfDone;
+    uint64_t startTime;
+    bool hasError;
+    bool isProceeding;                              /**< Is the plan used up in the call stack. */
+};
+
 /**
  * The function is responsible for initializaton of the provisioning manager. It will load
  * provisioning database which have owned device's list and their linked status.
@@ -185,6 +235,42 @@ OCStackResult OC_CALL OCDiscoverOwnedDevices(unsigned short timeout, OCProvision
     return PMDeviceDiscovery(timeout, true, ppList);
 }
 
+/**
+ * The function is responsible for incremental discovery of owned or unowned devices in current
+ * subnet. Each device is reported as soon as it is resolved, and the function returns before
+ * the timeout once the expected devices are resolved.
+ *
+ * @param[in] timeout Timeout in seconds, value till which function will listen to responses from
+ *                    server if the expected devices are not resolved.
+ * @param[in] isOwned true to discover owned devices, false to discover unowned devices.
+ * @param[in] expectedIds deviceIDs of the expected devices. It can be NULL.
+ * @param[in] nOfExpectedIds Number of expectedIds.
+ * @param[in] expectedCount Number of expected devices, 0 if not expected.
+ * @param[in] ctx Application context returned in discoveredCallback.
+ * @param[in] discoveredCallback Callback invoked for each resolved device. It can be NULL.
+ * @param[out] ppList List of discovered devices.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCDiscoverDevicesIncrementally(unsigned short timeout, bool isOwned,
+                                                     const OicUuid_t *expectedIds,
+                                                     size_t nOfExpectedIds, size_t expectedCount,
+                                                     void *ctx,
+                                                     OCDeviceDiscoveredCB discoveredCallback,
+                                                     OCProvisionDev_t **ppList)
+{
+    if( ppList == NULL || *ppList != NULL || 0 == timeout)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (NULL == expectedIds && 0 != nOfExpectedIds)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    return PMDeviceDiscoveryWithCallback(timeout, isOwned, expectedIds, nOfExpectedIds,
+                                         expectedCount, ctx, discoveredCallback, ppList);
+}
+
 #ifdef MULTIPLE_OWNER
 /**
  * The function is responsible for the discovery of an MOT-enabled device with the specified deviceID.
@@ -341,6 +427,35 @@ OCStackResult OC_CALL OCDoOwnershipTransfer(void* ctx,
     return OTMDoOwnershipTransfer(ctx, targetDevices, resultCallback);
 }
 
+/**
+ * Do ownership transfer for un-owned devices concurrently.
+ *
+ * @param[in] ctx Application context would be returned in callbacks
+ * @param[in] targetDevices List of devices to perform ownership transfer.
+ * @param[in] windowSize Maximum number of devices in progress at a time.
+ * @param[in] progressCallback Callback function to be invoked whenever a device finishes.
+ * @param[in] resultCallback Result callback function to be invoked when ownership transfer finished.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCDoOwnershipTransferConcurrently(void* ctx,
+                                                        OCProvisionDev_t *targetDevices,
+                                                        size_t windowSize,
+                                                        OCOwnershipTransferProgressCB progressCallback,
+                                                        OCProvisionResultCB resultCallback)
+{
+    if (NULL == targetDevices || 0 == windowSize)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (!resultCallback)
+    {
+        OIC_LOG(INFO, TAG, "OCDoOwnershipTransferConcurrently : NULL Callback");
+        return OC_STACK_INVALID_CALLBACK;
+    }
+    return OTMDoOwnershipTransferConcurrently(ctx, targetDevices, windowSize,
+                                              progressCallback, resultCallback);
+}
+
 /**
  * This function deletes memory allocated to linked list created by OCDiscover_XXX_Devices API.
  *
@@ -1312,6 +1427,405 @@ OCStackResult OC_CALL OCProvisionPairwiseDevices(void* ctx, OicSecCredType_t typ
 
 }
 
+static void ProceedPlan(ProvisionPlan_t *plan);
+
+/**
+ * Internal Function to finish a step of a provisioning plan.
+ */
+static void FinishPlanStep(PlanStepCtx_t *stepCtx, OCStackResult res)
+{
+    ProvisionPlan_t *plan = stepCtx->plan;
+    OCProvisionStepResult_t *result = &plan->results[stepCtx->stepIndex];
+
+    stepCtx->state = PLAN_STEP_DONE;
+    for (size_t i = 0; i < 2; i++)
+    {
+        if (PLAN_NO_DEVICE != stepCtx->devIdx[i])
+        {
+            plan->isBusy[stepCtx->devIdx[i]] = false;
+        }
+    }
+
+    result->res = res;
+    result->elapsedTime = OICGetCurrentTime(TIME_IN_MS) - plan->startTime - result->startTime;
+    plan->hasError = plan->hasError || (OC_STACK_OK != res);
+    plan->numOfInProgress--;
+    plan->numOfDone++;
+
+    OIC_LOG_V(DEBUG, TAG, "Step %" PRIuPTR " of the plan finished with %d in %" PRIu64 " ms",
+              stepCtx->stepIndex, res, result->elapsedTime);
+
+    //Keep the plan while the progress callback runs, it can't finish the plan then.
+    bool wasProceeding = plan->isProceeding;
+    plan->isProceeding = true;
+    if (plan->progressCallback)
+    {
+        plan->progressCallback(plan->ctx, result, plan->numOfDone, plan->numOfSteps);
+    }
+    plan->isProceeding = wasProceeding;
+
+    ProceedPlan(plan);
+}
+
+/**
+ * Callback to handle the result of a step of a provisioning plan.
+ */
+static void PlanStepCB(void* ctx, size_t nOfRes, OCProvisionResult_t *arr, bool hasError)
+{
+    PlanStepCtx_t *stepCtx = (PlanStepCtx_t*)ctx;
+    if (NULL == stepCtx || PLAN_STEP_RUNNING != stepCtx->state)
+    {
+        OIC_LOG(ERROR, TAG, "Result of a step which is not running");
+        return;
+    }
+
+    OCProvisionStepResult_t *result = &stepCtx->plan->results[stepCtx->stepIndex];
+    for (size_t i = 0; NULL != arr && i < nOfRes; i++)
+    {
+        for (size_t j = 0; j < result->nOfDevResults; j++)
+        {
+            if (0 == memcmp(result->devResults[j].deviceId.id, arr[i].deviceId.id, UUID_LENGTH))
+            {
+                result->devResults[j].res = arr[i].res;
+            }
+        }
+    }
+
+    FinishPlanStep(stepCtx, hasError ? OC_STACK_ERROR : OC_STACK_OK);
+}
+
+/**
+ * Internal Function to check that the devices of a credentials step are not linked yet.
+ */
+static OCStackResult CheckPlanStepLink(const OCProvisionStep_t *step)
+{
+    if (NULL == step->pDev2)
+    {
+        return OC_STACK_OK;
+    }
+
+    bool linkExists = true;
+    OCStackResult res = PDMIsLinkExists(&step->pDev1->doxm->deviceID,
+                                        &step->pDev2->doxm->deviceID, &linkExists);
+    if (OC_STACK_OK != res)
+    {
+        OIC_LOG(ERROR, TAG, "Internal Error Occured");
+        return res;
+    }
+    if (linkExists)
+    {
+        OIC_LOG(ERROR, TAG, "Link already exists");
+        return OC_STACK_INVALID_PARAM;
+    }
+    return OC_STACK_OK;
+}
+
+/**
+ * Internal Function to start a step of a provisioning plan.
+ */
+static void StartPlanStep(PlanStepCtx_t *stepCtx)
+{
+    ProvisionPlan_t *plan = stepCtx->plan;
+    const OCProvisionStep_t *step = &plan->steps[stepCtx->stepIndex];
+    OCProvisionStepResult_t *result = &plan->results[stepCtx->stepIndex];
+    OCStackResult res = OC_STACK_ERROR;
+
+    stepCtx->state = PLAN_STEP_RUNNING;
+    for (size_t i = 0; i < 2; i++)
+    {
+        if (PLAN_NO_DEVICE != stepCtx->devIdx[i])
+        {
+            plan->isBusy[stepCtx->devIdx[i]] = true;
+        }
+    }
+    plan->numOfInProgress++;
+    result->startTime = OICGetCurrentTime(TIME_IN_MS) - plan->startTime;
+
+    switch (step->type)
+    {
+        case OC_PROVISION_STEP_CREDENTIALS:
+            //Like OCProvisionPairwiseDevices, a linked pair is rejected, and the link is
+            //recorded in the PDM by the credential provisioning once both devices succeed.
+            res = CheckPlanStepLink(step);
+            if (OC_STACK_OK == res)
+            {
+                res = SRPProvisionCredentialsDos(stepCtx, step->credType, step->keySize,
+                                                 step->pDev1, step->pDev2, NULL, NULL,
+                                                 &PlanStepCB);
+            }
+            break;
+        case OC_PROVISION_STEP_ACL:
+            res = OCProvisionACL(stepCtx, step->pDev1, step->acl, &PlanStepCB);
+            break;
+        default:
+            res = OC_STACK_INVALID_PARAM;
+            break;
+    }
+
+    if (OC_STACK_OK != res)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to start step %" PRIuPTR " of the plan : %d",
+                  stepCtx->stepIndex, res);
+        for (size_t i = 0; i < result->nOfDevResults; i++)
+        {
+            result->devResults[i].res = res;
+        }
+        FinishPlanStep(stepCtx, res);
+    }
+}
+
+/**
+ * Internal Function to start the steps of a provisioning plan while the window has a free slot.
+ * A pending step is started if no step before it uses its devices, which keeps the steps of a
+ * device in the order of the plan.
+ */
+static void ProceedPlan(ProvisionPlan_t *plan)
+{
+    //The caller up in the call stack proceeds the plan.
+    if (plan->isProceeding)
+    {
+        return;
+    }
+
+    plan->isProceeding = true;
+    size_t numOfDone = 0;
+    do
+    {
+        //A step finishing while it starts frees its devices, so they are scanned again.
+        numOfDone = plan->numOfDone;
+
+        while (plan->firstPending < plan->numOfSteps &&
+               PLAN_STEP_PENDING != plan->stepCtxs[plan->firstPending].state)
+        {
+            plan->firstPending++;
+        }
+
+        size_t numOfBlocked = 0;
+        for (size_t i = 0; i < plan->numOfDevices; i++)
+        {
+            plan->isBlocked[i] = plan->isBusy[i];
+            numOfBlocked += plan->isBusy[i] ? 1 : 0;
+        }
+
+        for (size_t idx = plan->firstPending;
+             idx < plan->numOfSteps && plan->numOfInProgress < plan->windowSize &&
+             numOfBlocked < plan->numOfDevices;
+             idx++)
+        {
+            PlanStepCtx_t *stepCtx = &plan->stepCtxs[idx];
+            if (PLAN_STEP_PENDING != stepCtx->state)
+            {
+                continue;
+            }
+
+            bool canStart = true;
+            for (size_t i = 0; i < 2; i++)
+            {
+                size_t devIdx = stepCtx->devIdx[i];
+                if (PLAN_NO_DEVICE != devIdx && plan->isBlocked[devIdx])
+                {
+                    canStart = false;
+                }
+            }
+            if (canStart)
+            {
+                StartPlanStep(stepCtx);
+            }
+
+            //The later steps of the devices wait for this one.
+            for (size_t i = 0; i < 2; i++)
+            {
+                size_t devIdx = stepCtx->devIdx[i];
+                if (PLAN_NO_DEVICE != devIdx && !plan->isBlocked[devIdx])
+                {
+                    plan->isBlocked[devIdx] = true;
+                    numOfBlocked++;
+                }
+            }
+        }
+    } while (numOfDone != plan->numOfDone && plan->numOfDone < plan->numOfSteps);
+    plan->isProceeding = false;
+
+    if (plan->numOfDone == plan->numOfSteps)
+    {
+        uint64_t elapsedTime = OICGetCurrentTime(TIME_IN_MS) - plan->startTime;
+        OIC_LOG_V(INFO, TAG, "Plan of %" PRIuPTR " steps over %" PRIuPTR " devices finished in %"
+                  PRIu64 " ms", plan->numOfSteps, plan->numOfDevices, elapsedTime);
+
+        plan->resultCallback(plan->ctx, plan->numOfSteps, plan->results, elapsedTime,
+                             plan->hasError);
+        OICFree(plan->stepCtxs);
+        OICFree(plan->results);
+        OICFree(plan->isBusy);
+        OICFree(plan->isBlocked);
+        OICFree(plan);
+    }
+}
+
+/**
+ * Internal Function to check a step of a provisioning plan.
+ */
+static bool IsValidPlanStep(const OCProvisionStep_t *step)
+{
+    if (NULL == step->pDev1 || NULL == step->pDev1->doxm)
+    {
+        return false;
+    }
+
+    switch (step->type)
+    {
+        case OC_PROVISION_STEP_CREDENTIALS:
+            if (NULL != step->pDev2 &&
+                (NULL == step->pDev2->doxm ||
+                 0 == memcmp(&step->pDev1->doxm->deviceID, &step->pDev2->doxm->deviceID,
+                             sizeof(OicUuid_t))))
+            {
+                return false;
+            }
+            if (SYMMETRIC_PAIR_WISE_KEY == step->credType &&
+                (NULL == step->pDev2 ||
+                 !(OWNER_PSK_LENGTH_128 == step->keySize || OWNER_PSK_LENGTH_256 == step->keySize)))
+            {
+                return false;
+            }
+            return true;
+        case OC_PROVISION_STEP_ACL:
+            return (NULL != step->acl);
+        default:
+            return false;
+    }
+}
+
+/**
+ * Internal Function to get the index of a device in a provisioning plan, adding it if new.
+ */
+static size_t GetPlanDeviceIndex(OicUuid_t *devices, size_t *numOfDevices,
+                                 const OCProvisionDev_t *dev)
+{
+    if (NULL == dev)
+    {
+        return PLAN_NO_DEVICE;
+    }
+
+    for (size_t i = 0; i < *numOfDevices; i++)
+    {
+        if (0 == memcmp(devices[i].id, dev->doxm->deviceID.id, UUID_LENGTH))
+        {
+            return i;
+        }
+    }
+    memcpy(devices[*numOfDevices].id, dev->doxm->deviceID.id, UUID_LENGTH);
+    return (*numOfDevices)++;
+}
+
+/**
+ * API to run a provisioning plan of ACLs and credentials over several devices.
+ *
+ * @param[in] ctx Application context returned in the callbacks.
+ * @param[in] plan Array of the steps to run, which must be kept until the result callback.
+ * @param[in] nOfSteps Number of steps of the plan.
+ * @param[in] windowSize Maximum number of steps in progress at a time.
+ * @param[in] progressCallback Callback invoked whenever a step finishes, it can be NULL.
+ * @param[in] resultCallback Callback invoked once with the results and timings of all steps.
+ * @return OC_STACK_OK in case of success and other value otherwise.
+ */
+OCStackResult OC_CALL OCProvisionPlan(void* ctx, const OCProvisionStep_t *plan, size_t nOfSteps,
+                                      size_t windowSize,
+                                      OCProvisionStepProgressCB progressCallback,
+                                      OCProvisionPlanResultCB resultCallback)
+{
+    if (NULL == plan || 0 == nOfSteps || 0 == windowSize)
+    {
+        OIC_LOG(ERROR, TAG, "OCProvisionPlan : Invalid parameters");
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (!resultCallback)
+    {
+        OIC_LOG(INFO, TAG, "OCProvisionPlan : NULL Callback");
+        return OC_STACK_INVALID_CALLBACK;
+    }
+    for (size_t idx = 0; idx < nOfSteps; idx++)
+    {
+        if (!IsValidPlanStep(&plan[idx]))
+        {
+            OIC_LOG_V(ERROR, TAG, "OCProvisionPlan : Invalid step %" PRIuPTR, idx);
+            return OC_STACK_INVALID_PARAM;
+        }
+    }
+
+    OicUuid_t *devices = (OicUuid_t*)OICCalloc(nOfSteps * 2, sizeof(OicUuid_t));
+    ProvisionPlan_t *provPlan = (ProvisionPlan_t*)OICCalloc(1, sizeof(ProvisionPlan_t));
+    VERIFY_NOT_NULL(TAG, devices, ERROR);
+    VERIFY_NOT_NULL(TAG, provPlan, ERROR);
+
+    provPlan->stepCtxs = (PlanStepCtx_t*)OICCalloc(nOfSteps, sizeof(PlanStepCtx_t));
+    provPlan->results = (OCProvisionStepResult_t*)OICCalloc(nOfSteps,
+                                                            sizeof(OCProvisionStepResult_t));
+    VERIFY_NOT_NULL(TAG, provPlan->stepCtxs, ERROR);
+    VERIFY_NOT_NULL(TAG, provPlan->results, ERROR);
+
+    for (size_t idx = 0; idx < nOfSteps; idx++)
+    {
+        PlanStepCtx_t *stepCtx = &provPlan->stepCtxs[idx];
+        OCProvisionStepResult_t *result = &provPlan->results[idx];
+        const OCProvisionDev_t *stepDevs[2] = { plan[idx].pDev1, NULL };
+        if (OC_PROVISION_STEP_CREDENTIALS == plan[idx].type)
+        {
+            stepDevs[1] = plan[idx].pDev2;
+        }
+
+        stepCtx->plan = provPlan;
+        stepCtx->stepIndex = idx;
+        stepCtx->state = PLAN_STEP_PENDING;
+        result->stepIndex = idx;
+        result->res = OC_STACK_CONTINUE;
+        for (size_t i = 0; i < 2; i++)
+        {
+            stepCtx->devIdx[i] = GetPlanDeviceIndex(devices, &provPlan->numOfDevices, stepDevs[i]);
+            if (NULL != stepDevs[i])
+            {
+                memcpy(result->devResults[result->nOfDevResults].deviceId.id,
+                       stepDevs[i]->doxm->deviceID.id, UUID_LENGTH);
+                result->devResults[result->nOfDevResults].res = OC_STACK_CONTINUE;
+                result->nOfDevResults++;
+            }
+        }
+    }
+
+    provPlan->isBusy = (bool*)OICCalloc(provPlan->numOfDevices, sizeof(bool));
+    provPlan->isBlocked = (bool*)OICCalloc(provPlan->numOfDevices, sizeof(bool));
+    VERIFY_NOT_NULL(TAG, provPlan->isBusy, ERROR);
+    VERIFY_NOT_NULL(TAG, provPlan->isBlocked, ERROR);
+
+    provPlan->ctx = ctx;
+    provPlan->steps = plan;
+    provPlan->numOfSteps = nOfSteps;
+    provPlan->windowSize = windowSize;
+    provPlan->progressCallback = progressCallback;
+    provPlan->resultCallback = resultCallback;
+    provPlan->startTime = OICGetCurrentTime(TIME_IN_MS);
+    OICFree(devices);
+
+    OIC_LOG_V(INFO, TAG, "Start plan of %" PRIuPTR " steps over %" PRIuPTR " devices, %"
+              PRIuPTR " at a time", nOfSteps, provPlan->numOfDevices, windowSize);
+
+    ProceedPlan(provPlan);
+    return OC_STACK_OK;
+
+exit:
+    OIC_LOG(ERROR, TAG, "OCProvisionPlan : Failed to memory allocation");
+    OICFree(devices);
+    if (provPlan)
+    {
+        OICFree(provPlan->stepCtxs);
+        OICFree(provPlan->results);
+        OICFree(provPlan->isBusy);
+        OICFree(provPlan->isBlocked);
+        OICFree(provPlan);
+    }
+    return OC_STACK_NO_MEMORY;
+}
+
 OCStackResult OC_CALL OCGetDevInfoFromNetwork(unsigned short waittime,
                                               OCProvisionDev_t** pOwnedDevList,
                                               OCProvisionDev_t** pUnownedDevList)
@@ -497,27 +497,83 @@ static bool IsComplete(OTMContext_t* otmCtx)
 }
 
 /**
- * Function to save the result of provisioning.
- *
- * @param[in,out] otmCtx   Context value of ownership transfer.
- * @param[in] res   result of provisioning
+ * Context of the ownership transfer of devices in progress concurrently.
+ * Each device in progress has its own OTMContext_t sharing the result array of the batch.
  */
-static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
+struct OTMBatch
 {
-    OIC_LOG_V(DEBUG, TAG, "IN SetResult : %d ", res);
+    void* userCtx;                                  /**< Context for user. */
+    OCProvisionResultCB resultCallback;             /**< Invoked when all devices finished. */
+    OCOwnershipTransferProgressCB progressCallback; /**< Invoked whenever a device finished. */
+    OCProvisionResult_t* resultArray;               /**< Result array having result of all device. */
+    size_t resultArraySize;                         /**< No of elements in result array. */
+    OCProvisionDev_t* nextDevice;                   /**< Next device to start. */
+    size_t windowSize;                              /**< Max number of devices in progress. */
+    size_t numOfInProgress;                         /**< Number of devices in progress. */
+    size_t numOfDone;                               /**< Number of devices finished. */
+    bool hasError;                                  /**< Does any device have an error. */
+    bool isProceeding;                              /**< Is the batch used up in the call stack. */
+};
 
-    VERIFY_NOT_NULL(TAG, otmCtx, ERROR);
-    VERIFY_NOT_NULL(TAG, otmCtx->selectedDeviceInfo, ERROR);
+/**
+ * Steps of ownership transfer setting up a secure session.
+ */
+typedef enum
+{
+    OTM_SESSION_TEMPORAL = 0,        /**< Temporal session using the secret of the OxM. */
+    OTM_SESSION_OWNER_CREDENTIAL     /**< Session using the owner credential. */
+} OTMSessionStep_t;
 
-    //If OTM Context was removed from previous response handler, just exit the current OTM process.
-    if(NULL != GetOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
-                             getSecurePort(otmCtx->selectedDeviceInfo)))
-    {
-        OIC_LOG(WARNING, TAG, "Current OTM Process has already ended.");
-    }
+typedef struct OTMSessionWaiter OTMSessionWaiter_t;
 
-    VERIFY_NOT_NULL(TAG, otmCtx->selectedDeviceInfo->doxm, ERROR);
+/**
+ * Device waiting for its turn to set up a secure session.
+ */
+struct OTMSessionWaiter
+{
+    OTMContext_t* otmCtx;
+    OTMSessionStep_t step;
+    OTMSessionWaiter_t* next;
+};
+
+/**
+ * The OxM callbacks change the cipher suite and the credential handlers of the stack,
+ * so the devices of concurrent ownership transfers set up their sessions in turn.
+ */
+static OTMContext_t* g_sessionOwner = NULL;
+static OTMSessionWaiter_t* g_sessionWaiters = NULL;
+
+static void SetResult(OTMContext_t* otmCtx, const OCStackResult res);
 
+/**
+ * Function to load the secret of the selected OxM and create the temporal secure session.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ */
+static void CreateTemporalSession(OTMContext_t* otmCtx);
+
+/**
+ * Function to get ready to use the owner credential and update the owner ACL.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ */
+static void UseOwnerCredential(OTMContext_t* otmCtx);
+
+/**
+ * Function to start the next devices of a concurrent ownership transfer while the window
+ * has room, and to invoke the result callback once all devices finished.
+ *
+ * @param[in] batch   Concurrent ownership transfer.
+ */
+static void ProceedBatch(OTMBatch_t* batch);
+
+/**
+ * Function to revert the callbacks set up by the OxM to create the temporal session.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ */
+static void RevertOxmCallbacks(const OTMContext_t* otmCtx)
+{
     //Revert psk_info callback and new deivce uuid in case of random PIN OxM
     if(OIC_RANDOM_DEVICE_PIN == otmCtx->selectedDeviceInfo->doxm->oxmSel)
     {
@@ -545,13 +601,150 @@ static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
             OIC_LOG(WARNING, TAG, "Failed to revert CredentialTypesHandler.");
         }
     }
+}
+
+/**
+ * Function to take the turn to set up a secure session.
+ * The device is queued if another device has the turn, whether it belongs to a
+ * sequential or a concurrent ownership transfer, and the step is resumed on its turn.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ * @param[in] step   Step to resume on the turn.
+ * @return true if the device has the turn, false if queued.
+ */
+static bool AcquireSessionSetup(OTMContext_t* otmCtx, OTMSessionStep_t step)
+{
+    if (g_sessionOwner == otmCtx)
+    {
+        return true;
+    }
+    if (NULL == g_sessionOwner)
+    {
+        g_sessionOwner = otmCtx;
+        return true;
+    }
+
+    OTMSessionWaiter_t* waiter = (OTMSessionWaiter_t*)OICCalloc(1, sizeof(OTMSessionWaiter_t));
+    if (NULL == waiter)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to allocate the session waiter");
+        SetResult(otmCtx, OC_STACK_NO_MEMORY);
+        return false;
+    }
+    waiter->otmCtx = otmCtx;
+    waiter->step = step;
+    LL_APPEND(g_sessionWaiters, waiter);
+
+    OIC_LOG_V(DEBUG, TAG, "%s : %s waits for its turn", __func__,
+              otmCtx->selectedDeviceInfo->endpoint.addr);
+    return false;
+}
+
+/**
+ * Function to give up the turn to set up a secure session, and resume the next waiter.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer.
+ */
+static void ReleaseSessionSetup(OTMContext_t* otmCtx)
+{
+    OTMSessionWaiter_t* waiter = NULL;
+    OTMSessionWaiter_t* tmp = NULL;
+
+    LL_FOREACH_SAFE(g_sessionWaiters, waiter, tmp)
+    {
+        if (waiter->otmCtx == otmCtx)
+        {
+            LL_DELETE(g_sessionWaiters, waiter);
+            OICFree(waiter);
+        }
+    }
+
+    if (g_sessionOwner != otmCtx)
+    {
+        return;
+    }
+
+    RevertOxmCallbacks(otmCtx);
+    g_sessionOwner = NULL;
+
+    waiter = g_sessionWaiters;
+    if (NULL != waiter)
+    {
+        LL_DELETE(g_sessionWaiters, waiter);
+        g_sessionOwner = waiter->otmCtx;
+        OTMSessionStep_t step = waiter->step;
+        OICFree(waiter);
+
+        if (OTM_SESSION_TEMPORAL == step)
+        {
+            CreateTemporalSession(g_sessionOwner);
+        }
+        else
+        {
+            UseOwnerCredential(g_sessionOwner);
+        }
+    }
+}
+
+/**
+ * Function to finish a device of concurrent ownership transfer.
+ *
+ * @param[in] otmCtx   Context value of ownership transfer, which is freed.
+ * @param[in] result   result of the device in the result array.
+ */
+static void FinishBatchDevice(OTMContext_t* otmCtx, const OCProvisionResult_t* result)
+{
+    OTMBatch_t* batch = otmCtx->batch;
+
+    //Keep the batch while the next waiter is resumed, which can finish the other devices.
+    bool wasProceeding = batch->isProceeding;
+    batch->isProceeding = true;
+
+    batch->hasError = batch->hasError || otmCtx->ctxHasError;
+    batch->numOfInProgress--;
+    batch->numOfDone++;
+    if (batch->progressCallback && result)
+    {
+        batch->progressCallback(batch->userCtx, result, batch->numOfDone, batch->resultArraySize);
+    }
+
+    ReleaseSessionSetup(otmCtx);
+    OICFree(otmCtx);
+
+    batch->isProceeding = wasProceeding;
+    ProceedBatch(batch);
+}
 
+/**
+ * Function to save the result of provisioning.
+ *
+ * @param[in,out] otmCtx   Context value of ownership transfer.
+ * @param[in] res   result of provisioning
+ */
+static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN SetResult : %d ", res);
+
+    VERIFY_NOT_NULL(TAG, otmCtx, ERROR);
+    VERIFY_NOT_NULL(TAG, otmCtx->selectedDeviceInfo, ERROR);
+
+    //If OTM Context was removed from previous response handler, just exit the current OTM process.
+    if(NULL != GetOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
+                             getSecurePort(otmCtx->selectedDeviceInfo)))
+    {
+        OIC_LOG(WARNING, TAG, "Current OTM Process has already ended.");
+    }
+
+    VERIFY_NOT_NULL(TAG, otmCtx->selectedDeviceInfo->doxm, ERROR);
+
+    OCProvisionResult_t* result = NULL;
     for(size_t i = 0; i < otmCtx->ctxResultArraySize; i++)
     {
         if(memcmp(otmCtx->selectedDeviceInfo->doxm->deviceID.id,
                   otmCtx->ctxResultArray[i].deviceId.id, UUID_LENGTH) == 0)
         {
             otmCtx->ctxResultArray[i].res = res;
+            result = &otmCtx->ctxResultArray[i];
             if(OC_STACK_OK != res && OC_STACK_CONTINUE != res && OC_STACK_DUPLICATE_REQUEST != res)
             {
                 otmCtx->ctxHasError = true;
@@ -588,6 +781,24 @@ static void SetResult(OTMContext_t* otmCtx, const OCStackResult res)
         }
     }
 
+    if(otmCtx->batch)
+    {
+        //The OTM Context of a duplicated OTM process normally belongs to the other process,
+        //but the context of this device must not outlive it.
+        if(OC_STACK_DUPLICATE_REQUEST == res &&
+           otmCtx == GetOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
+                                   getSecurePort(otmCtx->selectedDeviceInfo)))
+        {
+            RemoveOTMContext(otmCtx->selectedDeviceInfo->endpoint.addr,
+                             getSecurePort(otmCtx->selectedDeviceInfo));
+        }
+        FinishBatchDevice(otmCtx, result);
+        goto exit;
+    }
+
+    //The callbacks of the OxM are reverted when the device gives up its turn.
+    ReleaseSessionSetup(otmCtx);
+
     //If all OTM process is complete, invoke the user callback.
     if(IsComplete(otmCtx))
     {
@@ -951,6 +1162,44 @@ exit:
     return res;
 }
 
+static void CreateTemporalSession(OTMContext_t* otmCtx)
+{
+    OCStackResult res = OC_STACK_ERROR;
+
+    if(otmCtx->otmCallback.loadSecretCB)
+    {
+        res = otmCtx->otmCallback.loadSecretCB(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "CreateTemporalSession : Failed to load secret");
+            SetResult(otmCtx, res);
+            return;
+        }
+    }
+    if(otmCtx->otmCallback.createSecureSessionCB)
+    {
+        res = otmCtx->otmCallback.createSecureSessionCB(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "CreateTemporalSession : Failed to create DTLS session");
+            SetResult(otmCtx, res);
+            return;
+        }
+
+        //This is a secure session.
+        otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
+
+        //Send request : GET /oic/sec/doxm. Then verify that the property values obtained this way
+        //are the same as those already-stored in the otmCtx.
+        res = GetAndVerifyDoxmResource(otmCtx);
+        if(OC_STACK_OK != res)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to get doxm information after establishing secure connection");
+            SetResult(otmCtx, res);
+        }
+    }
+}
+
 /**
  * Callback handler for OwnerShipTransferModeHandler API.
  *
@@ -986,38 +1235,10 @@ static OCStackApplicationResult OwnerTransferModeHandler(void *ctx, OCDoHandle U
             return OC_STACK_DELETE_TRANSACTION;
         }
 
-        //Create DTLS secure session
-        if(otmCtx->otmCallback.loadSecretCB)
+        //Create DTLS secure session, once the other devices finished setting up theirs.
+        if(AcquireSessionSetup(otmCtx, OTM_SESSION_TEMPORAL))
         {
-            res = otmCtx->otmCallback.loadSecretCB(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to load secret");
-                SetResult(otmCtx, res);
-                return  OC_STACK_DELETE_TRANSACTION;
-            }
-        }
-        if(otmCtx->otmCallback.createSecureSessionCB)
-        {
-            res = otmCtx->otmCallback.createSecureSessionCB(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "OwnerTransferModeHandler : Failed to create DTLS session");
-                SetResult(otmCtx, res);
-                return OC_STACK_DELETE_TRANSACTION;
-            }
-
-            //This is a secure session.
-            otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
-
-            //Send request : GET /oic/sec/doxm. Then verify that the property values obtained this way
-            //are the same as those already-stored in the otmCtx.
-            res = GetAndVerifyDoxmResource(otmCtx);
-            if(OC_STACK_OK != res)
-            {
-                OIC_LOG(ERROR, TAG, "Failed to get doxm information after establishing secure connection");
-                SetResult(otmCtx, res);
-            }
+            CreateTemporalSession(otmCtx);
         }
     }
     else
@@ -1326,6 +1547,68 @@ static OCStackApplicationResult OperationModeUpdateHandler(void *ctx, OCDoHandle
     return  OC_STACK_DELETE_TRANSACTION;
 }
 
+static void UseOwnerCredential(OTMContext_t* otmCtx)
+{
+    //For Servers based on OCF 1.0, PostOwnerAcl can be executed using
+    //the already-existing session. However, get ready here to use the
+    //Owner Credential for establishing future secure sessions.
+    //
+    //For Servers based on OIC 1.1, PostOwnerAcl might fail with status
+    //OC_STACK_UNAUTHORIZED_REQ. After such a failure, OwnerAclHandler
+    //will close the current session and re-establish a new session,
+    //using the Owner Credential.
+    CAEndpoint_t *endpoint = (CAEndpoint_t *)&otmCtx->selectedDeviceInfo->endpoint;
+
+    if (IS_OIC(otmCtx->selectedDeviceInfo->specVer))
+    {
+        endpoint->port = getSecurePort(otmCtx->selectedDeviceInfo);
+        if(CA_STATUS_OK != CAcloseSslConnection(endpoint))
+        {
+            OIC_LOG_V(WARNING, TAG, "%s: failed to close DTLS session", __func__);
+        }
+    }
+
+    /**
+      * If we select NULL cipher,
+      * client will select appropriate cipher suite according to server's cipher-suite list.
+      */
+    // TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA_256 = 0xC037, /**< see RFC 5489 */
+    CAResult_t caResult = CASelectCipherSuite(0xC037, endpoint->adapter);
+    if(CA_STATUS_OK != caResult)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to select TLS_NULL_WITH_NULL_NULL");
+        SetResult(otmCtx, CAResultToOCResult(caResult));
+        return;
+    }
+
+    /**
+      * in case of random PIN based OxM,
+      * revert get_psk_info callback of tinyDTLS to use owner credential.
+      */
+    if(OIC_RANDOM_DEVICE_PIN == otmCtx->selectedDeviceInfo->doxm->oxmSel)
+    {
+        OicUuid_t emptyUuid = OC_ZERO_UUID;
+        SetUuidForPinBasedOxm(&emptyUuid);
+
+        caResult = CAregisterPskCredentialsHandler(GetDtlsPskCredentials);
+        if(CA_STATUS_OK != caResult)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to revert DTLS credential handler.");
+            SetResult(otmCtx, OC_STACK_INVALID_CALLBACK);
+            return;
+        }
+    }
+#ifdef __WITH_TLS__
+    otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
+#endif
+    OCStackResult res = PostOwnerAcl(otmCtx, GET_ACL_VER(otmCtx->selectedDeviceInfo->specVer));
+    if(OC_STACK_OK != res)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to update owner ACL to new device");
+        SetResult(otmCtx, res);
+    }
+}
+
 /**
  * Response handler for update owner crendetial request.
  *
@@ -1350,80 +1633,25 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
 
     if(OC_STACK_RESOURCE_CHANGED == clientResponse->result)
     {
-        if(otmCtx->selectedDeviceInfo)
+        //Get ready to use the Owner Credential, once the other devices finished
+        //setting up their sessions.
+        if(otmCtx->selectedDeviceInfo &&
+           AcquireSessionSetup(otmCtx, OTM_SESSION_OWNER_CREDENTIAL))
         {
-            //For Servers based on OCF 1.0, PostOwnerAcl can be executed using
-            //the already-existing session. However, get ready here to use the
-            //Owner Credential for establishing future secure sessions.
-            //
-            //For Servers based on OIC 1.1, PostOwnerAcl might fail with status
-            //OC_STACK_UNAUTHORIZED_REQ. After such a failure, OwnerAclHandler
-            //will close the current session and re-establish a new session,
-            //using the Owner Credential.
-            CAEndpoint_t *endpoint = (CAEndpoint_t *)&otmCtx->selectedDeviceInfo->endpoint;
-
-            if (IS_OIC(otmCtx->selectedDeviceInfo->specVer))
-            {
-                endpoint->port = getSecurePort(otmCtx->selectedDeviceInfo);
-                if(CA_STATUS_OK != CAcloseSslConnection(endpoint))
-                {
-                    OIC_LOG_V(WARNING, TAG, "%s: failed to close DTLS session", __func__);
-                }
-            }
-
-            /**
-              * If we select NULL cipher,
-              * client will select appropriate cipher suite according to server's cipher-suite list.
-              */
-            // TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA_256 = 0xC037, /**< see RFC 5489 */
-                CAResult_t caResult = CASelectCipherSuite(0xC037, endpoint->adapter);
-                if(CA_STATUS_OK != caResult)
-                {
-                    OIC_LOG(ERROR, TAG, "Failed to select TLS_NULL_WITH_NULL_NULL");
-                    SetResult(otmCtx, CAResultToOCResult(caResult));
-                    return OC_STACK_DELETE_TRANSACTION;
-                }
-
-                /**
-                  * in case of random PIN based OxM,
-                  * revert get_psk_info callback of tinyDTLS to use owner credential.
-                  */
-                if(OIC_RANDOM_DEVICE_PIN == otmCtx->selectedDeviceInfo->doxm->oxmSel)
-                {
-                    OicUuid_t emptyUuid = OC_ZERO_UUID;
-                    SetUuidForPinBasedOxm(&emptyUuid);
-
-                    caResult = CAregisterPskCredentialsHandler(GetDtlsPskCredentials);
-                    if(CA_STATUS_OK != caResult)
-                    {
-                        OIC_LOG(ERROR, TAG, "Failed to revert DTLS credential handler.");
-                        SetResult(otmCtx, OC_STACK_INVALID_CALLBACK);
-                        return OC_STACK_DELETE_TRANSACTION;
-                    }
-                }
-    #ifdef __WITH_TLS__
-                otmCtx->selectedDeviceInfo->connType = (OCConnectivityType)(otmCtx->selectedDeviceInfo->connType | CT_FLAG_SECURE);
-    #endif
-                res = PostOwnerAcl(otmCtx, GET_ACL_VER(otmCtx->selectedDeviceInfo->specVer));
-                if(OC_STACK_OK != res)
-                {
-                    OIC_LOG(ERROR, TAG, "Failed to update owner ACL to new device");
-                    SetResult(otmCtx, res);
-                    return OC_STACK_DELETE_TRANSACTION;
-                }
-            }
-        }
-        else
-        {
-            res = clientResponse->result;
-            OIC_LOG_V(ERROR, TAG, "OwnerCredentialHandler : Unexpected result %d", res);
-            SetResult(otmCtx, res);
+            UseOwnerCredential(otmCtx);
         }
+    }
+    else
+    {
+        res = clientResponse->result;
+        OIC_LOG_V(ERROR, TAG, "OwnerCredentialHandler : Unexpected result %d", res);
+        SetResult(otmCtx, res);
+    }
 
-        OIC_LOG(DEBUG, TAG, "OUT OwnerCredentialHandler");
+    OIC_LOG(DEBUG, TAG, "OUT OwnerCredentialHandler");
 
-        return  OC_STACK_DELETE_TRANSACTION;
-    }
+    return  OC_STACK_DELETE_TRANSACTION;
+}
 
     static void SetAclVer2(char specVer[]){specVer[0]='o'; specVer[1]='c'; specVer[2]='f';}
 
@@ -1455,6 +1683,9 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
         OCStackResult res = clientResponse->result;
         if(OC_STACK_RESOURCE_CHANGED == res)
         {
+            //The session using the owner credential is set up.
+            ReleaseSessionSetup(otmCtx);
+
             if(NULL != selectedDeviceInfo)
             {
                 //POST /oic/sec/doxm [{ ..., "owned":"TRUE" }]
@@ -1476,7 +1707,18 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
             {
                 SetAclVer2(otmCtx->selectedDeviceInfo->specVer);
                 OIC_LOG_V(WARNING, TAG, "%s: set acl v2", __func__);
-                PostOwnerAcl(otmCtx, OIC_SEC_ACL_V2);
+                //The retry uses the same session, so the device keeps its turn.
+                res = PostOwnerAcl(otmCtx, OIC_SEC_ACL_V2);
+                if(OC_STACK_OK != res)
+                {
+                    OIC_LOG_V(ERROR, TAG, "%s: Failed to update the owner ACL, res = %d",
+                              __func__, res);
+                    SetResult(otmCtx, res);
+                }
+            }
+            else
+            {
+                SetResult(otmCtx, res);
             }
         }
         else
@@ -1666,6 +1908,9 @@ static OCStackApplicationResult OwnerCredentialHandler(void *ctx, OCDoHandle UNU
         }
         else
         {
+            //The temporal session is set up, the other devices can set up theirs.
+            ReleaseSessionSetup(otmCtx);
+
             //Sanity checks.
             OCProvisionDev_t* deviceInfo = otmCtx->selectedDeviceInfo;
             if (NULL == deviceInfo)
@@ -2653,6 +2898,7 @@ static OCStackResult StartOwnershipTransfer(void* ctx, OCProvisionDev_t* selecte
     if(OC_STACK_OK != res)
     {
         OIC_LOG_V(ERROR, TAG, "Error in OTMSetOTCallback : %d", res);
+        SetResult(otmCtx, res);
         return res;
     }
 
@@ -2765,6 +3011,153 @@ OCStackResult OTMDoOwnershipTransfer(void* ctx,
     return res;
 }
 
+/**
+ * Function to start the ownership transfer of a device of concurrent ownership transfer.
+ *
+ * @param[in] batch   Concurrent ownership transfer.
+ * @param[in] selectedDevice   device to start.
+ */
+static void StartBatchDevice(OTMBatch_t* batch, OCProvisionDev_t* selectedDevice)
+{
+    OTMContext_t* otmCtx = (OTMContext_t*)OICCalloc(1, sizeof(OTMContext_t));
+    if (NULL == otmCtx)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create OTM Context");
+
+        OCProvisionResult_t* result = NULL;
+        for (size_t i = 0; i < batch->resultArraySize; i++)
+        {
+            if (memcmp(selectedDevice->doxm->deviceID.id,
+                       batch->resultArray[i].deviceId.id, UUID_LENGTH) == 0)
+            {
+                batch->resultArray[i].res = OC_STACK_NO_MEMORY;
+                result = &batch->resultArray[i];
+            }
+        }
+        batch->hasError = true;
+        batch->numOfDone++;
+        if (batch->progressCallback && result)
+        {
+            batch->progressCallback(batch->userCtx, result, batch->numOfDone,
+                                    batch->resultArraySize);
+        }
+        return;
+    }
+
+    otmCtx->userCtx = batch->userCtx;
+    otmCtx->ctxResultCallback = batch->resultCallback;
+    otmCtx->ctxResultArray = batch->resultArray;
+    otmCtx->ctxResultArraySize = batch->resultArraySize;
+    otmCtx->ctxHasError = false;
+    otmCtx->batch = batch;
+    batch->numOfInProgress++;
+
+    //The result of a failure is set to the device, which does not affect the others.
+    if (OC_STACK_OK != StartOwnershipTransfer(otmCtx, selectedDevice))
+    {
+        OIC_LOG(ERROR, TAG, "Failed to StartOwnershipTransfer");
+    }
+}
+
+static void ProceedBatch(OTMBatch_t* batch)
+{
+    //The caller up in the call stack proceeds the batch.
+    if (batch->isProceeding)
+    {
+        return;
+    }
+
+    batch->isProceeding = true;
+    while (NULL != batch->nextDevice && batch->numOfInProgress < batch->windowSize)
+    {
+        OCProvisionDev_t* selectedDevice = batch->nextDevice;
+        batch->nextDevice = selectedDevice->next;
+        StartBatchDevice(batch, selectedDevice);
+    }
+    batch->isProceeding = false;
+
+    if (batch->numOfDone == batch->resultArraySize)
+    {
+        OIC_LOG_V(INFO, TAG, "Concurrent ownership transfer of %" PRIuPTR " devices finished",
+                  batch->resultArraySize);
+
+        SetDosState(DOS_RFNOP);
+        batch->resultCallback(batch->userCtx, batch->resultArraySize,
+                              batch->resultArray, batch->hasError);
+        OICFree(batch->resultArray);
+        OICFree(batch);
+    }
+}
+
+/**
+ * NOTE : Unowned discovery should be done before performing OTMDoOwnershipTransferConcurrently
+ */
+OCStackResult OTMDoOwnershipTransferConcurrently(void* ctx,
+                                                 OCProvisionDev_t *selectedDevicelist,
+                                                 size_t windowSize,
+                                                 OCOwnershipTransferProgressCB progressCallback,
+                                                 OCProvisionResultCB resultCallback)
+{
+    OIC_LOG(DEBUG, TAG, "IN OTMDoOwnershipTransferConcurrently");
+
+    if (NULL == selectedDevicelist || 0 == windowSize)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (NULL == resultCallback)
+    {
+        return OC_STACK_INVALID_CALLBACK;
+    }
+
+    OTMBatch_t* batch = (OTMBatch_t*)OICCalloc(1, sizeof(OTMBatch_t));
+    if (NULL == batch)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create OTM Batch");
+        return OC_STACK_NO_MEMORY;
+    }
+
+    batch->userCtx = ctx;
+    batch->resultCallback = resultCallback;
+    batch->progressCallback = progressCallback;
+    batch->nextDevice = selectedDevicelist;
+    batch->windowSize = windowSize;
+
+    //Counting number of selected devices.
+    for (OCProvisionDev_t* pCurDev = selectedDevicelist; NULL != pCurDev; pCurDev = pCurDev->next)
+    {
+        batch->resultArraySize++;
+    }
+
+    batch->resultArray =
+        (OCProvisionResult_t*)OICCalloc(batch->resultArraySize, sizeof(OCProvisionResult_t));
+    if (NULL == batch->resultArray)
+    {
+        OIC_LOG(ERROR, TAG, "OTMDoOwnershipTransferConcurrently : Failed to memory allocation");
+        OICFree(batch);
+        return OC_STACK_NO_MEMORY;
+    }
+
+    //Fill the device UUID for result array.
+    OCProvisionDev_t* pCurDev = selectedDevicelist;
+    for (size_t devIdx = 0; devIdx < batch->resultArraySize; devIdx++)
+    {
+        memcpy(batch->resultArray[devIdx].deviceId.id,
+               pCurDev->doxm->deviceID.id,
+               UUID_LENGTH);
+        batch->resultArray[devIdx].res = OC_STACK_CONTINUE;
+        pCurDev = pCurDev->next;
+    }
+
+    OIC_LOG_V(INFO, TAG, "Start ownership transfer of %" PRIuPTR " devices, %" PRIuPTR " at a time",
+              batch->resultArraySize, windowSize);
+
+    ProceedBatch(batch);
+
+    OIC_LOG(DEBUG, TAG, "OUT OTMDoOwnershipTransferConcurrently");
+
+    return OC_STACK_OK;
+}
+
 OCStackResult OTMSetOxmAllowStatus(const OicSecOxm_t oxm, const bool allowStatus)
 {
     OIC_LOG_V(INFO, TAG, "IN %s : oxm=%d, allow status=%s",
@@ -33,6 +33,7 @@
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
+#include <inttypes.h>
 
 #include "ocstack.h"
 #include "oic_malloc.h"
@@ -61,6 +62,14 @@ typedef struct _DiscoveryInfo{
     bool                isSingleDiscovery;
     bool                isFound;
     const OicUuid_t     *targetId;
+    const OicUuid_t     *expectedIds;       /**< Devices to resolve before the timeout. */
+    bool                *isExpectedResolved;
+    size_t              nOfExpectedIds;
+    size_t              nOfExpectedResolved;
+    size_t              expectedCount;      /**< Number of devices to resolve, 0 if none. */
+    size_t              nOfResolved;
+    void                *ctx;
+    OCDeviceDiscoveredCB discoveredCallback;
 } DiscoveryInfo;
 
 /*
@@ -632,6 +641,51 @@ bool OC_CALL PMGenerateQuery(bool isSecure,
     return true;
 }
 
+/*
+ * Function to report a device of ppDevicesList whose discovery is complete,
+ * and to check if the discovery has resolved the devices looked for.
+ *
+ * @param[in] discoveryInfo The pointer of discovery information to matain result of discovery
+ * @param[in] pDev          resolved device
+ */
+static void ResolveDevice(DiscoveryInfo* discoveryInfo, OCProvisionDev_t *pDev)
+{
+    if (NULL == pDev || NULL == pDev->doxm)
+    {
+        return;
+    }
+
+    // The handle of the spec version discovery, no more in use.
+    pDev->handle = NULL;
+    discoveryInfo->nOfResolved++;
+
+    for (size_t i = 0; i < discoveryInfo->nOfExpectedIds; i++)
+    {
+        if (!discoveryInfo->isExpectedResolved[i] &&
+            0 == memcmp(discoveryInfo->expectedIds[i].id, pDev->doxm->deviceID.id,
+                        sizeof(pDev->doxm->deviceID.id)))
+        {
+            discoveryInfo->isExpectedResolved[i] = true;
+            discoveryInfo->nOfExpectedResolved++;
+        }
+    }
+
+    if (discoveryInfo->discoveredCallback)
+    {
+        discoveryInfo->discoveredCallback(discoveryInfo->ctx, pDev);
+    }
+
+    if ((0 < discoveryInfo->nOfExpectedIds &&
+         discoveryInfo->nOfExpectedResolved == discoveryInfo->nOfExpectedIds) ||
+        (0 < discoveryInfo->expectedCount &&
+         discoveryInfo->nOfResolved >= discoveryInfo->expectedCount))
+    {
+        OIC_LOG_V(INFO, TAG, "Expected devices are resolved, %" PRIuPTR " devices",
+                  discoveryInfo->nOfResolved);
+        discoveryInfo->isFound = true;
+    }
+}
+
 /*
  * Since security version discovery does not used anymore, disable security version discovery.
  * Need to discussion to removing all version discovery related codes.
@@ -695,6 +749,9 @@ static OCStackApplicationResult SpecVersionDiscoveryHandler(void *ctx, OCDoHandl
             OIC_LOG_V(DEBUG, TAG, "IP %s", clientResponse->devAddr.addr);
             OIC_LOG_V(DEBUG, TAG, "PORT %d", clientResponse->devAddr.port);
             OIC_LOG_V(DEBUG, TAG, "VERSION %s", specVer);
+
+            ResolveDevice(pDInfo, GetDevice(pDInfo->ppDevicesList, clientResponse->devAddr.addr,
+                                            clientResponse->devAddr.port));
         }
     }
     else
@@ -865,6 +922,10 @@ static OCStackApplicationResult SecurePortDiscoveryHandler(void *ctx, OCDoHandle
                 if(OC_STACK_OK != res)
                 {
                     OIC_LOG(ERROR, TAG, "Failed to SpecVersionDiscovery");
+                    // The device is kept with the default spec version.
+                    ResolveDevice(pDInfo, GetDevice(pDInfo->ppDevicesList,
+                                                    clientResponse->devAddr.addr,
+                                                    clientResponse->devAddr.port));
                     return OC_STACK_DELETE_TRANSACTION;
                 }
             }
@@ -1131,13 +1192,42 @@ OCStackResult PMSingleDeviceDiscovery(unsigned short waittime, const OicUuid_t*
  */
 OCStackResult PMDeviceDiscovery(unsigned short waittime, bool isOwned, OCProvisionDev_t **ppDevicesList)
 {
-    OIC_LOG(DEBUG, TAG, "IN PMDeviceDiscovery");
+    return PMDeviceDiscoveryWithCallback(waittime, isOwned, NULL, 0, 0, NULL, NULL, ppDevicesList);
+}
+
+/**
+ * Discover owned/unowned devices in the same IP subnet, reporting each device as soon as
+ * it is resolved.
+ *
+ * @param[in] waittime            Timeout in seconds.
+ * @param[in] isOwned             bool flag for owned / unowned discovery
+ * @param[in] expectedIds         deviceIDs of the expected devices, it can be NULL.
+ * @param[in] nOfExpectedIds      number of expectedIds.
+ * @param[in] expectedCount       number of expected devices, 0 if not expected.
+ * @param[in] ctx                 context returned in discoveredCallback.
+ * @param[in] discoveredCallback  callback invoked for each resolved device, it can be NULL.
+ * @param[in] ppDevicesList       List of OCProvisionDev_t.
+ *
+ * @return OC_STACK_OK on success otherwise error.
+ */
+OCStackResult PMDeviceDiscoveryWithCallback(unsigned short waittime, bool isOwned,
+                                            const OicUuid_t *expectedIds, size_t nOfExpectedIds,
+                                            size_t expectedCount, void *ctx,
+                                            OCDeviceDiscoveredCB discoveredCallback,
+                                            OCProvisionDev_t **ppDevicesList)
+{
+    OIC_LOG(DEBUG, TAG, "IN PMDeviceDiscoveryWithCallback");
 
     if (NULL != *ppDevicesList)
     {
         OIC_LOG(ERROR, TAG, "List is not null can cause memory leak");
         return OC_STACK_INVALID_PARAM;
     }
+    if (NULL == expectedIds && 0 != nOfExpectedIds)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid expected device IDs");
+        return OC_STACK_INVALID_PARAM;
+    }
 
     const char DOXM_OWNED_FALSE_MULTICAST_QUERY[] = "/oic/sec/doxm?Owned=FALSE";
     const char DOXM_OWNED_TRUE_MULTICAST_QUERY[] = "/oic/sec/doxm?Owned=TRUE";
@@ -1145,15 +1235,32 @@ OCStackResult PMDeviceDiscovery(unsigned short waittime, bool isOwned, OCProvisi
     DiscoveryInfo *pDInfo = (DiscoveryInfo *)OICCalloc(1, sizeof(DiscoveryInfo));
     if(NULL == pDInfo)
     {
-        OIC_LOG(ERROR, TAG, "PMDeviceDiscovery : Memory allocation failed.");
+        OIC_LOG(ERROR, TAG, "PMDeviceDiscoveryWithCallback : Memory allocation failed.");
         return OC_STACK_NO_MEMORY;
     }
 
+    if (0 < nOfExpectedIds)
+    {
+        pDInfo->isExpectedResolved = (bool *)OICCalloc(nOfExpectedIds, sizeof(bool));
+        if (NULL == pDInfo->isExpectedResolved)
+        {
+            OIC_LOG(ERROR, TAG, "PMDeviceDiscoveryWithCallback : Memory allocation failed.");
+            OICFree(pDInfo);
+            return OC_STACK_NO_MEMORY;
+        }
+    }
+
     pDInfo->ppDevicesList = ppDevicesList;
     pDInfo->pCandidateList = NULL;
     pDInfo->isOwnedDiscovery = isOwned;
     pDInfo->isSingleDiscovery = false;
+    pDInfo->isFound = false;
     pDInfo->targetId = NULL;
+    pDInfo->expectedIds = expectedIds;
+    pDInfo->nOfExpectedIds = nOfExpectedIds;
+    pDInfo->expectedCount = expectedCount;
+    pDInfo->ctx = ctx;
+    pDInfo->discoveredCallback = discoveredCallback;
 
     OCCallbackData cbData;
     cbData.cb = &DeviceDiscoveryHandler;
@@ -1170,31 +1277,65 @@ OCStackResult PMDeviceDiscovery(unsigned short waittime, bool isOwned, OCProvisi
     if (res != OC_STACK_OK)
     {
         OIC_LOG(ERROR, TAG, "OCStack resource error");
+        OICFree(pDInfo->isExpectedResolved);
         OICFree(pDInfo);
         return res;
     }
 
-    //Waiting for each response.
-    res = PMTimeout(waittime, true);
+    //Waiting for each response, or until the expected devices are resolved.
+    res = OC_STACK_OK;
+    uint64_t startTime = OICGetCurrentTime(TIME_IN_MS);
+    while (OC_STACK_OK == res && !pDInfo->isFound)
+    {
+        uint64_t currTime = OICGetCurrentTime(TIME_IN_MS);
+
+        long elapsed = (long)((currTime - startTime) / MS_PER_SEC);
+        if (elapsed > waittime)
+        {
+            break;
+        }
+        res = OCProcess();
+    }
+
+    // The devices still waiting for the spec version are kept with the default one,
+    // and their requests are cancelled as pDInfo is freed.
+    OCProvisionDev_t *pDev = NULL;
+    LL_FOREACH(*ppDevicesList, pDev)
+    {
+        if (NULL != pDev->handle)
+        {
+            if (OC_STACK_OK != OCCancel(pDev->handle, OC_HIGH_QOS, NULL, 0))
+            {
+                OIC_LOG(ERROR, TAG, "Failed to remove registered callback");
+            }
+            ResolveDevice(pDInfo, pDev);
+        }
+    }
+
     if(OC_STACK_OK != res)
     {
         OIC_LOG(ERROR, TAG, "Failed to wait response for secure discovery.");
-        OICFree(pDInfo);
+        // The delete handler of the discovery uses pDInfo.
         OCStackResult resCancel = OCCancel(handle, OC_HIGH_QOS, NULL, 0);
         if(OC_STACK_OK !=  resCancel)
         {
             OIC_LOG(ERROR, TAG, "Failed to remove registered callback");
         }
+        OICFree(pDInfo->isExpectedResolved);
+        OICFree(pDInfo);
         return res;
     }
     res = OCCancel(handle,OC_HIGH_QOS,NULL,0);
     if (OC_STACK_OK != res)
     {
         OIC_LOG(ERROR, TAG, "Failed to remove registered callback");
+        OICFree(pDInfo->isExpectedResolved);
         OICFree(pDInfo);
         return res;
     }
-    OIC_LOG(DEBUG, TAG, "OUT PMDeviceDiscovery");
+    OIC_LOG_V(DEBUG, TAG, "OUT PMDeviceDiscoveryWithCallback, %" PRIuPTR " devices resolved",
+              pDInfo->nOfResolved);
+    OICFree(pDInfo->isExpectedResolved);
     OICFree(pDInfo);
     return res;
 }
@@ -1744,6 +1885,14 @@ static OCStackResult SpecVersionDiscovery(DiscoveryInfo* discoveryInfo,
         return OC_STACK_INVALID_PARAM;
     }
 
+    OCProvisionDev_t *pDev = GetDevice(discoveryInfo->ppDevicesList,
+                        clientResponse->devAddr.addr, clientResponse->devAddr.port);
+    if(NULL == pDev)
+    {
+        OIC_LOG(ERROR, TAG, "SpecVersionDiscovery : Failed to get device");
+        return OC_STACK_ERROR;
+    }
+
     //Try to the unicast discovery to getting security version
     char query[MAX_URI_LENGTH+MAX_QUERY_LENGTH+1] = {0};
     if(!PMGenerateQuery(false,
@@ -1760,7 +1909,9 @@ static OCStackResult SpecVersionDiscovery(DiscoveryInfo* discoveryInfo,
     cbData.cb = &SpecVersionDiscoveryHandler;
     cbData.context = (void*)discoveryInfo;
     cbData.cd = NULL;
-    OCStackResult ret = OCDoResource(NULL, OC_REST_DISCOVER, query, 0, 0,
+    // The handle is kept until the response, to cancel the request when the discovery ends.
+    pDev->handle = NULL;
+    OCStackResult ret = OCDoResource(&pDev->handle, OC_REST_DISCOVER, query, 0, 0,
             clientResponse->connType, OC_HIGH_QOS, &cbData, NULL, 0);
     if(OC_STACK_OK != ret)
     {
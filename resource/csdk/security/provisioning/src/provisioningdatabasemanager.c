@@ -23,6 +23,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <inttypes.h>
 
 #include "sqlite3.h"
 #include "experimental/logger.h"
@@ -47,7 +48,16 @@
 #define PDM_CREATE_DB "CREATE TABLE IF NOT EXISTS T_DEVICE_LIST(ID INTEGER PRIMARY KEY AUTOINCREMENT,\
                                   UUID BLOB NOT NULL UNIQUE, STATE INT NOT NULL);\
                        CREATE TABLE IF NOT EXISTS T_DEVICE_LINK_STATE(ID INT NOT NULL, ID2 INT NOT \
-                                    NULL,STATE INT NOT NULL, PRIMARY KEY (ID, ID2));"
+                                    NULL,STATE INT NOT NULL, PRIMARY KEY (ID, ID2));\
+                       CREATE INDEX IF NOT EXISTS I_DEVICE_LINK_STATE_ID2 ON \
+                                    T_DEVICE_LINK_STATE(ID2);"
+
+/*
+ * Changes are committed to a write-ahead log, so a commit needs no fsync of the database
+ * file. A commit may be lost on power failure, but the database stays consistent.
+ */
+#define PDM_SQLITE_JOURNAL_MODE "PRAGMA journal_mode=WAL;\
+                                 PRAGMA synchronous=NORMAL;"
 /**
  * Macro to verify sqlite success.
  * eg: VERIFY_NON_NULL(TAG, ptrData, ERROR,OC_STACK_ERROR);
@@ -78,7 +88,7 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_STALE_INFO);
 #define PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE (int)sizeof(PDM_SQLITE_INSERT_T_DEVICE_LIST)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_INSERT_T_DEVICE_LIST);
 
-#define PDM_SQLITE_GET_ID "SELECT ID FROM T_DEVICE_LIST WHERE UUID like ?"
+#define PDM_SQLITE_GET_ID "SELECT ID FROM T_DEVICE_LIST WHERE UUID = ?"
 #define PDM_SQLITE_GET_ID_SIZE (int)sizeof(PDM_SQLITE_GET_ID)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_ID);
 
@@ -94,6 +104,9 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_LINK);
 #define PDM_SQLITE_DELETE_DEVICE_SIZE (int)sizeof(PDM_SQLITE_DELETE_DEVICE)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_DEVICE);
 #define PDM_SQLITE_DELETE_DEVICE_WITH_STATE "DELETE FROM T_DEVICE_LIST  WHERE STATE= ?"
+#define PDM_SQLITE_DELETE_DEVICE_WITH_STATE_SIZE (int)sizeof(PDM_SQLITE_DELETE_DEVICE_WITH_STATE)
+PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_DELETE_DEVICE_WITH_STATE);
+
 #define PDM_SQLITE_UPDATE_LINK "UPDATE T_DEVICE_LINK_STATE SET STATE = ?  WHERE ID = ? and ID2 = ?"
 #define PDM_SQLITE_UPDATE_LINK_SIZE (int)sizeof(PDM_SQLITE_UPDATE_LINK)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_LINK);
@@ -106,8 +119,17 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_LIST_ALL_UUID);
 #define PDM_SQLITE_GET_UUID_SIZE (int)sizeof(PDM_SQLITE_GET_UUID)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_UUID);
 
-#define PDM_SQLITE_GET_LINKED_DEVICES "SELECT ID,ID2 FROM T_DEVICE_LINK_STATE WHERE \
-                                           (ID = ? or ID2 = ?) and state = 0"
+#define PDM_SQLITE_GET_LINKED_DEVICES "SELECT T_DEVICE_LIST.UUID FROM T_DEVICE_LINK_STATE \
+                                           LEFT JOIN T_DEVICE_LIST ON \
+                                           T_DEVICE_LIST.ID = T_DEVICE_LINK_STATE.ID2 WHERE \
+                                           T_DEVICE_LINK_STATE.ID = ?1 and \
+                                           T_DEVICE_LINK_STATE.STATE = 0 \
+                                       UNION ALL \
+                                       SELECT T_DEVICE_LIST.UUID FROM T_DEVICE_LINK_STATE \
+                                           LEFT JOIN T_DEVICE_LIST ON \
+                                           T_DEVICE_LIST.ID = T_DEVICE_LINK_STATE.ID WHERE \
+                                           T_DEVICE_LINK_STATE.ID2 = ?1 and \
+                                           T_DEVICE_LINK_STATE.STATE = 0"
 #define PDM_SQLITE_GET_LINKED_DEVICES_SIZE (int)sizeof(PDM_SQLITE_GET_LINKED_DEVICES)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_LINKED_DEVICES);
 
@@ -116,11 +138,11 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_LINKED_DEVICES);
 #define PDM_SQLITE_GET_DEVICE_LINKS_SIZE (int)sizeof(PDM_SQLITE_GET_DEVICE_LINKS)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_DEVICE_LINKS);
 
-#define PDM_SQLITE_UPDATE_DEVICE "UPDATE T_DEVICE_LIST SET STATE = ?  WHERE UUID like ?"
+#define PDM_SQLITE_UPDATE_DEVICE "UPDATE T_DEVICE_LIST SET STATE = ?  WHERE UUID = ?"
 #define PDM_SQLITE_UPDATE_DEVICE_SIZE (int)sizeof(PDM_SQLITE_UPDATE_DEVICE)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_DEVICE);
 
-#define PDM_SQLITE_GET_DEVICE_STATUS "SELECT STATE FROM T_DEVICE_LIST WHERE UUID like ?"
+#define PDM_SQLITE_GET_DEVICE_STATUS "SELECT STATE FROM T_DEVICE_LIST WHERE UUID = ?"
 #define PDM_SQLITE_GET_DEVICE_STATUS_SIZE (int)sizeof(PDM_SQLITE_GET_DEVICE_STATUS)
 PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_GET_DEVICE_STATUS);
 
@@ -137,8 +159,110 @@ PDM_VERIFY_STATEMENT_SIZE(PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE);
   { OIC_LOG(ERROR, TAG, "PDB is not initialized"); \
     return OC_STACK_PDM_IS_NOT_INITIALIZED; }}while(0)
 
+/**
+ * Statements which are prepared once and reused until PDMClose().
+ */
+typedef enum PdmStatement
+{
+    PDM_STMT_GET_STALE_INFO = 0,
+    PDM_STMT_INSERT_T_DEVICE_LIST,
+    PDM_STMT_GET_ID,
+    PDM_STMT_INSERT_LINK_DATA,
+    PDM_STMT_DELETE_LINK,
+    PDM_STMT_DELETE_DEVICE,
+    PDM_STMT_DELETE_DEVICE_WITH_STATE,
+    PDM_STMT_UPDATE_LINK,
+    PDM_STMT_LIST_ALL_UUID,
+    PDM_STMT_GET_UUID,
+    PDM_STMT_GET_LINKED_DEVICES,
+    PDM_STMT_GET_DEVICE_LINKS,
+    PDM_STMT_UPDATE_DEVICE,
+    PDM_STMT_GET_DEVICE_STATUS,
+    PDM_STMT_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
+    PDM_STMT_COUNT
+} PdmStatement_t;
+
+typedef struct PdmStatementSql
+{
+    const char *sql;
+    int size;
+} PdmStatementSql_t;
+
+/* In the order of PdmStatement_t. */
+static const PdmStatementSql_t g_statementSql[PDM_STMT_COUNT] =
+{
+    { PDM_SQLITE_GET_STALE_INFO, PDM_SQLITE_GET_STALE_INFO_SIZE },
+    { PDM_SQLITE_INSERT_T_DEVICE_LIST, PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE },
+    { PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE },
+    { PDM_SQLITE_INSERT_LINK_DATA, PDM_SQLITE_INSERT_LINK_DATA_SIZE },
+    { PDM_SQLITE_DELETE_LINK, PDM_SQLITE_DELETE_LINK_SIZE },
+    { PDM_SQLITE_DELETE_DEVICE, PDM_SQLITE_DELETE_DEVICE_SIZE },
+    { PDM_SQLITE_DELETE_DEVICE_WITH_STATE, PDM_SQLITE_DELETE_DEVICE_WITH_STATE_SIZE },
+    { PDM_SQLITE_UPDATE_LINK, PDM_SQLITE_UPDATE_LINK_SIZE },
+    { PDM_SQLITE_LIST_ALL_UUID, PDM_SQLITE_LIST_ALL_UUID_SIZE },
+    { PDM_SQLITE_GET_UUID, PDM_SQLITE_GET_UUID_SIZE },
+    { PDM_SQLITE_GET_LINKED_DEVICES, PDM_SQLITE_GET_LINKED_DEVICES_SIZE },
+    { PDM_SQLITE_GET_DEVICE_LINKS, PDM_SQLITE_GET_DEVICE_LINKS_SIZE },
+    { PDM_SQLITE_UPDATE_DEVICE, PDM_SQLITE_UPDATE_DEVICE_SIZE },
+    { PDM_SQLITE_GET_DEVICE_STATUS, PDM_SQLITE_GET_DEVICE_STATUS_SIZE },
+    { PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
+      PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE_SIZE }
+};
+
 static sqlite3 *g_db = NULL;
 static bool gInit = false;  /* Only if we can open sqlite db successfully, gInit is true. */
+static sqlite3_stmt *g_statements[PDM_STMT_COUNT] = { NULL, };
+
+/**
+ * Function to get a statement ready for binding. The statement is prepared at its first use.
+ * The caller calls releaseStatement() when done with it.
+ */
+static int getStatement(PdmStatement_t type, sqlite3_stmt **stmt)
+{
+    if (NULL == g_statements[type])
+    {
+        int res = sqlite3_prepare_v2(g_db, g_statementSql[type].sql, g_statementSql[type].size,
+                                     &g_statements[type], NULL);
+        if (SQLITE_OK != res)
+        {
+            g_statements[type] = NULL;
+            return res;
+        }
+    }
+    else
+    {
+        /* In case the previous user returned before releasing it. */
+        sqlite3_reset(g_statements[type]);
+        sqlite3_clear_bindings(g_statements[type]);
+    }
+
+    *stmt = g_statements[type];
+    return SQLITE_OK;
+}
+
+/**
+ * Function to reset a statement for the next use, so that it holds no lock meanwhile.
+ */
+static void releaseStatement(sqlite3_stmt *stmt)
+{
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+}
+
+/**
+ * Function to finalize the prepared statements
+ */
+static void finalizeStatements(void)
+{
+    for (size_t i = 0; i < PDM_STMT_COUNT; i++)
+    {
+        if (NULL != g_statements[i])
+        {
+            sqlite3_finalize(g_statements[i]);
+            g_statements[i] = NULL;
+        }
+    }
+}
 
 /**
  * Function to begin any transaction
@@ -218,6 +342,12 @@ OCStackResult PDMInit(const char *path)
         OIC_LOG_V(INFO, TAG, "ERROR: Can't open database: %s", sqlite3_errmsg(g_db));
         return OC_STACK_ERROR;
     }
+    rc = sqlite3_exec(g_db, PDM_SQLITE_JOURNAL_MODE, NULL, NULL, NULL);
+    if (SQLITE_OK != rc)
+    {
+        OIC_LOG_V(INFO, TAG, "Unable to use write-ahead log: %s", sqlite3_errmsg(g_db));
+    }
+
     //create DB in case DB doesn't exists
     rc = sqlite3_exec(g_db, PDM_CREATE_DB, NULL, NULL, NULL);
     if (SQLITE_OK != rc)
@@ -245,21 +375,16 @@ OCStackResult PDMInit(const char *path)
 }
 
 
-OCStackResult PDMAddDevice(const OicUuid_t *UUID)
+/**
+ * Function to add device in sqlite
+ */
+static OCStackResult addDevice(const OicUuid_t *UUID)
 {
     OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
 
-    CHECK_PDM_INIT();
-
-    if (NULL == UUID)
-    {
-        return OC_STACK_INVALID_PARAM;
-    }
-
     sqlite3_stmt *stmt = 0;
     int res =0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_INSERT_T_DEVICE_LIST,
-                              PDM_SQLITE_INSERT_T_DEVICE_LIST_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_INSERT_T_DEVICE_LIST, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_SECOND, UUID, UUID_LENGTH, SQLITE_STATIC);
@@ -275,14 +400,61 @@ OCStackResult PDMAddDevice(const OicUuid_t *UUID)
         {
             //new OCStack result code
             OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_DUPLICATE_UUID;
         }
         OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
+        return OC_STACK_ERROR;
+    }
+    releaseStatement(stmt);
+
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return OC_STACK_OK;
+}
+
+OCStackResult PDMAddDevice(const OicUuid_t *UUID)
+{
+    CHECK_PDM_INIT();
+
+    if (NULL == UUID)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    return addDevice(UUID);
+}
+
+OCStackResult PDMAddDevices(const OicUuid_t *uuidList, size_t numOfDevices)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+
+    if (NULL == uuidList && 0 != numOfDevices)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    if (OC_STACK_OK != begin())
+    {
+        return OC_STACK_ERROR;
+    }
+    for (size_t i = 0; i < numOfDevices; i++)
+    {
+        OCStackResult res = addDevice(&uuidList[i]);
+        if (OC_STACK_OK != res)
+        {
+            rollback();
+            OIC_LOG_V(ERROR, TAG, "Failed to add device %" PRIuPTR, i);
+            return res;
+        }
+    }
+    if (OC_STACK_OK != commit())
+    {
+        rollback();
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
 
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
@@ -305,8 +477,7 @@ static OCStackResult getIdForUUID(const OicUuid_t *UUID , int *id)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE,
-                             &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_ID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, UUID, UUID_LENGTH, SQLITE_STATIC);
@@ -318,11 +489,11 @@ static OCStackResult getIdForUUID(const OicUuid_t *UUID , int *id)
         int tempId = sqlite3_column_int(stmt, PDM_FIRST_INDEX);
         OIC_LOG_V(DEBUG, TAG, "ID is %d", tempId);
         *id = tempId;
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
         return OC_STACK_OK;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     return OC_STACK_INVALID_PARAM;
 }
 
@@ -341,8 +512,7 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* UUID, bool *result)
     }
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_ID, PDM_SQLITE_GET_ID_SIZE,
-                             &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_ID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, UUID, UUID_LENGTH, SQLITE_STATIC);
@@ -356,7 +526,7 @@ OCStackResult PDMIsDuplicateDevice(const OicUuid_t* UUID, bool *result)
         retValue = true;
     }
 
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     *result = retValue;
 
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
@@ -374,8 +544,7 @@ static OCStackResult addlink(int id1, int id2)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_INSERT_LINK_DATA,
-                              PDM_SQLITE_INSERT_LINK_DATA_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_INSERT_LINK_DATA, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -390,25 +559,21 @@ static OCStackResult addlink(int id1, int id2)
     if (sqlite3_step(stmt) != SQLITE_DONE)
     {
         OIC_LOG_V(ERROR, TAG, "Error Occured: %s",sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
 
-OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
+/**
+ * Function to link two active devices
+ */
+static OCStackResult linkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
 {
     OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
 
-    CHECK_PDM_INIT();
-    if (NULL == UUID1 || NULL == UUID2)
-    {
-        OIC_LOG(ERROR, TAG, "Invalid PARAM");
-        return  OC_STACK_INVALID_PARAM;
-    }
-
     PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
     if (OC_STACK_OK != PDMGetDeviceState(UUID1, &state))
     {
@@ -451,6 +616,47 @@ OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
     return addlink(id1, id2);
 }
 
+OCStackResult PDMLinkDevices(const OicUuid_t *UUID1, const OicUuid_t *UUID2)
+{
+    CHECK_PDM_INIT();
+    if (NULL == UUID1 || NULL == UUID2)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid PARAM");
+        return  OC_STACK_INVALID_PARAM;
+    }
+
+    return linkDevices(UUID1, UUID2);
+}
+
+OCStackResult PDMLinkDevicePairs(const OCPairList_t *pairList)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    CHECK_PDM_INIT();
+
+    if (OC_STACK_OK != begin())
+    {
+        return OC_STACK_ERROR;
+    }
+    for (const OCPairList_t *pair = pairList; NULL != pair; pair = pair->next)
+    {
+        OCStackResult res = linkDevices(&pair->dev, &pair->dev2);
+        if (OC_STACK_OK != res)
+        {
+            rollback();
+            return res;
+        }
+    }
+    if (OC_STACK_OK != commit())
+    {
+        rollback();
+        return OC_STACK_ERROR;
+    }
+
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return OC_STACK_OK;
+}
+
 /**
  * Function to remove created link
  */
@@ -462,8 +668,7 @@ static OCStackResult removeLink(int id1, int id2)
 
     int res = 0;
     sqlite3_stmt *stmt = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_LINK,
-                             PDM_SQLITE_DELETE_LINK_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_DELETE_LINK, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -475,10 +680,10 @@ static OCStackResult removeLink(int id1, int id2)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -520,8 +725,7 @@ static OCStackResult removeFromDeviceList(int id)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_DEVICE,
-                              PDM_SQLITE_DELETE_DEVICE_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_DELETE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -530,10 +734,10 @@ static OCStackResult removeFromDeviceList(int id)
     if (sqlite3_step(stmt) != SQLITE_DONE)
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -574,8 +778,7 @@ static OCStackResult updateLinkState(int id1, int id2, int state)
 
     sqlite3_stmt *stmt = 0;
     int res = 0 ;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_LINK,
-                              PDM_SQLITE_UPDATE_LINK_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_UPDATE_LINK, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -590,10 +793,10 @@ static OCStackResult updateLinkState(int id1, int id2, int state)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -639,8 +842,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
     }
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_LIST_ALL_UUID,
-                              PDM_SQLITE_LIST_ALL_UUID_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_LIST_ALL_UUID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     size_t counter  = 0;
@@ -652,7 +854,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
         if (NULL == temp)
         {
             OIC_LOG_V(ERROR, TAG, "Memory allocation problem");
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_NO_MEMORY;
         }
         memcpy(&temp->dev.id, uid->id, UUID_LENGTH);
@@ -660,7 +862,7 @@ OCStackResult PDMGetOwnedDevices(OCUuidList_t **uuidList, size_t *numOfDevices)
         ++counter;
     }
     *numOfDevices = counter;
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -679,8 +881,7 @@ static OCStackResult getUUIDforId(int id, OicUuid_t *uid, bool *result)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_UUID,
-                              PDM_SQLITE_GET_UUID_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_UUID, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -695,14 +896,55 @@ static OCStackResult getUUIDforId(int id, OicUuid_t *uid, bool *result)
             *result = (PDM_DEVICE_STALE == sqlite3_column_int(stmt, PDM_SECOND_INDEX)) ?
                         true : false;
         }
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_OK;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_INVALID_PARAM;
 }
 
+/**
+ * Function to get the devices which have an active link with the device of id
+ */
+static OCStackResult getLinkedDevices(int id, OCUuidList_t **uuidList, size_t *numOfDevices)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
+
+    sqlite3_stmt *stmt = 0;
+    int res = 0;
+    res = getStatement(PDM_STMT_GET_LINKED_DEVICES, &stmt);
+    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+
+    res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
+    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+
+    size_t counter  = 0;
+    while (SQLITE_ROW == sqlite3_step(stmt))
+    {
+        /* UUID of the linked device, NULL if the device was deleted. */
+        const void *ptr = sqlite3_column_blob(stmt, PDM_FIRST_INDEX);
+
+        OCUuidList_t *tempNode = (OCUuidList_t *) OICCalloc(1,sizeof(OCUuidList_t));
+        if (NULL == tempNode)
+        {
+            OIC_LOG(ERROR, TAG, "No Memory");
+            releaseStatement(stmt);
+            return OC_STACK_NO_MEMORY;
+        }
+        if (NULL != ptr)
+        {
+            memcpy(&tempNode->dev.id, ptr, UUID_LENGTH);
+        }
+        LL_PREPEND(*uuidList,tempNode);
+        ++counter;
+    }
+    *numOfDevices = counter;
+    releaseStatement(stmt);
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return OC_STACK_OK;
+}
+
 void PDMFreeLinkedDevices(OCUuidList_t *uuidList)
 {
     OCUuidList_t *p1 = NULL;
@@ -747,50 +989,103 @@ OCStackResult PDMGetLinkedDevices(const OicUuid_t *UUID, OCUuidList_t **UUIDLIST
         return OC_STACK_INVALID_PARAM;
     }
 
+    OCStackResult res = getLinkedDevices(id, UUIDLIST, numOfDevices);
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return res;
+}
 
-    sqlite3_stmt *stmt = 0;
-    int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_LINKED_DEVICES,
-                              PDM_SQLITE_GET_LINKED_DEVICES_SIZE, &stmt, NULL);
-    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
-
-    res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
-    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+OCStackResult PDMGetLinkedDevicePairs(const OCUuidList_t *uuidList, OCPairList_t **pairList,
+                                      size_t *numOfPairs)
+{
+    OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
 
-    res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_SECOND, id);
-    PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
+    CHECK_PDM_INIT();
+    if (NULL == pairList || NULL == numOfPairs)
+    {
+        return OC_STACK_INVALID_PARAM;
+    }
+    if (NULL != *pairList)
+    {
+        OIC_LOG(ERROR, TAG, "Not null list will cause memory leak");
+        return OC_STACK_INVALID_PARAM;
+    }
 
-    size_t counter  = 0;
-    while (SQLITE_ROW == sqlite3_step(stmt))
+    /* A single read transaction gives a consistent view of all the devices. */
+    if (OC_STACK_OK != begin())
     {
-        int i1 = sqlite3_column_int(stmt, PDM_FIRST_INDEX);
-        int i2 = sqlite3_column_int(stmt, PDM_SECOND_INDEX);
+        return OC_STACK_ERROR;
+    }
 
-        OicUuid_t temp = {{0,}};
-        if (i1 != id)
+    OCStackResult res = OC_STACK_OK;
+    OCPairList_t *pairs = NULL;
+    size_t counter = 0;
+    for (const OCUuidList_t *device = uuidList; NULL != device; device = device->next)
+    {
+        PdmDeviceState_t state = PDM_DEVICE_UNKNOWN;
+        if (OC_STACK_OK != PDMGetDeviceState(&device->dev, &state))
         {
-            getUUIDforId(i1, &temp, NULL);
+            OIC_LOG(ERROR, TAG, "Internal error occured");
+            res = OC_STACK_ERROR;
+            break;
         }
-        if (i2 != id)
+        if (PDM_DEVICE_ACTIVE != state)
         {
-            getUUIDforId(i2, &temp, NULL);
+            OIC_LOG_V(ERROR, TAG, "Device state is not active : %d", state);
+            res = OC_STACK_INVALID_PARAM;
+            break;
+        }
+        int id = 0;
+        if (OC_STACK_OK != getIdForUUID(&device->dev, &id))
+        {
+            OIC_LOG(ERROR, TAG, "Requested value not found");
+            res = OC_STACK_INVALID_PARAM;
+            break;
         }
 
-        OCUuidList_t *tempNode = (OCUuidList_t *) OICCalloc(1,sizeof(OCUuidList_t));
-        if (NULL == tempNode)
+        OCUuidList_t *linkedDevices = NULL;
+        size_t numOfLinkedDevices = 0;
+        res = getLinkedDevices(id, &linkedDevices, &numOfLinkedDevices);
+
+        OCUuidList_t *linkedDevice = NULL;
+        LL_FOREACH(linkedDevices, linkedDevice)
         {
-            OIC_LOG(ERROR, TAG, "No Memory");
-            sqlite3_finalize(stmt);
-            return OC_STACK_NO_MEMORY;
+            if (OC_STACK_OK != res)
+            {
+                break;
+            }
+
+            OCPairList_t *tempNode = (OCPairList_t *) OICCalloc(1, sizeof(OCPairList_t));
+            if (NULL == tempNode)
+            {
+                OIC_LOG(ERROR, TAG, "No Memory");
+                res = OC_STACK_NO_MEMORY;
+                break;
+            }
+            memcpy(&tempNode->dev.id, &device->dev.id, UUID_LENGTH);
+            memcpy(&tempNode->dev2.id, &linkedDevice->dev.id, UUID_LENGTH);
+            LL_PREPEND(pairs, tempNode);
+            ++counter;
+        }
+        PDMDestoryOicUuidLinkList(linkedDevices);
+
+        if (OC_STACK_OK != res)
+        {
+            break;
         }
-        memcpy(&tempNode->dev.id, &temp.id, UUID_LENGTH);
-        LL_PREPEND(*UUIDLIST,tempNode);
-        ++counter;
     }
-    *numOfDevices = counter;
-     sqlite3_finalize(stmt);
-     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
-     return OC_STACK_OK;
+
+    if (OC_STACK_OK != res)
+    {
+        rollback();
+        PDMDestoryStaleLinkList(pairs);
+        return res;
+    }
+    commit();
+
+    *pairList = pairs;
+    *numOfPairs = counter;
+    OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
+    return OC_STACK_OK;
 }
 
 OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *numOfDevices)
@@ -806,8 +1101,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_STALE_INFO,
-                              PDM_SQLITE_GET_STALE_INFO_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_STALE_INFO, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, PDM_DEVICE_STALE);
@@ -827,7 +1121,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
         if (NULL == tempNode)
         {
             OIC_LOG(ERROR, TAG, "No Memory");
-            sqlite3_finalize(stmt);
+            releaseStatement(stmt);
             return OC_STACK_NO_MEMORY;
         }
         memcpy(&tempNode->dev.id, &temp1.id, UUID_LENGTH);
@@ -836,7 +1130,7 @@ OCStackResult PDMGetToBeUnlinkedDevices(OCPairList_t **staleDevList, size_t *num
         ++counter;
     }
     *numOfDevices = counter;
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -849,6 +1143,8 @@ OCStackResult PDMClose(void)
 
     if (g_db)
     {
+        finalizeStatements();
+
         int res = 0;
         res = sqlite3_close(g_db);
         g_db = NULL;
@@ -945,8 +1241,7 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_DEVICE_LINKS,
-                              PDM_SQLITE_GET_DEVICE_LINKS_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_DEVICE_LINKS, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id1);
@@ -961,7 +1256,7 @@ OCStackResult PDMIsLinkExists(const OicUuid_t* uuidOfDevice1, const OicUuid_t* u
         OIC_LOG(INFO, TAG, "Link already exists between devices");
         ret = true;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     *result = ret;
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
@@ -975,8 +1270,7 @@ static OCStackResult updateDeviceState(const OicUuid_t *uuid, PdmDeviceState_t s
 
     sqlite3_stmt *stmt = 0;
     int res = 0 ;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_DEVICE,
-                              PDM_SQLITE_UPDATE_DEVICE_SIZE, &stmt, NULL);
+    res = getStatement(PDM_STMT_UPDATE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -988,10 +1282,10 @@ static OCStackResult updateDeviceState(const OicUuid_t *uuid, PdmDeviceState_t s
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1012,9 +1306,7 @@ static OCStackResult updateLinkForStaleDevice(const OicUuid_t *devUuid)
         return OC_STACK_INVALID_PARAM;
     }
 
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE,
-                              PDM_SQLITE_UPDATE_LINK_STALE_FOR_STALE_DEVICE_SIZE,
-                               &stmt, NULL);
+    res = getStatement(PDM_STMT_UPDATE_LINK_STALE_FOR_STALE_DEVICE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, id);
@@ -1026,10 +1318,10 @@ static OCStackResult updateLinkForStaleDevice(const OicUuid_t *devUuid)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1084,8 +1376,7 @@ OCStackResult PDMGetDeviceState(const OicUuid_t *uuid, PdmDeviceState_t* result)
 
     sqlite3_stmt *stmt = 0;
     int res = 0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_GET_DEVICE_STATUS, PDM_SQLITE_GET_DEVICE_STATUS_SIZE,
-                              &stmt, NULL);
+    res = getStatement(PDM_STMT_GET_DEVICE_STATUS, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_blob(stmt, PDM_BIND_INDEX_FIRST, uuid, UUID_LENGTH, SQLITE_STATIC);
@@ -1098,7 +1389,7 @@ OCStackResult PDMGetDeviceState(const OicUuid_t *uuid, PdmDeviceState_t* result)
         OIC_LOG_V(DEBUG, TAG, "Device state is %d", tempStaleStateFromDb);
         *result = (PdmDeviceState_t)tempStaleStateFromDb;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -1116,8 +1407,7 @@ OCStackResult PDMDeleteDeviceWithState(const PdmDeviceState_t state)
 
     sqlite3_stmt *stmt = 0;
     int res =0;
-    res = sqlite3_prepare_v2(g_db, PDM_SQLITE_DELETE_DEVICE_WITH_STATE,
-                              (int)strlen(PDM_SQLITE_DELETE_DEVICE_WITH_STATE) + 1, &stmt, NULL);
+    res = getStatement(PDM_STMT_DELETE_DEVICE_WITH_STATE, &stmt);
     PDM_VERIFY_SQLITE_OK(TAG, res, ERROR, OC_STACK_ERROR);
 
     res = sqlite3_bind_int(stmt, PDM_BIND_INDEX_FIRST, state);
@@ -1126,10 +1416,10 @@ OCStackResult PDMDeleteDeviceWithState(const PdmDeviceState_t state)
     if (SQLITE_DONE != sqlite3_step(stmt))
     {
         OIC_LOG_V(ERROR, TAG, "Error message: %s", sqlite3_errmsg(g_db));
-        sqlite3_finalize(stmt);
+        releaseStatement(stmt);
         return OC_STACK_ERROR;
     }
-    sqlite3_finalize(stmt);
+    releaseStatement(stmt);
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
     return OC_STACK_OK;
 }
@@ -502,7 +502,13 @@ static OCStackApplicationResult ProvisionCredentialDosCB2(void *ctx, OCDoHandle
                                                 &credData->deviceInfo[1]->doxm->deviceID);
             if (OC_STACK_OK != res)
             {
+                //Report the failure, the caller (e.g. a provisioning plan) waits for it.
                 OIC_LOG(ERROR, TAG, "Error occured on PDMLinkDevices");
+                credData->resArr[credData->numOfResults - 1].res = res;
+                ((OCProvisionResultCB)(resultCallback))(credData->ctx, credData->numOfResults,
+                                                        credData->resArr,
+                                                        true);
+                FreeData((Data_t *)ctx);
                 return OC_STACK_DELETE_TRANSACTION;
             }
             OIC_LOG(INFO, TAG, "Link created successfully");
@@ -19,6 +19,7 @@
  * *****************************************************************/
 #include <gtest/gtest.h>
 #include "ocprovisioningmanager.h"
+#include "provisioningdatabasemanager.h"
 
 static OicSecAcl_t acl1;
 static OicSecAcl_t acl2;
@@ -125,6 +126,115 @@ TEST(OCProvisionPairwiseDevicesTest, InvalidKeySize)
                                                               &pDev2, &acl2 ,&provisioningCB));
 }
 
+static void provisionPlanCB(void* UNUSED1, size_t UNUSED2, const OCProvisionStepResult_t *UNUSED3,
+                            uint64_t UNUSED4, bool UNUSED5)
+{
+    //dummy callback
+    (void) UNUSED1;
+    (void) UNUSED2;
+    (void) UNUSED3;
+    (void) UNUSED4;
+    (void) UNUSED5;
+}
+
+TEST(OCProvisionPlanTest, NullPlan)
+{
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCProvisionPlan(NULL, NULL, 1, 4, NULL, &provisionPlanCB));
+}
+
+TEST(OCProvisionPlanTest, NullCallback)
+{
+    OCProvisionStep_t plan[] = {
+        { OC_PROVISION_STEP_CREDENTIALS, &pDev1, &pDev2, NULL, credType, OWNER_PSK_LENGTH_128 }
+    };
+    EXPECT_EQ(OC_STACK_INVALID_CALLBACK, OCProvisionPlan(NULL, plan, 1, 4, NULL, NULL));
+}
+
+TEST(OCProvisionPlanTest, ZeroWindowSize)
+{
+    OCProvisionStep_t plan[] = {
+        { OC_PROVISION_STEP_CREDENTIALS, &pDev1, &pDev2, NULL, credType, OWNER_PSK_LENGTH_128 }
+    };
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCProvisionPlan(NULL, plan, 1, 0, NULL, &provisionPlanCB));
+}
+
+TEST(OCProvisionPlanTest, InvalidStep)
+{
+    OCProvisionStep_t plan[] = {
+        { OC_PROVISION_STEP_CREDENTIALS, &pDev1, &pDev2, NULL, credType, OWNER_PSK_LENGTH_128 },
+        { OC_PROVISION_STEP_ACL, &pDev1, NULL, NULL, credType, 0 }
+    };
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCProvisionPlan(NULL, plan, 2, 4, NULL, &provisionPlanCB));
+
+    plan[1].acl = &acl1;
+    plan[0].pDev2 = &pDev1;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCProvisionPlan(NULL, plan, 2, 4, NULL, &provisionPlanCB));
+
+    plan[0].pDev2 = &pDev2;
+    plan[0].keySize = 0;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCProvisionPlan(NULL, plan, 2, 4, NULL, &provisionPlanCB));
+}
+
+static bool g_planDone;
+static bool g_planHasError;
+static OCStackResult g_planStepRes;
+static OCStackResult g_planDevRes[2];
+
+static void checkPlanCB(void* UNUSED1, size_t nOfSteps, const OCProvisionStepResult_t *arr,
+                        uint64_t UNUSED2, bool hasError)
+{
+    (void) UNUSED1;
+    (void) UNUSED2;
+    ASSERT_EQ(1u, nOfSteps);
+    ASSERT_EQ(2u, arr[0].nOfDevResults);
+    g_planStepRes = arr[0].res;
+    g_planDevRes[0] = arr[0].devResults[0].res;
+    g_planDevRes[1] = arr[0].devResults[1].res;
+    g_planHasError = hasError;
+    g_planDone = true;
+}
+
+static void runCredentialsStep()
+{
+    OCProvisionStep_t plan[] = {
+        { OC_PROVISION_STEP_CREDENTIALS, &pDev1, &pDev2, NULL, credType, OWNER_PSK_LENGTH_128 }
+    };
+    g_planDone = false;
+    g_planHasError = false;
+    g_planStepRes = OC_STACK_CONTINUE;
+    // A rejected step finishes the plan before it returns, no request is sent.
+    EXPECT_EQ(OC_STACK_OK, OCProvisionPlan(NULL, plan, 1, 4, NULL, &checkPlanCB));
+    EXPECT_TRUE(g_planDone);
+}
+
+TEST(OCProvisionPlanTest, UnknownDevicesStepIsRejected)
+{
+    runCredentialsStep();
+    EXPECT_TRUE(g_planHasError);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planStepRes);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planDevRes[0]);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planDevRes[1]);
+}
+
+TEST(OCProvisionPlanTest, LinkedDevicesStepIsRejected)
+{
+    ASSERT_EQ(OC_STACK_OK, PDMAddDevice(&pDev1.doxm->deviceID));
+    ASSERT_EQ(OC_STACK_OK, PDMAddDevice(&pDev2.doxm->deviceID));
+    EXPECT_EQ(OC_STACK_OK, PDMSetDeviceState(&pDev1.doxm->deviceID, PDM_DEVICE_ACTIVE));
+    EXPECT_EQ(OC_STACK_OK, PDMSetDeviceState(&pDev2.doxm->deviceID, PDM_DEVICE_ACTIVE));
+    EXPECT_EQ(OC_STACK_OK, PDMLinkDevices(&pDev1.doxm->deviceID, &pDev2.doxm->deviceID));
+
+    runCredentialsStep();
+    EXPECT_TRUE(g_planHasError);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planStepRes);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planDevRes[0]);
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, g_planDevRes[1]);
+
+    EXPECT_EQ(OC_STACK_OK, PDMUnlinkDevices(&pDev1.doxm->deviceID, &pDev2.doxm->deviceID));
+    EXPECT_EQ(OC_STACK_OK, PDMDeleteDevice(&pDev1.doxm->deviceID));
+    EXPECT_EQ(OC_STACK_OK, PDMDeleteDevice(&pDev2.doxm->deviceID));
+}
+
 TEST(OCUnlinkDevicesTest, NullDevice1)
 {
     EXPECT_EQ(OC_STACK_INVALID_PARAM, OCUnlinkDevices(NULL, NULL, &pDev2, provisioningCB));
@@ -234,6 +344,47 @@ TEST(OCSetOwnerTransferCallbackDataTest, InvalidOXMType)
     &stOTMCallbackData));
 }
 
+TEST(OCDiscoverDevicesIncrementallyTest, NullList)
+{
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCDiscoverDevicesIncrementally(1, false, NULL, 0, 1,
+    NULL, NULL, NULL));
+}
+
+TEST(OCDiscoverDevicesIncrementallyTest, ZeroTimeout)
+{
+    OCProvisionDev_t *pDevList = NULL;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCDiscoverDevicesIncrementally(0, false, NULL, 0, 1,
+    NULL, NULL, &pDevList));
+}
+
+TEST(OCDiscoverDevicesIncrementallyTest, NullExpectedIds)
+{
+    OCProvisionDev_t *pDevList = NULL;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCDiscoverDevicesIncrementally(1, true, NULL, 2, 0,
+    NULL, NULL, &pDevList));
+}
+
+TEST(OCDoOwnershipTransferConcurrentlyTest, NullTargetDevice)
+{
+    size_t windowSize = 4;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCDoOwnershipTransferConcurrently(NULL, NULL, windowSize,
+    NULL, provisioningCB));
+}
+
+TEST(OCDoOwnershipTransferConcurrentlyTest, NullResultCallback)
+{
+    size_t windowSize = 4;
+    EXPECT_EQ(OC_STACK_INVALID_CALLBACK, OCDoOwnershipTransferConcurrently(NULL, &pDev1,
+    windowSize, NULL, NULL));
+}
+
+TEST(OCDoOwnershipTransferConcurrentlyTest, ZeroWindowSize)
+{
+    size_t windowSize = 0;
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCDoOwnershipTransferConcurrently(NULL, &pDev1,
+    windowSize, NULL, provisioningCB));
+}
+
 TEST(OCResetDeviceTest, NULLCallback)
 {
     unsigned short waitTime = 10;
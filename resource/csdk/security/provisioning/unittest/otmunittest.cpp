@@ -19,12 +19,14 @@
  * *****************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <inttypes.h>
 #include <gtest/gtest.h>
 #include "ocstack.h"
 #include "utlist.h"
 #include "experimental/logger.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "ocprovisioningmanager.h"
 #include "oxmjustworks.h"
 #include "oxmrandompin.h"
@@ -306,6 +308,77 @@ TEST(OCDiscoverSingleDeviceInUnicast, Simple)
     //EXPECT_EQ(true, NumOfFoundDevice > 0);
 }
 */
+#define NUM_OF_SAMPLE_SERVERS 7
+
+static OicUuid_t g_expectedIds[NUM_OF_SAMPLE_SERVERS];
+static size_t g_numOfDiscovered;
+static bool g_isUnexpectedDiscovered;
+static uint64_t g_firstDiscoveredTime;
+
+static void deviceDiscoveredCB(void *ctx, const OCProvisionDev_t *device)
+{
+    OC_UNUSED(ctx);
+
+    bool isExpected = false;
+    for (size_t i = 0; i < NUM_OF_SAMPLE_SERVERS; i++)
+    {
+        if (0 == memcmp(g_expectedIds[i].id, device->doxm->deviceID.id, UUID_LENGTH))
+        {
+            isExpected = true;
+        }
+    }
+    g_isUnexpectedDiscovered = g_isUnexpectedDiscovered || !isExpected;
+
+    if (0 == g_numOfDiscovered)
+    {
+        g_firstDiscoveredTime = OICGetCurrentTime(TIME_IN_MS);
+    }
+    g_numOfDiscovered++;
+}
+
+/*
+ * Each sample server is reported once resolved, and the discovery returns as soon as all of
+ * them are resolved instead of waiting for the timeout.
+ */
+TEST(OCDiscoverDevicesIncrementally, ExpectedDevicesEndDiscovery)
+{
+    //initialize Provisioning DB Manager
+    EXPECT_EQ(OC_STACK_OK, OCInitPM(PM_DB_FILE_NAME));
+
+    for (size_t i = 0; i < NUM_OF_SAMPLE_SERVERS; i++)
+    {
+        char uuidString[UUID_STRING_SIZE];
+        snprintf(uuidString, sizeof(uuidString), UUID_TEMPLATE "%zu", i + 1);
+        ASSERT_EQ(OC_STACK_OK, ConvertStrToUuid(uuidString, &g_expectedIds[i]));
+    }
+
+    g_numOfDiscovered = 0;
+    g_isUnexpectedDiscovered = false;
+    g_firstDiscoveredTime = 0;
+    OCProvisionDev_t *foundDevices = NULL;
+
+    uint64_t startTime = OICGetCurrentTime(TIME_IN_MS);
+    EXPECT_EQ(OC_STACK_OK, OCDiscoverDevicesIncrementally(DISCOVERY_TIMEOUT, false,
+              g_expectedIds, NUM_OF_SAMPLE_SERVERS, 0, NULL, deviceDiscoveredCB,
+              &foundDevices));
+    uint64_t endTime = OICGetCurrentTime(TIME_IN_MS);
+
+    size_t numOfFound = 0;
+    OCProvisionDev_t *tempDev = NULL;
+    LL_COUNT(foundDevices, tempDev, numOfFound);
+
+    EXPECT_EQ((size_t)NUM_OF_SAMPLE_SERVERS, g_numOfDiscovered);
+    EXPECT_EQ(g_numOfDiscovered, numOfFound);
+    EXPECT_FALSE(g_isUnexpectedDiscovered);
+    EXPECT_LT(endTime - startTime, (uint64_t)DISCOVERY_TIMEOUT * 1000);
+    EXPECT_LE(startTime, g_firstDiscoveredTime);
+    EXPECT_LE(g_firstDiscoveredTime, endTime);
+
+    PMDeleteDeviceList(foundDevices);
+    // close Provisioning DB
+    EXPECT_EQ(OC_STACK_OK, OCClosePM());
+}
+
 TEST(OCDiscoverUnownedDevices, Simple)
 {
     //initialize Provisioning DB Manager
@@ -343,6 +416,163 @@ TEST(OCDiscoverUnownedDevices, Simple)
     EXPECT_EQ(OC_STACK_OK, OCClosePM());
 }
 
+static bool g_batchDoneCB;
+static bool g_batchCallbackResult;
+static size_t g_numOfBatchProgress;
+
+static void batchProgressCB(void *ctx, const OCProvisionResult_t *result, size_t nOfDone,
+                            size_t nOfDevices)
+{
+    OC_UNUSED(ctx);
+    OC_UNUSED(result);
+    OC_UNUSED(nOfDone);
+    OC_UNUSED(nOfDevices);
+
+    OIC_LOG_V(DEBUG, TAG, "%s: %zu of %zu done, res: %d", __func__, nOfDone, nOfDevices,
+              result ? result->res : OC_STACK_ERROR);
+    g_numOfBatchProgress++;
+}
+
+static void batchResultCB(void *ctx, size_t UNUSED1, OCProvisionResult_t *UNUSED2, bool hasError)
+{
+    OC_UNUSED(UNUSED1);
+    OC_UNUSED(UNUSED2);
+    OC_UNUSED(ctx);
+
+    g_batchCallbackResult = !hasError;
+    g_batchDoneCB = true;
+
+    OIC_LOG_V(DEBUG, TAG, "%s: done(has erro: %s)", __func__, hasError ? "yes" : "no");
+}
+
+/**
+ * Takes the device with the given id out of the list of unowned devices.
+ */
+static OCProvisionDev_t *detachUnownedDevice(const char *uuidString)
+{
+    OicUuid_t uuid;
+    if (OC_STACK_OK != ConvertStrToUuid(uuidString, &uuid))
+    {
+        return NULL;
+    }
+
+    OCProvisionDev_t *tempDev1 = NULL;
+    OCProvisionDev_t *tempDev2 = NULL;
+    LL_FOREACH_SAFE(g_unownedDevices, tempDev1, tempDev2)
+    {
+        if (0 == memcmp(tempDev1->doxm->deviceID.id, uuid.id, UUID_LENGTH))
+        {
+            LL_DELETE(g_unownedDevices, tempDev1);
+            tempDev1->next = NULL;
+            gNumOfUnownDevice--;
+            return tempDev1;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Servers 3 and 4 are owned by a concurrent and a sequential ownership transfer running at
+ * the same time, which take turns at setting up the sessions with the devices.
+ * Servers 5 to 7 are owned by a concurrent ownership transfer with a window of 2 devices.
+ * Servers 1 and 2 are left to the tests below.
+ */
+TEST(OCDoOwnershipTransferConcurrently, WithSequentialTransfer)
+{
+    //initialize Provisioning DB Manager
+    EXPECT_EQ(OC_STACK_OK, OCInitPM(PM_DB_FILE_NAME));
+
+    OCProvisionDev_t *batchDev = detachUnownedDevice(UUID_TEMPLATE "3");
+    OCProvisionDev_t *sequentialDev = detachUnownedDevice(UUID_TEMPLATE "4");
+    if (NULL == batchDev || NULL == sequentialDev)
+    {
+        PMDeleteDeviceList(batchDev);
+        PMDeleteDeviceList(sequentialDev);
+        EXPECT_EQ(OC_STACK_OK, OCClosePM());
+        FAIL() << "servers 3 and 4 were not discovered";
+    }
+
+    g_doneCB = false;
+    g_callbackResult = false;
+    g_batchDoneCB = false;
+    g_batchCallbackResult = false;
+    g_numOfBatchProgress = 0;
+    EXPECT_EQ(OC_STACK_OK, OCDoOwnershipTransferConcurrently((void *)g_otmCtx, batchDev, 1,
+              batchProgressCB, batchResultCB));
+    EXPECT_EQ(OC_STACK_OK, OCDoOwnershipTransfer((void *)g_otmCtx, sequentialDev,
+              ownershipTransferCB));
+
+    for (int i = 0; !(g_doneCB && g_batchDoneCB) && OTM_TIMEOUT > i; ++i)
+    {
+        sleep(1);
+        if (OC_STACK_OK != OCProcess())
+        {
+            OIC_LOG(FATAL, TAG, "OCStack process error");
+            break;
+        }
+    }
+
+    EXPECT_EQ(true, g_batchDoneCB);
+    EXPECT_EQ(true, g_batchCallbackResult);
+    EXPECT_EQ(1u, g_numOfBatchProgress);
+    EXPECT_EQ(true, g_doneCB);
+    EXPECT_EQ(true, g_callbackResult);
+
+    PMDeleteDeviceList(batchDev);
+    PMDeleteDeviceList(sequentialDev);
+    // close Provisioning DB
+    EXPECT_EQ(OC_STACK_OK, OCClosePM());
+}
+
+TEST(OCDoOwnershipTransferConcurrently, MultipleDevicesInWindow)
+{
+    //initialize Provisioning DB Manager
+    EXPECT_EQ(OC_STACK_OK, OCInitPM(PM_DB_FILE_NAME));
+
+    OCProvisionDev_t *batchDevs = NULL;
+    size_t numOfBatchDevs = 0;
+    const char *uuids[] = { UUID_TEMPLATE "5", UUID_TEMPLATE "6", UUID_TEMPLATE "7" };
+    for (size_t i = 0; i < sizeof(uuids) / sizeof(uuids[0]); ++i)
+    {
+        OCProvisionDev_t *dev = detachUnownedDevice(uuids[i]);
+        if (NULL != dev)
+        {
+            LL_APPEND(batchDevs, dev);
+            numOfBatchDevs++;
+        }
+    }
+    if (sizeof(uuids) / sizeof(uuids[0]) != numOfBatchDevs)
+    {
+        PMDeleteDeviceList(batchDevs);
+        EXPECT_EQ(OC_STACK_OK, OCClosePM());
+        FAIL() << "servers 5 to 7 were not discovered";
+    }
+
+    g_batchDoneCB = false;
+    g_batchCallbackResult = false;
+    g_numOfBatchProgress = 0;
+    EXPECT_EQ(OC_STACK_OK, OCDoOwnershipTransferConcurrently((void *)g_otmCtx, batchDevs, 2,
+              batchProgressCB, batchResultCB));
+
+    for (int i = 0; !g_batchDoneCB && OTM_TIMEOUT > i; ++i)
+    {
+        sleep(1);
+        if (OC_STACK_OK != OCProcess())
+        {
+            OIC_LOG(FATAL, TAG, "OCStack process error");
+            break;
+        }
+    }
+
+    EXPECT_EQ(true, g_batchDoneCB);
+    EXPECT_EQ(true, g_batchCallbackResult);
+    EXPECT_EQ(numOfBatchDevs, g_numOfBatchProgress);
+
+    PMDeleteDeviceList(batchDevs);
+    // close Provisioning DB
+    EXPECT_EQ(OC_STACK_OK, OCClosePM());
+}
+
 TEST(OCDoOwnershipTransfer, Simple)
 {
     //initialize Provisioning DB Manager
@@ -386,6 +616,119 @@ TEST(OCDiscoverOwnedDevices, Simple)
     EXPECT_EQ(OC_STACK_OK, OCClosePM());
 }
 
+#define NUM_OF_PLAN_STEPS 3
+
+static bool g_planDoneCB;
+static bool g_planCallbackResult;
+static size_t g_planStepOrder[NUM_OF_PLAN_STEPS];
+static size_t g_numOfPlanProgress;
+static OCProvisionStepResult_t g_planResults[NUM_OF_PLAN_STEPS];
+
+static void planProgressCB(void *ctx, const OCProvisionStepResult_t *result, size_t nOfDone,
+                           size_t nOfSteps)
+{
+    OC_UNUSED(ctx);
+    OC_UNUSED(nOfSteps);
+
+    OIC_LOG_V(DEBUG, TAG, "%s: step %zu done(%zu), res: %d", __func__, result->stepIndex,
+              nOfDone, result->res);
+    if (NUM_OF_PLAN_STEPS > g_numOfPlanProgress)
+    {
+        g_planStepOrder[g_numOfPlanProgress] = result->stepIndex;
+    }
+    g_numOfPlanProgress++;
+}
+
+static void planResultCB(void *ctx, size_t nOfSteps, const OCProvisionStepResult_t *arr,
+                         uint64_t elapsedTime, bool hasError)
+{
+    OC_UNUSED(ctx);
+
+    OIC_LOG_V(DEBUG, TAG, "%s: done in %" PRIu64 " ms(has error: %s)", __func__, elapsedTime,
+              hasError ? "yes" : "no");
+    for (size_t i = 0; i < nOfSteps && NUM_OF_PLAN_STEPS > i; i++)
+    {
+        g_planResults[i] = arr[i];
+    }
+    g_planCallbackResult = !hasError;
+    g_planDoneCB = true;
+}
+
+/*
+ * The credentials steps of devices 1-2 and 3-4 are independent and run at the same time,
+ * the step of devices 1-3 waits for both of them.
+ */
+TEST(OCProvisionPlan, IndependentStepsRunConcurrently)
+{
+    //initialize Provisioning DB Manager
+    EXPECT_EQ(OC_STACK_OK, OCInitPM(PM_DB_FILE_NAME));
+
+    OicUuid_t myUuid;
+    EXPECT_EQ(OC_STACK_OK, GetDoxmDeviceID(&myUuid));
+
+    //Extract target devices except PT.
+    OCProvisionDev_t *devs[4] = { NULL, NULL, NULL, NULL };
+    size_t numOfDevs = 0;
+    for (OCProvisionDev_t *tempDev = g_ownedDevices; tempDev && 4 > numOfDevs;
+         tempDev = tempDev->next)
+    {
+        if (memcmp(tempDev->doxm->deviceID.id, myUuid.id, UUID_LENGTH) != 0)
+        {
+            devs[numOfDevs++] = tempDev;
+        }
+    }
+    if (4 > numOfDevs)
+    {
+        EXPECT_EQ(OC_STACK_OK, OCClosePM());
+        FAIL() << "4 owned devices are needed, found " << numOfDevs;
+    }
+
+    OCProvisionStep_t plan[NUM_OF_PLAN_STEPS] = {
+        { OC_PROVISION_STEP_CREDENTIALS, devs[0], devs[1], NULL, SYMMETRIC_PAIR_WISE_KEY,
+          OWNER_PSK_LENGTH_128 },
+        { OC_PROVISION_STEP_CREDENTIALS, devs[2], devs[3], NULL, SYMMETRIC_PAIR_WISE_KEY,
+          OWNER_PSK_LENGTH_128 },
+        { OC_PROVISION_STEP_CREDENTIALS, devs[0], devs[2], NULL, SYMMETRIC_PAIR_WISE_KEY,
+          OWNER_PSK_LENGTH_128 }
+    };
+
+    g_planDoneCB = false;
+    g_planCallbackResult = false;
+    g_numOfPlanProgress = 0;
+    EXPECT_EQ(OC_STACK_OK, OCProvisionPlan((void *)g_otmCtx, plan, NUM_OF_PLAN_STEPS, 4,
+              planProgressCB, planResultCB));
+
+    for (int i = 0; !g_planDoneCB && OTM_TIMEOUT > i; ++i)
+    {
+        sleep(1);
+        if (OC_STACK_OK != OCProcess())
+        {
+            OIC_LOG(FATAL, TAG, "OCStack process error");
+            break;
+        }
+    }
+
+    ASSERT_EQ(true, g_planDoneCB);
+    EXPECT_EQ(true, g_planCallbackResult);
+    EXPECT_EQ((size_t)NUM_OF_PLAN_STEPS, g_numOfPlanProgress);
+
+    const OCProvisionStepResult_t *first = &g_planResults[0];
+    const OCProvisionStepResult_t *second = &g_planResults[1];
+    const OCProvisionStepResult_t *dependent = &g_planResults[2];
+
+    //The independent steps overlap.
+    EXPECT_LT(second->startTime, first->startTime + first->elapsedTime);
+    EXPECT_LT(first->startTime, second->startTime + second->elapsedTime);
+
+    //The dependent step starts after both of them, and finishes last.
+    EXPECT_GE(dependent->startTime, first->startTime + first->elapsedTime);
+    EXPECT_GE(dependent->startTime, second->startTime + second->elapsedTime);
+    EXPECT_EQ(2u, g_planStepOrder[NUM_OF_PLAN_STEPS - 1]);
+
+    // close Provisioning DB
+    EXPECT_EQ(OC_STACK_OK, OCClosePM());
+}
+
 TEST(PerformLinkDevices, NullParam)
 {
     if (gNumOfOwnDevice < 2)
@@ -42,6 +42,9 @@ const char ID_10[] = "1222222222222222";
 const char ID_11[] = "2222222222222222";
 const char ID_12[] = "3222222222222222";
 const char ID_13[] = "4222222222222222";
+const char ID_14[] = "5222222222222222";
+const char ID_15[] = "6222222222222222";
+const char ID_16[] = "7222222222222222";
 
 
 TEST(CallPDMAPIbeforeInit, BeforeInit)
@@ -437,3 +440,55 @@ TEST(PDMSetDeviceStaleTest, StaleDeviceNotinLinkedDevice)
     }
     EXPECT_EQ(OC_STACK_OK, PDMClose());
 }
+
+TEST(PDMAddDevicesTest, DuplicateUUID)
+{
+    EXPECT_EQ(OC_STACK_OK, PDMInit(NULL));
+    OicUuid_t uids[3] = {{{0,}}};
+    memcpy(&uids[0].id, ID_14, sizeof(uids[0].id));
+    memcpy(&uids[1].id, ID_15, sizeof(uids[1].id));
+    memcpy(&uids[2].id, ID_14, sizeof(uids[2].id));
+
+    EXPECT_NE(OC_STACK_OK, PDMAddDevices(uids, 3));
+
+    bool isDuplicate = true;
+    EXPECT_EQ(OC_STACK_OK, PDMIsDuplicateDevice(&uids[0], &isDuplicate));
+    EXPECT_FALSE(isDuplicate);
+    EXPECT_EQ(OC_STACK_OK, PDMIsDuplicateDevice(&uids[1], &isDuplicate));
+    EXPECT_FALSE(isDuplicate);
+    EXPECT_EQ(OC_STACK_OK, PDMClose());
+}
+
+TEST(PDMGetLinkedDevicePairs, ValidCase)
+{
+    EXPECT_EQ(OC_STACK_OK, PDMInit(NULL));
+    OicUuid_t uids[3] = {{{0,}}};
+    memcpy(&uids[0].id, ID_14, sizeof(uids[0].id));
+    memcpy(&uids[1].id, ID_15, sizeof(uids[1].id));
+    memcpy(&uids[2].id, ID_16, sizeof(uids[2].id));
+
+    EXPECT_EQ(OC_STACK_OK, PDMAddDevices(uids, 3));
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(OC_STACK_OK, PDMSetDeviceState(&uids[i], PDM_DEVICE_ACTIVE));
+    }
+
+    OCPairList_t pair2 = {uids[1], uids[2], NULL};
+    OCPairList_t pair1 = {uids[0], uids[1], &pair2};
+    EXPECT_EQ(OC_STACK_OK, PDMLinkDevicePairs(&pair1));
+
+    OCUuidList_t dev2 = {uids[1], NULL};
+    OCUuidList_t dev1 = {uids[0], &dev2};
+    OCPairList_t *pairList = NULL;
+    size_t numOfPairs = 0;
+    EXPECT_EQ(OC_STACK_OK, PDMGetLinkedDevicePairs(&dev1, &pairList, &numOfPairs));
+    EXPECT_EQ(3u, numOfPairs);
+    for (OCPairList_t *ptr = pairList; NULL != ptr; ptr = ptr->next)
+    {
+        bool isLinked = false;
+        EXPECT_EQ(OC_STACK_OK, PDMIsLinkExists(&ptr->dev, &ptr->dev2, &isLinked));
+        EXPECT_TRUE(isLinked);
+    }
+    PDMDestoryStaleLinkList(pairList);
+    EXPECT_EQ(OC_STACK_OK, PDMClose());
+}
@@ -42,6 +42,7 @@
 #include "ocpayload.h"
 #include "ocpayloadcbor.h"
 #include "utlist.h"
+#include "octhread.h"
 #include "credresource.h"
 #include "experimental/doxmresource.h"
 #include "pstatresource.h"
@@ -139,6 +140,410 @@ static void DeleteCredIdList(CredIdList_t** list)
     }
 }
 
+/** Minimum number of buckets of a cred index. */
+#define CRED_INDEX_MIN_BUCKETS 16
+
+/** Position of no entry in a cred index. */
+#define CRED_INDEX_NONE SIZE_MAX
+
+/**
+ * Entry of a cred index.
+ */
+typedef struct
+{
+    OicSecCred_t *cred;                     /**< Indexed cred of gCred. */
+    size_t next;                            /**< Next entry of the bucket. */
+} CredIndexEntry_t;
+
+/**
+ * Hash index of gCred. A bucket chains its entries in the order of gCred, so the creds
+ * of a key are found in the order a walk over gCred finds them.
+ */
+typedef struct
+{
+    size_t numOfBuckets;                    /**< Number of buckets, a power of 2. */
+    size_t *buckets;                        /**< First entry of each bucket. */
+    CredIndexEntry_t *entries;              /**< Entries of the indexed creds. */
+} CredIndex_t;
+
+/**
+ * Indexes of gCred by credId, subject and usage, built together from one state of gCred.
+ */
+typedef struct
+{
+    CredIndex_t byId;                       /**< Index by credId. */
+    CredIndex_t bySubject;                  /**< Index by subject. */
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    CredIndex_t byUsage;                    /**< Index by credUsage. */
+#endif
+    uint32_t nextCredId;                    /**< Smallest credId not in gCred. */
+} CredIndexSet_t;
+
+/**
+ * Gets the hash of the key of a cred. Returns false if the cred is not indexed.
+ */
+typedef bool (*CredIndexHash_t)(const OicSecCred_t *cred, uint32_t *hash);
+
+/**
+ * Checks if a cred matches the argument of a lookup.
+ */
+typedef bool (*CredIndexMatch_t)(const OicSecCred_t *cred, const void *arg);
+
+/**
+ * Iterator over the creds matching a lookup, in the order of gCred.
+ * It walks a bucket of an index, or gCred if no index is published.
+ */
+typedef struct
+{
+    const CredIndex_t *index;               /**< Index to walk, NULL to walk gCred. */
+    size_t pos;                             /**< Next entry of the bucket. */
+    OicSecCred_t *cred;                     /**< Next cred of gCred. */
+    CredIndexMatch_t match;                 /**< Match of the lookup. */
+    const void *arg;                        /**< Argument of the lookup. */
+} CredIter_t;
+
+/*
+ * Indexes of gCred. gCred is only changed by the thread processing requests, while the
+ * CA thread looks creds up for the DTLS handshakes. So the indexes are only built and freed
+ * by the thread changing gCred, right after the change, and lookups just take the published
+ * set under gCredIndexMutex. A change unpublishes the set first, so lookups walk gCred until
+ * the set of the new gCred is published. An unpublished set is freed at the next change, not
+ * at once, so that a lookup which took the set before the change does not walk freed buckets
+ * and entries. The creds the entries point to are not kept: a removed cred is freed at once
+ * by FreeCred, so as for a walk of gCred itself, a lookup must not run while the creds it may
+ * reach are removed.
+ */
+static CredIndexSet_t *gCredIndexSet = NULL;
+static CredIndexSet_t *gRetiredCredIndexSet = NULL;
+static oc_mutex gCredIndexMutex = NULL;
+
+static uint32_t HashCredBytes(const uint8_t *data, size_t len)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool HashCredId(const OicSecCred_t *cred, uint32_t *hash)
+{
+    *hash = HashCredBytes((const uint8_t *)&cred->credId, sizeof(cred->credId));
+    return true;
+}
+
+static bool HashCredSubject(const OicSecCred_t *cred, uint32_t *hash)
+{
+    *hash = HashCredBytes(cred->subject.id, sizeof(cred->subject.id));
+    return true;
+}
+
+static bool IsCredOfId(const OicSecCred_t *cred, const void *arg)
+{
+    return cred->credId == *(const uint16_t *)arg;
+}
+
+static bool IsCredOfSubject(const OicSecCred_t *cred, const void *arg)
+{
+    return 0 == memcmp(cred->subject.id, ((const OicUuid_t *)arg)->id, sizeof(cred->subject.id));
+}
+
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+static bool HashCredUsage(const OicSecCred_t *cred, uint32_t *hash)
+{
+    if (NULL == cred->credUsage)
+    {
+        return false;
+    }
+    *hash = HashCredBytes((const uint8_t *)cred->credUsage, strlen(cred->credUsage));
+    return true;
+}
+
+static bool IsCredOfUsage(const OicSecCred_t *cred, const void *arg)
+{
+    return NULL != cred->credUsage && 0 == strcmp(cred->credUsage, (const char *)arg);
+}
+#endif
+
+static void LockCredIndex(void)
+{
+    if (NULL != gCredIndexMutex)
+    {
+        oc_mutex_lock(gCredIndexMutex);
+    }
+}
+
+static void UnlockCredIndex(void)
+{
+    if (NULL != gCredIndexMutex)
+    {
+        oc_mutex_unlock(gCredIndexMutex);
+    }
+}
+
+static void FreeCredIndex(CredIndex_t *index)
+{
+    OICFree(index->buckets);
+    OICFree(index->entries);
+}
+
+static void FreeCredIndexSet(CredIndexSet_t *set)
+{
+    if (NULL == set)
+    {
+        return;
+    }
+    FreeCredIndex(&set->byId);
+    FreeCredIndex(&set->bySubject);
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    FreeCredIndex(&set->byUsage);
+#endif
+    OICFree(set);
+}
+
+/**
+ * Unpublishes the indexes of gCred. It must be called before creds are added to or
+ * removed from gCred, or their credId, subject or usage change, and only by the thread
+ * changing gCred.
+ */
+static void InvalidateCredIndex(void)
+{
+    LockCredIndex();
+    CredIndexSet_t *set = gCredIndexSet;
+    gCredIndexSet = NULL;
+    UnlockCredIndex();
+
+    if (NULL != set)
+    {
+        FreeCredIndexSet(gRetiredCredIndexSet);
+        gRetiredCredIndexSet = set;
+    }
+}
+
+static void FreeCredIndexes(void)
+{
+    InvalidateCredIndex();
+    FreeCredIndexSet(gRetiredCredIndexSet);
+    gRetiredCredIndexSet = NULL;
+}
+
+static bool AllocCredIndex(CredIndex_t *index, size_t numOfBuckets, size_t numOfCreds)
+{
+    index->buckets = (size_t *)OICMalloc(numOfBuckets * sizeof(size_t));
+    index->entries =
+        (CredIndexEntry_t *)OICMalloc((numOfCreds ? numOfCreds : 1) * sizeof(CredIndexEntry_t));
+    if (NULL == index->buckets || NULL == index->entries)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to allocate cred index");
+        return false;
+    }
+
+    for (size_t i = 0; i < numOfBuckets; i++)
+    {
+        index->buckets[i] = CRED_INDEX_NONE;
+    }
+    index->numOfBuckets = numOfBuckets;
+    return true;
+}
+
+/*
+ * Fills an index from creds in the order of gCred. The creds are pushed to the head of
+ * their buckets from the last one, which keeps the buckets in the order of gCred.
+ */
+static void FillCredIndex(CredIndex_t *index, OicSecCred_t **creds, size_t numOfCreds,
+                          CredIndexHash_t getHash)
+{
+    size_t numOfEntries = 0;
+    for (size_t i = numOfCreds; i > 0; i--)
+    {
+        uint32_t hash = 0;
+        if (!getHash(creds[i - 1], &hash))
+        {
+            continue;
+        }
+
+        size_t bucket = hash & (index->numOfBuckets - 1);
+        index->entries[numOfEntries].cred = creds[i - 1];
+        index->entries[numOfEntries].next = index->buckets[bucket];
+        index->buckets[bucket] = numOfEntries;
+        numOfEntries++;
+    }
+}
+
+/*
+ * Builds and publishes the indexes of gCred if they are not published.
+ * Only the thread changing gCred may call it, once gCred is consistent again.
+ * If they can't be built, lookups walk gCred instead.
+ */
+static void RefreshCredIndex(void)
+{
+    if (NULL != gCredIndexSet)
+    {
+        return;
+    }
+
+    size_t numOfCreds = 0;
+    OicSecCred_t *cred = NULL;
+    LL_COUNT(gCred, cred, numOfCreds);
+
+    size_t numOfBuckets = CRED_INDEX_MIN_BUCKETS;
+    while (numOfBuckets < numOfCreds)
+    {
+        numOfBuckets *= 2;
+    }
+
+    CredIndexSet_t *set = (CredIndexSet_t *)OICCalloc(1, sizeof(CredIndexSet_t));
+    OicSecCred_t **creds = (OicSecCred_t **)OICMalloc((numOfCreds ? numOfCreds : 1) * sizeof(*creds));
+    // credIds from 1 to numOfCreds + 1, one of them is not used.
+    bool *isUsedId = (bool *)OICCalloc(numOfCreds + 2, sizeof(bool));
+    VERIFY_NOT_NULL(TAG, set, ERROR);
+    VERIFY_NOT_NULL(TAG, creds, ERROR);
+    VERIFY_NOT_NULL(TAG, isUsedId, ERROR);
+
+    VERIFY_SUCCESS(TAG, AllocCredIndex(&set->byId, numOfBuckets, numOfCreds), ERROR);
+    VERIFY_SUCCESS(TAG, AllocCredIndex(&set->bySubject, numOfBuckets, numOfCreds), ERROR);
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    VERIFY_SUCCESS(TAG, AllocCredIndex(&set->byUsage, numOfBuckets, numOfCreds), ERROR);
+#endif
+
+    size_t i = 0;
+    LL_FOREACH(gCred, cred)
+    {
+        creds[i++] = cred;
+        if (cred->credId <= numOfCreds + 1)
+        {
+            isUsedId[cred->credId] = true;
+        }
+    }
+
+    FillCredIndex(&set->byId, creds, numOfCreds, HashCredId);
+    FillCredIndex(&set->bySubject, creds, numOfCreds, HashCredSubject);
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    FillCredIndex(&set->byUsage, creds, numOfCreds, HashCredUsage);
+#endif
+
+    set->nextCredId = 1;
+    while (isUsedId[set->nextCredId])
+    {
+        set->nextCredId++;
+    }
+
+    LockCredIndex();
+    gCredIndexSet = set;
+    UnlockCredIndex();
+    set = NULL;
+exit:
+    FreeCredIndexSet(set);
+    OICFree(creds);
+    OICFree(isUsedId);
+}
+
+/** Selects an index of a set. */
+typedef const CredIndex_t *(*CredIndexOf_t)(const CredIndexSet_t *set);
+
+static const CredIndex_t *CredIndexById(const CredIndexSet_t *set)
+{
+    return &set->byId;
+}
+
+static const CredIndex_t *CredIndexBySubject(const CredIndexSet_t *set)
+{
+    return &set->bySubject;
+}
+
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+static const CredIndex_t *CredIndexByUsage(const CredIndexSet_t *set)
+{
+    return &set->byUsage;
+}
+#endif
+
+static void InitCredIter(CredIter_t *iter, CredIndexOf_t indexOf, uint32_t hash,
+                         CredIndexMatch_t match, const void *arg)
+{
+    iter->match = match;
+    iter->arg = arg;
+    iter->index = NULL;
+    iter->pos = CRED_INDEX_NONE;
+    iter->cred = gCred;
+
+    LockCredIndex();
+    const CredIndexSet_t *set = gCredIndexSet;
+    UnlockCredIndex();
+
+    if (NULL != set)
+    {
+        iter->index = indexOf(set);
+        iter->pos = iter->index->buckets[hash & (iter->index->numOfBuckets - 1)];
+    }
+}
+
+/**
+ * Starts a lookup of the creds with the credId.
+ */
+static void InitCredIterById(CredIter_t *iter, const uint16_t *credId)
+{
+    OicSecCred_t key;
+    uint32_t hash = 0;
+    key.credId = *credId;
+    HashCredId(&key, &hash);
+    InitCredIter(iter, CredIndexById, hash, IsCredOfId, credId);
+}
+
+/**
+ * Starts a lookup of the creds of the subject.
+ */
+static void InitCredIterBySubject(CredIter_t *iter, const OicUuid_t *subject)
+{
+    uint32_t hash = HashCredBytes(subject->id, sizeof(subject->id));
+    InitCredIter(iter, CredIndexBySubject, hash, IsCredOfSubject, subject);
+}
+
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+/**
+ * Starts a lookup of the creds of the usage.
+ */
+static void InitCredIterByUsage(CredIter_t *iter, const char *usage)
+{
+    uint32_t hash = HashCredBytes((const uint8_t *)usage, strlen(usage));
+    InitCredIter(iter, CredIndexByUsage, hash, IsCredOfUsage, usage);
+}
+#endif
+
+/**
+ * Gets the next cred of a lookup, or NULL if there is no more.
+ * gCred must not change during a lookup.
+ */
+static OicSecCred_t *NextCred(CredIter_t *iter)
+{
+    if (NULL != iter->index)
+    {
+        while (CRED_INDEX_NONE != iter->pos)
+        {
+            const CredIndexEntry_t *entry = &iter->index->entries[iter->pos];
+            iter->pos = entry->next;
+            if (iter->match(entry->cred, iter->arg))
+            {
+                return entry->cred;
+            }
+        }
+        return NULL;
+    }
+
+    while (NULL != iter->cred)
+    {
+        OicSecCred_t *cred = iter->cred;
+        iter->cred = cred->next;
+        if (iter->match(cred, iter->arg))
+        {
+            return cred;
+        }
+    }
+    return NULL;
+}
+
 /**
  * Internal function to check a subject of SIGNED_ASYMMETRIC_KEY(Certificate).
  * If that subject is NULL or wildcard, set it to own deviceID.
@@ -1508,6 +1913,15 @@ static bool UpdatePersistentStorage(const OicSecCred_t *cred)
     bool ret = false;
     OIC_LOG(DEBUG, TAG, "IN Cred UpdatePersistentStorage");
 
+    // gCred is consistent again here, so its indexes are rebuilt on this thread.
+    InvalidateCredIndex();
+    RefreshCredIndex();
+
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    // every change of gCred is stored here, so the parsed certificates are reloaded.
+    CAinvalidatePkixInfo();
+#endif
+
     // Convert Cred data into JSON for update to persistent storage
     if (cred)
     {
@@ -1596,69 +2010,36 @@ static bool UpdatePersistentStorage(const OicSecCred_t *cred)
 }
 
 /**
- * Compare function used LL_SORT for sorting credentials.
- *
- * @param first pointer to OicSecCred_t struct.
- * @param second  pointer to OicSecCred_t struct.
- *
- *@return -1, if credId of first is less than credId of second.
- * 0, if credId of first is equal to credId of second.
- * 1, if credId of first is greater than credId of second.
- */
-static int CmpCredId(const OicSecCred_t * first, const OicSecCred_t *second)
-{
-    if (NULL == first || NULL == second)
-    {
-        return 0;
-    }
-    if (first->credId < second->credId)
-    {
-        return -1;
-    }
-    else if (first->credId > second->credId)
-    {
-        return 1;
-    }
-    else
-        return 0;
-}
-
-/**
- * GetCredId goes through the cred list and returns the next
- * available credId. The next credId could be the credId that is
- * available due deletion of OicSecCred_t object or one more than
- * credId of last credential in the list.
+ * GetCredId returns the next available credId. The next credId is the
+ * smallest credId not in the cred list, which could be the credId that is
+ * available due deletion of OicSecCred_t object.
  *
  * @return next available credId if successful, else 0 for error.
  */
 static uint16_t GetCredId(void)
 {
-    //Sorts credential list in incremental order of credId
-    /** @todo: Remove pragma for VS2013 warning; Investigate fixing LL_SORT macro */
-#ifdef _MSC_VER
-#pragma warning(suppress:4133)
-    LL_SORT(gCred, CmpCredId);
-#else
-    LL_SORT(gCred, CmpCredId);
-#endif
+    uint32_t nextCredId = 1;
 
-    OicSecCred_t *currentCred = NULL, *credTmp = NULL;
-    uint16_t nextCredId = 1;
-
-    LL_FOREACH_SAFE(gCred, currentCred, credTmp)
+    RefreshCredIndex();
+    if (NULL != gCredIndexSet)
     {
-        if (currentCred->credId == nextCredId)
-        {
-            nextCredId += 1;
-        }
-        else
+        nextCredId = gCredIndexSet->nextCredId;
+    }
+    else
+    {
+        //Without the index, take the one after the largest credId.
+        OicSecCred_t *currentCred = NULL;
+        LL_FOREACH(gCred, currentCred)
         {
-            break;
+            if (currentCred->credId >= nextCredId)
+            {
+                nextCredId = (uint32_t)currentCred->credId + 1;
+            }
         }
     }
 
     VERIFY_SUCCESS(TAG, nextCredId < UINT16_MAX, ERROR);
-    return nextCredId;
+    return (uint16_t)nextCredId;
 
 exit:
     return 0;
@@ -1747,6 +2128,7 @@ OCStackResult AddCredential(OicSecCred_t * newCred)
             //save old credid so act like an update
             newCred->credId = cred->credId;
 
+            InvalidateCredIndex();
             LL_DELETE(gCred, cred);
             LL_PREPEND(gCred, newCred);
 
@@ -1770,6 +2152,7 @@ OCStackResult AddCredential(OicSecCred_t * newCred)
             if (cred->credId == newCred->credId)
             {
                 //remove old cred with same cred id
+                InvalidateCredIndex();
                 LL_DELETE(gCred, cred);
                 FreeCred(cred);
                 break;
@@ -1829,6 +2212,7 @@ OCStackResult AddCredential(OicSecCred_t * newCred)
 #endif
 
     OIC_LOG(DEBUG, TAG, "Adding New Cred");
+    InvalidateCredIndex();
     LL_APPEND(gCred, newCred);
 
 saveToDB:
@@ -1851,6 +2235,7 @@ OCStackResult RemoveCredential(const OicUuid_t *subject)
     {
         if (memcmp(cred->subject.id, subject->id, sizeof(subject->id)) == 0)
         {
+            InvalidateCredIndex();
             LL_DELETE(gCred, cred);
             FreeCred(cred);
             deleteFlag = 1;
@@ -1888,6 +2273,7 @@ OCStackResult RemoveCredentialByCredId(uint16_t credId)
         {
             OIC_LOG_V(DEBUG, TAG, "Credential(ID=%d) will be removed.", credId);
 
+            InvalidateCredIndex();
             LL_DELETE(gCred, cred);
             FreeCred(cred);
             deleteFlag = true;
@@ -1934,6 +2320,7 @@ static OCStackResult RemoveCredentialByCredIds(CredIdList_t *credIdList)
             {
                 OIC_LOG_V(DEBUG, TAG, "Credential(ID=%d) will be removed.", cred->credId);
 
+                InvalidateCredIndex();
                 LL_DELETE(gCred, cred);
                 FreeCred(cred);
                 deleteFlag = true;
@@ -2023,6 +2410,7 @@ exit:
  */
 static OCStackResult RemoveAllCredentials(void)
 {
+    InvalidateCredIndex();
     DeleteCredList(gCred);
     gCred = GetCredDefault();
 
@@ -2675,6 +3063,13 @@ OCStackResult InitCredResource(void)
     OicSecCred_t* cred = NULL;
     OicUuid_t   *rownerId = NULL;
 
+    if (NULL == gCredIndexMutex)
+    {
+        gCredIndexMutex = oc_mutex_new();
+        VERIFY_NOT_NULL_RETURN(TAG, gCredIndexMutex, ERROR, OC_STACK_NO_MEMORY);
+    }
+    InvalidateCredIndex();
+
     //Read Cred resource from PS
     uint8_t *data = NULL;
     size_t size = 0;
@@ -2747,6 +3142,11 @@ OCStackResult InitCredResource(void)
     {
         gCred = GetCredDefault();
     }
+    InvalidateCredIndex();
+    RefreshCredIndex();
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    CAinvalidatePkixInfo();
+#endif
 
     if (gCred)
     {
@@ -2804,32 +3204,32 @@ exit:
 OCStackResult DeInitCredResource(void)
 {
     OCStackResult result = OCDeleteResource(gCredHandle);
+    FreeCredIndexes();
+    oc_mutex_free(gCredIndexMutex);
+    gCredIndexMutex = NULL;
     if (NULL != gCred)
     {
         logCredMetadata();
         DeleteCredList(gCred);
         gCred = NULL;
     }
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+    CAinvalidatePkixInfo();
+#endif
     return result;
 }
 
 OicSecCred_t* GetCredResourceData(const OicUuid_t* subject)
 {
-    OicSecCred_t *cred = NULL;
+    CredIter_t iter;
 
    if ( NULL == subject)
     {
        return NULL;
     }
 
-    LL_FOREACH(gCred, cred)
-    {
-        if(memcmp(cred->subject.id, subject->id, sizeof(subject->id)) == 0)
-        {
-            return cred;
-        }
-    }
-    return NULL;
+    InitCredIterBySubject(&iter, subject);
+    return NextCred(&iter);
 }
 
 const OicSecCred_t* GetCredList(void)
@@ -2906,6 +3306,7 @@ OicSecCred_t* GetCredEntryByCredId(const uint16_t credId)
     OIC_LOG_V(DEBUG, TAG, "IN %s", __func__);
 
     OicSecCred_t *tmpCred = NULL;
+    CredIter_t iter;
 
     if ( 1 > credId)
     {
@@ -2913,13 +3314,12 @@ OicSecCred_t* GetCredEntryByCredId(const uint16_t credId)
         return NULL;
     }
 
-    LL_FOREACH(gCred, tmpCred)
+    InitCredIterById(&iter, &credId);
+    tmpCred = NextCred(&iter);
+    if (NULL != tmpCred)
     {
-        if(tmpCred->credId == credId)
-        {
-            OIC_LOG_V(DEBUG, TAG, "OUT %s: cred found, id: %d", __func__, tmpCred->credId);
-            return CopyCred(tmpCred);
-        }
+        OIC_LOG_V(DEBUG, TAG, "OUT %s: cred found, id: %d", __func__, tmpCred->credId);
+        return CopyCred(tmpCred);
     }
 
     OIC_LOG_V(DEBUG, TAG, "OUT %s", __func__);
@@ -2996,7 +3396,15 @@ int32_t GetDtlsPskCredentials(CADtlsPskCredType_t type,
         case CA_DTLS_PSK_KEY:
             {
                 OicSecCred_t *cred = NULL;
-                LL_FOREACH(gCred, cred)
+                OicUuid_t subject = OC_ZERO_UUID;
+                CredIter_t iter;
+                if ((NULL != desc) && (desc_len == sizeof(subject.id)))
+                {
+                    memcpy(subject.id, desc, sizeof(subject.id));
+                }
+
+                InitCredIterBySubject(&iter, &subject);
+                while (NULL != (cred = NextCred(&iter)))
                 {
                     if (cred->credType != SYMMETRIC_PAIR_WISE_KEY)
                     {
@@ -3546,7 +3954,10 @@ void GetIdentityHandler(UuidContext_t* ctx, unsigned char* crt, size_t crtLen)
     }
 
     OicSecCred_t *cred = NULL;
-    LL_FOREACH(gCred, cred)
+    CredIter_t iter;
+
+    InitCredIterByUsage(&iter, TRUST_CA);
+    while (NULL != (cred = NextCred(&iter)))
     {
         if (SIGNED_ASYMMETRIC_KEY != cred->credType)
         {
@@ -3815,8 +4226,10 @@ void GetCaCert(ByteArrayLL_t * chain, const char * usage)
         return;
     }
     OicSecCred_t* temp = NULL;
+    CredIter_t iter;
 
-    LL_FOREACH(gCred, temp)
+    InitCredIterByUsage(&iter, usage);
+    while (NULL != (temp = NextCred(&iter)))
     {
         if ((SIGNED_ASYMMETRIC_KEY == temp->credType) &&
             (temp->credUsage != NULL) &&
@@ -3890,7 +4303,10 @@ OCStackResult GetAllRoleCerts(RoleCertChain_t ** output)
     *output = NULL;
 
     OicSecCred_t * temp = NULL;
-    LL_FOREACH(gCred, temp)
+    CredIter_t iter;
+
+    InitCredIterByUsage(&iter, ROLE_CERT);
+    while (NULL != (temp = NextCred(&iter)))
     {
         if ((SIGNED_ASYMMETRIC_KEY == temp->credType) &&
             (temp->credUsage != NULL) &&
@@ -3937,7 +4353,10 @@ void GetOwnCert(ByteArrayLL_t * chain, const char * usage)
         return;
     }
     OicSecCred_t * temp = NULL;
-    LL_FOREACH(gCred, temp)
+    CredIter_t iter;
+
+    InitCredIterByUsage(&iter, usage);
+    while (NULL != (temp = NextCred(&iter)))
     {
         if (SIGNED_ASYMMETRIC_KEY == temp->credType &&
             0 == strcmp(temp->credUsage, usage))
@@ -3976,8 +4395,11 @@ void GetDerKey(ByteArray_t * key, const char * usage)
     }
 
     OicSecCred_t * temp = NULL;
+    CredIter_t iter;
     key->len = 0;
-    LL_FOREACH(gCred, temp)
+
+    InitCredIterByUsage(&iter, usage);
+    while (NULL != (temp = NextCred(&iter)))
     {
         if ((SIGNED_ASYMMETRIC_KEY == temp->credType || ASYMMETRIC_KEY == temp->credType) &&
             temp->privateData.len > 0 &&
@@ -4082,12 +4504,14 @@ void GetPrimaryCertKey(ByteArray_t * key)
     OIC_LOG_V(DEBUG, TAG, "In %s", __func__);
 
     OicSecCred_t * temp = NULL;
+    CredIter_t iter;
 
     VERIFY_NOT_NULL(TAG, key, ERROR);
 
     key->len = 0;
 
-    LL_FOREACH(gCred, temp)
+    InitCredIterByUsage(&iter, PRIMARY_CERT);
+    while (NULL != (temp = NextCred(&iter)))
     {
         size_t length = temp->privateData.len;
 
@@ -31,6 +31,7 @@
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "crlresource.h"
+#include "casecurityinterface.h"
 #include "ocpayloadcbor.h"
 #include "mbedtls/base64.h"
 #include <time.h>
@@ -445,6 +446,7 @@ OCStackResult UpdateCRLResource(OicSecCrl_t *crl)
         OIC_LOG(ERROR, TAG, "Can't update global crl");
         return OC_STACK_ERROR;
     }
+    CAinvalidatePkixInfo();
 
     char currentTime[32] = {0};
     getCurrentUTCTime(currentTime, sizeof(currentTime));
@@ -702,6 +704,7 @@ OCStackResult InitCRLResource(void)
     {
         gCrl = GetCrlDefault();
     }
+    CAinvalidatePkixInfo();
 
     ret = CreateCRLResource();
     OICFree(data);
@@ -717,6 +720,7 @@ OCStackResult DeInitCRLResource(void)
     gCrlHandle = NULL;
     DeleteCrl(gCrl);
     gCrl = NULL;
+    CAinvalidatePkixInfo();
     return result;
 }
 
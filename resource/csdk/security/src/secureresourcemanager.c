@@ -126,7 +126,7 @@ void SRMGenerateResponse(SRMRequestContext_t *context)
 }
 
 // Set the value of context->resourceUri, based on the context->requestInfo.
-static void SetResourceUriAndType(SRMRequestContext_t *context)
+static void SetResourceUri(SRMRequestContext_t *context)
 {
     if (NULL == context || NULL == context->requestInfo ||
         NULL == context->requestInfo->info.resourceUri)
@@ -158,73 +158,58 @@ static void SetResourceUriAndType(SRMRequestContext_t *context)
     OICStrcpyPartial(context->resourceUri, MAX_URI_LENGTH + 1,
         context->requestInfo->info.resourceUri, position);
 
-    // Set the resource type.
-    context->resourceType = GetSvrTypeFromUri(context->resourceUri);
-
     return;
 }
 
-static void SetDiscoverableAndOcSecureFlags(SRMRequestContext_t *context)
+// Resolve the security attributes of resource, unless they are still cached.
+static const OCResourceSecurityAttributes *GetSecurityAttributes(OCResource *resource)
+{
+    OCResourceSecurityAttributes *attributes = &resource->securityAttributes;
+    if (!attributes->isValid)
+    {
+        attributes->svrType = GetSvrTypeFromUri(resource->uri);
+        attributes->isDiscoverable =
+            (OC_DISCOVERABLE == (resource->resourceProperties & OC_DISCOVERABLE));
+        attributes->isSecure = (OC_SECURE == (resource->resourceProperties & OC_SECURE));
+        // Reminder: a Resource can set both flags, and expose both an
+        // unsecure (e.g. CoAP) and secure (e.g. CoAPS) endpoint.
+        attributes->isNonsecure =
+            (OC_NONSECURE == (resource->resourceProperties & OC_NONSECURE));
+        attributes->isValid = true;
+    }
+    return attributes;
+}
+
+// Set the requested resource, its type, the discoverable enum and the
+// OC_SECURE and OC_NONSECURE flags with a single lookup of context->resourceUri.
+static void SetResourceTypeAndFlags(SRMRequestContext_t *context)
 {
     if (NULL == context)
     {
         OIC_LOG_V(ERROR, TAG, "%s: Null context.", __func__);
         return;
     }
-    if (NULL == context->resourceUri)
-    {
-        OIC_LOG_V(ERROR, TAG, "%s: Null resourceUri.", __func__);
-        context->discoverable = DISCOVERABLE_NOT_KNOWN;
-        return;
-    }
 
-    OCResource *resource = FindResourceByUri(context->resourceUri);
-    if (NULL == resource)
+    context->resource = FindResourceByUri(context->resourceUri);
+    if (NULL == context->resource)
     {
         OIC_LOG_V(ERROR, TAG, "%s: Unkown resourceUri(%s).", __func__, context->resourceUri);
+        context->resourceType = GetSvrTypeFromUri(context->resourceUri);
         context->discoverable = DISCOVERABLE_NOT_KNOWN;
         return;
     }
 
-    if (OC_DISCOVERABLE == (resource->resourceProperties & OC_DISCOVERABLE))
-    {
-        context->discoverable = DISCOVERABLE_TRUE;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is OC_DISCOVERABLE.",
-                  __func__, context->resourceUri);
-    }
-    else
-    {
-        context->discoverable = DISCOVERABLE_FALSE;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is NOT OC_DISCOVERABLE.",
-                  __func__, context->resourceUri);
-    }
+    const OCResourceSecurityAttributes *attributes = GetSecurityAttributes(context->resource);
+    context->resourceType = attributes->svrType;
+    context->discoverable = attributes->isDiscoverable ? DISCOVERABLE_TRUE : DISCOVERABLE_FALSE;
+    context->resourceIsOcSecure = attributes->isSecure;
+    context->resourceIsOcNonsecure = attributes->isNonsecure;
 
-    if (OC_SECURE == (resource->resourceProperties & OC_SECURE))
-    {
-        context->resourceIsOcSecure = true;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is OC_SECURE.",
-                  __func__, context->resourceUri);
-    }
-    else
-    {
-        context->resourceIsOcSecure = false;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is *not* OC_SECURE.",
-                  __func__, context->resourceUri);
-    }
-    // Reminder: a Resource can set both flags, and expose both an
-    // unsecure (e.g. CoAP) and secure (e.g. CoAPS) endpoint.
-    if (OC_NONSECURE == (resource->resourceProperties & OC_NONSECURE))
-    {
-        context->resourceIsOcNonsecure = true;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is OC_NONSECURE.",
-                  __func__, context->resourceUri);
-    }
-    else
-    {
-        context->resourceIsOcNonsecure = false;
-        OIC_LOG_V(DEBUG, TAG, "%s: resource %s is *not* OC_NONSECURE.",
-                  __func__, context->resourceUri);
-    }
+    OIC_LOG_V(DEBUG, TAG, "%s: resource %s is%s OC_DISCOVERABLE, is%s OC_SECURE, is%s OC_NONSECURE.",
+              __func__, context->resourceUri,
+              attributes->isDiscoverable ? "" : " *not*",
+              attributes->isSecure ? "" : " *not*",
+              attributes->isNonsecure ? "" : " *not*");
 }
 
 static void ClearRequestContext(SRMRequestContext_t *context)
@@ -239,6 +224,7 @@ static void ClearRequestContext(SRMRequestContext_t *context)
         context->endPoint = NULL;
         context->resourceType = OIC_RESOURCE_TYPE_ERROR;
         memset(&context->resourceUri, 0, sizeof(context->resourceUri));
+        context->resource = NULL;
         context->requestedPermission = PERMISSION_ERROR;
         memset(&context->responseInfo, 0, sizeof(context->responseInfo));
         context->responseSent = false;
@@ -358,11 +344,11 @@ void SRMRequestHandler(const CAEndpoint_t *endPoint, const CARequestInfo_t *requ
 #endif // NDEBUG
 #endif // DTLS
 
-    // Set resource URI and type.
-    SetResourceUriAndType(ctx);
+    // Set resource URI.
+    SetResourceUri(ctx);
 
-    // Set discoverable enum, and OC_SECURE and/or OC_NONSECURE flags.
-    SetDiscoverableAndOcSecureFlags(ctx);
+    // Set resource, type, discoverable enum, and OC_SECURE and/or OC_NONSECURE flags.
+    SetResourceTypeAndFlags(ctx);
 
     // Initialize responseInfo.
     memcpy(&(ctx->responseInfo.info), &(requestInfo->info),
@@ -396,10 +382,24 @@ void SRMRequestHandler(const CAEndpoint_t *endPoint, const CARequestInfo_t *requ
     {
         OIC_LOG(ERROR, TAG, "Exiting SRM without responding to requester!");
     }
+
+    // The resource may be deleted once the request has been handled.
+    ctx->resource = NULL;
 exit:
     return;
 }
 
+OCResource *SRMGetRequestedResource(const char* uri)
+{
+    SRMRequestContext_t *ctx = &g_requestContext;
+
+    if (NULL == uri || NULL == ctx->resource || 0 != strcmp(uri, ctx->resourceUri))
+    {
+        return NULL;
+    }
+    return ctx->resource;
+}
+
 /**
  * Handle the response from the SRM.
  *
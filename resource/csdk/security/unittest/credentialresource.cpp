@@ -19,6 +19,9 @@
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "ocpayload.h"
 #include "ocstack.h"
 #include "oic_malloc.h"
@@ -29,6 +32,7 @@
 #include "srmutility.h"
 #include "psinterface.h"
 #include "security_internals.h"
+#include "srmresourcestrings.h"
 #include "experimental/logger.h"
 
 #define TAG "SRM-CRED-UT"
@@ -375,6 +379,145 @@ TEST(CredResourceTest, GenerateAndAddCredentialValidInput)
     DeleteCredList(headCred);
 }
 
+TEST(CredResourceTest, AddCredentialReusesRemovedCredId)
+{
+    OicUuid_t subject1 = {{0}};
+    OicUuid_t subject2 = {{0}};
+    OicUuid_t subject3 = {{0}};
+    OICStrcpy((char *)subject1.id, sizeof(subject1.id), "subject41");
+    OICStrcpy((char *)subject2.id, sizeof(subject2.id), "subject42");
+    OICStrcpy((char *)subject3.id, sizeof(subject3.id), "subject43");
+
+    uint8_t privateKey[] = "My private Key41";
+    OicSecKey_t key = {privateKey, sizeof(privateKey), OIC_ENCODING_RAW};
+
+    OicSecCred_t *cred1 = GenerateCredential(&subject1, SYMMETRIC_PAIR_WISE_KEY, NULL,
+                                             &key, NULL);
+    ASSERT_TRUE(NULL != cred1);
+    ASSERT_EQ(OC_STACK_OK, AddCredential(cred1));
+
+    OicSecCred_t *cred2 = GenerateCredential(&subject2, SYMMETRIC_PAIR_WISE_KEY, NULL,
+                                             &key, NULL);
+    ASSERT_TRUE(NULL != cred2);
+    ASSERT_EQ(OC_STACK_OK, AddCredential(cred2));
+
+    EXPECT_EQ(cred1, GetCredResourceData(&subject1));
+    EXPECT_EQ(cred2, GetCredResourceData(&subject2));
+
+    uint16_t credId1 = cred1->credId;
+    uint16_t credId2 = cred2->credId;
+    EXPECT_NE(credId1, credId2);
+
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(credId1));
+    EXPECT_EQ(NULL, GetCredResourceData(&subject1));
+
+    OicSecCred_t *cred3 = GenerateCredential(&subject3, SYMMETRIC_PAIR_WISE_KEY, NULL,
+                                             &key, NULL);
+    ASSERT_TRUE(NULL != cred3);
+    ASSERT_EQ(OC_STACK_OK, AddCredential(cred3));
+    EXPECT_EQ(credId1, cred3->credId);
+
+    OicSecCred_t *copy = GetCredEntryByCredId(credId1);
+    ASSERT_TRUE(NULL != copy);
+    EXPECT_EQ(0, memcmp(subject3.id, copy->subject.id, sizeof(subject3.id)));
+    DeleteCredList(copy);
+
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(credId1));
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(credId2));
+}
+
+#if defined(__WITH_DTLS__) || defined(__WITH_TLS__)
+static OicSecCred_t *addCaCred(const char *subjectId, const char *usage, const char *cert)
+{
+    OicUuid_t subject = {{0}};
+    OICStrcpy((char *)subject.id, sizeof(subject.id), subjectId);
+
+    // DER data is copied as is, the terminator keeps the PEM lookup within the data.
+    OicSecKey_t publicData = {(uint8_t *)cert, strlen(cert) + 1, OIC_ENCODING_DER};
+    OicSecCred_t *cred = GenerateCredential(&subject, SIGNED_ASYMMETRIC_KEY, &publicData,
+                                            NULL, NULL);
+    if (NULL == cred)
+    {
+        return NULL;
+    }
+    cred->credUsage = OICStrdup(usage);
+    if (NULL == cred->credUsage || OC_STACK_OK != AddCredential(cred))
+    {
+        DeleteCredList(cred);
+        return NULL;
+    }
+    return cred;
+}
+
+static std::vector<std::string> getCaCerts(const char *usage)
+{
+    ByteArrayLL_t chain = {0, 0};
+    GetCaCert(&chain, usage);
+
+    std::vector<std::string> certs;
+    ByteArrayLL_t *it = &chain;
+    while (NULL != it)
+    {
+        ByteArrayLL_t *next = it->next;
+        if (NULL != it->cert)
+        {
+            certs.push_back(std::string((const char *)it->cert->data));
+            OICFree(it->cert->data);
+            OICFree(it->cert);
+        }
+        if (&chain != it)
+        {
+            OICFree(it);
+        }
+        it = next;
+    }
+
+    std::sort(certs.begin(), certs.end());
+    return certs;
+}
+
+TEST(CredResourceTest, GetCaCertFollowsAddedAndRemovedCreds)
+{
+    EXPECT_TRUE(getCaCerts(TRUST_CA).empty());
+
+    OicSecCred_t *caCred1 = addCaCred("subject51", TRUST_CA, "ca-cert-1");
+    ASSERT_TRUE(NULL != caCred1);
+    uint16_t caCredId1 = caCred1->credId;
+    OicSecCred_t *mfCred = addCaCred("subject52", MF_TRUST_CA, "mf-ca-cert");
+    ASSERT_TRUE(NULL != mfCred);
+    uint16_t mfCredId = mfCred->credId;
+    OicSecCred_t *caCred2 = addCaCred("subject53", TRUST_CA, "ca-cert-2");
+    ASSERT_TRUE(NULL != caCred2);
+    uint16_t caCredId2 = caCred2->credId;
+
+    std::vector<std::string> expected;
+    expected.push_back("ca-cert-1");
+    expected.push_back("ca-cert-2");
+    EXPECT_EQ(expected, getCaCerts(TRUST_CA));
+    EXPECT_EQ(std::vector<std::string>(1, "mf-ca-cert"), getCaCerts(MF_TRUST_CA));
+
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(caCredId1));
+    EXPECT_EQ(std::vector<std::string>(1, "ca-cert-2"), getCaCerts(TRUST_CA));
+    EXPECT_EQ(std::vector<std::string>(1, "mf-ca-cert"), getCaCerts(MF_TRUST_CA));
+
+    // A cred added after a removal is found as well.
+    caCred1 = addCaCred("subject54", TRUST_CA, "ca-cert-3");
+    ASSERT_TRUE(NULL != caCred1);
+    caCredId1 = caCred1->credId;
+    expected.clear();
+    expected.push_back("ca-cert-2");
+    expected.push_back("ca-cert-3");
+    EXPECT_EQ(expected, getCaCerts(TRUST_CA));
+
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(caCredId1));
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(caCredId2));
+    EXPECT_TRUE(getCaCerts(TRUST_CA).empty());
+
+    EXPECT_EQ(OC_STACK_RESOURCE_DELETED, RemoveCredentialByCredId(mfCredId));
+    EXPECT_TRUE(getCaCerts(MF_TRUST_CA).empty());
+}
+#endif // __WITH_DTLS__ or __WITH_TLS__
+
 #if 0
 TEST(CredGetResourceDataTest, GetCredResourceDataValidSubject)
 {
@@ -32,6 +32,7 @@
 #include "ocstackconfig.h"
 #include "occlientcb.h"
 #include "ocobserve.h"
+#include "experimental/securevirtualresourcetypes.h"
 
 /** Macro Definitions for observers */
 
@@ -185,6 +186,28 @@ typedef struct OCChildResource {
     struct OCChildResource *next;
 } OCChildResource;
 
+/**
+ * Security attributes of a resource, resolved from its uri and resourceProperties by the
+ * Secure Resource Manager when the first request for the resource arrives.
+ */
+typedef struct
+{
+    /** False until resolved, and after each change of resourceProperties.*/
+    bool isValid;
+
+    /** Secure Virtual Resource type of the uri, NOT_A_SVR_RESOURCE for other resources.*/
+    OicSecSvrType_t svrType;
+
+    /** Is the resource OC_DISCOVERABLE.*/
+    bool isDiscoverable;
+
+    /** Is the resource OC_SECURE.*/
+    bool isSecure;
+
+    /** Is the resource OC_NONSECURE.*/
+    bool isNonsecure;
+} OCResourceSecurityAttributes;
+
 /**
  * Data structure for holding data type and definition for OIC resource.
  */
@@ -247,6 +270,10 @@ typedef struct OCResource {
     /** Sequence number for observable resources. Per the CoAP standard it is a 24 bit value.*/
     uint32_t sequenceNum;
 
+    /** Version of the representation, sent as the ETag of resources with OC_ETAG.
+     * It is never zero.*/
+    uint32_t etag;
+
     /** Pointer of ActionSet which to support group action.*/
     OCActionSet *actionsetHead;
 
@@ -263,6 +290,9 @@ typedef struct OCResource {
 
     /** Resource endpoint type(s). */
     OCTpsSchemeFlags endpointType;
+
+    /** Security attributes cached for the Secure Resource Manager.*/
+    OCResourceSecurityAttributes securityAttributes;
 } OCResource;
 
 /**
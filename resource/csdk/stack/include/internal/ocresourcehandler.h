@@ -215,12 +215,40 @@ void DeletePlatformInfo(void);
  */
 void DeleteDeviceInfo(void);
 
+/**
+ * Internal API used to clear the cached introspection data.
+ * The data is read again from the persistent storage on the next request.
+ */
+void DeleteIntrospectionData(void);
+
+/**
+ * Internal API used to mark the cached introspection data as stale.
+ * The data is read again from the persistent storage on the next request, which
+ * frees the stale data.
+ */
+void InvalidateIntrospectionData(void);
+
+/**
+ * Internal API used to change the ETag of a resource when its representation changes.
+ * A resource without an ETag gets a random one, so the ETags of a restarted server do
+ * not match the ones given out before.
+ *
+ * @param resource      Resource whose representation changed.
+ */
+void UpdateResourceETag(OCResource *resource);
+
 /*
  * Prepare payload for resource representation.
  */
 OCStackResult BuildResponseRepresentation(const OCResource *resourcePtr,
                     OCRepPayload** payload, OCDevAddr *devAddr);
 
+/*
+ * Prepare payload for the introspection data, from the data cached for requests.
+ */
+OCStackResult BuildIntrospectionPayloadResponse(const OCResource *resourcePtr,
+                    OCPayload **payload, OCDevAddr *devAddr);
+
 /**
  * A helper function that Maps an @ref OCEntityHandlerResult type to an
  * @ref OCStackResult type.
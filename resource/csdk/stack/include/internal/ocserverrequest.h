@@ -76,6 +76,9 @@ typedef struct OCServerRequest
     /** Observe Result field.*/
     OCStackResult observeResult;
 
+    /** ETag of the resource when the request was received, 0 if the response has no ETag.*/
+    uint32_t etag;
+
     /** number of Responses.*/
     uint8_t numResponses;
 
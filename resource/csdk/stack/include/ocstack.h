@@ -36,6 +36,7 @@
 #include "octypes.h"
 
 #include "platform_features.h"
+#include "ocevent.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -144,6 +145,28 @@ OCStackResult OC_CALL OCStopMulticastServer(void);
  */
 OCStackResult OC_CALL OCProcess(void);
 
+/**
+ * This function is an event driven alternative to OCProcess(). It performs the
+ * same processing and reports how long the caller may block before the stack
+ * needs to be processed again, so that the main loop can wait on the event
+ * registered with OCRegisterProcessEvent() instead of polling.
+ *
+ * @param[out] nextEventTime    Milliseconds until the next stack timer expires.
+ *                              UINT32_MAX if no timer is pending.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCProcessEvent(uint32_t *nextEventTime);
+
+/**
+ * Register an event to be signaled whenever the stack has work pending for
+ * OCProcessEvent(), e.g. a received request or response. Once this returns,
+ * the previously registered event is no longer signaled and may be freed.
+ *
+ * @param[in] event    Event to signal, or NULL to unregister.
+ */
+void OC_CALL OCRegisterProcessEvent(oc_event event);
+
 /**
  * This function discovers or Perform requests on a specified resource
  * (specified by that Resource's respective URI).
@@ -254,6 +277,9 @@ OCStackResult OC_CALL OCCancel(OCDoHandle handle,
 
 /**
  * Register Persistent storage callback.
+ * The introspection data is read once and served from memory afterwards; registering
+ * the handler again makes the stack read it again on the next request.
+ *
  * @param   persistentStorageHandler  Pointers to open, read, write, close & unlink handlers.
  *
  * @return
@@ -647,6 +673,7 @@ OCStackResult OC_CALL OCNotifyNewAMAvailable(const OCResourceHandle handle);
  * This function notify all registered observers that the resource representation has
  * changed. If observation includes a query the client is notified only if the query is valid after
  * the resource representation has changed.
+ * The ETag of a resource with ::OC_ETAG changes as well, even if there is no observer.
  *
  * @param handle   Handle of resource.
  * @param qos      Desired quality of service for the observation notifications.
@@ -677,6 +704,17 @@ OCStackResult OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
                                        const OCRepPayload *payload,
                                        OCQualityOfService qos);
 
+/**
+ * This function changes the ETag of a resource with ::OC_ETAG, so that the representations
+ * cached by the clients are not valid anymore. A server calls it when the representation
+ * changes without a request or a notification, e.g. when a sensor value is updated.
+ *
+ * @param handle   Handle of resource.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult OC_CALL OCInvalidateResourceETag(OCResourceHandle handle);
+
 /**
  * This function sends a response to a request.
  * The response can be a normal, slow, or block (i.e. a response that
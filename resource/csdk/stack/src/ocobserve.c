@@ -616,7 +616,7 @@ GetObserveHeaderOption (uint32_t * observationOption,
             *observationOption = options[i].optionData[0];
             for(uint8_t c = i; c < *numOptions-1; c++)
             {
-                options[i] = options[i+1];
+                options[c] = options[c+1];
             }
             (*numOptions)--;
             return OC_STACK_OK;
@@ -60,6 +60,7 @@
 #include "oickeepalive.h"
 #include "ocpayloadcbor.h"
 #include "psinterface.h"
+#include "experimental/ocrandom.h"
 
 #ifdef ROUTING_GATEWAY
 #include "routingmanager.h"
@@ -942,92 +943,119 @@ OCStackResult InitializeDeviceProperties(void)
     return result;
 }
 
-static size_t GetIntrospectionDataSize(const OCPersistentStorage *ps)
-{
-    size_t size = 0;
-    char buffer[INTROSPECTION_FILE_SIZE_BLOCK];
-    FILE *fp;
-
-    if (!ps)
-    {
-        return 0;
-    }
-
-    fp = ps->open(OC_INTROSPECTION_FILE_NAME, "rb");
-    if (fp)
-    {
-        size_t bytesRead = 0;
-        do
-        {
-            bytesRead = ps->read(buffer, 1, INTROSPECTION_FILE_SIZE_BLOCK, fp);
-            size += bytesRead;
-        } while (bytesRead);
-        ps->close(fp);
-    }
-    return size;
-}
+/**
+ * Introspection data read from the persistent storage, cached until the stack stops or
+ * another persistent storage handler is registered.
+ */
+static uint8_t *g_introspectionData = NULL;
+static size_t g_introspectionDataSize = 0;
+static const OCPersistentStorage *g_introspectionDataStorage = NULL;
 
-OCStackResult GetIntrospectionDataFromPS(uint8_t **data, size_t *size)
+static OCStackResult ReadIntrospectionData(const OCPersistentStorage *ps,
+                                           uint8_t **data, size_t *size)
 {
-    OIC_LOG(DEBUG, TAG, "GetIntrospectionDataFromPS IN");
-
     FILE *fp = NULL;
     uint8_t *fsData = NULL;
     size_t fileSize = 0;
+    size_t capacity = INTROSPECTION_FILE_SIZE_BLOCK;
+    size_t bytesRead = 0;
     OCStackResult ret = OC_STACK_ERROR;
-    OCPersistentStorage *ps = NULL;
 
-    if (!data || *data || !size)
+    fp = ps->open(OC_INTROSPECTION_FILE_NAME, "rb");
+    if (!fp)
     {
-        return OC_STACK_INVALID_PARAM;
+        OIC_LOG(ERROR, TAG, "Could not open persistent storage file for introspection data");
+        return OC_STACK_ERROR;
     }
 
-    ps = OCGetPersistentStorageHandler();
-    if (!ps)
+    // allocate one more byte to accomodate null terminator for string we are reading.
+    fsData = (uint8_t *)OICMalloc(capacity + 1);
+    if (!fsData)
     {
-        OIC_LOG(ERROR, TAG, "Persistent Storage handler is NULL");
+        OIC_LOG(ERROR, TAG, "Could not allocate memory for introspection data");
+        ret = OC_STACK_NO_MEMORY;
         goto exit;
     }
 
-    fileSize = GetIntrospectionDataSize(ps);
-    OIC_LOG_V(DEBUG, TAG, "File Read Size: %zu", fileSize);
-    if (fileSize)
+    // the file is read once, growing the buffer instead of sizing the file beforehand.
+    while ((bytesRead = ps->read(fsData + fileSize, 1, capacity - fileSize, fp)) > 0)
     {
-        // allocate one more byte to accomodate null terminator for string we are reading.
-        fsData = (uint8_t *)OICCalloc(1, fileSize + 1);
-        if (!fsData)
+        fileSize += bytesRead;
+        if (fileSize == capacity)
         {
-            OIC_LOG(ERROR, TAG, "Could not allocate memory for introspection data");
-            goto exit;
+            uint8_t *newData = (uint8_t *)OICRealloc(fsData, capacity * 2 + 1);
+            if (!newData)
+            {
+                OIC_LOG(ERROR, TAG, "Could not allocate memory for introspection data");
+                ret = OC_STACK_NO_MEMORY;
+                goto exit;
+            }
+            fsData = newData;
+            capacity *= 2;
         }
+    }
 
-        fp = ps->open(OC_INTROSPECTION_FILE_NAME, "rb");
-        if (!fp)
-        {
-            OIC_LOG(ERROR, TAG, "Could not open persistent storage file for introspection data");
-            goto exit;
-        }
-        if (ps->read(fsData, 1, fileSize, fp) == fileSize)
-        {
-            *size = fileSize;
-            fsData[fileSize] = '\0';
-            *data = fsData;
-            fsData = NULL;
-            ret = OC_STACK_OK;
-        }
+    OIC_LOG_V(DEBUG, TAG, "File Read Size: %zu", fileSize);
+    if (fileSize)
+    {
+        fsData[fileSize] = '\0';
+        *data = fsData;
+        *size = fileSize;
+        fsData = NULL;
+        ret = OC_STACK_OK;
     }
-    OIC_LOG(DEBUG, TAG, "GetIntrospectionDataFromPS OUT");
 
 exit:
-    if (fp)
+    ps->close(fp);
+    OICFree(fsData);
+    return ret;
+}
+
+/**
+ * Returns the cached introspection data, reading it from the persistent storage
+ * on the first request. The data is owned by the cache.
+ */
+static OCStackResult GetCachedIntrospectionData(const uint8_t **data, size_t *size)
+{
+    const OCPersistentStorage *ps = OCGetPersistentStorageHandler();
+    if (!ps)
     {
-        ps->close(fp);
+        OIC_LOG(ERROR, TAG, "Persistent Storage handler is NULL");
+        return OC_STACK_ERROR;
     }
-    if (fsData)
+
+    if (!g_introspectionData || g_introspectionDataStorage != ps)
     {
-        OICFree(fsData);
+        uint8_t *newData = NULL;
+        size_t newSize = 0;
+        OCStackResult ret = ReadIntrospectionData(ps, &newData, &newSize);
+        if (OC_STACK_OK != ret)
+        {
+            return ret;
+        }
+
+        DeleteIntrospectionData();
+        g_introspectionData = newData;
+        g_introspectionDataSize = newSize;
+        g_introspectionDataStorage = ps;
     }
-    return ret;
+
+    *data = g_introspectionData;
+    *size = g_introspectionDataSize;
+    return OC_STACK_OK;
+}
+
+void DeleteIntrospectionData(void)
+{
+    OICFree(g_introspectionData);
+    g_introspectionData = NULL;
+    g_introspectionDataSize = 0;
+    g_introspectionDataStorage = NULL;
+}
+
+void InvalidateIntrospectionData(void)
+{
+    g_introspectionDataStorage = NULL;
 }
 
 OCStackResult BuildIntrospectionPayloadResponse(const OCResource *resourcePtr,
@@ -1036,9 +1064,9 @@ OCStackResult BuildIntrospectionPayloadResponse(const OCResource *resourcePtr,
     OC_UNUSED(resourcePtr);
     OC_UNUSED(devAddr);
 
-    uint8_t *introspectionData = NULL;
+    const uint8_t *introspectionData = NULL;
     size_t size = 0;
-    OCStackResult ret = GetIntrospectionDataFromPS(&introspectionData, &size);
+    OCStackResult ret = GetCachedIntrospectionData(&introspectionData, &size);
     if (OC_STACK_OK == ret)
     {
         OCIntrospectionPayload *tempPayload = OCIntrospectionPayloadCreateFromCbor(introspectionData, size);
@@ -1049,7 +1077,6 @@ OCStackResult BuildIntrospectionPayloadResponse(const OCResource *resourcePtr,
         else
         {
             ret = OC_STACK_NO_MEMORY;
-            OICFree(introspectionData);
         }
     }
 
@@ -1386,7 +1413,12 @@ OCStackResult DetermineResourceHandling (const OCServerRequest *request,
     }
     else
     {
-        OCResource *resourcePtr = FindResourceByUri((const char*)request->resourceUrl);
+        // SRM has already looked up the resource of a request it passes to the stack.
+        OCResource *resourcePtr = SRMGetRequestedResource((const char*)request->resourceUrl);
+        if (!resourcePtr)
+        {
+            resourcePtr = FindResourceByUri((const char*)request->resourceUrl);
+        }
         *resource = resourcePtr;
 
         // Checking resource TPS flags if resource exist in stack.
@@ -1730,6 +1762,53 @@ exit:
     return OC_STACK_NO_MEMORY;
 }
 
+void UpdateResourceETag(OCResource *resource)
+{
+    if (0 == resource->etag)
+    {
+        resource->etag = OCGetRandom();
+    }
+    else
+    {
+        resource->etag++;
+    }
+
+    // zero stands for no ETag.
+    if (0 == resource->etag)
+    {
+        resource->etag = 1;
+    }
+}
+
+/**
+ * Checks if one of the ETags of a GET request matches the current ETag of the resource.
+ */
+static bool HasCurrentETag(const OCServerRequest *request, const OCResource *resource)
+{
+    for (uint8_t i = 0; i < request->numRcvdVendorSpecificHeaderOptions; i++)
+    {
+        const OCHeaderOption *option = &request->rcvdVendorSpecificHeaderOptions[i];
+
+        if (OC_RSRVD_ETAG_OPTION_ID != option->optionID
+            || sizeof(uint32_t) != option->optionLength)
+        {
+            continue;
+        }
+
+        uint32_t etag = 0;
+        for (size_t j = 0; j < sizeof(uint32_t); j++)
+        {
+            etag = (etag << 8) | option->optionData[j];
+        }
+
+        if (etag == resource->etag)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 static OCStackResult EHRequest(OCEntityHandlerRequest *ehRequest, OCPayloadType type,
     OCServerRequest *request, OCResource *resource)
 {
@@ -2290,6 +2369,25 @@ HandleResourceWithEntityHandler(OCServerRequest *request,
         type = PAYLOAD_TYPE_SECURITY;
     }
 
+    if (PAYLOAD_TYPE_SECURITY != type && (resource->resourceProperties & OC_ETAG))
+    {
+        if (OC_REST_GET != request->method)
+        {
+            // the request may change the representation.
+            UpdateResourceETag(resource);
+        }
+        else if (OC_OBSERVE_NO_OPTION == request->observationOption)
+        {
+            if (HasCurrentETag(request, resource))
+            {
+                OIC_LOG_V(INFO, TAG, "Representation of %s is valid", resource->uri);
+                request->etag = resource->etag;
+                return SendNonPersistantDiscoveryResponse(request, NULL, OC_EH_VALID);
+            }
+            request->etag = resource->etag;
+        }
+    }
+
     result = EHRequest(&ehRequest, type, request, resource);
     VERIFY_SUCCESS(result);
 
@@ -603,6 +603,21 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
         }
     }
 
+    // The ETag of the resource is added unless the entity handler set its own.
+    bool addETag = serverRequest->etag != 0 &&
+                   (CA_CONTENT == responseInfo.result || CA_VALID == responseInfo.result);
+    for (uint8_t i = 0; addETag && i < ehResponse->numSendVendorSpecificHeaderOptions; i++)
+    {
+        if (OC_RSRVD_ETAG_OPTION_ID == ehResponse->sendVendorSpecificHeaderOptions[i].optionID)
+        {
+            addETag = false;
+        }
+    }
+    if (addETag)
+    {
+        responseInfo.info.numOptions++;
+    }
+
     if (responseInfo.info.numOptions > 0)
     {
         responseInfo.info.options = (CAHeaderOption_t *)
@@ -672,6 +687,22 @@ OCStackResult HandleSingleResponse(OCEntityHandlerResponse * ehResponse)
             optionsPointer += 1;
         }
 
+        if (addETag)
+        {
+            optionsPointer->protocolID = CA_COAP_ID;
+            optionsPointer->optionID = OC_RSRVD_ETAG_OPTION_ID;
+            optionsPointer->optionLength = sizeof(uint32_t);
+            uint8_t* etagData = (uint8_t*)optionsPointer->optionData;
+            uint32_t etag = serverRequest->etag;
+
+            for (size_t i = sizeof(uint32_t); i; --i)
+            {
+                etagData[i-1] = etag & 0xFF;
+                etag >>= 8;
+            }
+            optionsPointer += 1;
+        }
+
         if (ehResponse->payload)
         {
             if (!IsPayloadVersionSet && !IsPayloadFormatSet)
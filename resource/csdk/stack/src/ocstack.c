@@ -194,6 +194,12 @@ bool g_multicastServerStopped = false;
 
 #define MILLISECONDS_PER_SECOND   (1000)
 
+/**
+ * Longest time, in milliseconds, OCProcessEvent() lets the caller sleep while
+ * periodic stack work (keepalive, routing) is enabled.
+ */
+#define PROCESS_EVENT_PERIODIC_TIMEOUT_MS   (1000)
+
 //-----------------------------------------------------------------------------
 // Private internal function prototypes
 //-----------------------------------------------------------------------------
@@ -1876,15 +1882,26 @@ void OC_CALL OCHandleResponse(const CAEndpoint_t* endPoint, const CAResponseInfo
             response->numRcvdVendorSpecificHeaderOptions = 0;
             if((responseInfo->info.numOptions > 0) && (responseInfo->info.options != NULL))
             {
-                uint8_t start = 0;
-                //First option always with option ID is COAP_OPTION_OBSERVE if it is available.
-                if(responseInfo->info.options[0].optionID == COAP_OPTION_OBSERVE)
+                // Options are ordered by number, so an ETag or If-Match option
+                // comes before COAP_OPTION_OBSERVE.
+                uint8_t observeIndex = responseInfo->info.numOptions;
+                for (uint8_t i = 0; i < responseInfo->info.numOptions; i++)
+                {
+                    if (responseInfo->info.options[i].optionID == COAP_OPTION_OBSERVE)
+                    {
+                        observeIndex = i;
+                        break;
+                    }
+                }
+
+                if(observeIndex < responseInfo->info.numOptions)
                 {
                     size_t i;
                     uint32_t observationOption;
-                    uint8_t* optionData = (uint8_t*)responseInfo->info.options[0].optionData;
+                    const CAHeaderOption_t *observeOption = &responseInfo->info.options[observeIndex];
+                    uint8_t* optionData = (uint8_t*)observeOption->optionData;
                     for (observationOption=0, i=0;
-                            i<sizeof(uint32_t) && i<responseInfo->info.options[0].optionLength;
+                            i<sizeof(uint32_t) && i<observeOption->optionLength;
                             i++)
                     {
                         observationOption =
@@ -1892,7 +1909,6 @@ void OC_CALL OCHandleResponse(const CAEndpoint_t* endPoint, const CAResponseInfo
                     }
                     response->sequenceNumber = observationOption;
                     response->numRcvdVendorSpecificHeaderOptions = responseInfo->info.numOptions - 1;
-                    start = 1;
                 }
                 else
                 {
@@ -1907,10 +1923,14 @@ void OC_CALL OCHandleResponse(const CAEndpoint_t* endPoint, const CAResponseInfo
                     return;
                 }
 
-                for (uint8_t i = start; i < responseInfo->info.numOptions; i++)
+                uint8_t count = 0;
+                for (uint8_t i = 0; i < responseInfo->info.numOptions; i++)
                 {
-                    memcpy (&(response->rcvdVendorSpecificHeaderOptions[i - start]),
-                            &(responseInfo->info.options[i]), sizeof(OCHeaderOption));
+                    if (i != observeIndex)
+                    {
+                        memcpy (&(response->rcvdVendorSpecificHeaderOptions[count++]),
+                                &(responseInfo->info.options[i]), sizeof(OCHeaderOption));
+                    }
                 }
             }
 
@@ -2919,6 +2939,8 @@ OCStackResult OCDeInitializeInternal(void)
     DeleteClientCBList();
     // Terminate connectivity-abstraction layer.
     CATerminate();
+    // Free the introspection data cached for requests
+    DeleteIntrospectionData();
 
 #if defined(TCP_ADAPTER) && defined(WITH_CLOUD)
     // Terminate the Connection Manager
@@ -3889,6 +3911,8 @@ OCStackResult OC_CALL OCRegisterPersistentStorageHandler(OCPersistentStorage* pe
         }
     }
     g_PersistentStorageHandler = persistentStorageHandler;
+    // The stored files may have changed along with the handler.
+    InvalidateIntrospectionData();
     return OC_STACK_OK;
 }
 
@@ -3993,8 +4017,75 @@ exit:
 
     return result;
 }
+
+/**
+ * Get the time until the next presence timeout fires.
+ *
+ * @return  milliseconds until the earliest presence timeout, UINT32_MAX if none.
+ */
+static uint32_t GetNextPresenceTimeout(void)
+{
+    uint32_t next = UINT32_MAX;
+    uint32_t now = GetTicks(0);
+    ClientCB* cbNode = NULL;
+
+    LL_FOREACH(g_cbList, cbNode)
+    {
+        if (OC_REST_PRESENCE != cbNode->method || !cbNode->presence ||
+            cbNode->presence->TTLlevel >= PresenceTimeOutSize)
+        {
+            continue;
+        }
+
+        uint32_t timeOut = cbNode->presence->timeOut[cbNode->presence->TTLlevel];
+        if (timeOut <= now)
+        {
+            return 0;
+        }
+
+        uint32_t remaining = (uint32_t)(((uint64_t)(timeOut - now) * MILLISECONDS_PER_SECOND) /
+                                        COAP_TICKS_PER_SECOND);
+        if (remaining < next)
+        {
+            next = remaining;
+        }
+    }
+
+    return next;
+}
 #endif // WITH_PRESENCE
 
+OCStackResult OC_CALL OCProcessEvent(uint32_t *nextEventTime)
+{
+    VERIFY_NON_NULL(nextEventTime, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCStackResult result = OCProcess();
+    if (OC_STACK_OK != result)
+    {
+        return result;
+    }
+
+    uint32_t next = UINT32_MAX;
+#ifdef WITH_PRESENCE
+    next = GetNextPresenceTimeout();
+#endif
+
+#if defined(TCP_ADAPTER) || defined(ROUTING_GATEWAY)
+    if (PROCESS_EVENT_PERIODIC_TIMEOUT_MS < next)
+    {
+        next = PROCESS_EVENT_PERIODIC_TIMEOUT_MS;
+    }
+#endif
+
+    *nextEventTime = next;
+    return OC_STACK_OK;
+}
+
+void OC_CALL OCRegisterProcessEvent(oc_event event)
+{
+    CARegisterProcessEvent(event);
+}
+
 OCStackResult OC_CALL OCProcess(void)
 {
     if (stackState == OC_STACK_UNINITIALIZED)
@@ -4176,7 +4267,7 @@ OCStackResult OC_CALL OCCreateResourceWithEp(OCResourceHandle *handle,
     // Make sure resourceProperties bitmask has allowed properties specified
     if (resourceProperties
             > (OC_ACTIVE | OC_DISCOVERABLE | OC_OBSERVABLE | OC_SLOW | OC_NONSECURE | OC_SECURE |
-               OC_EXPLICIT_DISCOVERABLE
+               OC_EXPLICIT_DISCOVERABLE | OC_ETAG
 #ifdef MQ_PUBLISHER
                | OC_MQ_PUBLISHER
 #endif
@@ -4242,6 +4333,7 @@ OCStackResult OC_CALL OCCreateResourceWithEp(OCResourceHandle *handle,
         goto exit;
     }
     pointer->sequenceNum = OC_OFFSET_SEQUENCE_NUMBER;
+    UpdateResourceETag(pointer);
 
     insertResource(pointer);
 
@@ -4911,6 +5003,7 @@ OCStackResult OC_CALL OCSetResourceProperties(OCResourceHandle handle, uint8_t r
         return OC_STACK_NO_RESOURCE;
     }
     resource->resourceProperties = (OCResourceProperty) (resource->resourceProperties | resourceProperties);
+    resource->securityAttributes.isValid = false;
     return OC_STACK_OK;
 }
 
@@ -4925,6 +5018,7 @@ OCStackResult OC_CALL OCClearResourceProperties(OCResourceHandle handle, uint8_t
         return OC_STACK_NO_RESOURCE;
     }
     resource->resourceProperties = (OCResourceProperty) (resource->resourceProperties & ~resourceProperties);
+    resource->securityAttributes.isValid = false;
     return OC_STACK_OK;
 }
 
@@ -5174,6 +5268,7 @@ OCStackResult OC_CALL OCNotifyAllObservers(OCResourceHandle handle, OCQualityOfS
     {
         //only increment in the case of regular observing (not presence)
         incrementSequenceNumber(resPtr);
+        UpdateResourceETag(resPtr);
         method = OC_REST_OBSERVE;
         maxAge = MAX_OBSERVE_AGE;
 #ifdef WITH_PRESENCE
@@ -5211,11 +5306,26 @@ OC_CALL OCNotifyListOfObservers (OCResourceHandle handle,
     else
     {
         incrementSequenceNumber(resPtr);
+        UpdateResourceETag(resPtr);
     }
     return (SendListObserverNotification(resPtr, obsIdList, numberOfIds,
             payload, maxAge, qos));
 }
 
+OCStackResult OC_CALL OCInvalidateResourceETag(OCResourceHandle handle)
+{
+    VERIFY_NON_NULL(handle, ERROR, OC_STACK_INVALID_PARAM);
+
+    OCResource *resPtr = findResource((OCResource *) handle);
+    if (NULL == resPtr)
+    {
+        return OC_STACK_NO_RESOURCE;
+    }
+
+    UpdateResourceETag(resPtr);
+    return OC_STACK_OK;
+}
+
 OCStackResult OC_CALL OCDoResponse(OCEntityHandlerResponse *ehResponse)
 {
     OIC_TRACE_BEGIN(%s:OCDoResponse, TAG);
@@ -5517,6 +5627,7 @@ OCStackResult deleteResource(OCResource *resource)
         {
             // Invalidate all Resource Properties.
             resource->resourceProperties = (OCResourceProperty) 0;
+            resource->securityAttributes.isValid = false;
 #ifdef WITH_PRESENCE
             if(resource != (OCResource *) presenceResource.handle)
             {
@@ -26,7 +26,6 @@
 #include "oic_string.h"
 #include "oic_time.h"
 #include "experimental/ocrandom.h"
-#include "uarraylist.h"
 #include "ocstackinternal.h"
 #include "ocpayloadcbor.h"
 #include "ocpayload.h"
@@ -77,6 +76,16 @@ static const uint64_t USECS_PER_SEC = 1000000;
  */
 #define DEFAULT_INTERVAL_COUNT  6
 
+/**
+ * Delay before retrying a ping message which could not be sent.
+ */
+#define KEEPALIVE_RETRY_INTERVAL_SEC 1
+
+/**
+ * Initial number of buckets and heap slots of the KeepAlive table.
+ */
+#define KEEPALIVE_TABLE_INITIAL_SIZE 64
+
 /**
  * KeepAlive key to parser Payload Table.
  */
@@ -97,15 +106,10 @@ static bool g_isKeepAliveInitialized = false;
  */
 static OCResourceHandle g_keepAliveHandle = NULL;
 
-/**
- * KeepAlive table which holds connection interval.
- */
-static u_arraylist_t *g_keepAliveConnectionTable = NULL;
-
 /**
  * KeepAlive table entries.
  */
-typedef struct
+typedef struct KeepAliveEntry
 {
     OCMode mode;                    /**< host Mode of Operation. */
     CAEndpoint_t remoteAddr;        /**< destination Address. */
@@ -115,8 +119,30 @@ typedef struct
     int64_t *intervalInfo;          /**< interval values for KeepAlive. */
     bool sentPingMsg;               /**< if oic client already sent ping message. */
     uint64_t timeStamp;             /**< last sent or received ping message. in microseconds. */
+    uint64_t deadline;              /**< time to check the entry next. in microseconds. */
+    size_t heapIndex;               /**< position in the deadline heap. */
+    struct KeepAliveEntry *next;    /**< next entry in the same hash bucket. */
 } KeepAliveEntry_t;
 
+/**
+ * KeepAlive table which holds connection interval.
+ * Entries are hashed by remote address to be found on every message, and kept in
+ * a min-heap ordered by deadline, so that only expired entries are visited.
+ */
+typedef struct
+{
+    KeepAliveEntry_t **buckets;     /**< entries hashed by remote address. */
+    size_t bucketCount;             /**< number of buckets, a power of 2. */
+    KeepAliveEntry_t **heap;        /**< entries ordered by deadline. */
+    size_t heapCapacity;            /**< allocated slots of the heap. */
+    size_t count;                   /**< number of entries. */
+} KeepAliveTable_t;
+
+/**
+ * KeepAlive table which holds connection interval.
+ */
+static KeepAliveTable_t *g_keepAliveConnectionTable = NULL;
+
 /**
  * Send disconnect message to remove connection.
  */
@@ -183,10 +209,34 @@ OCStackResult HandleKeepAliveResponse(const CAEndpoint_t *endPoint,
  * @param[in]   endpoint    Remote Endpoint information (like ipaddress,
  *                          port, reference URI and transport type) to
  *                          which the ping message has to be sent.
- * @param[out]  index       index of array list.
  * @return  KeepAlive entry to send ping message.
  */
-static KeepAliveEntry_t *GetEntryFromEndpoint(const CAEndpoint_t *endpoint, size_t *index);
+static KeepAliveEntry_t *GetEntryFromEndpoint(const CAEndpoint_t *endpoint);
+
+/**
+ * Computes the deadline of keepalive entry from its state, and reorders the
+ * deadline heap.
+ * @param[in]   entry       KeepAlive entry whose state has changed.
+ */
+static void UpdateDeadline(KeepAliveEntry_t *entry);
+
+/**
+ * Moves an entry of the deadline heap down after its deadline has been delayed.
+ * @param[in]   index       Index of the entry in the heap.
+ */
+static void SiftDown(size_t index);
+
+/**
+ * Creates the KeepAlive table.
+ * @return  Created KeepAlive table.
+ */
+static KeepAliveTable_t *CreateKeepAliveTable(void);
+
+/**
+ * Destroys the KeepAlive table with its entries.
+ * @param[in]   table       KeepAlive table to destroy.
+ */
+static void DestroyKeepAliveTable(KeepAliveTable_t *table);
 
 /**
  * Add keepalive entry.
@@ -259,7 +309,7 @@ OCStackResult InitializeKeepAlive(OCMode mode)
 
     if (!g_keepAliveConnectionTable)
     {
-        g_keepAliveConnectionTable = u_arraylist_create();
+        g_keepAliveConnectionTable = CreateKeepAliveTable();
         if (NULL == g_keepAliveConnectionTable)
         {
             OIC_LOG(ERROR, TAG, "Creating KeepAlive Table failed");
@@ -296,7 +346,7 @@ OCStackResult TerminateKeepAlive(OCMode mode)
 
     if (NULL != g_keepAliveConnectionTable)
     {
-        u_arraylist_destroy(g_keepAliveConnectionTable);
+        DestroyKeepAliveTable(g_keepAliveConnectionTable);
         g_keepAliveConnectionTable = NULL;
     }
 
@@ -405,8 +455,7 @@ OCStackResult SendKeepAliveResponse(OCServerRequest *request,
     CAEndpoint_t endpoint = {.adapter = CA_DEFAULT_ADAPTER};
     CopyDevAddrToEndpoint(&request->devAddr, &endpoint);
 
-    size_t index = 0;
-    KeepAliveEntry_t *entry = GetEntryFromEndpoint(&endpoint, &index);
+    KeepAliveEntry_t *entry = GetEntryFromEndpoint(&endpoint);
     int64_t interval = (entry) ? entry->interval : 0;
 
     // Create KeepAlive payload to send response message.
@@ -457,8 +506,7 @@ OCEntityHandlerResult HandleKeepAlivePOSTRequest(OCServerRequest *request,
     CAEndpoint_t endpoint = { .adapter = CA_DEFAULT_ADAPTER };
     CopyDevAddrToEndpoint(&request->devAddr, &endpoint);
 
-    size_t index = 0;
-    KeepAliveEntry_t *entry = GetEntryFromEndpoint(&endpoint, &index);
+    KeepAliveEntry_t *entry = GetEntryFromEndpoint(&endpoint);
     if (!entry)
     {
         OIC_LOG(ERROR, TAG, "Received the first keepalive message from client");
@@ -480,6 +528,7 @@ OCEntityHandlerResult HandleKeepAlivePOSTRequest(OCServerRequest *request,
     entry->interval = interval;
     OIC_LOG_V(DEBUG, TAG, "Received interval is [%" PRId64 "]", entry->interval);
     entry->timeStamp = OICGetCurrentTime(TIME_IN_US);
+    UpdateDeadline(entry);
 
     OCPayloadDestroy(ocPayload);
 
@@ -495,8 +544,7 @@ OCStackResult HandleKeepAliveResponse(const CAEndpoint_t *endPoint,
     OIC_LOG(DEBUG, TAG, "HandleKeepAliveResponse IN");
 
     // Get entry from KeepAlive table.
-    size_t index = 0;
-    KeepAliveEntry_t *entry = GetEntryFromEndpoint(endPoint, &index);
+    KeepAliveEntry_t *entry = GetEntryFromEndpoint(endPoint);
     if (!entry)
     {
         // Receive response message about find /oic/ping request.
@@ -535,6 +583,7 @@ OCStackResult HandleKeepAliveResponse(const CAEndpoint_t *endPoint,
     {
         // Set sentPingMsg values with false.
         entry->sentPingMsg = false;
+        UpdateDeadline(entry);
 
         // Check the received interval value.
         int64_t interval = 0;
@@ -554,18 +603,19 @@ void ProcessKeepAlive()
         return;
     }
 
-    size_t len = u_arraylist_length(g_keepAliveConnectionTable);
+    if (0 == g_keepAliveConnectionTable->count)
+    {
+        return;
+    }
+
+    uint64_t currentTime = OICGetCurrentTime(TIME_IN_US);
 
-    for (size_t i = 0; i < len; i++)
+    // Every entry visited is either removed or moved to a deadline after currentTime.
+    while (g_keepAliveConnectionTable->count
+            && g_keepAliveConnectionTable->heap[0]->deadline <= currentTime)
     {
-        KeepAliveEntry_t *entry = (KeepAliveEntry_t *)u_arraylist_get(g_keepAliveConnectionTable,
-                                                                      i);
-        if (NULL == entry)
-        {
-            continue;
-        }
+        KeepAliveEntry_t *entry = g_keepAliveConnectionTable->heap[0];
 
-        uint64_t currentTime = OICGetCurrentTime(TIME_IN_US);
         if (OC_CLIENT == entry->mode)
         {
             if (entry->sentPingMsg)
@@ -575,44 +625,35 @@ void ProcessKeepAlive()
                  * terminate the connection.
                  * In this case the timeStamp means last time sent ping message.
                  */
-                if ((KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC) <= currentTime - entry->timeStamp)
-                {
-                    OIC_LOG(DEBUG, TAG, "Client does not receive the response within 1 minutes.");
+                OIC_LOG(DEBUG, TAG, "Client does not receive the response within 1 minutes.");
 
-                    // Send message to disconnect session.
-                    SendDisconnectMessage(entry);
-                }
+                // Send message to disconnect session.
+                SendDisconnectMessage(entry);
             }
             else
             {
-                if ((entry->interval * KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC)
-                        <= currentTime - entry->timeStamp)
+                // Increase interval value.
+                IncreaseInterval(entry);
+
+                OCStackResult result = SendPingMessage(entry);
+                if (OC_STACK_OK != result)
                 {
-                    // Increase interval value.
-                    IncreaseInterval(entry);
-
-                    OCStackResult result = SendPingMessage(entry);
-                    if (OC_STACK_OK != result)
-                    {
-                        OIC_LOG(ERROR, TAG, "Failed to send ping request");
-                        continue;
-                    }
+                    OIC_LOG(ERROR, TAG, "Failed to send ping request");
+
+                    entry->deadline = currentTime + KEEPALIVE_RETRY_INTERVAL_SEC * USECS_PER_SEC;
+                    SiftDown(0);
                 }
             }
         }
-        else if (OC_SERVER == entry->mode)
+        else
         {
             /*
              * If an OIC Server does not receive a PUT request to ping resource
              * within the specified interval time, terminate the connection.
              * In this case the timeStamp means last time received ping message.
              */
-            if ((entry->interval * KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC)
-                    <= currentTime - entry->timeStamp)
-            {
-                OIC_LOG(DEBUG, TAG, "Server does not receive a PUT request.");
-                SendDisconnectMessage(entry);
-            }
+            OIC_LOG(DEBUG, TAG, "Server does not receive a PUT request.");
+            SendDisconnectMessage(entry);
         }
     }
 }
@@ -639,14 +680,17 @@ OCStackResult SendDisconnectMessage(const KeepAliveEntry_t *entry)
      * If CA get the empty message from RI, CA will disconnect a connection.
      */
 
-    OCStackResult result = RemoveKeepAliveEntry(&entry->remoteAddr);
+    // The entry is freed on removal.
+    CAEndpoint_t endpoint = entry->remoteAddr;
+
+    OCStackResult result = RemoveKeepAliveEntry(&endpoint);
     if (result != OC_STACK_OK)
     {
         return result;
     }
 
     CARequestInfo_t requestInfo = { .method = CA_POST };
-    result = CASendRequest(&entry->remoteAddr, &requestInfo);
+    result = CASendRequest(&endpoint, &requestInfo);
     return CAResultToOCResult(result);
 }
 
@@ -672,6 +716,7 @@ OCStackResult SendPingMessage(KeepAliveEntry_t *entry)
     // Update timeStamp with time sent ping message for next ping message.
     entry->timeStamp = OICGetCurrentTime(TIME_IN_US);
     entry->sentPingMsg = true;
+    UpdateDeadline(entry);
 
     OIC_LOG_V(DEBUG, TAG, "Client sent ping message, interval [%" PRId64 "]", entry->interval);
 
@@ -698,30 +743,200 @@ OCStackApplicationResult PingRequestCallback(void* ctx, OCDoHandle handle,
     return OC_STACK_DELETE_TRANSACTION;
 }
 
-KeepAliveEntry_t *GetEntryFromEndpoint(const CAEndpoint_t *endpoint, size_t *index)
+KeepAliveTable_t *CreateKeepAliveTable(void)
 {
-    if (!g_keepAliveConnectionTable)
+    KeepAliveTable_t *table = (KeepAliveTable_t *) OICCalloc(1, sizeof(KeepAliveTable_t));
+    if (NULL == table)
     {
-        OIC_LOG(ERROR, TAG, "KeepAlive Table was not Created.");
         return NULL;
     }
 
-    size_t len = u_arraylist_length(g_keepAliveConnectionTable);
+    table->bucketCount = KEEPALIVE_TABLE_INITIAL_SIZE;
+    table->buckets = (KeepAliveEntry_t **) OICCalloc(table->bucketCount,
+                                                     sizeof(KeepAliveEntry_t *));
+    table->heapCapacity = KEEPALIVE_TABLE_INITIAL_SIZE;
+    table->heap = (KeepAliveEntry_t **) OICMalloc(table->heapCapacity *
+                                                  sizeof(KeepAliveEntry_t *));
+    if (NULL == table->buckets || NULL == table->heap)
+    {
+        OICFree(table->buckets);
+        OICFree(table->heap);
+        OICFree(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+void DestroyKeepAliveTable(KeepAliveTable_t *table)
+{
+    if (NULL == table)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        OICFree(table->heap[i]->intervalInfo);
+        OICFree(table->heap[i]);
+    }
+    OICFree(table->buckets);
+    OICFree(table->heap);
+    OICFree(table);
+}
+
+/**
+ * FNV-1a hash of the remote address and port, which identify a keepalive entry.
+ */
+static size_t HashEndpoint(const CAEndpoint_t *endpoint)
+{
+    uint32_t hash = 2166136261u;
 
-    for (size_t i = 0; i < len; i++)
+    for (size_t i = 0; i < sizeof(endpoint->addr) && endpoint->addr[i]; i++)
     {
-        KeepAliveEntry_t *entry = (KeepAliveEntry_t *)u_arraylist_get(g_keepAliveConnectionTable,
-                                                                      i);
-        if (NULL == entry)
+        hash = (hash ^ (uint8_t) endpoint->addr[i]) * 16777619u;
+    }
+    hash = (hash ^ (uint8_t) (endpoint->port & 0xFF)) * 16777619u;
+    hash = (hash ^ (uint8_t) (endpoint->port >> 8)) * 16777619u;
+
+    return (size_t) hash;
+}
+
+static bool IsSameEndpoint(const CAEndpoint_t *endpoint1, const CAEndpoint_t *endpoint2)
+{
+    return !strncmp(endpoint1->addr, endpoint2->addr, sizeof(endpoint1->addr))
+            && (endpoint1->port == endpoint2->port);
+}
+
+static KeepAliveEntry_t **GetBucket(const KeepAliveTable_t *table, const CAEndpoint_t *endpoint)
+{
+    return &table->buckets[HashEndpoint(endpoint) & (table->bucketCount - 1)];
+}
+
+/**
+ * Doubles the buckets once the entries outnumber them, so that a bucket holds one
+ * entry on average.
+ */
+static bool GrowBuckets(KeepAliveTable_t *table)
+{
+    size_t bucketCount = table->bucketCount * 2;
+    KeepAliveEntry_t **buckets = (KeepAliveEntry_t **) OICCalloc(bucketCount,
+                                                                 sizeof(KeepAliveEntry_t *));
+    if (NULL == buckets)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        KeepAliveEntry_t *entry = table->heap[i];
+        KeepAliveEntry_t **bucket = &buckets[HashEndpoint(&entry->remoteAddr) & (bucketCount - 1)];
+        entry->next = *bucket;
+        *bucket = entry;
+    }
+
+    OICFree(table->buckets);
+    table->buckets = buckets;
+    table->bucketCount = bucketCount;
+    return true;
+}
+
+static void SwapHeapEntries(size_t index1, size_t index2)
+{
+    KeepAliveEntry_t **heap = g_keepAliveConnectionTable->heap;
+    KeepAliveEntry_t *entry = heap[index1];
+
+    heap[index1] = heap[index2];
+    heap[index2] = entry;
+    heap[index1]->heapIndex = index1;
+    heap[index2]->heapIndex = index2;
+}
+
+static void SiftUp(size_t index)
+{
+    KeepAliveEntry_t **heap = g_keepAliveConnectionTable->heap;
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (heap[parent]->deadline <= heap[index]->deadline)
+        {
+            break;
+        }
+        SwapHeapEntries(parent, index);
+        index = parent;
+    }
+}
+
+static void SiftDown(size_t index)
+{
+    KeepAliveEntry_t **heap = g_keepAliveConnectionTable->heap;
+    size_t count = g_keepAliveConnectionTable->count;
+
+    while (true)
+    {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+
+        if (left < count && heap[left]->deadline < heap[smallest]->deadline)
+        {
+            smallest = left;
+        }
+        if (right < count && heap[right]->deadline < heap[smallest]->deadline)
+        {
+            smallest = right;
+        }
+        if (smallest == index)
         {
-            continue;
+            break;
         }
+        SwapHeapEntries(index, smallest);
+        index = smallest;
+    }
+}
+
+void UpdateDeadline(KeepAliveEntry_t *entry)
+{
+    VERIFY_NON_NULL_NR(entry, FATAL);
+
+    uint64_t oldDeadline = entry->deadline;
+
+    if (OC_CLIENT == entry->mode && entry->sentPingMsg)
+    {
+        // waiting for the response of the ping message.
+        entry->deadline = entry->timeStamp + KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC;
+    }
+    else
+    {
+        entry->deadline = entry->timeStamp
+                + entry->interval * KEEPALIVE_RESPONSE_TIMEOUT_SEC * USECS_PER_SEC;
+    }
 
-        if (!strncmp(entry->remoteAddr.addr, endpoint->addr, sizeof(entry->remoteAddr.addr))
-                && (entry->remoteAddr.port == endpoint->port))
+    if (entry->deadline < oldDeadline)
+    {
+        SiftUp(entry->heapIndex);
+    }
+    else
+    {
+        SiftDown(entry->heapIndex);
+    }
+}
+
+KeepAliveEntry_t *GetEntryFromEndpoint(const CAEndpoint_t *endpoint)
+{
+    if (!g_keepAliveConnectionTable)
+    {
+        OIC_LOG(ERROR, TAG, "KeepAlive Table was not Created.");
+        return NULL;
+    }
+
+    for (KeepAliveEntry_t *entry = *GetBucket(g_keepAliveConnectionTable, endpoint);
+         entry; entry = entry->next)
+    {
+        if (IsSameEndpoint(&entry->remoteAddr, endpoint))
         {
             OIC_LOG(DEBUG, TAG, "Connection Info found in KeepAlive table");
-            *index = i;
             return entry;
         }
     }
@@ -738,12 +953,32 @@ KeepAliveEntry_t *AddKeepAliveEntry(const CAEndpoint_t *endpoint, OCMode mode,
         return NULL;
     }
 
-    if (!g_keepAliveConnectionTable)
+    KeepAliveTable_t *table = g_keepAliveConnectionTable;
+    if (!table)
     {
         OIC_LOG(ERROR, TAG, "KeepAlive Table was not Created.");
         return NULL;
     }
 
+    if (table->count == table->heapCapacity)
+    {
+        KeepAliveEntry_t **heap = (KeepAliveEntry_t **) OICRealloc(table->heap,
+                2 * table->heapCapacity * sizeof(KeepAliveEntry_t *));
+        if (NULL == heap)
+        {
+            OIC_LOG(ERROR, TAG, "Adding node to head failed");
+            return NULL;
+        }
+        table->heap = heap;
+        table->heapCapacity *= 2;
+    }
+
+    if (table->count >= table->bucketCount && !GrowBuckets(table))
+    {
+        // keeps the current buckets, which only makes the lookup slower.
+        OIC_LOG(WARNING, TAG, "Failed to grow KeepAlive table");
+    }
+
     KeepAliveEntry_t *entry = (KeepAliveEntry_t *) OICCalloc(1, sizeof(KeepAliveEntry_t));
     if (NULL == entry)
     {
@@ -759,6 +994,12 @@ KeepAliveEntry_t *AddKeepAliveEntry(const CAEndpoint_t *endpoint, OCMode mode,
     if (!entry->intervalInfo)
     {
         entry->intervalInfo = (int64_t*) OICMalloc(entry->intervalSize * sizeof(int64_t));
+        if (!entry->intervalInfo)
+        {
+            OIC_LOG(ERROR, TAG, "Failed to allocate interval values");
+            OICFree(entry);
+            return NULL;
+        }
         for (size_t i = 0; i < entry->intervalSize; i++)
         {
             entry->intervalInfo[i] = KEEPALIVE_MIN_INTERVAL << i;
@@ -766,14 +1007,14 @@ KeepAliveEntry_t *AddKeepAliveEntry(const CAEndpoint_t *endpoint, OCMode mode,
     }
     entry->interval = entry->intervalInfo[0];
 
-    bool result = u_arraylist_add(g_keepAliveConnectionTable, (void *)entry);
-    if (!result)
-    {
-        OIC_LOG(ERROR, TAG, "Adding node to head failed");
-        OICFree(entry->intervalInfo);
-        OICFree(entry);
-        return NULL;
-    }
+    KeepAliveEntry_t **bucket = GetBucket(table, endpoint);
+    entry->next = *bucket;
+    *bucket = entry;
+
+    entry->heapIndex = table->count;
+    entry->deadline = UINT64_MAX;
+    table->heap[table->count++] = entry;
+    UpdateDeadline(entry);
 
     return entry;
 }
@@ -782,27 +1023,43 @@ OCStackResult RemoveKeepAliveEntry(const CAEndpoint_t *endpoint)
 {
     VERIFY_NON_NULL(endpoint, FATAL, OC_STACK_INVALID_PARAM);
 
-    size_t index = 0;
-    KeepAliveEntry_t *entry = GetEntryFromEndpoint(endpoint, &index);
-    if (!entry)
+    KeepAliveTable_t *table = g_keepAliveConnectionTable;
+    if (!table)
     {
-        OIC_LOG(ERROR, TAG, "There is no entry in keepalive table.");
+        OIC_LOG(ERROR, TAG, "KeepAlive Table was not Created.");
         return OC_STACK_ERROR;
     }
 
-    KeepAliveEntry_t *removedEntry = (KeepAliveEntry_t *)
-                                        u_arraylist_remove(g_keepAliveConnectionTable, index);
-    if (NULL == removedEntry)
+    KeepAliveEntry_t **link = GetBucket(table, endpoint);
+    while (*link && !IsSameEndpoint(&(*link)->remoteAddr, endpoint))
+    {
+        link = &(*link)->next;
+    }
+
+    KeepAliveEntry_t *removedEntry = *link;
+    if (!removedEntry)
     {
-        OIC_LOG(ERROR, TAG, "Removed Entry is NULL");
+        OIC_LOG(ERROR, TAG, "There is no entry in keepalive table.");
         return OC_STACK_ERROR;
     }
+    *link = removedEntry->next;
+
+    // fills the hole with the last entry of the heap.
+    size_t index = removedEntry->heapIndex;
+    table->count--;
+    if (index != table->count)
+    {
+        table->heap[index] = table->heap[table->count];
+        table->heap[index]->heapIndex = index;
+        SiftUp(index);
+        SiftDown(table->heap[index]->heapIndex);
+    }
 
     OIC_LOG_V(DEBUG, TAG, "Remove Connection Info from KeepAlive table, "
              "remote addr=%s port:%d", removedEntry->remoteAddr.addr,
              removedEntry->remoteAddr.port);
 
-    OICFree(entry->intervalInfo);
+    OICFree(removedEntry->intervalInfo);
     OICFree(removedEntry);
 
     return OC_STACK_OK;
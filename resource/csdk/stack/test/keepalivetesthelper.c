@@ -0,0 +1,153 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "keepalivetesthelper.h"
+
+// The copy below must not clash with the one of the stack library.
+#define InitializeKeepAlive TestInitializeKeepAlive
+#define TerminateKeepAlive TestTerminateKeepAlive
+#define HandleKeepAliveRequest TestHandleKeepAliveRequest
+#define HandleKeepAliveResponse TestHandleKeepAliveResponse
+#define ProcessKeepAlive TestProcessKeepAlive
+#define AddKeepAliveEntry TestAddKeepAliveEntry
+#define HandleKeepAliveConnCB TestHandleKeepAliveConnCB
+
+#include "../src/oickeepalive.c"
+
+OCStackResult KeepAliveTestInitialize(void)
+{
+    return InitializeKeepAlive(OC_CLIENT);
+}
+
+void KeepAliveTestTerminate(void)
+{
+    TerminateKeepAlive(OC_CLIENT);
+}
+
+void KeepAliveTestProcess(void)
+{
+    ProcessKeepAlive();
+}
+
+bool KeepAliveTestAddEntry(const CAEndpoint_t *endpoint, OCMode mode, uint64_t deadline)
+{
+    KeepAliveEntry_t *entry = AddKeepAliveEntry(endpoint, mode, NULL);
+    if (!entry)
+    {
+        return false;
+    }
+
+    uint64_t oldDeadline = entry->deadline;
+    entry->deadline = deadline;
+    if (entry->deadline < oldDeadline)
+    {
+        SiftUp(entry->heapIndex);
+    }
+    else
+    {
+        SiftDown(entry->heapIndex);
+    }
+    return true;
+}
+
+void KeepAliveTestRemoveEntry(const CAEndpoint_t *endpoint)
+{
+    HandleKeepAliveConnCB(endpoint, false, true);
+}
+
+bool KeepAliveTestGetEntry(const CAEndpoint_t *endpoint, uint64_t *deadline,
+                           int64_t *interval, bool *sentPingMsg)
+{
+    const KeepAliveEntry_t *entry = GetEntryFromEndpoint(endpoint);
+    if (!entry)
+    {
+        return false;
+    }
+
+    *deadline = entry->deadline;
+    *interval = entry->interval;
+    *sentPingMsg = entry->sentPingMsg;
+    return true;
+}
+
+const CAEndpoint_t *KeepAliveTestGetEarliest(void)
+{
+    if (!g_keepAliveConnectionTable || !g_keepAliveConnectionTable->count)
+    {
+        return NULL;
+    }
+    return &g_keepAliveConnectionTable->heap[0]->remoteAddr;
+}
+
+size_t KeepAliveTestGetCount(void)
+{
+    return g_keepAliveConnectionTable ? g_keepAliveConnectionTable->count : 0;
+}
+
+size_t KeepAliveTestGetBucketCount(void)
+{
+    return g_keepAliveConnectionTable ? g_keepAliveConnectionTable->bucketCount : 0;
+}
+
+bool KeepAliveTestIsConsistent(void)
+{
+    const KeepAliveTable_t *table = g_keepAliveConnectionTable;
+    if (!table)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        const KeepAliveEntry_t *entry = table->heap[i];
+        if (entry->heapIndex != i)
+        {
+            return false;
+        }
+        if (i > 0 && table->heap[(i - 1) / 2]->deadline > entry->deadline)
+        {
+            return false;
+        }
+
+        size_t found = 0;
+        for (const KeepAliveEntry_t *node = *GetBucket(table, &entry->remoteAddr);
+             node; node = node->next)
+        {
+            if (node == entry)
+            {
+                found++;
+            }
+        }
+        if (1 != found)
+        {
+            return false;
+        }
+    }
+
+    size_t bucketEntries = 0;
+    for (size_t i = 0; i < table->bucketCount; i++)
+    {
+        for (const KeepAliveEntry_t *node = table->buckets[i]; node; node = node->next)
+        {
+            bucketEntries++;
+        }
+    }
+    return bucketEntries == table->count;
+}
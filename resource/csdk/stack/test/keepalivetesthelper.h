@@ -0,0 +1,81 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+/*
+ * Access to a private copy of the KeepAlive table of oickeepalive.c, which is
+ * compiled into keepalivetesthelper.c so that its static functions can be reached.
+ */
+
+#ifndef KEEPALIVE_TEST_HELPER_H_
+#define KEEPALIVE_TEST_HELPER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "octypes.h"
+#include "cacommon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Creates the KeepAlive table of an OIC client. */
+OCStackResult KeepAliveTestInitialize(void);
+
+/** Destroys the KeepAlive table. */
+void KeepAliveTestTerminate(void);
+
+/** Runs one pass of ProcessKeepAlive over the table. */
+void KeepAliveTestProcess(void);
+
+/** Adds an entry for endpoint, due at deadline (in microseconds). */
+bool KeepAliveTestAddEntry(const CAEndpoint_t *endpoint, OCMode mode, uint64_t deadline);
+
+/** Removes the entry of endpoint, as on a disconnection reported by CA. */
+void KeepAliveTestRemoveEntry(const CAEndpoint_t *endpoint);
+
+/**
+ * Looks up the entry of endpoint.
+ * @return false if there is no entry for endpoint, otherwise the deadline, the current
+ *         interval and whether a ping is outstanding are returned.
+ */
+bool KeepAliveTestGetEntry(const CAEndpoint_t *endpoint, uint64_t *deadline,
+                           int64_t *interval, bool *sentPingMsg);
+
+/** Endpoint of the entry at the root of the deadline heap, NULL if the table is empty. */
+const CAEndpoint_t *KeepAliveTestGetEarliest(void);
+
+/** Number of entries of the table. */
+size_t KeepAliveTestGetCount(void);
+
+/** Number of hash buckets of the table. */
+size_t KeepAliveTestGetBucketCount(void);
+
+/**
+ * Checks that the heap is ordered by deadline, that every entry knows its heap
+ * position and that every entry is reachable from its bucket, once.
+ */
+bool KeepAliveTestIsConsistent(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEEPALIVE_TEST_HELPER_H_
@@ -0,0 +1,184 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+extern "C"
+{
+    #include "oic_time.h"
+    #include "keepalivetesthelper.h"
+}
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+
+static const uint64_t USECS_PER_SEC = 1000000;
+
+// Far enough from now for ProcessKeepAlive to leave the entry alone.
+static const uint64_t FUTURE_DEADLINE = UINT64_MAX / 2;
+
+static CAEndpoint_t MakeEndpoint(int index)
+{
+    CAEndpoint_t endpoint = CAEndpoint_t();
+    endpoint.adapter = CA_ADAPTER_TCP;
+    snprintf(endpoint.addr, sizeof(endpoint.addr), "10.0.%d.%d", index / 256, index % 256);
+    endpoint.port = (uint16_t) (5683 + index);
+    return endpoint;
+}
+
+class KeepAliveTest : public testing::Test
+{
+    protected:
+        virtual void SetUp()
+        {
+            ASSERT_EQ(OC_STACK_OK, KeepAliveTestInitialize());
+        }
+
+        virtual void TearDown()
+        {
+            KeepAliveTestTerminate();
+        }
+};
+
+TEST_F(KeepAliveTest, HeapIsOrderedByDeadline)
+{
+    const int numOfEntries = 100;
+    for (int i = 0; i < numOfEntries; i++)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        // deadlines out of insertion order, with some ties.
+        uint64_t deadline = FUTURE_DEADLINE + (uint64_t) ((i * 37) % 50);
+        ASSERT_TRUE(KeepAliveTestAddEntry(&endpoint, OC_CLIENT, deadline));
+        ASSERT_TRUE(KeepAliveTestIsConsistent());
+    }
+    ASSERT_EQ((size_t) numOfEntries, KeepAliveTestGetCount());
+
+    // The entries leave the root of the heap in deadline order.
+    uint64_t previous = 0;
+    while (KeepAliveTestGetCount())
+    {
+        CAEndpoint_t earliest = *KeepAliveTestGetEarliest();
+        uint64_t deadline = 0;
+        int64_t interval = 0;
+        bool sentPingMsg = false;
+        ASSERT_TRUE(KeepAliveTestGetEntry(&earliest, &deadline, &interval, &sentPingMsg));
+        EXPECT_LE(previous, deadline);
+        previous = deadline;
+
+        KeepAliveTestRemoveEntry(&earliest);
+        ASSERT_TRUE(KeepAliveTestIsConsistent());
+    }
+}
+
+TEST_F(KeepAliveTest, RemoveFromTheMiddleKeepsTheHeap)
+{
+    const int numOfEntries = 50;
+    for (int i = 0; i < numOfEntries; i++)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        ASSERT_TRUE(KeepAliveTestAddEntry(&endpoint, OC_CLIENT,
+                                          FUTURE_DEADLINE + (uint64_t) ((i * 13) % numOfEntries)));
+    }
+
+    size_t numOfRemoved = 0;
+    for (int i = 1; i < numOfEntries; i += 3)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        KeepAliveTestRemoveEntry(&endpoint);
+        numOfRemoved++;
+        ASSERT_TRUE(KeepAliveTestIsConsistent());
+    }
+    EXPECT_EQ(numOfEntries - numOfRemoved, KeepAliveTestGetCount());
+
+    for (int i = 0; i < numOfEntries; i++)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        uint64_t deadline = 0;
+        int64_t interval = 0;
+        bool sentPingMsg = false;
+        EXPECT_EQ(1 != i % 3, KeepAliveTestGetEntry(&endpoint, &deadline, &interval,
+                                                     &sentPingMsg)) << "entry " << i;
+    }
+
+    // Removing an unknown endpoint leaves the table alone.
+    CAEndpoint_t unknown = MakeEndpoint(numOfEntries);
+    KeepAliveTestRemoveEntry(&unknown);
+    EXPECT_EQ(numOfEntries - numOfRemoved, KeepAliveTestGetCount());
+    EXPECT_TRUE(KeepAliveTestIsConsistent());
+}
+
+TEST_F(KeepAliveTest, FailedPingIsRetried)
+{
+    CAEndpoint_t later = MakeEndpoint(1);
+    ASSERT_TRUE(KeepAliveTestAddEntry(&later, OC_CLIENT, FUTURE_DEADLINE));
+
+    CAEndpoint_t due = MakeEndpoint(0);
+    uint64_t deadline = 0;
+    int64_t interval = 0;
+    bool sentPingMsg = false;
+    ASSERT_TRUE(KeepAliveTestAddEntry(&due, OC_CLIENT, 1));
+    ASSERT_TRUE(KeepAliveTestGetEntry(&due, &deadline, &interval, &sentPingMsg));
+    int64_t firstInterval = interval;
+
+    // The stack is not running, so the ping message can't be sent.
+    uint64_t before = OICGetCurrentTime(TIME_IN_US);
+    KeepAliveTestProcess();
+    uint64_t after = OICGetCurrentTime(TIME_IN_US);
+
+    // The entry is kept and checked again a second later.
+    ASSERT_TRUE(KeepAliveTestGetEntry(&due, &deadline, &interval, &sentPingMsg));
+    EXPECT_FALSE(sentPingMsg);
+    EXPECT_LT(firstInterval, interval);
+    EXPECT_LE(before + USECS_PER_SEC, deadline);
+    EXPECT_GE(after + USECS_PER_SEC, deadline);
+
+    EXPECT_EQ(2u, KeepAliveTestGetCount());
+    EXPECT_TRUE(KeepAliveTestIsConsistent());
+    EXPECT_STREQ(due.addr, KeepAliveTestGetEarliest()->addr);
+    EXPECT_TRUE(KeepAliveTestGetEntry(&later, &deadline, &interval, &sentPingMsg));
+    EXPECT_EQ(FUTURE_DEADLINE, deadline);
+}
+
+TEST_F(KeepAliveTest, BucketsGrowPastInitialSize)
+{
+    const int numOfEntries = 200;
+    size_t initialBucketCount = KeepAliveTestGetBucketCount();
+    ASSERT_GT((size_t) numOfEntries, initialBucketCount);
+
+    for (int i = 0; i < numOfEntries; i++)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        ASSERT_TRUE(KeepAliveTestAddEntry(&endpoint, OC_CLIENT, FUTURE_DEADLINE + i));
+    }
+
+    EXPECT_EQ((size_t) numOfEntries, KeepAliveTestGetCount());
+    EXPECT_LT(initialBucketCount, KeepAliveTestGetBucketCount());
+    EXPECT_LE((size_t) numOfEntries, KeepAliveTestGetBucketCount());
+    EXPECT_TRUE(KeepAliveTestIsConsistent());
+
+    for (int i = 0; i < numOfEntries; i++)
+    {
+        CAEndpoint_t endpoint = MakeEndpoint(i);
+        uint64_t deadline = 0;
+        int64_t interval = 0;
+        bool sentPingMsg = false;
+        ASSERT_TRUE(KeepAliveTestGetEntry(&endpoint, &deadline, &interval, &sentPingMsg))
+            << "entry " << i;
+        EXPECT_EQ(FUTURE_DEADLINE + i, deadline);
+    }
+}
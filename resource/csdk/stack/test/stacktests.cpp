@@ -35,6 +35,11 @@ extern "C"
 #if defined (WITH_POSIX) && (defined (__WITH_DTLS__) || defined(__WITH_TLS__))
     #include "ca_adapter_net_ssl.h"
 #endif
+#if defined (__WITH_DTLS__) || defined(__WITH_TLS__)
+    #include "secureresourcemanager.h"
+
+    extern SRMRequestContext_t g_requestContext;
+#endif
 }
 
 #include <gtest/gtest.h>
@@ -55,6 +60,8 @@ extern "C"
 
 #include <iostream>
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 #include "gtest_helper.h"
 
@@ -3231,6 +3238,331 @@ TEST(DiagnosticPayload, DISABLED_EndToEnd)
     OCStop();
 }
 
+#define INTROSPECTION_TEST_FILE_NAME "introspection_test.dat"
+
+static int g_introspectionOpens;
+
+static FILE *IntrospectionOpen(const char *path, const char *mode)
+{
+    if (0 == strcmp(path, OC_INTROSPECTION_FILE_NAME))
+    {
+        g_introspectionOpens++;
+        path = INTROSPECTION_TEST_FILE_NAME;
+    }
+    return fopen(path, mode);
+}
+
+static void WriteIntrospectionFile(const char *data)
+{
+    FILE *fp = fopen(INTROSPECTION_TEST_FILE_NAME, "wb");
+    ASSERT_TRUE(NULL != fp);
+    EXPECT_EQ(strlen(data), fwrite(data, 1, strlen(data), fp));
+    fclose(fp);
+}
+
+static std::string BuildIntrospectionPayload()
+{
+    OCPayload *payload = NULL;
+    EXPECT_EQ(OC_STACK_OK, BuildIntrospectionPayloadResponse(NULL, &payload, NULL));
+    if (!payload)
+    {
+        return std::string();
+    }
+
+    EXPECT_EQ(PAYLOAD_TYPE_INTROSPECTION, payload->type);
+    OCIntrospectionPayload *introspectionPayload = (OCIntrospectionPayload *) payload;
+    std::string data((const char *) introspectionPayload->cborPayload.bytes,
+            introspectionPayload->cborPayload.len);
+    OCPayloadDestroy(payload);
+    return data;
+}
+
+TEST(IntrospectionTests, RegisteringStorageHandlerInvalidatesCachedData)
+{
+    OCPersistentStorage ps = { IntrospectionOpen, fread, fwrite, fclose, unlink };
+    WriteIntrospectionFile("first");
+    EXPECT_EQ(OC_STACK_OK, OCRegisterPersistentStorageHandler(&ps));
+    g_introspectionOpens = 0;
+
+    EXPECT_EQ("first", BuildIntrospectionPayload());
+    EXPECT_EQ(1, g_introspectionOpens);
+
+    // The data is served from memory, even if the file changes.
+    WriteIntrospectionFile("second");
+    EXPECT_EQ("first", BuildIntrospectionPayload());
+    EXPECT_EQ(1, g_introspectionOpens);
+
+    EXPECT_EQ(OC_STACK_OK, OCRegisterPersistentStorageHandler(&ps));
+    EXPECT_EQ("second", BuildIntrospectionPayload());
+    EXPECT_EQ(2, g_introspectionOpens);
+
+    DeleteIntrospectionData();
+    unlink(INTROSPECTION_TEST_FILE_NAME);
+}
+
+struct ETagResponse
+{
+    OCStackResult result;
+    bool hasPayload;
+    std::vector<uint8_t> etag;
+};
+
+static ETagResponse g_etagResponse;
+static int g_etagRequests;
+
+class OCETagTests : public testing::Test
+{
+    protected:
+        virtual void SetUp()
+        {
+            EXPECT_EQ(OC_STACK_OK, OCInit("127.0.0.1", 5683, OC_CLIENT_SERVER));
+            g_etagRequests = 0;
+        }
+
+        virtual void TearDown()
+        {
+            OCStop();
+        }
+};
+
+static OCEntityHandlerResult ETagRequest(OCEntityHandlerFlag flag,
+        OCEntityHandlerRequest *request, void *ctx)
+{
+    OC_UNUSED(flag);
+    (*(int *) ctx)++;
+
+    OCRepPayload *payload = OCRepPayloadCreate();
+    EXPECT_TRUE(payload != NULL);
+    OCRepPayloadSetPropBool(payload, "state", true);
+
+    OCEntityHandlerResponse response;
+    memset(&response, 0, sizeof(response));
+    response.requestHandle = request->requestHandle;
+    response.ehResult = OC_EH_OK;
+    response.payload = (OCPayload*) payload;
+    EXPECT_EQ(OC_STACK_OK, OCDoResponse(&response));
+    OCRepPayloadDestroy(payload);
+    return OC_EH_OK;
+}
+
+static OCStackApplicationResult ETagResponseHandler(void *ctx, OCDoHandle handle,
+        OCClientResponse *response)
+{
+    OC_UNUSED(ctx);
+    OC_UNUSED(handle);
+    g_etagResponse.result = response->result;
+    g_etagResponse.hasPayload = (NULL != response->payload);
+    g_etagResponse.etag.clear();
+    for (uint8_t i = 0; i < response->numRcvdVendorSpecificHeaderOptions; i++)
+    {
+        const OCHeaderOption *option = &response->rcvdVendorSpecificHeaderOptions[i];
+        if (OC_RSRVD_ETAG_OPTION_ID == option->optionID)
+        {
+            g_etagResponse.etag.assign(option->optionData,
+                                       option->optionData + option->optionLength);
+        }
+    }
+    return OC_STACK_DELETE_TRANSACTION;
+}
+
+/*
+ * Sends a request to a resource of the stack itself, with the given ETag if it's not empty,
+ * and waits for the response in g_etagResponse.
+ */
+static void SendETagRequest(OCMethod method, const char *uri, std::vector<uint8_t> etag)
+{
+    OCHeaderOption options[1];
+    size_t numOptions = 0;
+    if (!etag.empty())
+    {
+        EXPECT_EQ(OC_STACK_OK, OCSetHeaderOption(options, &numOptions, OC_RSRVD_ETAG_OPTION_ID,
+                                                 etag.data(), etag.size()));
+    }
+
+    OCPayload *payload = NULL;
+    if (OC_REST_PUT == method)
+    {
+        OCRepPayload *repPayload = OCRepPayloadCreate();
+        OCRepPayloadSetPropBool(repPayload, "state", false);
+        payload = (OCPayload *) repPayload;
+    }
+
+    g_etagResponse = ETagResponse();
+    g_etagResponse.result = OC_STACK_ERROR;
+    itst::Callback etagCB(&ETagResponseHandler);
+    EXPECT_EQ(OC_STACK_OK, OCDoResource(NULL, method, uri, NULL, payload, CT_DEFAULT,
+            OC_HIGH_QOS, etagCB, numOptions ? options : NULL, (uint8_t) numOptions));
+    EXPECT_EQ(OC_STACK_OK, etagCB.Wait(100));
+}
+
+TEST_F(OCETagTests, MatchingETagIsValid)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.light", "oic.if.baseline", "/a/light",
+            ETagRequest, &g_etagRequests, OC_DISCOVERABLE | OC_ETAG));
+
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", std::vector<uint8_t>());
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_EQ(sizeof(uint32_t), g_etagResponse.etag.size());
+    EXPECT_EQ(1, g_etagRequests);
+
+    // 2.03 Valid with the same ETag, without payload nor calling the entity handler.
+    std::vector<uint8_t> etag = g_etagResponse.etag;
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", etag);
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_FALSE(g_etagResponse.hasPayload);
+    EXPECT_EQ(etag, g_etagResponse.etag);
+    EXPECT_EQ(1, g_etagRequests);
+
+    // An other ETag gets the representation.
+    std::vector<uint8_t> otherETag = etag;
+    otherETag[0] ^= 0xFF;
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", otherETag);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_EQ(etag, g_etagResponse.etag);
+    EXPECT_EQ(2, g_etagRequests);
+}
+
+TEST_F(OCETagTests, ETagChangesWithRepresentation)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.light", "oic.if.baseline", "/a/light",
+            ETagRequest, &g_etagRequests, OC_DISCOVERABLE | OC_OBSERVABLE | OC_ETAG));
+
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", std::vector<uint8_t>());
+    std::vector<uint8_t> etag = g_etagResponse.etag;
+    EXPECT_EQ(sizeof(uint32_t), etag.size());
+
+    // After a PUT, 2.05 Content with a new ETag.
+    SendETagRequest(OC_REST_PUT, "127.0.0.1:5683/a/light", std::vector<uint8_t>());
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", etag);
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_EQ(sizeof(uint32_t), g_etagResponse.etag.size());
+    EXPECT_NE(etag, g_etagResponse.etag);
+    EXPECT_EQ(3, g_etagRequests);
+
+    // After a notification.
+    etag = g_etagResponse.etag;
+    EXPECT_EQ(OC_STACK_NO_OBSERVERS, OCNotifyAllObservers(handle, OC_LOW_QOS));
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", etag);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_NE(etag, g_etagResponse.etag);
+    EXPECT_EQ(4, g_etagRequests);
+
+    // After an explicit invalidation.
+    etag = g_etagResponse.etag;
+    EXPECT_EQ(OC_STACK_OK, OCInvalidateResourceETag(handle));
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", etag);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_NE(etag, g_etagResponse.etag);
+    EXPECT_EQ(5, g_etagRequests);
+
+    EXPECT_EQ(OC_STACK_INVALID_PARAM, OCInvalidateResourceETag(NULL));
+}
+
+TEST_F(OCETagTests, ResourceWithoutETagIsUnchanged)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.light", "oic.if.baseline", "/a/light",
+            ETagRequest, &g_etagRequests, OC_DISCOVERABLE));
+
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", std::vector<uint8_t>());
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_TRUE(g_etagResponse.etag.empty());
+
+    std::vector<uint8_t> etag(sizeof(uint32_t), 0x01);
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", etag);
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_TRUE(g_etagResponse.etag.empty());
+    EXPECT_EQ(2, g_etagRequests);
+}
+
+TEST_F(OCETagTests, ObserveRequestIsUnchanged)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.light", "oic.if.baseline", "/a/light",
+            ETagRequest, &g_etagRequests, OC_DISCOVERABLE | OC_OBSERVABLE | OC_ETAG));
+
+    SendETagRequest(OC_REST_GET, "127.0.0.1:5683/a/light", std::vector<uint8_t>());
+    std::vector<uint8_t> etag = g_etagResponse.etag;
+    EXPECT_EQ(sizeof(uint32_t), etag.size());
+
+    // The registration is answered by the entity handler even though the ETag matches.
+    SendETagRequest(OC_REST_OBSERVE, "127.0.0.1:5683/a/light", etag);
+    EXPECT_EQ(OC_STACK_OK, g_etagResponse.result);
+    EXPECT_TRUE(g_etagResponse.hasPayload);
+    EXPECT_EQ(2, g_etagRequests);
+}
+
+#if defined (__WITH_DTLS__) || defined(__WITH_TLS__)
+static OCStackApplicationResult SecurityFlagsResponse(void *ctx, OCDoHandle handle,
+        OCClientResponse *response)
+{
+    OC_UNUSED(ctx);
+    OC_UNUSED(handle);
+    OC_UNUSED(response);
+    return OC_STACK_DELETE_TRANSACTION;
+}
+
+/*
+ * Sends a request to a resource of the stack itself, and returns once it is answered,
+ * whether SRM has granted it or not.
+ */
+static void SendSecurityFlagsRequest(const char *uri)
+{
+    itst::Callback flagsCB(&SecurityFlagsResponse);
+    EXPECT_EQ(OC_STACK_OK, OCDoResource(NULL, OC_REST_GET, uri, NULL, NULL, CT_DEFAULT,
+            OC_HIGH_QOS, flagsCB, NULL, 0));
+    EXPECT_EQ(OC_STACK_OK, flagsCB.Wait(100));
+}
+
+TEST(StackResourceAccess, ChangedSecurityFlagsAreSeenByNextRequest)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    EXPECT_EQ(OC_STACK_OK, OCInit("127.0.0.1", 5683, OC_CLIENT_SERVER));
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle, "core.light", "oic.if.baseline", "/a/light",
+            NULL, NULL, OC_DISCOVERABLE | OC_SECURE));
+    OCResource *resource = (OCResource *) handle;
+
+    SendSecurityFlagsRequest("127.0.0.1:5683/a/light");
+    EXPECT_TRUE(resource->securityAttributes.isValid);
+    EXPECT_TRUE(g_requestContext.resourceIsOcSecure);
+    EXPECT_FALSE(g_requestContext.resourceIsOcNonsecure);
+
+    EXPECT_EQ(OC_STACK_OK, OCSetResourceProperties(handle, OC_NONSECURE));
+    EXPECT_FALSE(resource->securityAttributes.isValid);
+    SendSecurityFlagsRequest("127.0.0.1:5683/a/light");
+    EXPECT_TRUE(g_requestContext.resourceIsOcSecure);
+    EXPECT_TRUE(g_requestContext.resourceIsOcNonsecure);
+
+    EXPECT_EQ(OC_STACK_OK, OCClearResourceProperties(handle, OC_SECURE));
+    EXPECT_FALSE(resource->securityAttributes.isValid);
+    SendSecurityFlagsRequest("127.0.0.1:5683/a/light");
+    EXPECT_FALSE(g_requestContext.resourceIsOcSecure);
+    EXPECT_TRUE(g_requestContext.resourceIsOcNonsecure);
+    EXPECT_TRUE(resource->securityAttributes.isValid);
+    EXPECT_FALSE(resource->securityAttributes.isSecure);
+    EXPECT_TRUE(resource->securityAttributes.isNonsecure);
+
+    OCStop();
+}
+#endif
+
 // Mostly copy-paste from ca_api_unittest.cpp
 TEST(OCIpv6ScopeLevel, getMulticastScope)
 {
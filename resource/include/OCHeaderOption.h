@@ -41,13 +41,14 @@ namespace OC
         *            (in OCResource.h) to set header Options.
         *            NOTE: HeaderOptionID  is an unsigned integer value which MUST be within
         *            range of 2048 to 3000 inclusive of lower and upper bound
-        *            except for If-Match with empty(num : 1), If-None-Match(num : 5),
+        *            except for If-Match with empty(num : 1), ETag(num : 4), If-None-Match(num : 5),
         *            Location-Path(num : 8), Location-Query(num : 20), Accept(num : 17) option.
         *            HeaderOptions instance creation fails if above condition is not satisfied.
         */
         const uint16_t MIN_HEADER_OPTIONID = 2048;
         const uint16_t MAX_HEADER_OPTIONID = 3000;
         const uint16_t IF_MATCH_OPTION_ID = 1;
+        const uint16_t ETAG_OPTION_ID = 4;
         const uint16_t IF_NONE_MATCH_OPTION_ID = 5;
         const uint16_t LOCATION_PATH_OPTION_ID = 8;
         const uint16_t LOCATION_QUERY_OPTION_ID = 20;
@@ -70,6 +71,7 @@ namespace OC
             {
                 if (!(optionID >= MIN_HEADER_OPTIONID && optionID <= MAX_HEADER_OPTIONID)
                         && optionID != IF_MATCH_OPTION_ID
+                        && optionID != ETAG_OPTION_ID
                         && optionID != IF_NONE_MATCH_OPTION_ID
                         && optionID != LOCATION_PATH_OPTION_ID
                         && optionID != LOCATION_QUERY_OPTION_ID
@@ -154,8 +154,18 @@ namespace OC
             for(size_t i = 0; i < clientResponse->numRcvdVendorSpecificHeaderOptions; i++)
             {
                 optionID = clientResponse->rcvdVendorSpecificHeaderOptions[i].optionID;
-                optionData = reinterpret_cast<const char*>
+                if (HeaderOption::ETAG_OPTION_ID == optionID)
+                {
+                    // an ETag is opaque, so it may contain a zero byte.
+                    optionData.assign(reinterpret_cast<const char*>
+                                (clientResponse->rcvdVendorSpecificHeaderOptions[i].optionData),
+                                clientResponse->rcvdVendorSpecificHeaderOptions[i].optionLength);
+                }
+                else
+                {
+                    optionData = reinterpret_cast<const char*>
                                 (clientResponse->rcvdVendorSpecificHeaderOptions[i].optionData);
+                }
                 HeaderOption::OCHeaderOption headerOption(optionID, optionData);
                 serverHeaderOptions.push_back(headerOption);
             }
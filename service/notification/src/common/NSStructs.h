@@ -36,6 +36,7 @@ typedef struct _nsTask
     NSTaskType taskType;        /**< task type */
     void * taskData;            /**< task data */
     struct _nsTask * nextTask;  /**< pointer to next task */
+    uint64_t pushTime;          /**< time pushed to task queue in microseconds */
 
 } NSTask;
 
@@ -51,11 +52,14 @@ typedef struct
 
 typedef void * NSCacheData; /**< ns cache data */
 
+typedef struct _NSCacheIndex NSCacheIndex; /**< ns cache lookup index */
+
 /** ns cache element structure */
 typedef struct _NSCacheElement
 {
     NSCacheData * data;                 /**< cache data */
     struct _NSCacheElement * next;      /**< pointer to next element */
+    struct _NSCacheElement * prev;      /**< pointer to previous element */
 
 } NSCacheElement;
 
@@ -65,6 +69,7 @@ typedef struct
     NSCacheType cacheType;         /**< cache type */
     NSCacheElement * head;         /**< head node of list */
     NSCacheElement * tail;         /**< tail node of list */
+    NSCacheIndex * index;          /**< hash index of elements, provider only */
 
 } NSCacheList;
 
@@ -0,0 +1,363 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "NSTaskQueue.h"
+
+#include <pthread.h>
+#include "NSConstants.h"
+#include "oic_malloc.h"
+#include "oic_time.h"
+
+/** maximum tasks handled before a worker moves on to the next ready queue */
+#define NS_TASK_QUEUE_BATCH_SIZE 32
+
+#define NS_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define NS_ATOMIC_STORE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_SEQ_CST)
+
+struct _NSTaskQueue
+{
+    NSTask stub;                      /**< stub node of the queue */
+    NSTask * head;                    /**< last pushed task, updated by producers */
+    NSTask * tail;                    /**< next task to pop, used by worker */
+    NSTaskHandler handler;            /**< task handler */
+    NSWorkerPool * pool;              /**< pool running the queue */
+    int isScheduled;                  /**< 1 while queue is ready or running */
+    size_t depth;                     /**< tasks waiting in queue */
+    size_t maxDepth;                  /**< largest depth seen */
+    uint64_t handledCount;            /**< tasks handled */
+    uint64_t totalLatency;            /**< sum of latency in microseconds */
+    uint64_t maxLatency;              /**< largest latency in microseconds */
+    struct _NSTaskQueue * nextReady;  /**< next queue in ready list of pool */
+};
+
+struct _NSWorkerPool
+{
+    pthread_t * threads;              /**< worker threads */
+    size_t threadCount;               /**< number of started worker threads */
+    pthread_mutex_t mutex;            /**< protects ready list */
+    pthread_cond_t condition;         /**< signals ready queue or stop */
+    NSTaskQueue * readyHead;          /**< first queue ready to run */
+    NSTaskQueue * readyTail;          /**< last queue ready to run */
+    bool isRunning;                   /**< false once pool is stopping */
+};
+
+static void NSLinkTask(NSTaskQueue * queue, NSTask * task)
+{
+    NS_ATOMIC_STORE(&task->nextTask, NULL);
+    NSTask * prev = __atomic_exchange_n(&queue->head, task, __ATOMIC_SEQ_CST);
+    NS_ATOMIC_STORE(&prev->nextTask, task);
+}
+
+static NSTask * NSUnlinkTask(NSTaskQueue * queue)
+{
+    NSTask * tail = queue->tail;
+    NSTask * next = NS_ATOMIC_LOAD(&tail->nextTask);
+
+    if (tail == &queue->stub)
+    {
+        if (!next)
+        {
+            return NULL;
+        }
+
+        queue->tail = next;
+        tail = next;
+        next = NS_ATOMIC_LOAD(&next->nextTask);
+    }
+
+    if (next)
+    {
+        queue->tail = next;
+        return tail;
+    }
+
+    if (tail != NS_ATOMIC_LOAD(&queue->head))
+    {
+        // a producer swapped the head but did not link its task yet.
+        return NULL;
+    }
+
+    NSLinkTask(queue, &queue->stub);
+    next = NS_ATOMIC_LOAD(&tail->nextTask);
+
+    if (next)
+    {
+        queue->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+static bool NSHasLinkedTask(NSTaskQueue * queue)
+{
+    NSTask * tail = queue->tail;
+
+    if (NS_ATOMIC_LOAD(&tail->nextTask))
+    {
+        return true;
+    }
+
+    return tail != &queue->stub && tail == NS_ATOMIC_LOAD(&queue->head);
+}
+
+static void NSScheduleTaskQueue(NSWorkerPool * pool, NSTaskQueue * queue)
+{
+    pthread_mutex_lock(&pool->mutex);
+
+    queue->nextReady = NULL;
+
+    if (pool->readyTail)
+    {
+        pool->readyTail->nextReady = queue;
+    }
+    else
+    {
+        pool->readyHead = queue;
+    }
+
+    pool->readyTail = queue;
+
+    pthread_cond_signal(&pool->condition);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static void NSUpdateTaskStats(NSTaskQueue * queue, NSTask * task)
+{
+    uint64_t now = OICGetCurrentTime(TIME_IN_US);
+    uint64_t latency = (now > task->pushTime) ? now - task->pushTime : 0;
+
+    // only the worker running the queue updates these, readers load them atomically.
+    NS_ATOMIC_STORE(&queue->handledCount, queue->handledCount + 1);
+    NS_ATOMIC_STORE(&queue->totalLatency, queue->totalLatency + latency);
+
+    if (latency > queue->maxLatency)
+    {
+        NS_ATOMIC_STORE(&queue->maxLatency, latency);
+    }
+}
+
+static void NSRunTaskQueue(NSTaskQueue * queue)
+{
+    NSWorkerPool * pool = queue->pool;
+    size_t handled = 0;
+
+    while (handled < NS_TASK_QUEUE_BATCH_SIZE)
+    {
+        if (!NS_ATOMIC_LOAD(&pool->isRunning))
+        {
+            return;
+        }
+
+        NSTask * task = NSUnlinkTask(queue);
+
+        if (!task)
+        {
+            break;
+        }
+
+        __atomic_sub_fetch(&queue->depth, 1, __ATOMIC_SEQ_CST);
+        NSUpdateTaskStats(queue, task);
+        queue->handler(task);
+        handled++;
+    }
+
+    if (handled == NS_TASK_QUEUE_BATCH_SIZE && NSHasLinkedTask(queue))
+    {
+        NSScheduleTaskQueue(pool, queue);
+        return;
+    }
+
+    NS_ATOMIC_STORE(&queue->isScheduled, 0);
+
+    int expected = 0;
+
+    if (NSHasLinkedTask(queue) && __atomic_compare_exchange_n(&queue->isScheduled, &expected, 1,
+            false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+        NSScheduleTaskQueue(pool, queue);
+    }
+}
+
+static void * NSWorkerThreadFunc(void * data)
+{
+    NSWorkerPool * pool = (NSWorkerPool *) data;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (true)
+    {
+        while (pool->isRunning && !pool->readyHead)
+        {
+            pthread_cond_wait(&pool->condition, &pool->mutex);
+        }
+
+        if (!pool->isRunning)
+        {
+            break;
+        }
+
+        NSTaskQueue * queue = pool->readyHead;
+        pool->readyHead = queue->nextReady;
+
+        if (!pool->readyHead)
+        {
+            pool->readyTail = NULL;
+        }
+
+        pthread_mutex_unlock(&pool->mutex);
+        NSRunTaskQueue(queue);
+        pthread_mutex_lock(&pool->mutex);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+NSWorkerPool * NSCreateWorkerPool(size_t workerCount)
+{
+    NS_VERIFY_NOT_NULL(workerCount ? (void *) 1 : NULL, NULL);
+
+    NSWorkerPool * pool = (NSWorkerPool *) OICCalloc(1, sizeof(NSWorkerPool));
+    NS_VERIFY_NOT_NULL(pool, NULL);
+
+    pool->threads = (pthread_t *) OICCalloc(workerCount, sizeof(pthread_t));
+    NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(pool->threads, NULL, NSOICFree(pool));
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->condition, NULL);
+    pool->isRunning = true;
+
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        if (pthread_create(&pool->threads[i], NULL, NSWorkerThreadFunc, pool) != 0)
+        {
+            NS_LOG(ERROR, "Fail to create worker thread");
+            NSDestroyWorkerPool(pool);
+            return NULL;
+        }
+
+        pool->threadCount++;
+    }
+
+    return pool;
+}
+
+void NSDestroyWorkerPool(NSWorkerPool * pool)
+{
+    NS_VERIFY_NOT_NULL_V(pool);
+
+    pthread_mutex_lock(&pool->mutex);
+    NS_ATOMIC_STORE(&pool->isRunning, false);
+    pthread_cond_broadcast(&pool->condition);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t i = 0; i < pool->threadCount; ++i)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->condition);
+    pthread_mutex_destroy(&pool->mutex);
+    NSOICFree(pool->threads);
+    NSOICFree(pool);
+}
+
+NSTaskQueue * NSCreateTaskQueue(NSWorkerPool * pool, NSTaskHandler handler)
+{
+    NS_VERIFY_NOT_NULL(pool, NULL);
+    NS_VERIFY_NOT_NULL(handler, NULL);
+
+    NSTaskQueue * queue = (NSTaskQueue *) OICCalloc(1, sizeof(NSTaskQueue));
+    NS_VERIFY_NOT_NULL(queue, NULL);
+
+    queue->head = queue->tail = &queue->stub;
+    queue->handler = handler;
+    queue->pool = pool;
+
+    return queue;
+}
+
+void NSDestroyTaskQueue(NSTaskQueue * queue)
+{
+    NS_VERIFY_NOT_NULL_V(queue);
+
+    NSTask * task = NSUnlinkTask(queue);
+
+    while (task)
+    {
+        NSOICFree(task);
+        task = NSUnlinkTask(queue);
+    }
+
+    NSOICFree(queue);
+}
+
+void NSPushTaskQueue(NSTaskQueue * queue, NSTask * task)
+{
+    NS_VERIFY_NOT_NULL_V(queue);
+    NS_VERIFY_NOT_NULL_V(task);
+
+    task->pushTime = OICGetCurrentTime(TIME_IN_US);
+
+    size_t depth = __atomic_add_fetch(&queue->depth, 1, __ATOMIC_SEQ_CST);
+    size_t maxDepth = NS_ATOMIC_LOAD(&queue->maxDepth);
+
+    while (depth > maxDepth && !__atomic_compare_exchange_n(&queue->maxDepth, &maxDepth, depth,
+            false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+    }
+
+    NSLinkTask(queue, task);
+
+    int expected = 0;
+
+    if (__atomic_compare_exchange_n(&queue->isScheduled, &expected, 1,
+            false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+        NSScheduleTaskQueue(queue->pool, queue);
+    }
+}
+
+NSTask * NSPopTaskQueue(NSTaskQueue * queue)
+{
+    NS_VERIFY_NOT_NULL(queue, NULL);
+
+    NSTask * task = NSUnlinkTask(queue);
+
+    if (task)
+    {
+        __atomic_sub_fetch(&queue->depth, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return task;
+}
+
+void NSGetTaskQueueStats(NSTaskQueue * queue, NSTaskQueueStats * stats)
+{
+    NS_VERIFY_NOT_NULL_V(queue);
+    NS_VERIFY_NOT_NULL_V(stats);
+
+    stats->depth = NS_ATOMIC_LOAD(&queue->depth);
+    stats->maxDepth = NS_ATOMIC_LOAD(&queue->maxDepth);
+    stats->handledCount = NS_ATOMIC_LOAD(&queue->handledCount);
+    stats->totalLatency = NS_ATOMIC_LOAD(&queue->totalLatency);
+    stats->maxLatency = NS_ATOMIC_LOAD(&queue->maxLatency);
+}
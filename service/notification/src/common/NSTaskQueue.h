@@ -0,0 +1,125 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#ifndef _NS_TASK_QUEUE_H_
+#define _NS_TASK_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "NSStructs.h"
+
+/**
+ * Task queues are multi producer, single consumer queues of NSTask nodes.
+ * Pushing a task is lock free. The queues are served by a shared pool of
+ * worker threads; a queue is run by at most one worker at a time, so the
+ * tasks of one queue are handled in push order.
+ */
+
+/** ns task queue */
+typedef struct _NSTaskQueue NSTaskQueue;
+
+/** ns worker pool */
+typedef struct _NSWorkerPool NSWorkerPool;
+
+/** task handler, owns the task and must free it */
+typedef void (* NSTaskHandler)(NSTask * task);
+
+/** ns task queue statistics */
+typedef struct
+{
+    size_t depth;              /**< tasks waiting in queue */
+    size_t maxDepth;           /**< largest depth seen */
+    uint64_t handledCount;     /**< tasks handled */
+    uint64_t totalLatency;     /**< sum of push to handle latency in microseconds */
+    uint64_t maxLatency;       /**< largest push to handle latency in microseconds */
+
+} NSTaskQueueStats;
+
+/**
+ * Create worker pool.
+ *
+ * @param workerCount  number of worker threads.
+ *
+ * @return new worker pool, NULL if failed.
+ */
+NSWorkerPool * NSCreateWorkerPool(size_t workerCount);
+
+/**
+ * Stop and destroy worker pool. Tasks being handled are completed, tasks left
+ * in the queues stay there until the queues are destroyed.
+ *
+ * @param pool  worker pool to destroy.
+ */
+void NSDestroyWorkerPool(NSWorkerPool * pool);
+
+/**
+ * Create task queue served by worker pool.
+ *
+ * @param pool     worker pool.
+ * @param handler  handler called for each task.
+ *
+ * @return new task queue, NULL if failed.
+ */
+NSTaskQueue * NSCreateTaskQueue(NSWorkerPool * pool, NSTaskHandler handler);
+
+/**
+ * Destroy task queue. Must be called after its worker pool is destroyed.
+ * Tasks left in queue are freed without their data.
+ *
+ * @param queue  task queue to destroy.
+ */
+void NSDestroyTaskQueue(NSTaskQueue * queue);
+
+/**
+ * Push task to queue.
+ *
+ * @param queue  task queue.
+ * @param task   task to push, owned by queue afterwards.
+ */
+void NSPushTaskQueue(NSTaskQueue * queue, NSTask * task);
+
+/**
+ * Pop task from queue. Only for use when no worker runs the queue,
+ * i.e. after its worker pool is destroyed.
+ *
+ * @param queue  task queue.
+ *
+ * @return task, NULL if queue is empty.
+ */
+NSTask * NSPopTaskQueue(NSTaskQueue * queue);
+
+/**
+ * Get statistics of task queue.
+ *
+ * @param queue  task queue.
+ * @param stats  statistics to fill.
+ */
+void NSGetTaskQueueStats(NSTaskQueue * queue, NSTaskQueueStats * stats);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // _NS_TASK_QUEUE_H_
@@ -154,8 +154,10 @@ NSResult NSProviderCacheUpdate(NSProvider_internal * provider)
     return NS_OK;
 }
 
-void NSCancelAllSubscription(void)
+void NSCancelAllSubscription(NSTaskHandler handler)
 {
+    NS_VERIFY_NOT_NULL_V(handler);
+
     NSCacheList * ProviderCache = *(NSGetProviderCacheList());
     if (!ProviderCache)
     {
@@ -178,7 +180,7 @@ void NSCancelAllSubscription(void)
         NSTask * task = NSMakeTask(TASK_CONSUMER_REQ_SUBSCRIBE_CANCEL, prov);
         NS_VERIFY_NOT_NULL_V(task);
 
-        NSConsumerPushEvent(task);
+        handler(task);
         NSRemoveProvider_internal((void *) obj->data);
         NSOICFree(obj);
 
@@ -28,6 +28,7 @@ extern "C" {
 #include "NSStructs.h"
 #include "NSConsumerMemoryCache.h"
 #include "NSConsumerCommunication.h"
+#include "NSTaskQueue.h"
 
 /**
  * Get message cache list.
@@ -52,8 +53,10 @@ NSCacheList ** NSGetProviderCacheList(void);
 
 /**
  * Cancel all subscription.
+ *
+ * @param handler to run each cancel task on the calling thread.
  */
-void NSCancelAllSubscription(void);
+void NSCancelAllSubscription(NSTaskHandler handler);
 
 /**
  * Set provider cache list.
@@ -33,9 +33,6 @@
 #include "NSConsumerCommon.h"
 #include "NSConsumerCommunication.h"
 
-#include "NSThread.h"
-#include "NSConsumerQueue.h"
-
 #include "NSConsumerDiscovery.h"
 #include "NSConsumerInternalTaskController.h"
 #include "NSConsumerNetworkEventListener.h"
@@ -45,25 +42,26 @@
 #include "NSConsumerMQPlugin.h"
 #endif
 
-void * NSConsumerMsgHandleThreadFunc(void * handle);
-
-void * NSConsumerMsgPushThreadFunc(void * data);
+/** worker threads running the consumer task queue */
+#define NS_CONSUMER_WORKER_COUNT 1
 
 void NSConsumerTaskProcessing(NSTask * task);
 
-static NSConsumerThread * g_handle = NULL;
-
 static pthread_mutex_t g_start_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-static NSConsumerQueue * g_queue = NULL;
+static NSWorkerPool * g_pool = NULL;
+
+static NSTaskQueue * g_queue = NULL;
+
+/* Pushing is lock free; exit waits for the pushes in flight before it destroys the queue. */
+static bool g_isClosing = true;
+
+static int g_pushCount = 0;
 
 NSResult NSConsumerMessageHandlerInit(void)
 {
     pthread_mutex_lock(&g_start_mutex);
 
-    NSConsumerThread * handle = NULL;
-    NSConsumerQueue * queue = NULL;
-
     char * consumerUuid = (char *)OCGetServerInstanceIDString();
     NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(consumerUuid, NS_ERROR,
             pthread_mutex_unlock(&g_start_mutex));
@@ -81,20 +79,22 @@ NSResult NSConsumerMessageHandlerInit(void)
     NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(ret == NS_OK ? (void *) 1 : NULL, NS_ERROR,
             pthread_mutex_unlock(&g_start_mutex));
 
+    NS_LOG(DEBUG, "worker pool init");
+    NSWorkerPool * pool = NSCreateWorkerPool(NS_CONSUMER_WORKER_COUNT);
+    NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(pool, NS_ERROR,
+            pthread_mutex_unlock(&g_start_mutex));
+
     NS_LOG(DEBUG, "create queue");
-    queue = NSCreateQueue();
+    NSTaskQueue * queue = NSCreateTaskQueue(pool, NSConsumerTaskProcessing);
     NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(queue, NS_ERROR,
-            pthread_mutex_unlock(&g_start_mutex));
-    g_queue = queue;
+            {
+                NSDestroyWorkerPool(pool);
+                pthread_mutex_unlock(&g_start_mutex);
+            });
 
-    NS_LOG(DEBUG, "queue thread init");
-    handle = NSThreadInit(NSConsumerMsgHandleThreadFunc, NULL);
-    if (!handle)
-    {
-        pthread_mutex_unlock(&g_start_mutex);
-        return NS_ERROR;
-    }
-    g_handle = handle;
+    g_pool = pool;
+    g_queue = queue;
+    __atomic_store_n(&g_isClosing, false, __ATOMIC_SEQ_CST);
 
     pthread_mutex_unlock(&g_start_mutex);
     return NS_OK;
@@ -102,150 +102,74 @@ NSResult NSConsumerMessageHandlerInit(void)
 
 NSResult NSConsumerPushEvent(NSTask * task)
 {
-    NSConsumerThread * thread = NSThreadInit(NSConsumerMsgPushThreadFunc, (void *) task);
-    NS_VERIFY_NOT_NULL(thread, NS_ERROR);
+    NS_VERIFY_NOT_NULL(task, NS_ERROR);
 
-    NSDestroyThreadHandle(thread);
-    NSOICFree(thread);
+    __atomic_add_fetch(&g_pushCount, 1, __ATOMIC_SEQ_CST);
 
-    return NS_OK;
-}
-
-void NSConsumerMessageHandlerExit(void)
-{
-    pthread_mutex_lock(&g_start_mutex);
-
-    NSConsumerListenerTermiate();
-    NSCancelAllSubscription();
-
-    NSThreadLock(g_handle);
-    NS_LOG(DEBUG, "Execute remaining task");
-    while (!NSIsQueueEmpty(g_queue))
+    if (__atomic_load_n(&g_isClosing, __ATOMIC_SEQ_CST))
     {
-        NSConsumerQueueObject * obj = NSPopQueue(g_queue);
-        if (obj)
-        {
-            NS_LOG_V(DEBUG, "Execute remaining task type : %d", ((NSTask *)(obj->data))->taskType);
-            NSConsumerTaskProcessing((NSTask *)(obj->data));
-            NSOICFree(obj);
-        }
+        __atomic_sub_fetch(&g_pushCount, 1, __ATOMIC_SEQ_CST);
+        NS_LOG(ERROR, "NSQueue is null. can not insert to queue");
+        NSOICFree(task);
+        return NS_ERROR;
     }
 
-    NSDestroyQueue(g_queue);
-    NSOICFree(g_queue);
-    g_queue = NULL;
-
-    NSThreadUnlock(g_handle);
-    NSThreadStop(g_handle);
-    NSOICFree(g_handle);
-    g_handle = NULL;
+    NSPushTaskQueue(g_queue, task);
+    __atomic_sub_fetch(&g_pushCount, 1, __ATOMIC_SEQ_CST);
 
-    NSDestroyInternalCachedList();
-    pthread_mutex_unlock(&g_start_mutex);
+    return NS_OK;
 }
 
-void * NSConsumerMsgHandleThreadFunc(void * threadHandle)
+bool NSConsumerGetSchedulerStats(NSTaskQueueStats * stats)
 {
-    (void) threadHandle;
-    NSConsumerQueueObject * obj = NULL;
+    NS_VERIFY_NOT_NULL(stats, false);
 
-    NS_LOG(DEBUG, "create thread for consumer message handle");
-    NS_VERIFY_NOT_NULL(g_handle, NULL);
+    pthread_mutex_lock(&g_start_mutex);
 
-    while (true)
+    if (!g_queue)
     {
-        pthread_mutex_lock(&g_start_mutex);
-        if (NULL == g_handle)
-        {
-            pthread_mutex_unlock(&g_start_mutex);
-            break;
-        }
-
-        NSThreadLock(g_handle);
-        if (!g_queue)
-        {
-            NSThreadUnlock(g_handle);
-            pthread_mutex_unlock(&g_start_mutex);
-            usleep(2000);
-            continue;
-        }
-
-        if (!g_handle->isStarted && NSIsQueueEmpty(g_queue))
-        {
-            NS_LOG(ERROR, "msg handler thread will be terminated");
-            NSThreadUnlock(g_handle);
-            pthread_mutex_unlock(&g_start_mutex);
-            break;
-        }
-
-        if (NSIsQueueEmpty(g_queue))
-        {
-            NSThreadUnlock(g_handle);
-            pthread_mutex_unlock(&g_start_mutex);
-            usleep(2000);
-            continue;
-        }
-
-        NS_LOG(DEBUG, "msg handler working");
-        obj = NSPopQueue(g_queue);
-
-        if (obj)
-        {
-            NSConsumerTaskProcessing((NSTask *)(obj->data));
-            NSOICFree(obj);
-        }
-
-        NSThreadUnlock(g_handle);
         pthread_mutex_unlock(&g_start_mutex);
-
+        return false;
     }
 
-    return NULL;
-}
+    NSGetTaskQueueStats(g_queue, stats);
+    pthread_mutex_unlock(&g_start_mutex);
 
+    return true;
+}
 
-void * NSConsumerMsgPushThreadFunc(void * data)
+void NSConsumerMessageHandlerExit(void)
 {
     pthread_mutex_lock(&g_start_mutex);
-    NSConsumerQueueObject * obj = NULL;
 
-    NS_LOG(DEBUG, "get queueThread handle");
-    if (NULL == g_handle)
+    __atomic_store_n(&g_isClosing, true, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&g_pushCount, __ATOMIC_SEQ_CST) > 0)
     {
-        NSOICFree(data);
-        pthread_mutex_unlock(&g_start_mutex);
-        return NULL;
+        usleep(1000);
     }
-    NSThreadLock(g_handle);
-
-    NS_LOG(DEBUG, "create queue object");
-    obj = (NSConsumerQueueObject *)OICMalloc(sizeof(NSConsumerQueueObject));
-    NS_VERIFY_NOT_NULL_WITH_POST_CLEANING(obj, NULL,
-              {
-                      NSThreadUnlock(g_handle);
-                      pthread_mutex_unlock(&g_start_mutex);
-                      NSOICFree(data);
-              });
-
-    obj->data = data;
-    obj->next = NULL;
 
+    // from here on this thread is the only one running consumer tasks.
+    NSDestroyWorkerPool(g_pool);
+    g_pool = NULL;
 
-    if (!g_queue)
-    {
-        NS_LOG(ERROR, "NSQueue is null. can not insert to queue");
-        NSOICFree(data);
-        NSOICFree(obj);
-    }
-    else
+    NS_LOG(DEBUG, "Execute remaining task");
+    NSTask * task = NSPopTaskQueue(g_queue);
+    while (task)
     {
-        NSPushConsumerQueue(g_queue, obj);
+        NS_LOG_V(DEBUG, "Execute remaining task type : %d", task->taskType);
+        NSConsumerTaskProcessing(task);
+        task = NSPopTaskQueue(g_queue);
     }
 
-    NSThreadUnlock(g_handle);
-    pthread_mutex_unlock(&g_start_mutex);
+    NSConsumerListenerTermiate();
+    NSCancelAllSubscription(NSConsumerTaskProcessing);
 
-    return NULL;
+    NSDestroyTaskQueue(g_queue);
+    g_queue = NULL;
+
+    NSDestroyInternalCachedList();
+    pthread_mutex_unlock(&g_start_mutex);
 }
 
 void NSProviderDeletedPostClean(
@@ -32,6 +32,7 @@ extern "C" {
 #include "NSCommon.h"
 #include "NSStructs.h"
 #include "NSConsumerCommon.h"
+#include "NSTaskQueue.h"
 
 /**
  * API to initialize consumer message handler.
@@ -54,6 +55,15 @@ void NSConsumerMessageHandlerExit(void);
  */
 extern NSResult NSConsumerPushEvent(NSTask *);
 
+/**
+ * Get statistics of consumer task queue.
+ *
+ * @param stats to fill
+ *
+ * @return true if message handler is running.
+ */
+bool NSConsumerGetSchedulerStats(NSTaskQueueStats * stats);
+
 /**
  * Find message by id.
  *
@@ -64,66 +64,44 @@ void NSSyncCb(NSSyncInfo *sync)
     NS_LOG(DEBUG, "NSSyncCb - OUT");
 }
 
-void * NSCallbackResponseSchedule(void * ptr)
+void NSCallbackResponseSchedule(NSTask * node)
 {
-    if (ptr == NULL)
+    switch (node->taskType)
     {
-        NS_LOG(DEBUG, "Create NSReponseSchedule");
-    }
-
-    while (NSIsRunning[CALLBACK_RESPONSE_SCHEDULER])
-    {
-        sem_wait(&NSSemaphore[CALLBACK_RESPONSE_SCHEDULER]);
-        pthread_mutex_lock(&NSMutex[CALLBACK_RESPONSE_SCHEDULER]);
-
-        if (NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER] != NULL)
+        case TASK_CB_SUBSCRIPTION:
         {
-            NSTask *node = NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER];
-            NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER] = node->nextTask;
+            NS_LOG(DEBUG, "CASE TASK_CB_SUBSCRIPTION : ");
 
-            switch (node->taskType)
-            {
-                case TASK_CB_SUBSCRIPTION:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_CB_SUBSCRIPTION : ");
-
-                    OCEntityHandlerRequest * request = (OCEntityHandlerRequest*)node->taskData;
-                    NSConsumer * consumer = (NSConsumer *)OICMalloc(sizeof(NSConsumer));
+            OCEntityHandlerRequest * request = (OCEntityHandlerRequest*)node->taskData;
+            NSConsumer * consumer = (NSConsumer *)OICMalloc(sizeof(NSConsumer));
 
-                    char * copyQuery = OICStrdup(request->query);
-                    char * consumerId = NSGetValueFromQuery(copyQuery, NS_QUERY_CONSUMER_ID);
+            char * copyQuery = OICStrdup(request->query);
+            char * consumerId = NSGetValueFromQuery(copyQuery, NS_QUERY_CONSUMER_ID);
 
-                    if (consumerId)
-                    {
-                        OICStrcpy(consumer->consumerId, UUID_STRING_SIZE, consumerId);
-                        NSSubscribeRequestCb(consumer);
-                    }
+            if (consumerId)
+            {
+                OICStrcpy(consumer->consumerId, UUID_STRING_SIZE, consumerId);
+                NSSubscribeRequestCb(consumer);
+            }
 
-                    NSOICFree(copyQuery);
-                    NSFreeConsumer(consumer);
-                    NSFreeOCEntityHandlerRequest(request);
+            NSOICFree(copyQuery);
+            NSFreeConsumer(consumer);
+            NSFreeOCEntityHandlerRequest(request);
 
-                    break;
-                }
-                case TASK_CB_SYNC:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_CB_SYNC : ");
-                    NSSyncInfo * sync = (NSSyncInfo*)node->taskData;
-                    NSSyncCb(NSDuplicateSync(sync));
-                    NSFreeSync(sync);
-                    break;
-                }
-                default:
-                    NS_LOG(DEBUG, "No Task Type");
-                    break;
-            }
-            NSOICFree(node);
+            break;
         }
-
-        pthread_mutex_unlock(&NSMutex[CALLBACK_RESPONSE_SCHEDULER]);
+        case TASK_CB_SYNC:
+        {
+            NS_LOG(DEBUG, "CASE TASK_CB_SYNC : ");
+            NSSyncInfo * sync = (NSSyncInfo*)node->taskData;
+            NSSyncCb(NSDuplicateSync(sync));
+            NSFreeSync(sync);
+            break;
+        }
+        default:
+            NS_LOG(DEBUG, "No Task Type");
+            break;
     }
-
-    NS_LOG(DEBUG, "Destroy NSResponseSchedule");
-    return NULL;
+    NSOICFree(node);
 }
 
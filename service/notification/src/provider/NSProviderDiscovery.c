@@ -48,53 +48,30 @@ NSResult NSStopPresence(void)
     return NS_OK;
 }
 
-void * NSDiscoverySchedule(void * ptr)
+void NSDiscoverySchedule(NSTask * node)
 {
-    if (ptr == NULL)
+    switch (node->taskType)
     {
-        NS_LOG(DEBUG, "Create NSDiscoverySchedule");
-    }
-
-    while (NSIsRunning[DISCOVERY_SCHEDULER])
-    {
-        sem_wait(&NSSemaphore[DISCOVERY_SCHEDULER]);
-        pthread_mutex_lock(&NSMutex[DISCOVERY_SCHEDULER]);
-
-        if (NSHeadMsg[DISCOVERY_SCHEDULER] != NULL)
-        {
-            NSTask *node = NSHeadMsg[DISCOVERY_SCHEDULER];
-            NSHeadMsg[DISCOVERY_SCHEDULER] = node->nextTask;
-
-            switch (node->taskType)
-            {
-                case TASK_START_PRESENCE:
-                    NS_LOG(DEBUG, "CASE TASK_START_PRESENCE : ");
-                    NSStartPresence();
-                    break;
-                case TASK_STOP_PRESENCE:
-                    NS_LOG(DEBUG, "CASE TASK_STOP_PRESENCE : ");
-                    NSStopPresence();
-                    break;
-                case TASK_REGISTER_RESOURCE:
-                    NS_LOG(DEBUG, "CASE TASK_REGISTER_RESOURCE : ");
-                    NSRegisterResource();
-                    break;
+        case TASK_START_PRESENCE:
+            NS_LOG(DEBUG, "CASE TASK_START_PRESENCE : ");
+            NSStartPresence();
+            break;
+        case TASK_STOP_PRESENCE:
+            NS_LOG(DEBUG, "CASE TASK_STOP_PRESENCE : ");
+            NSStopPresence();
+            break;
+        case TASK_REGISTER_RESOURCE:
+            NS_LOG(DEBUG, "CASE TASK_REGISTER_RESOURCE : ");
+            NSRegisterResource();
+            break;
 #if (defined WITH_CLOUD)
-                case TASK_PUBLISH_RESOURCE:
-                    NS_LOG(DEBUG, "CASE TASK_PUBLISH_PESOURCE : ");
-                    NSPublishResourceToCloud((char*)node->taskData);
-                    break;
+        case TASK_PUBLISH_RESOURCE:
+            NS_LOG(DEBUG, "CASE TASK_PUBLISH_PESOURCE : ");
+            NSPublishResourceToCloud((char*)node->taskData);
+            break;
 #endif
-                default:
-                    break;
-            }
-
-            NSOICFree(node);
-        }
-
-        pthread_mutex_unlock(&NSMutex[DISCOVERY_SCHEDULER]);
+        default:
+            break;
     }
-
-    NS_LOG(DEBUG, "Destroy NSDiscoverySchedule");
-    return NULL;
+    NSOICFree(node);
 }
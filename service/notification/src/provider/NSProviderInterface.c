@@ -49,9 +49,7 @@ void NSInitialize(void)
 {
     NS_LOG(DEBUG, "NSSetList - IN");
 
-    pthread_mutexattr_init(&NSCacheMutexAttr);
-    pthread_mutexattr_settype(&NSCacheMutexAttr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init(&NSCacheMutex, &NSCacheMutexAttr);
+    pthread_rwlock_init(&NSCacheLock, NULL);
     pthread_cond_init(&nstopicCond, NULL);
 
     NSInitSubscriptionList();
@@ -65,8 +63,7 @@ void NSDeinitailize(void)
     NSProviderStorageDestroy(consumerTopicList);
     NSProviderStorageDestroy(registeredTopicList);
 
-    pthread_mutex_destroy(&NSCacheMutex);
-    pthread_mutexattr_destroy(&NSCacheMutexAttr);
+    pthread_rwlock_destroy(&NSCacheLock);
     pthread_cond_destroy(&nstopicCond);
 }
 
@@ -19,8 +19,14 @@
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #include "NSProviderMemoryCache.h"
+#include <stdint.h>
 #include <string.h>
 
+#define NS_CACHE_INDEX_INITIAL_BUCKETS 64
+#define NS_CACHE_OBSERVER_INITIAL_SIZE 16
+
+pthread_rwlock_t NSCacheLock;
+
 #define NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj) \
     { \
         if (it) \
@@ -29,207 +35,563 @@
             NSOICFree(topicData->topicName); \
             NSOICFree(topicData); \
             NSOICFree(newObj); \
-            pthread_mutex_unlock(&NSCacheMutex); \
+            pthread_rwlock_unlock(&NSCacheLock); \
             return NS_FAIL; \
         } \
     }
 
-NSCacheList * NSProviderStorageCreate(void)
+/** ns cache index node */
+typedef struct _NSCacheIndexNode
 {
-    pthread_mutex_lock(&NSCacheMutex);
-    NSCacheList * newList = (NSCacheList *) OICMalloc(sizeof(NSCacheList));
+    uint32_t hash;                        /**< hash of key */
+    const char * key;                     /**< key, owned by element data */
+    NSCacheElement * element;             /**< indexed element */
+    struct _NSCacheIndexNode * next;      /**< pointer to next node in bucket */
 
-    if (!newList)
+} NSCacheIndexNode;
+
+/** ns cache hash table */
+typedef struct
+{
+    NSCacheIndexNode ** buckets;   /**< buckets, power of two */
+    size_t bucketCount;            /**< number of buckets */
+    size_t count;                  /**< number of nodes */
+
+} NSCacheHashTable;
+
+/**
+ * Elements are indexed by consumer id (subscriber, consumer topic) or topic name
+ * (registered topic) in the primary table. Consumer topics are also indexed by
+ * topic name in the secondary table, which gives the subscribers of a topic.
+ */
+struct _NSCacheIndex
+{
+    NSCacheHashTable primary;      /**< index by id */
+    NSCacheHashTable secondary;    /**< index by topic name of consumer topic */
+};
+
+static uint32_t NSCacheHash(const char * key)
+{
+    uint32_t hash = 2166136261u;
+
+    while (*key)
+    {
+        hash ^= (uint8_t) *key++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool NSCacheTableResize(NSCacheHashTable * table, size_t bucketCount)
+{
+    NSCacheIndexNode ** buckets = (NSCacheIndexNode **) OICCalloc(bucketCount,
+            sizeof(NSCacheIndexNode *));
+
+    if (!buckets)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < table->bucketCount; ++i)
+    {
+        NSCacheIndexNode * node = table->buckets[i];
+
+        while (node)
+        {
+            NSCacheIndexNode * next = node->next;
+            size_t bucket = node->hash & (bucketCount - 1);
+            node->next = buckets[bucket];
+            buckets[bucket] = node;
+            node = next;
+        }
+    }
+
+    NSOICFree(table->buckets);
+    table->buckets = buckets;
+    table->bucketCount = bucketCount;
+    return true;
+}
+
+static bool NSCacheTableInsert(NSCacheHashTable * table, const char * key,
+        NSCacheElement * element)
+{
+    if (!table->buckets)
+    {
+        if (!NSCacheTableResize(table, NS_CACHE_INDEX_INITIAL_BUCKETS))
+        {
+            return false;
+        }
+    }
+    else if (table->count >= table->bucketCount)
+    {
+        // keep the current buckets if growing fails, lookups only get slower.
+        NSCacheTableResize(table, table->bucketCount * 2);
+    }
+
+    NSCacheIndexNode * node = (NSCacheIndexNode *) OICMalloc(sizeof(NSCacheIndexNode));
+
+    if (!node)
+    {
+        return false;
+    }
+
+    node->hash = NSCacheHash(key);
+    node->key = key;
+    node->element = element;
+
+    size_t bucket = node->hash & (table->bucketCount - 1);
+    node->next = table->buckets[bucket];
+    table->buckets[bucket] = node;
+    table->count++;
+
+    return true;
+}
+
+static void NSCacheTableRemove(NSCacheHashTable * table, const char * key,
+        NSCacheElement * element)
+{
+    if (!table->buckets)
+    {
+        return;
+    }
+
+    NSCacheIndexNode ** iter = &table->buckets[NSCacheHash(key) & (table->bucketCount - 1)];
+
+    while (*iter)
+    {
+        NSCacheIndexNode * node = *iter;
+
+        if (node->element == element)
+        {
+            *iter = node->next;
+            NSOICFree(node);
+            table->count--;
+            return;
+        }
+
+        iter = &node->next;
+    }
+}
+
+static NSCacheIndexNode * NSCacheTableNext(NSCacheIndexNode * node, uint32_t hash,
+        const char * key)
+{
+    while (node)
+    {
+        if (node->hash == hash && strcmp(node->key, key) == 0)
+        {
+            return node;
+        }
+
+        node = node->next;
+    }
+
+    return NULL;
+}
+
+static NSCacheIndexNode * NSCacheTableFind(const NSCacheHashTable * table, const char * key)
+{
+    if (!table->buckets || !key)
     {
-        pthread_mutex_unlock(&NSCacheMutex);
         return NULL;
     }
 
-    newList->head = newList->tail = NULL;
+    uint32_t hash = NSCacheHash(key);
+    return NSCacheTableNext(table->buckets[hash & (table->bucketCount - 1)], hash, key);
+}
 
-    pthread_mutex_unlock(&NSCacheMutex);
-    NS_LOG(DEBUG, "NSCacheCreate");
+static void NSCacheTableDestroy(NSCacheHashTable * table)
+{
+    for (size_t i = 0; i < table->bucketCount; ++i)
+    {
+        NSCacheIndexNode * node = table->buckets[i];
 
-    return newList;
+        while (node)
+        {
+            NSCacheIndexNode * next = node->next;
+            NSOICFree(node);
+            node = next;
+        }
+    }
+
+    NSOICFree(table->buckets);
+    table->bucketCount = 0;
+    table->count = 0;
 }
 
-NSCacheElement * NSProviderStorageRead(NSCacheList * list, const char * findId)
+static const char * NSProviderGetPrimaryKey(NSCacheType type, void * data)
 {
-    pthread_mutex_lock(&NSCacheMutex);
+    switch (type)
+    {
+        case NS_PROVIDER_CACHE_SUBSCRIBER:
+        case NS_PROVIDER_CACHE_SUBSCRIBER_OBSERVE_ID:
+            return ((NSCacheSubData *) data)->id;
+        case NS_PROVIDER_CACHE_REGISTER_TOPIC:
+            return ((NSCacheTopicData *) data)->topicName;
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME:
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID:
+            return ((NSCacheTopicSubData *) data)->id;
+        default:
+            return NULL;
+    }
+}
 
-    NS_LOG(DEBUG, "NSCacheRead - IN");
+static const char * NSProviderGetSecondaryKey(NSCacheType type, void * data)
+{
+    if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
+    {
+        return ((NSCacheTopicSubData *) data)->topicName;
+    }
 
-    NSCacheElement * iter = list->head;
-    NSCacheElement * next = NULL;
-    NSCacheType type = list->cacheType;
+    return NULL;
+}
 
-    NS_LOG_V(INFO_PRIVATE, "Find ID - %s", findId);
+static NSCacheHashTable * NSProviderGetLookupTable(NSCacheList * list)
+{
+    if (!list->index)
+    {
+        return NULL;
+    }
 
-    while (iter)
+    switch (list->cacheType)
+    {
+        case NS_PROVIDER_CACHE_SUBSCRIBER:
+        case NS_PROVIDER_CACHE_REGISTER_TOPIC:
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID:
+            return &list->index->primary;
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME:
+            return &list->index->secondary;
+        default:
+            return NULL;
+    }
+}
+
+static NSResult NSProviderIndexCacheElement(NSCacheList * list, NSCacheElement * element)
+{
+    if (!list->index || !element->data)
+    {
+        return NS_OK;
+    }
+
+    const char * key = NSProviderGetPrimaryKey(list->cacheType, element->data);
+    const char * subKey = NSProviderGetSecondaryKey(list->cacheType, element->data);
+
+    if (key && !NSCacheTableInsert(&list->index->primary, key, element))
     {
-        next = iter->next;
+        return NS_ERROR;
+    }
 
-        if (NSProviderCompareIdCacheData(type, iter->data, findId))
+    if (subKey && !NSCacheTableInsert(&list->index->secondary, subKey, element))
+    {
+        if (key)
+        {
+            NSCacheTableRemove(&list->index->primary, key, element);
+        }
+
+        return NS_ERROR;
+    }
+
+    return NS_OK;
+}
+
+static void NSProviderUnindexCacheElement(NSCacheList * list, NSCacheElement * element)
+{
+    if (!list->index || !element->data)
+    {
+        return;
+    }
+
+    const char * key = NSProviderGetPrimaryKey(list->cacheType, element->data);
+    const char * subKey = NSProviderGetSecondaryKey(list->cacheType, element->data);
+
+    if (key)
+    {
+        NSCacheTableRemove(&list->index->primary, key, element);
+    }
+
+    if (subKey)
+    {
+        NSCacheTableRemove(&list->index->secondary, subKey, element);
+    }
+}
+
+static NSCacheElement * NSProviderFindCacheElement(NSCacheList * list, const char * findId)
+{
+    NSCacheHashTable * table = NSProviderGetLookupTable(list);
+
+    if (table)
+    {
+        NSCacheIndexNode * node = NSCacheTableFind(table, findId);
+        return node ? node->element : NULL;
+    }
+
+    NSCacheElement * iter = list->head;
+
+    while (iter)
+    {
+        if (NSProviderCompareIdCacheData(list->cacheType, iter->data, findId))
         {
-            NS_LOG(DEBUG, "Found in Cache");
-            pthread_mutex_unlock(&NSCacheMutex);
             return iter;
         }
 
-        iter = next;
+        iter = iter->next;
     }
 
-    NS_LOG(DEBUG, "Not found in Cache");
-    NS_LOG(DEBUG, "NSCacheRead - OUT");
-    pthread_mutex_unlock(&NSCacheMutex);
+    return NULL;
+}
+
+static NSCacheElement * NSProviderFindConsumerTopic(NSCacheList * conTopicList,
+        const char * cId, const char * topicName)
+{
+    if (!conTopicList->index)
+    {
+        return NULL;
+    }
+
+    uint32_t hash = NSCacheHash(cId);
+    NSCacheIndexNode * node = NSCacheTableFind(&conTopicList->index->primary, cId);
+
+    while (node)
+    {
+        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) node->element->data;
+
+        if (strcmp(curr->topicName, topicName) == 0)
+        {
+            return node->element;
+        }
+
+        node = NSCacheTableNext(node->next, hash, cId);
+    }
 
     return NULL;
 }
 
-NSResult NSCacheUpdateSubScriptionState(NSCacheList * list, char * id, bool state)
+static void NSProviderRemoveCacheElement(NSCacheList * list, NSCacheElement * del)
+{
+    NSProviderUnindexCacheElement(list, del);
+
+    if (del->prev)
+    {
+        del->prev->next = del->next;
+    }
+    else
+    {
+        list->head = del->next;
+    }
+
+    if (del->next)
+    {
+        del->next->prev = del->prev;
+    }
+    else
+    {
+        list->tail = del->prev;
+    }
+
+    NSProviderDeleteCacheData(list->cacheType, del->data);
+    NSOICFree(del);
+}
+
+static bool NSProviderAppendObId(OCObservationId ** obIds, size_t * obCount,
+        size_t * capacity, OCObservationId id)
+{
+    if (*obCount == *capacity)
+    {
+        size_t newCapacity = *capacity ? *capacity * 2 : NS_CACHE_OBSERVER_INITIAL_SIZE;
+        OCObservationId * newIds = (OCObservationId *) OICRealloc(*obIds,
+                newCapacity * sizeof(OCObservationId));
+
+        if (!newIds)
+        {
+            return false;
+        }
+
+        *obIds = newIds;
+        *capacity = newCapacity;
+    }
+
+    (*obIds)[(*obCount)++] = id;
+    return true;
+}
+
+NSCacheList * NSProviderStorageCreate(void)
 {
-    pthread_mutex_lock(&NSCacheMutex);
+    NSCacheList * newList = (NSCacheList *) OICMalloc(sizeof(NSCacheList));
+
+    if (!newList)
+    {
+        return NULL;
+    }
+
+    newList->index = (NSCacheIndex *) OICCalloc(1, sizeof(NSCacheIndex));
+
+    if (!newList->index)
+    {
+        NSOICFree(newList);
+        return NULL;
+    }
+
+    newList->head = newList->tail = NULL;
+
+    NS_LOG(DEBUG, "NSCacheCreate");
+
+    return newList;
+}
 
+NSCacheElement * NSProviderStorageRead(NSCacheList * list, const char * findId)
+{
+    pthread_rwlock_rdlock(&NSCacheLock);
+
+    NS_LOG(DEBUG, "NSCacheRead - IN");
+    NS_LOG_V(INFO_PRIVATE, "Find ID - %s", findId);
+
+    NSCacheElement * found = NSProviderFindCacheElement(list, findId);
+
+    NS_LOG_V(DEBUG, "%s in Cache", found ? "Found" : "Not found");
+    NS_LOG(DEBUG, "NSCacheRead - OUT");
+    pthread_rwlock_unlock(&NSCacheLock);
+
+    return found;
+}
+
+NSResult NSCacheUpdateSubScriptionState(NSCacheList * list, char * id, bool state)
+{
     NS_LOG(DEBUG, "NSCacheUpdateSubScriptionState - IN");
 
     if (id == NULL)
     {
         NS_LOG(DEBUG, "id is NULL");
-        pthread_mutex_unlock(&NSCacheMutex);
         return NS_ERROR;
     }
 
-    NSCacheElement * it = NSProviderStorageRead(list, id);
+    pthread_rwlock_wrlock(&NSCacheLock);
+
+    NSCacheElement * it = NSProviderFindCacheElement(list, id);
 
     if (it)
     {
         NSCacheSubData * itData = (NSCacheSubData *) it->data;
-        if (strcmp(itData->id, id) == 0)
-        {
-            NS_LOG(DEBUG, "Update Data - IN");
 
-            NS_LOG_V(INFO_PRIVATE, "currData_ID = %s", itData->id);
-            NS_LOG_V(DEBUG, "currData_MsgObID = %d", itData->messageObId);
-            NS_LOG_V(DEBUG, "currData_SyncObID = %d", itData->syncObId);
-            NS_LOG_V(DEBUG, "currData_IsWhite = %d", itData->isWhite);
+        NS_LOG(DEBUG, "Update Data - IN");
 
-            NS_LOG_V(DEBUG, "update state = %d", state);
+        NS_LOG_V(INFO_PRIVATE, "currData_ID = %s", itData->id);
+        NS_LOG_V(DEBUG, "currData_MsgObID = %d", itData->messageObId);
+        NS_LOG_V(DEBUG, "currData_SyncObID = %d", itData->syncObId);
+        NS_LOG_V(DEBUG, "currData_IsWhite = %d", itData->isWhite);
 
-            itData->isWhite = state;
+        NS_LOG_V(DEBUG, "update state = %d", state);
 
-            NS_LOG(DEBUG, "Update Data - OUT");
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
-        }
-    }
-    else
-    {
-        NS_LOG(DEBUG, "Not Found Data");
+        itData->isWhite = state;
+
+        NS_LOG(DEBUG, "Update Data - OUT");
+        pthread_rwlock_unlock(&NSCacheLock);
+        return NS_OK;
     }
 
+    NS_LOG(DEBUG, "Not Found Data");
     NS_LOG(DEBUG, "NSCacheUpdateSubScriptionState - OUT");
-    pthread_mutex_unlock(&NSCacheMutex);
+    pthread_rwlock_unlock(&NSCacheLock);
     return NS_ERROR;
 }
 
 NSResult NSProviderStorageWrite(NSCacheList * list, NSCacheElement * newObj)
 {
-    pthread_mutex_lock(&NSCacheMutex);
-
-    NSCacheType type = list->cacheType;
-
     NS_LOG(DEBUG, "NSCacheWrite - IN");
 
     if (newObj == NULL)
     {
         NS_LOG(DEBUG, "newObj is NULL - IN");
-        pthread_mutex_unlock(&NSCacheMutex);
         return NS_ERROR;
     }
 
+    pthread_rwlock_wrlock(&NSCacheLock);
+
+    NSCacheType type = list->cacheType;
+
     if (type == NS_PROVIDER_CACHE_SUBSCRIBER)
     {
         NS_LOG(DEBUG, "Type is SUBSCRIBER");
 
         NSCacheSubData * subData = (NSCacheSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, subData->id);
+        NSCacheElement * it = NSProviderFindCacheElement(list, subData->id);
 
         if (it)
         {
             NSCacheSubData * itData = (NSCacheSubData *) it->data;
 
-            if (strcmp(itData->id, subData->id) == 0)
-            {
-                NS_LOG(DEBUG, "Update Data - IN");
+            NS_LOG(DEBUG, "Update Data - IN");
 
-                NS_LOG_V(INFO_PRIVATE, "currData_ID = %s", itData->id);
-                NS_LOG_V(DEBUG, "currData_MsgObID = %d", itData->messageObId);
-                NS_LOG_V(DEBUG, "currData_SyncObID = %d", itData->syncObId);
-                NS_LOG_V(DEBUG, "currData_IsWhite = %d", itData->isWhite);
+            NS_LOG_V(INFO_PRIVATE, "currData_ID = %s", itData->id);
+            NS_LOG_V(DEBUG, "currData_MsgObID = %d", itData->messageObId);
+            NS_LOG_V(DEBUG, "currData_SyncObID = %d", itData->syncObId);
+            NS_LOG_V(DEBUG, "currData_IsWhite = %d", itData->isWhite);
 
-                NS_LOG_V(INFO_PRIVATE, "subData_ID = %s", subData->id);
-                NS_LOG_V(DEBUG, "subData_MsgObID = %d", subData->messageObId);
-                NS_LOG_V(DEBUG, "subData_SyncObID = %d", subData->syncObId);
-                NS_LOG_V(DEBUG, "subData_IsWhite = %d", subData->isWhite);
+            NS_LOG_V(INFO_PRIVATE, "subData_ID = %s", subData->id);
+            NS_LOG_V(DEBUG, "subData_MsgObID = %d", subData->messageObId);
+            NS_LOG_V(DEBUG, "subData_SyncObID = %d", subData->syncObId);
+            NS_LOG_V(DEBUG, "subData_IsWhite = %d", subData->isWhite);
 
-                if (subData->messageObId != 0)
-                {
-                    itData->messageObId = subData->messageObId;
-                }
-
-                if (subData->syncObId != 0)
-                {
-                    itData->syncObId = subData->syncObId;
-                }
+            if (subData->messageObId != 0)
+            {
+                itData->messageObId = subData->messageObId;
+            }
 
-                NS_LOG(DEBUG, "Update Data - OUT");
-                NSOICFree(subData);
-                NSOICFree(newObj);
-                pthread_mutex_unlock(&NSCacheMutex);
-                return NS_OK;
+            if (subData->syncObId != 0)
+            {
+                itData->syncObId = subData->syncObId;
             }
-        }
 
+            NS_LOG(DEBUG, "Update Data - OUT");
+            NSOICFree(subData);
+            NSOICFree(newObj);
+            pthread_rwlock_unlock(&NSCacheLock);
+            return NS_OK;
+        }
     }
     else if (type == NS_PROVIDER_CACHE_REGISTER_TOPIC)
     {
         NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
 
         NSCacheTopicData * topicData = (NSCacheTopicData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->topicName);
+        NSCacheElement * it = NSProviderFindCacheElement(list, topicData->topicName);
 
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
-    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME)
+    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
     {
-        NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
+        NS_LOG(DEBUG, "Type is CONSUMER TOPIC");
 
         NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->topicName);
+        NSCacheElement * it = NSProviderFindConsumerTopic(list, topicData->id,
+                topicData->topicName);
 
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
-    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
-    {
-        NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
-
-        NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->id);
 
-        NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
+    if (NSProviderIndexCacheElement(list, newObj) != NS_OK)
+    {
+        NS_LOG(ERROR, "Fail to index cache data");
+        pthread_rwlock_unlock(&NSCacheLock);
+        return NS_ERROR;
     }
 
+    newObj->next = NULL;
+    newObj->prev = list->tail;
+
     if (list->head == NULL)
     {
         NS_LOG(DEBUG, "list->head is NULL, Insert First Data");
         list->head = list->tail = newObj;
-        pthread_mutex_unlock(&NSCacheMutex);
+        pthread_rwlock_unlock(&NSCacheLock);
         return NS_OK;
     }
 
     list->tail = list->tail->next = newObj;
     NS_LOG(DEBUG, "list->head is not NULL");
-    pthread_mutex_unlock(&NSCacheMutex);
+    pthread_rwlock_unlock(&NSCacheLock);
     return NS_OK;
 }
 
@@ -247,6 +609,13 @@ NSResult NSProviderStorageDestroy(NSCacheList * list)
         iter = next;
     }
 
+    if (list->index)
+    {
+        NSCacheTableDestroy(&list->index->primary);
+        NSCacheTableDestroy(&list->index->secondary);
+        NSOICFree(list->index);
+    }
+
     NSOICFree(list);
     return NS_OK;
 }
@@ -388,72 +757,34 @@ NSResult NSProviderDeleteCacheData(NSCacheType type, void * data)
 
 NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
 {
-    pthread_mutex_lock(&NSCacheMutex);
-    NSCacheElement * prev = list->head;
-    NSCacheElement * del = list->head;
-
-    NSCacheType type = list->cacheType;
+    pthread_rwlock_wrlock(&NSCacheLock);
 
-    if (!del)
+    if (!list->head)
     {
         NS_LOG(DEBUG, "list head is NULL");
-        pthread_mutex_unlock(&NSCacheMutex);
+        pthread_rwlock_unlock(&NSCacheLock);
         return NS_FAIL;
     }
 
-    if (NSProviderCompareIdCacheData(type, del->data, delId))
-    {
-        if (del == list->head) // first object
-        {
-            if (del == list->tail) // first object (one object)
-            {
-                list->tail = del->next;
-            }
-
-            list->head = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            NSOICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
-        }
-    }
-
-    del = del->next;
+    NSCacheElement * del = NSProviderFindCacheElement(list, delId);
 
-    while (del)
+    if (!del)
     {
-        if (NSProviderCompareIdCacheData(type, del->data, delId))
-        {
-            if (del == list->tail) // delete object same to last object
-            {
-                list->tail = prev;
-            }
-
-            prev->next = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            NSOICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
-        }
-
-        prev = del;
-        del = del->next;
+        pthread_rwlock_unlock(&NSCacheLock);
+        return NS_FAIL;
     }
 
-    pthread_mutex_unlock(&NSCacheMutex);
-    return NS_FAIL;
+    NSProviderRemoveCacheElement(list, del);
+    pthread_rwlock_unlock(&NSCacheLock);
+    return NS_OK;
 }
 
-NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList)
+static NSTopicLL * NSProviderCopyTopicsCacheData(NSCacheList * regTopicList)
 {
-    NS_LOG(DEBUG, "NSProviderGetTopicsCache - IN");
-    pthread_mutex_lock(&NSCacheMutex);
-
     NSCacheElement * iter = regTopicList->head;
 
     if (!iter)
     {
-        pthread_mutex_unlock(&NSCacheMutex);
         return NULL;
     }
 
@@ -468,7 +799,6 @@ NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList)
 
         if (!newTopic)
         {
-            pthread_mutex_unlock(&NSCacheMutex);
             return NULL;
         }
 
@@ -489,7 +819,17 @@ NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList)
         iter = iter->next;
     }
 
-    pthread_mutex_unlock(&NSCacheMutex);
+    return topics;
+}
+
+NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList)
+{
+    NS_LOG(DEBUG, "NSProviderGetTopicsCache - IN");
+    pthread_rwlock_rdlock(&NSCacheLock);
+
+    NSTopicLL * topics = NSProviderCopyTopicsCacheData(regTopicList);
+
+    pthread_rwlock_unlock(&NSCacheLock);
     NS_LOG(DEBUG, "NSProviderGetTopicsCache - OUT");
 
     return topics;
@@ -500,45 +840,41 @@ NSTopicLL * NSProviderGetConsumerTopicsCacheData(NSCacheList * regTopicList,
 {
     NS_LOG(DEBUG, "NSProviderGetConsumerTopicsCacheData - IN");
 
-    pthread_mutex_lock(&NSCacheMutex);
-    NSTopicLL * topics = NSProviderGetTopicsCacheData(regTopicList);
+    pthread_rwlock_rdlock(&NSCacheLock);
+    NSTopicLL * topics = NSProviderCopyTopicsCacheData(regTopicList);
 
-    if (!topics)
+    if (!topics || !conTopicList->index)
     {
-        pthread_mutex_unlock(&NSCacheMutex);
-        return NULL;
+        pthread_rwlock_unlock(&NSCacheLock);
+        return topics;
     }
 
-    NSCacheElement * iter = conTopicList->head;
-    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID;
+    uint32_t hash = NSCacheHash(consumerId);
+    NSCacheIndexNode * node = NSCacheTableFind(&conTopicList->index->primary, consumerId);
 
-    while (iter)
+    while (node)
     {
-        NSCacheTopicSubData * curr = (NSCacheTopicSubData *)iter->data;
+        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) node->element->data;
 
-        if (curr && strcmp(curr->id, consumerId) == 0)
-        {
-            NS_LOG_V(INFO_PRIVATE, "curr->id = %s", curr->id);
-            NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
-            NSTopicLL * topicIter = topics;
+        NS_LOG_V(INFO_PRIVATE, "curr->id = %s", curr->id);
+        NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
+        NSTopicLL * topicIter = topics;
 
-            while (topicIter)
+        while (topicIter)
+        {
+            if (strcmp(topicIter->topicName, curr->topicName) == 0)
             {
-                if (strcmp(topicIter->topicName, curr->topicName) == 0)
-                {
-                    topicIter->state = NS_TOPIC_SUBSCRIBED;
-                    break;
-                }
-
-                topicIter = topicIter->next;
+                topicIter->state = NS_TOPIC_SUBSCRIBED;
+                break;
             }
+
+            topicIter = topicIter->next;
         }
 
-        iter = iter->next;
+        node = NSCacheTableNext(node->next, hash, consumerId);
     }
 
-    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
-    pthread_mutex_unlock(&NSCacheMutex);
+    pthread_rwlock_unlock(&NSCacheLock);
     NS_LOG(DEBUG, "NSProviderGetConsumerTopics - OUT");
 
     return topics;
@@ -546,14 +882,13 @@ NSTopicLL * NSProviderGetConsumerTopicsCacheData(NSCacheList * regTopicList,
 
 bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char * topicName)
 {
-    pthread_mutex_lock(&NSCacheMutex);
-
     if (!conTopicList || !cId || !topicName)
     {
-        pthread_mutex_unlock(&NSCacheMutex);
         return false;
     }
 
+    pthread_rwlock_rdlock(&NSCacheLock);
+
     NSCacheElement * iter = conTopicList;
 
     while (iter)
@@ -562,92 +897,137 @@ bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char
 
         if ( (strcmp(curr->id, cId) == 0) && (strcmp(curr->topicName, topicName) == 0) )
         {
-            pthread_mutex_unlock(&NSCacheMutex);
+            pthread_rwlock_unlock(&NSCacheLock);
             return true;
         }
 
         iter = iter->next;
     }
 
-    pthread_mutex_unlock(&NSCacheMutex);
+    pthread_rwlock_unlock(&NSCacheLock);
     return false;
 }
 
 NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
         NSCacheTopicSubData * topicSubData)
 {
-    pthread_mutex_lock(&NSCacheMutex);
+    if (!conTopicList || !topicSubData || !topicSubData->topicName)
+    {
+        return NS_ERROR;
+    }
 
     char * cId = topicSubData->id;
     char * topicName = topicSubData->topicName;
 
-    if (!conTopicList || !cId || !topicName)
-    {
-        pthread_mutex_unlock(&NSCacheMutex);
-        return NS_ERROR;
-    }
+    NS_LOG_V(INFO_PRIVATE, "compareid = %s", cId);
+    NS_LOG_V(DEBUG, "comparetopicName = %s", topicName);
 
-    NSCacheElement * prev = conTopicList->head;
-    NSCacheElement * del = conTopicList->head;
+    pthread_rwlock_wrlock(&NSCacheLock);
 
-    NSCacheType type = conTopicList->cacheType;
+    NSCacheElement * del = NSProviderFindConsumerTopic(conTopicList, cId, topicName);
 
     if (!del)
     {
-        NS_LOG(DEBUG, "list head is NULL");
-        pthread_mutex_unlock(&NSCacheMutex);
+        NS_LOG(DEBUG, "consumer topic is not found");
+        pthread_rwlock_unlock(&NSCacheLock);
         return NS_FAIL;
     }
 
-    NSCacheTopicSubData * curr = (NSCacheTopicSubData *) del->data;
-    NS_LOG_V(INFO_PRIVATE, "compareid = %s", cId);
-    NS_LOG_V(DEBUG, "comparetopicName = %s", topicName);
-    NS_LOG_V(INFO_PRIVATE, "curr->id = %s", curr->id);
-    NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
+    NSProviderRemoveCacheElement(conTopicList, del);
+    pthread_rwlock_unlock(&NSCacheLock);
+    return NS_OK;
+}
+
+OCObservationId * NSProviderGetMessageObIds(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, size_t * obCount)
+{
+    OCObservationId * obIds = NULL;
+    size_t capacity = 0;
+    bool isTopic = topicName && topicName[0] != '\0';
+
+    *obCount = 0;
+    pthread_rwlock_rdlock(&NSCacheLock);
+
+    if (isTopic)
+    {
+        NS_LOG_V(DEBUG, "this is topic message: %s", topicName);
+
+        if (!conTopicList->index || !subList->index)
+        {
+            pthread_rwlock_unlock(&NSCacheLock);
+            return NULL;
+        }
+
+        uint32_t hash = NSCacheHash(topicName);
+        NSCacheIndexNode * node = NSCacheTableFind(&conTopicList->index->secondary, topicName);
+
+        while (node)
+        {
+            NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) node->element->data;
+            NSCacheIndexNode * subNode = NSCacheTableFind(&subList->index->primary,
+                    topicData->id);
+            NSCacheSubData * subData = subNode ? (NSCacheSubData *) subNode->element->data : NULL;
 
-    if ( (strncmp(curr->id, cId, NS_UUID_STRING_SIZE) == 0) &&
-            (strcmp(curr->topicName, topicName) == 0) )
+            if (subData && subData->isWhite && subData->messageObId != 0)
+            {
+                if (!NSProviderAppendObId(&obIds, obCount, &capacity, subData->messageObId))
+                {
+                    break;
+                }
+            }
+
+            node = NSCacheTableNext(node->next, hash, topicName);
+        }
+    }
+    else
     {
-        if (del == conTopicList->head) // first object
+        NSCacheElement * it = subList->head;
+
+        while (it)
         {
-            if (del == conTopicList->tail) // first object (one object)
+            NSCacheSubData * subData = (NSCacheSubData *) it->data;
+
+            if (subData->isWhite && subData->messageObId != 0)
             {
-                conTopicList->tail = del->next;
+                if (!NSProviderAppendObId(&obIds, obCount, &capacity, subData->messageObId))
+                {
+                    break;
+                }
             }
 
-            conTopicList->head = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            NSOICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
+            it = it->next;
         }
     }
 
-    curr = NULL;
-    del = del->next;
+    pthread_rwlock_unlock(&NSCacheLock);
+    return obIds;
+}
+
+OCObservationId * NSProviderGetSyncObIds(NSCacheList * subList, size_t * obCount)
+{
+    OCObservationId * obIds = NULL;
+    size_t capacity = 0;
 
-    while (del)
+    *obCount = 0;
+    pthread_rwlock_rdlock(&NSCacheLock);
+
+    NSCacheElement * it = subList->head;
+
+    while (it)
     {
-        curr = (NSCacheTopicSubData *) del->data;
-        if ( (strncmp(curr->id, cId, NS_UUID_STRING_SIZE) == 0) &&
-                (strcmp(curr->topicName, topicName) == 0) )
+        NSCacheSubData * subData = (NSCacheSubData *) it->data;
+
+        if (subData->isWhite && subData->syncObId != 0)
         {
-            if (del == conTopicList->tail) // delete object same to last object
+            if (!NSProviderAppendObId(&obIds, obCount, &capacity, subData->syncObId))
             {
-                conTopicList->tail = prev;
+                break;
             }
-
-            prev->next = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            NSOICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
         }
 
-        prev = del;
-        del = del->next;
+        it = it->next;
     }
 
-    pthread_mutex_unlock(&NSCacheMutex);
-    return NS_FAIL;
+    pthread_rwlock_unlock(&NSCacheLock);
+    return obIds;
 }
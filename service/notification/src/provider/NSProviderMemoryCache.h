@@ -174,7 +174,30 @@ bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char
 NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
         NSCacheTopicSubData * topicSubData);
 
-pthread_mutex_t NSCacheMutex;
-pthread_mutexattr_t NSCacheMutexAttr;
+/**
+ * Get message observation Ids of allowed consumers.
+ * If topic name is given, only the consumers subscribed to the topic are looked up.
+ *
+ * @param subList       consumer subscription list.
+ * @param conTopicList  consumer topic list.
+ * @param topicName     topic name of message, NULL for all consumers.
+ * @param obCount       number of observation Ids.
+ *
+ * @return observation Id array to be freed by caller, NULL if none.
+ */
+OCObservationId * NSProviderGetMessageObIds(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, size_t * obCount);
+
+/**
+ * Get sync observation Ids of allowed consumers.
+ *
+ * @param subList       consumer subscription list.
+ * @param obCount       number of observation Ids.
+ *
+ * @return observation Id array to be freed by caller, NULL if none.
+ */
+OCObservationId * NSProviderGetSyncObIds(NSCacheList * subList, size_t * obCount);
+
+extern pthread_rwlock_t NSCacheLock;
 
 #endif /* _NS_PROVIDER_CACHEADAPTER__H_ */
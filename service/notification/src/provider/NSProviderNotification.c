@@ -114,7 +114,7 @@ NSResult NSSendNotification(NSMessage *msg)
     NS_LOG(DEBUG, "NSSendMessage - IN");
 
     OCResourceHandle rHandle = NULL;
-    OCObservationId obArray[255] = { 0, };
+    OCObservationId * obArray = NULL;
     size_t obCount = 0;
 
     if (NSPutMessageResource(msg, &rHandle) != NS_OK)
@@ -146,37 +146,8 @@ NSResult NSSendNotification(NSMessage *msg)
         return NS_ERROR;
     }
 
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
-    {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-        NS_LOG_V(INFO_PRIVATE, "message subData->id = %s", subData->id);
-        NS_LOG_V(DEBUG, "subData->messageId = %d", subData->messageObId);
-        NS_LOG_V(DEBUG, "subData->syncId = %d", subData->syncObId);
-        NS_LOG_V(DEBUG, "subData->isWhite = %d", subData->isWhite);
-
-        if (subData->isWhite)
-        {
-            if(subData->messageObId != 0)
-            {
-                if (msg->topic && (msg->topic)[0] != '\0')
-                {
-                    NS_LOG_V(DEBUG, "this is topic message: %s", msg->topic);
-
-                    if (NSProviderIsTopicSubScribed(consumerTopicList->head, subData->id, msg->topic))
-                    {
-                        obArray[obCount++] = subData->messageObId;
-                    }
-                }
-                else
-                {
-                    obArray[obCount++] = subData->messageObId;
-                }
-            }
-        }
-        it = it->next;
-    }
+    obArray = NSProviderGetMessageObIds(consumerSubList, consumerTopicList, msg->topic,
+            &obCount);
 
     for (size_t i = 0; i < obCount; ++i)
     {
@@ -193,12 +164,10 @@ NSResult NSSendNotification(NSMessage *msg)
         return NS_ERROR;
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray, obCount, payload,
-            OC_LOW_QOS);
-
-    NS_LOG_V(DEBUG, "Message ocstackResult = %d", ocstackResult);
+    NSResult result = NSNotifyObservers(rHandle, obArray, obCount, payload, OC_LOW_QOS);
+    NSOICFree(obArray);
 
-    if (ocstackResult != OC_STACK_OK)
+    if (result != NS_OK)
     {
         NS_LOG(ERROR, "fail to send message");
         OCRepPayloadDestroy(payload);
@@ -217,7 +186,7 @@ NSResult NSSendSync(NSSyncInfo *sync)
 {
     NS_LOG(DEBUG, "NSSendSync - IN");
 
-    OCObservationId obArray[255] = { 0, };
+    OCObservationId * obArray = NULL;
     size_t obCount = 0;
 
     OCResourceHandle rHandle = NULL;
@@ -227,30 +196,13 @@ NSResult NSSendSync(NSSyncInfo *sync)
         return NS_ERROR;
     }
 
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
-    {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-        NS_LOG_V(INFO_PRIVATE, "sync subData->id = %s", subData->id);
-        NS_LOG_V(DEBUG, "subData->messageId = %d", subData->messageObId);
-        NS_LOG_V(DEBUG, "subData->syncId = %d", subData->syncObId);
-        NS_LOG_V(DEBUG, "subData->isWhite = %d", subData->isWhite);
-
-        if (subData->isWhite)
-        {
-            if (subData->syncObId != 0)
-            {
-                obArray[obCount++] = subData->syncObId;
-            }
-        }
-        it = it->next;
-    }
+    obArray = NSProviderGetSyncObIds(consumerSubList, &obCount);
 
     OCRepPayload* payload = NULL;
     if (NSSetSyncPayload(sync, &payload) != NS_OK)
     {
         NS_LOG(ERROR, "Failed to allocate payload");
+        NSOICFree(obArray);
         return NS_ERROR;
     }
 
@@ -281,11 +233,10 @@ NSResult NSSendSync(NSSyncInfo *sync)
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray,
-            obCount, payload, OC_LOW_QOS);
+    NSResult result = NSNotifyObservers(rHandle, obArray, obCount, payload, OC_LOW_QOS);
+    NSOICFree(obArray);
 
-    NS_LOG_V(DEBUG, "Sync ocstackResult = %d", ocstackResult);
-    if (ocstackResult != OC_STACK_OK)
+    if (result != NS_OK)
     {
         NS_LOG(ERROR, "fail to send Sync");
         OCRepPayloadDestroy(payload);
@@ -298,53 +249,31 @@ NSResult NSSendSync(NSSyncInfo *sync)
     return NS_OK;
 }
 
-void * NSNotificationSchedule(void *ptr)
+void NSNotificationSchedule(NSTask * node)
 {
-    if (ptr == NULL)
+    switch (node->taskType)
     {
-        NS_LOG(DEBUG, "Create NSNotifiactionSchedule");
-    }
-
-    while (NSIsRunning[NOTIFICATION_SCHEDULER])
-    {
-        sem_wait(&NSSemaphore[NOTIFICATION_SCHEDULER]);
-        pthread_mutex_lock(&NSMutex[NOTIFICATION_SCHEDULER]);
-
-        if (NSHeadMsg[NOTIFICATION_SCHEDULER] != NULL)
+        case TASK_SEND_NOTIFICATION:
         {
-            NSTask *node = NSHeadMsg[NOTIFICATION_SCHEDULER];
-            NSHeadMsg[NOTIFICATION_SCHEDULER] = node->nextTask;
-
-            switch (node->taskType)
-            {
-                case TASK_SEND_NOTIFICATION:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_SEND_NOTIFICATION : ");
-                    NSSendNotification((NSMessage *)node->taskData);
-                    NSFreeMessage((NSMessage *)node->taskData);
-                }
-                    break;
-                case TASK_SEND_READ:
-                    NS_LOG(DEBUG, "CASE TASK_SEND_READ : ");
-                    NSSendSync((NSSyncInfo*) node->taskData);
-                    NSFreeSync((NSSyncInfo*) node->taskData);
-                    break;
-                case TASK_RECV_READ:
-                    NS_LOG(DEBUG, "CASE TASK_RECV_READ : ");
-                    NSSendSync((NSSyncInfo*) node->taskData);
-                    NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SYNC, node->taskData);
-                    break;
-                default:
-                    NS_LOG(ERROR, "Unknown type message");
-                    break;
-
-            }
-            NSOICFree(node);
+            NS_LOG(DEBUG, "CASE TASK_SEND_NOTIFICATION : ");
+            NSSendNotification((NSMessage *)node->taskData);
+            NSFreeMessage((NSMessage *)node->taskData);
         }
+            break;
+        case TASK_SEND_READ:
+            NS_LOG(DEBUG, "CASE TASK_SEND_READ : ");
+            NSSendSync((NSSyncInfo*) node->taskData);
+            NSFreeSync((NSSyncInfo*) node->taskData);
+            break;
+        case TASK_RECV_READ:
+            NS_LOG(DEBUG, "CASE TASK_RECV_READ : ");
+            NSSendSync((NSSyncInfo*) node->taskData);
+            NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SYNC, node->taskData);
+            break;
+        default:
+            NS_LOG(ERROR, "Unknown type message");
+            break;
 
-        pthread_mutex_unlock(&NSMutex[NOTIFICATION_SCHEDULER]);
     }
-
-    NS_LOG(INFO, "Destroy NSNotificationSchedule");
-    return NULL;
+    NSOICFree(node);
 }
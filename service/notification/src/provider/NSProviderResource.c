@@ -344,3 +344,28 @@ NSResult NSPutTopicResource(NSTopicList *topicList, OCResourceHandle * handle)
     NS_LOG(DEBUG, "NSPutTopicResource - OUT");
     return NS_OK;
 }
+
+NSResult NSNotifyObservers(OCResourceHandle handle, OCObservationId * obArray, size_t obCount,
+        const OCRepPayload * payload, OCQualityOfService qos)
+{
+    NS_LOG(DEBUG, "NSNotifyObservers - IN");
+
+    NSResult result = NS_OK;
+
+    for (size_t i = 0; i < obCount; i += UINT8_MAX)
+    {
+        uint8_t count = (uint8_t) ((obCount - i) < UINT8_MAX ? (obCount - i) : UINT8_MAX);
+        OCStackResult ocstackResult = OCNotifyListOfObservers(handle, obArray + i, count,
+                payload, qos);
+
+        NS_LOG_V(DEBUG, "Notify ocstackResult = %d", ocstackResult);
+
+        if (ocstackResult != OC_STACK_OK)
+        {
+            result = NS_ERROR;
+        }
+    }
+
+    NS_LOG(DEBUG, "NSNotifyObservers - OUT");
+    return result;
+}
@@ -121,4 +121,19 @@ NSResult NSPutSyncResource(NSSyncInfo *sync, OCResourceHandle * handle);
  */
 NSResult NSPutTopicResource(NSTopicList *topicList, OCResourceHandle * handle);
 
+/**
+ * Notify the observers of resource. Observers are notified in batches of
+ * the largest count accepted by OCNotifyListOfObservers.
+ *
+ * @param[in] handle      resource handler
+ * @param[in] obArray     observation ids
+ * @param[in] obCount     number of observation ids
+ * @param[in] payload     payload to be notified
+ * @param[in] qos         quality of service
+ *
+ * @return success code.
+ */
+NSResult NSNotifyObservers(OCResourceHandle handle, OCObservationId * obArray, size_t obCount,
+        const OCRepPayload * payload, OCQualityOfService qos);
+
 #endif /* _NS_PROVIDER_RESOURCE_H_ */
@@ -19,32 +19,62 @@
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
 #include "NSProviderScheduler.h"
+#include "NSTaskQueue.h"
+
+/**
+ * Worker threads shared by the provider schedulers. A callback response task
+ * may call a provider API which waits for the topic scheduler, so at least two
+ * workers are required.
+ */
+#define NS_PROVIDER_WORKER_COUNT 3
 
-pthread_t NSThread[THREAD_COUNT];
-pthread_mutex_t NSMutex[THREAD_COUNT];
-sem_t NSSemaphore[THREAD_COUNT];
 bool NSIsRunning[THREAD_COUNT] = { false, };
 
-NSTask* NSHeadMsg[THREAD_COUNT];
-NSTask* NSTailMsg[THREAD_COUNT];
+static NSWorkerPool * NSWorkerPoolHandle = NULL;
+static NSTaskQueue * NSTaskQueues[THREAD_COUNT] = { NULL, };
 
-void * NSCallbackResponseSchedule(void *ptr);
-void * NSDiscoverySchedule(void *ptr);
-void * NSSubScriptionSchedule(void *ptr);
-void * NSNotificationSchedule(void *ptr);
-void * NSTopicSchedule(void * ptr);
+static NSTaskHandler NSGetTaskHandler(NSSchedulerType type)
+{
+    switch (type)
+    {
+        case CALLBACK_RESPONSE_SCHEDULER:
+            return NSCallbackResponseSchedule;
+        case DISCOVERY_SCHEDULER:
+            return NSDiscoverySchedule;
+        case SUBSCRIPTION_SCHEDULER:
+            return NSSubScriptionSchedule;
+        case NOTIFICATION_SCHEDULER:
+            return NSNotificationSchedule;
+        case TOPIC_SCHEDULER:
+            return NSTopicSchedule;
+        default:
+            return NULL;
+    }
+}
 
 bool NSInitScheduler(void)
 {
     NS_LOG(DEBUG, "NSInitScheduler - IN");
 
-    int i = 0;
+    NSWorkerPoolHandle = NSCreateWorkerPool(NS_PROVIDER_WORKER_COUNT);
+
+    if (!NSWorkerPoolHandle)
+    {
+        NS_LOG(ERROR, "Fail to create worker pool");
+        return false;
+    }
 
-    for (i = 0; i < THREAD_COUNT; i++)
+    for (int i = 0; i < THREAD_COUNT; i++)
     {
-        pthread_mutex_init(&NSMutex[i], NULL);
-        NSIsRunning[i] = true;
-        sem_init(&(NSSemaphore[i]), 0, 0);
+        NSTaskQueues[i] = NSCreateTaskQueue(NSWorkerPoolHandle,
+                NSGetTaskHandler((NSSchedulerType) i));
+
+        if (!NSTaskQueues[i])
+        {
+            NS_LOG(ERROR, "Fail to create task queue");
+            NSStopScheduler();
+            return false;
+        }
     }
 
     NS_LOG(DEBUG, "NSInitScheduler - OUT");
@@ -54,57 +84,9 @@ bool NSInitScheduler(void)
 
 bool NSStartScheduler(void)
 {
-    int i = 0;
-
-    for (i = 0; i < THREAD_COUNT; i++)
+    for (int i = 0; i < THREAD_COUNT; i++)
     {
-        pthread_mutex_lock(&NSMutex[i]);
-
-        switch (i)
-        {
-            case CALLBACK_RESPONSE_SCHEDULER:
-            {
-                NS_LOG(DEBUG, "CASE RESPONSE_SCHEDULER :");
-                pthread_create(&NSThread[i], NULL, NSCallbackResponseSchedule, NULL);
-            }
-                break;
-
-            case DISCOVERY_SCHEDULER:
-            {
-                NS_LOG(DEBUG, "CASE DISCOVERY_SCHEDULER :");
-                pthread_create(&NSThread[i], NULL, NSDiscoverySchedule, NULL);
-            }
-                break;
-
-            case SUBSCRIPTION_SCHEDULER:
-            {
-                NS_LOG(DEBUG, "CASE SUBSCRIPTION_SCHEDULER :");
-                pthread_create(&NSThread[i], NULL, NSSubScriptionSchedule, NULL);
-            }
-                break;
-
-            case NOTIFICATION_SCHEDULER:
-            {
-                NS_LOG(DEBUG, "CASE NOTIFICATION_SCHEDULER :");
-                pthread_create(&NSThread[i], NULL, NSNotificationSchedule, NULL);
-            }
-                break;
-
-            case TOPIC_SCHEDULER:
-            {
-                NS_LOG(DEBUG, "CASE TOPIC_SCHEDULER :");
-                pthread_create(&NSThread[i], NULL, NSTopicSchedule, NULL);
-            }
-                break;
-            default:
-                break;
-
-        }
-
-        NSHeadMsg[i] = NSTailMsg[i] = NULL;
-
-        pthread_mutex_unlock(&NSMutex[i]);
-
+        NSIsRunning[i] = (NSTaskQueues[i] != NULL);
     }
 
     return true;
@@ -113,33 +95,39 @@ bool NSStartScheduler(void)
 bool NSStopScheduler(void)
 {
     NS_LOG(DEBUG, "NSStopScheduler - IN");
-    int i = 0;
 
-    for (i = THREAD_COUNT - 1; i >= 0; --i)
+    for (int i = 0; i < THREAD_COUNT; i++)
     {
-        int status = -1;
-
         NSIsRunning[i] = false;
+    }
+
+    NSDestroyWorkerPool(NSWorkerPoolHandle);
+    NSWorkerPoolHandle = NULL;
 
-        sem_post(&(NSSemaphore[i]));
-        pthread_join(NSThread[i], (void **) &status);
+    for (int i = THREAD_COUNT - 1; i >= 0; --i)
+    {
+        if (!NSTaskQueues[i])
+        {
+            continue;
+        }
 
-        NSThread[i] = 0;
+        NSTaskQueueStats stats;
+        NSGetTaskQueueStats(NSTaskQueues[i], &stats);
+        NS_LOG_V(DEBUG, "Scheduler[%d] handled = %" PRIu64 ", max depth = %" PRIuPTR
+                ", max latency = %" PRIu64 " us", i, stats.handledCount, stats.maxDepth,
+                stats.maxLatency);
 
-        pthread_mutex_lock(&NSMutex[i]);
+        NSTask * task = NSPopTaskQueue(NSTaskQueues[i]);
 
-        while (NSHeadMsg[i] != NULL)
+        while (task)
         {
-            NSTask* temp = NSHeadMsg[i];
-            NSHeadMsg[i] = NSHeadMsg[i]->nextTask;
-            NSFreeData(i, temp);
-            NSOICFree(temp);
+            NSFreeData((NSSchedulerType) i, task);
+            NSOICFree(task);
+            task = NSPopTaskQueue(NSTaskQueues[i]);
         }
 
-        NSTailMsg[i] = NSHeadMsg[i] = NULL;
-
-        pthread_mutex_unlock(&NSMutex[i]);
-        pthread_mutex_destroy(&NSMutex[i]);
+        NSDestroyTaskQueue(NSTaskQueues[i]);
+        NSTaskQueues[i] = NULL;
     }
 
     NS_LOG(DEBUG, "NSStopScheduler - OUT");
@@ -149,47 +137,38 @@ bool NSStopScheduler(void)
 
 void NSPushQueue(NSSchedulerType schedulerType, NSTaskType taskType, void* data)
 {
-
     if (!NSIsRunning[schedulerType])
     {
         return;
     }
 
-    pthread_mutex_lock(&NSMutex[schedulerType]);
-
     NS_LOG(DEBUG, "NSPushQueue - IN");
     NS_LOG_V(DEBUG, "NSSchedulerType = %d", schedulerType);
     NS_LOG_V(DEBUG, "NSTaskType = %d", taskType);
 
-    if (NSHeadMsg[schedulerType] == NULL)
-    {
-        NSHeadMsg[schedulerType] = (NSTask*) OICMalloc(sizeof(NSTask));
+    NSTask * newNode = (NSTask *) OICMalloc(sizeof(NSTask));
 
-        if (NSHeadMsg[schedulerType])
-        {
-            NSHeadMsg[schedulerType]->taskType = taskType;
-            NSHeadMsg[schedulerType]->taskData = data;
-            NSHeadMsg[schedulerType]->nextTask = NULL;
-            NSTailMsg[schedulerType] = NSHeadMsg[schedulerType];
-        }
-    }
-    else
+    if (newNode)
     {
-        NSTask* newNode = (NSTask*) OICMalloc(sizeof(NSTask));
-        if (newNode)
-        {
-            newNode->taskType = taskType;
-            newNode->taskData = data;
-            newNode->nextTask = NULL;
+        newNode->taskType = taskType;
+        newNode->taskData = data;
+        newNode->nextTask = NULL;
 
-            NSTailMsg[schedulerType]->nextTask = newNode;
-            NSTailMsg[schedulerType] = newNode;
-        }
+        NSPushTaskQueue(NSTaskQueues[schedulerType], newNode);
     }
 
-    sem_post(&(NSSemaphore[schedulerType]));
     NS_LOG(DEBUG, "NSPushQueue - OUT");
-    pthread_mutex_unlock(&NSMutex[schedulerType]);
+}
+
+bool NSGetSchedulerStats(NSSchedulerType schedulerType, NSTaskQueueStats * stats)
+{
+    if (schedulerType >= THREAD_COUNT || !NSTaskQueues[schedulerType] || !stats)
+    {
+        return false;
+    }
+
+    NSGetTaskQueueStats(NSTaskQueues[schedulerType], stats);
+    return true;
 }
 
 void NSFreeData(NSSchedulerType type, NSTask * task)
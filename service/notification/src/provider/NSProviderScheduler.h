@@ -23,7 +23,6 @@
 
 #include <stdio.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdbool.h>
 #include "ocstack.h"
 #include "NSCommon.h"
@@ -33,20 +32,15 @@
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "NSUtil.h"
+#include "NSTaskQueue.h"
 
-extern NSTask* NSHeadMsg[THREAD_COUNT]; /**< Current MSG */
-extern NSTask* NSTailMsg[THREAD_COUNT]; /**< Recently MSG */
-
-extern pthread_t NSThread[THREAD_COUNT];
-extern pthread_mutex_t NSMutex[THREAD_COUNT];
-extern sem_t NSSemaphore[THREAD_COUNT];
 extern bool NSIsRunning[THREAD_COUNT];
 
-extern void * NSCallbackResponseSchedule(void *ptr);
-extern void * NSDiscoverySchedule(void *ptr);
-extern void * NSSubScriptionSchedule(void *ptr);
-extern void * NSNotificationSchedule(void *ptr);
-extern void * NSTopicSchedule(void * ptr);
+extern void NSCallbackResponseSchedule(NSTask * node);
+extern void NSDiscoverySchedule(NSTask * node);
+extern void NSSubScriptionSchedule(NSTask * node);
+extern void NSNotificationSchedule(NSTask * node);
+extern void NSTopicSchedule(NSTask * node);
 
 /**
  * set list
@@ -83,6 +77,16 @@ bool NSStopScheduler(void);
  */
 void NSPushQueue(NSSchedulerType schedulerType, NSTaskType taskType, void* data);
 
+/**
+ * Get task latency and queue depth statistics of scheduler.
+ *
+ * @param[in] schedulerType   scheduler type
+ * @param[out] stats          statistics of scheduler queue
+ *
+ * @return true if scheduler is initialized, otherwise false.
+ */
+bool NSGetSchedulerStats(NSSchedulerType schedulerType, NSTaskQueueStats * stats);
+
 /**
  * Free data.
  *
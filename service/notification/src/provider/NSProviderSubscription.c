@@ -349,83 +349,61 @@ void NSProviderMQSubscription(NSMQTopicAddress * topicAddr)
 }
 #endif
 
-void * NSSubScriptionSchedule(void *ptr)
+void NSSubScriptionSchedule(NSTask * node)
 {
-    if (ptr == NULL)
+    switch (node->taskType)
     {
-        NS_LOG(DEBUG, "Create NSSubScriptionSchedule");
-    }
-
-    while (NSIsRunning[SUBSCRIPTION_SCHEDULER])
-    {
-        sem_wait(&NSSemaphore[SUBSCRIPTION_SCHEDULER]);
-        pthread_mutex_lock(&NSMutex[SUBSCRIPTION_SCHEDULER]);
-
-        if (NSHeadMsg[SUBSCRIPTION_SCHEDULER] != NULL)
+        case TASK_SEND_POLICY:
+            NS_LOG(DEBUG, "CASE TASK_SEND_POLICY : ");
+            NSSendAccessPolicyResponse((OCEntityHandlerRequest*) node->taskData);
+            break;
+
+        case TASK_RECV_SUBSCRIPTION:
+            NS_LOG(DEBUG, "CASE TASK_RECV_SUBSCRIPTION : ");
+            NSHandleSubscription((OCEntityHandlerRequest*) node->taskData,
+                    NS_RESOURCE_MESSAGE);
+            break;
+
+        case TASK_RECV_UNSUBSCRIPTION:
+            NS_LOG(DEBUG, "CASE TASK_RECV_UNSUBSCRIPTION : ");
+            NSHandleUnsubscription((OCEntityHandlerRequest*) node->taskData);
+            break;
+
+        case TASK_SEND_ALLOW:
         {
-            NSTask *node = NSHeadMsg[SUBSCRIPTION_SCHEDULER];
-            NSHeadMsg[SUBSCRIPTION_SCHEDULER] = node->nextTask;
-
-            switch (node->taskType)
-            {
-                case TASK_SEND_POLICY:
-                    NS_LOG(DEBUG, "CASE TASK_SEND_POLICY : ");
-                    NSSendAccessPolicyResponse((OCEntityHandlerRequest*) node->taskData);
-                    break;
-
-                case TASK_RECV_SUBSCRIPTION:
-                    NS_LOG(DEBUG, "CASE TASK_RECV_SUBSCRIPTION : ");
-                    NSHandleSubscription((OCEntityHandlerRequest*) node->taskData,
-                            NS_RESOURCE_MESSAGE);
-                    break;
-
-                case TASK_RECV_UNSUBSCRIPTION:
-                    NS_LOG(DEBUG, "CASE TASK_RECV_UNSUBSCRIPTION : ");
-                    NSHandleUnsubscription((OCEntityHandlerRequest*) node->taskData);
-                    break;
-
-                case TASK_SEND_ALLOW:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_SEND_ALLOW : ");
-                    char * consumerId = (char *) node->taskData;
-
-                    NSCacheUpdateSubScriptionState(consumerSubList, consumerId, true);
-                    NSSendResponse(consumerId, true);
-                    NSOICFree(consumerId);
-                    break;
-                }
-                case TASK_SEND_DENY:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_SEND_DENY : ");
-                    char * consumerId = (char *) node->taskData;
-
-                    NSCacheUpdateSubScriptionState(consumerSubList, consumerId, false);
-                    NSSendResponse(consumerId, false);
-                    NSOICFree(consumerId);
-
-                    break;
-                }
-                case TASK_SYNC_SUBSCRIPTION:
-                    NS_LOG(DEBUG, "CASE TASK_SYNC_SUBSCRIPTION : ");
-                    NSHandleSubscription((OCEntityHandlerRequest*) node->taskData,
-                            NS_RESOURCE_SYNC);
-                    break;
-#ifdef WITH_MQ
-                case TASK_MQ_REQ_SUBSCRIBE:
-                    NS_LOG(DEBUG, "CASE TASK_MQ_REQ_SUBSCRIBE : ");
-                    NSProviderMQSubscription((NSMQTopicAddress*) node->taskData);
-                    break;
-#endif
-                default:
-                    break;
+            NS_LOG(DEBUG, "CASE TASK_SEND_ALLOW : ");
+            char * consumerId = (char *) node->taskData;
 
-            }
-            NSOICFree(node);
+            NSCacheUpdateSubScriptionState(consumerSubList, consumerId, true);
+            NSSendResponse(consumerId, true);
+            NSOICFree(consumerId);
+            break;
         }
+        case TASK_SEND_DENY:
+        {
+            NS_LOG(DEBUG, "CASE TASK_SEND_DENY : ");
+            char * consumerId = (char *) node->taskData;
+
+            NSCacheUpdateSubScriptionState(consumerSubList, consumerId, false);
+            NSSendResponse(consumerId, false);
+            NSOICFree(consumerId);
 
-        pthread_mutex_unlock(&NSMutex[SUBSCRIPTION_SCHEDULER]);
+            break;
+        }
+        case TASK_SYNC_SUBSCRIPTION:
+            NS_LOG(DEBUG, "CASE TASK_SYNC_SUBSCRIPTION : ");
+            NSHandleSubscription((OCEntityHandlerRequest*) node->taskData,
+                    NS_RESOURCE_SYNC);
+            break;
+#ifdef WITH_MQ
+        case TASK_MQ_REQ_SUBSCRIBE:
+            NS_LOG(DEBUG, "CASE TASK_MQ_REQ_SUBSCRIBE : ");
+            NSProviderMQSubscription((NSMQTopicAddress*) node->taskData);
+            break;
+#endif
+        default:
+            break;
 
     }
-    NS_LOG(INFO, "Destroy NSSubScriptionSchedule");
-    return NULL;
+    NSOICFree(node);
 }
@@ -141,26 +141,9 @@ NSResult NSSendTopicUpdation(void)
     OCRepPayloadSetPropInt(payload, NS_ATTRIBUTE_MESSAGE_ID, NS_TOPIC);
     OCRepPayloadSetPropString(payload, NS_ATTRIBUTE_PROVIDER_ID, NSGetProviderInfo()->providerId);
 
-    OCObservationId obArray[255] =
-    { 0, };
     size_t obCount = 0;
-
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
-    {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-
-        if (subData->isWhite)
-        {
-            if (subData->messageObId != 0)
-            {
-                obArray[obCount++] = subData->messageObId;
-            }
-        }
-
-        it = it->next;
-    }
+    OCObservationId * obArray = NSProviderGetMessageObIds(consumerSubList, consumerTopicList,
+            NULL, &obCount);
 
     if (!obCount)
     {
@@ -169,13 +152,16 @@ NSResult NSSendTopicUpdation(void)
         return NS_ERROR;
     }
 
-    if (OCNotifyListOfObservers(rHandle, obArray, obCount, payload, OC_HIGH_QOS) != OC_STACK_OK)
+    NSResult result = NSNotifyObservers(rHandle, obArray, obCount, payload, OC_HIGH_QOS);
+    NSOICFree(obArray);
+
+    if (result != NS_OK)
     {
         NS_LOG(ERROR, "fail to send topic updation");
         OCRepPayloadDestroy(payload);
         return NS_ERROR;
-
     }
+
     OCRepPayloadDestroy(payload);
 
     NS_LOG(DEBUG, "NSSendTopicUpdation - OUT");
@@ -432,154 +418,131 @@ NSResult NSPostConsumerTopics(OCEntityHandlerRequest * entityHandlerRequest)
     return NS_OK;
 }
 
-void * NSTopicSchedule(void * ptr)
+void NSTopicSchedule(NSTask * node)
 {
-    if (ptr == NULL)
-    {
-        NS_LOG(DEBUG, "Create NSTopicSchedule");
-    }
-
-    while (NSIsRunning[TOPIC_SCHEDULER])
+    switch (node->taskType)
     {
-        sem_wait(&NSSemaphore[TOPIC_SCHEDULER]);
-        pthread_mutex_lock(&NSMutex[TOPIC_SCHEDULER]);
-
-        if (NSHeadMsg[TOPIC_SCHEDULER] != NULL)
+        case TASK_SEND_TOPICS:
+            NS_LOG(DEBUG, "CASE TASK_SEND_TOPICS : ");
+            NSSendTopicList((OCEntityHandlerRequest*) node->taskData);
+            NSFreeOCEntityHandlerRequest((OCEntityHandlerRequest*) node->taskData);
+            break;
+        case TASK_SUBSCRIBE_TOPIC:
         {
-            NSTask *node = NSHeadMsg[TOPIC_SCHEDULER];
-            NSHeadMsg[TOPIC_SCHEDULER] = node->nextTask;
-
-            switch (node->taskType)
+            NS_LOG(DEBUG, "CASE TASK_SUBSCRIBE_TOPIC : ");
+            NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
+            pthread_mutex_lock(topicSyncResult->mutex);
+            NSCacheElement * newObj = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+            NSCacheTopicSubData * subData =
+                    (NSCacheTopicSubData *) topicSyncResult->topicData;
+            if (!newObj)
             {
-                case TASK_SEND_TOPICS:
-                    NS_LOG(DEBUG, "CASE TASK_SEND_TOPICS : ");
-                    NSSendTopicList((OCEntityHandlerRequest*) node->taskData);
-                    NSFreeOCEntityHandlerRequest((OCEntityHandlerRequest*) node->taskData);
-                    break;
-                case TASK_SUBSCRIBE_TOPIC:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_SUBSCRIBE_TOPIC : ");
-                    NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
-                    pthread_mutex_lock(topicSyncResult->mutex);
-                    NSCacheElement * newObj = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
-                    NSCacheTopicSubData * subData =
-                            (NSCacheTopicSubData *) topicSyncResult->topicData;
-                    if (!newObj)
-                    {
-                        NSOICFree(subData->topicName);
-                        NSOICFree(subData);
-                        pthread_cond_signal(topicSyncResult->condition);
-                        pthread_mutex_unlock(topicSyncResult->mutex);
-                    }
-                    else
-                    {
-                        if (NSProviderStorageRead(registeredTopicList, subData->topicName))
-                        {
-                            newObj->data = topicSyncResult->topicData;
-                            newObj->next = NULL;
-
-                            if (NSProviderStorageWrite(consumerTopicList, newObj) == NS_OK)
-                            {
-                                NSSendTopicUpdationToConsumer(subData->id);
-                                topicSyncResult->result = NS_OK;
-                            }
-                        }
-                        else
-                        {
-                            NSOICFree(subData->topicName);
-                            NSOICFree(subData);
-                            NSOICFree(newObj);
-                        }
-                    }
-                    pthread_cond_signal(topicSyncResult->condition);
-                    pthread_mutex_unlock(topicSyncResult->mutex);
-                }
-                    break;
-                case TASK_UNSUBSCRIBE_TOPIC:
+                NSOICFree(subData->topicName);
+                NSOICFree(subData);
+                pthread_cond_signal(topicSyncResult->condition);
+                pthread_mutex_unlock(topicSyncResult->mutex);
+            }
+            else
+            {
+                if (NSProviderStorageRead(registeredTopicList, subData->topicName))
                 {
-                    NS_LOG(DEBUG, "CASE TASK_UNSUBSCRIBE_TOPIC : ");
-                    NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
-                    pthread_mutex_lock(topicSyncResult->mutex);
-                    NSCacheTopicSubData * topicSubData =
-                            (NSCacheTopicSubData *) topicSyncResult->topicData;
+                    newObj->data = topicSyncResult->topicData;
+                    newObj->next = NULL;
 
-                    if (NSProviderDeleteConsumerTopic(consumerTopicList, topicSubData) == NS_OK)
+                    if (NSProviderStorageWrite(consumerTopicList, newObj) == NS_OK)
                     {
-                        NSSendTopicUpdationToConsumer(topicSubData->id);
+                        NSSendTopicUpdationToConsumer(subData->id);
                         topicSyncResult->result = NS_OK;
                     }
-
-                    NSOICFree(topicSubData->topicName);
-                    NSOICFree(topicSubData);
-                    pthread_cond_signal(topicSyncResult->condition);
-                    pthread_mutex_unlock(topicSyncResult->mutex);
-
-                }
-                    break;
-                case TASK_REGISTER_TOPIC:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_ADD_TOPIC : ");
-                    NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
-
-                    pthread_mutex_lock(topicSyncResult->mutex);
-                    topicSyncResult->result = NSRegisterTopic(
-                            (const char *) topicSyncResult->topicData);
-                    pthread_cond_signal(topicSyncResult->condition);
-                    pthread_mutex_unlock(topicSyncResult->mutex);
-                }
-                    break;
-                case TASK_UNREGISTER_TOPIC:
-                {
-                    NS_LOG(DEBUG, "CASE_TASK_DELETE_TOPIC : ");
-                    NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
-                    pthread_mutex_lock(topicSyncResult->mutex);
-                    topicSyncResult->result = NSUnregisterTopic(
-                            (const char *) topicSyncResult->topicData);
-                    NSOICFree(topicSyncResult->topicData);
-                    pthread_cond_signal(topicSyncResult->condition);
-                    pthread_mutex_unlock(topicSyncResult->mutex);
-                }
-                    break;
-                case TASK_POST_TOPIC:
-                {
-                    NS_LOG(DEBUG, "TASK_POST_TOPIC : ");
-                    NSPostConsumerTopics((OCEntityHandlerRequest*) node->taskData);
-                    NSFreeOCEntityHandlerRequest((OCEntityHandlerRequest*) node->taskData);
-                }
-                    break;
-                case TASK_GET_TOPICS:
-                {
-                    NS_LOG(DEBUG, "TASK_GET_TOPICS : ");
-                    NSTopicSync * topicSync = (NSTopicSync *) node->taskData;
-                    pthread_mutex_lock(topicSync->mutex);
-                    NSTopicLL * topics = NSProviderGetTopicsCacheData(registeredTopicList);
-                    topicSync->topics = topics;
-                    pthread_cond_signal(topicSync->condition);
-                    pthread_mutex_unlock(topicSync->mutex);
                 }
-                    break;
-                case TAST_GET_CONSUMER_TOPICS:
+                else
                 {
-                    NS_LOG(DEBUG, "TASK_GET_CONSUMER_TOPICS : ");
-                    NSTopicSync * topicSync = (NSTopicSync *) node->taskData;
-                    pthread_mutex_lock(topicSync->mutex);
-                    NSTopicLL * topics = NSProviderGetConsumerTopicsCacheData(registeredTopicList,
-                            consumerTopicList, topicSync->consumerId);
-                    topicSync->topics = topics;
-                    pthread_cond_signal(topicSync->condition);
-                    pthread_mutex_unlock(topicSync->mutex);
+                    NSOICFree(subData->topicName);
+                    NSOICFree(subData);
+                    NSOICFree(newObj);
                 }
-                    break;
-                default:
-                    break;
             }
-
-            NSOICFree(node);
+            pthread_cond_signal(topicSyncResult->condition);
+            pthread_mutex_unlock(topicSyncResult->mutex);
         }
+            break;
+        case TASK_UNSUBSCRIBE_TOPIC:
+        {
+            NS_LOG(DEBUG, "CASE TASK_UNSUBSCRIBE_TOPIC : ");
+            NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
+            pthread_mutex_lock(topicSyncResult->mutex);
+            NSCacheTopicSubData * topicSubData =
+                    (NSCacheTopicSubData *) topicSyncResult->topicData;
 
-        pthread_mutex_unlock(&NSMutex[TOPIC_SCHEDULER]);
-    }
+            if (NSProviderDeleteConsumerTopic(consumerTopicList, topicSubData) == NS_OK)
+            {
+                NSSendTopicUpdationToConsumer(topicSubData->id);
+                topicSyncResult->result = NS_OK;
+            }
+
+            NSOICFree(topicSubData->topicName);
+            NSOICFree(topicSubData);
+            pthread_cond_signal(topicSyncResult->condition);
+            pthread_mutex_unlock(topicSyncResult->mutex);
 
-    NS_LOG(DEBUG, "Destroy NSTopicSchedule");
-    return NULL;
+        }
+            break;
+        case TASK_REGISTER_TOPIC:
+        {
+            NS_LOG(DEBUG, "CASE TASK_ADD_TOPIC : ");
+            NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
+
+            pthread_mutex_lock(topicSyncResult->mutex);
+            topicSyncResult->result = NSRegisterTopic(
+                    (const char *) topicSyncResult->topicData);
+            pthread_cond_signal(topicSyncResult->condition);
+            pthread_mutex_unlock(topicSyncResult->mutex);
+        }
+            break;
+        case TASK_UNREGISTER_TOPIC:
+        {
+            NS_LOG(DEBUG, "CASE_TASK_DELETE_TOPIC : ");
+            NSTopicSyncResult * topicSyncResult = (NSTopicSyncResult *) node->taskData;
+            pthread_mutex_lock(topicSyncResult->mutex);
+            topicSyncResult->result = NSUnregisterTopic(
+                    (const char *) topicSyncResult->topicData);
+            NSOICFree(topicSyncResult->topicData);
+            pthread_cond_signal(topicSyncResult->condition);
+            pthread_mutex_unlock(topicSyncResult->mutex);
+        }
+            break;
+        case TASK_POST_TOPIC:
+        {
+            NS_LOG(DEBUG, "TASK_POST_TOPIC : ");
+            NSPostConsumerTopics((OCEntityHandlerRequest*) node->taskData);
+            NSFreeOCEntityHandlerRequest((OCEntityHandlerRequest*) node->taskData);
+        }
+            break;
+        case TASK_GET_TOPICS:
+        {
+            NS_LOG(DEBUG, "TASK_GET_TOPICS : ");
+            NSTopicSync * topicSync = (NSTopicSync *) node->taskData;
+            pthread_mutex_lock(topicSync->mutex);
+            NSTopicLL * topics = NSProviderGetTopicsCacheData(registeredTopicList);
+            topicSync->topics = topics;
+            pthread_cond_signal(topicSync->condition);
+            pthread_mutex_unlock(topicSync->mutex);
+        }
+            break;
+        case TAST_GET_CONSUMER_TOPICS:
+        {
+            NS_LOG(DEBUG, "TASK_GET_CONSUMER_TOPICS : ");
+            NSTopicSync * topicSync = (NSTopicSync *) node->taskData;
+            pthread_mutex_lock(topicSync->mutex);
+            NSTopicLL * topics = NSProviderGetConsumerTopicsCacheData(registeredTopicList,
+                    consumerTopicList, topicSync->consumerId);
+            topicSync->topics = topics;
+            pthread_cond_signal(topicSync->condition);
+            pthread_mutex_unlock(topicSync->mutex);
+        }
+            break;
+        default:
+            break;
+    }
+    NSOICFree(node);
 }
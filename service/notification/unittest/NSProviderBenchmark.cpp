@@ -0,0 +1,179 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Publish benchmark of notification provider.
+// Usage : notification_provider_benchmark [consumer count] [message count]
+//
+// Consumers are written to the subscription cache directly, so the benchmark
+// measures the provider scheduler, cache and payload path. The observation
+// ids are not registered to the stack, so no packet is sent over the network.
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+#include "OCPlatform.h"
+#include "oic_malloc.h"
+#include "oic_string.h"
+
+#include "NSCommon.h"
+#include "NSConstants.h"
+#include "NSProviderInterface.h"
+#include "NSProviderScheduler.h"
+#include "NSProviderSubscription.h"
+#include "NSProviderMemoryCache.h"
+
+#define DEFAULT_CONSUMER_COUNT 100
+#define DEFAULT_MESSAGE_COUNT 10000
+
+namespace
+{
+    void NSRequestedSubscribeCallback(NSConsumer * consumer)
+    {
+        (void) consumer;
+    }
+
+    void NSSyncCallback(NSSyncInfo * sync)
+    {
+        free(sync);
+    }
+
+    bool addConsumers(int consumerCount)
+    {
+        for (int i = 0; i < consumerCount; ++i)
+        {
+            NSCacheElement * element = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+            NSCacheSubData * subData = (NSCacheSubData *) OICMalloc(sizeof(NSCacheSubData));
+            if (!element || !subData)
+            {
+                OICFree(element);
+                OICFree(subData);
+                return false;
+            }
+
+            snprintf(subData->id, sizeof(subData->id),
+                    "00000000-0000-0000-0000-%012d", i);
+            subData->messageObId = i + 1;
+            subData->syncObId = 0;
+            subData->isWhite = true;
+
+            element->data = (NSCacheData *) subData;
+            element->next = NULL;
+
+            if (NSProviderStorageWrite(consumerSubList, element) != NS_OK)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint64_t handledCount()
+    {
+        NSTaskQueueStats stats;
+        NSGetSchedulerStats(NOTIFICATION_SCHEDULER, &stats);
+        return stats.handledCount;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int consumerCount = (argc > 1) ? atoi(argv[1]) : DEFAULT_CONSUMER_COUNT;
+    int messageCount = (argc > 2) ? atoi(argv[2]) : DEFAULT_MESSAGE_COUNT;
+
+    if (consumerCount <= 0 || messageCount <= 0)
+    {
+        std::cout << "Usage : " << argv[0] << " [consumer count] [message count]" << std::endl;
+        return -1;
+    }
+
+    OC::PlatformConfig cfg
+    {
+        OC::ServiceType::InProc,
+        OC::ModeType::Server,
+        OC_DEFAULT_ADAPTER,
+        OC::QualityOfService::LowQos
+    };
+    OC::OCPlatform::Configure(cfg);
+
+    NSProviderConfig config;
+    config.subRequestCallback = NSRequestedSubscribeCallback;
+    config.syncInfoCallback = NSSyncCallback;
+    config.subControllability = true;
+    config.userInfo = NULL;
+    config.resourceSecurity = false;
+
+    if (NSStartProvider(config) != NS_OK)
+    {
+        std::cout << "Fail to start provider" << std::endl;
+        return -1;
+    }
+
+    if (!addConsumers(consumerCount))
+    {
+        std::cout << "Fail to add consumers" << std::endl;
+        NSStopProvider();
+        return -1;
+    }
+
+    NSMessage * msg = NSCreateMessage();
+    msg->title = OICStrdup("benchmark title");
+    msg->contentText = OICStrdup("benchmark content");
+    msg->sourceName = OICStrdup("benchmark");
+
+    uint64_t startCount = handledCount();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < messageCount; ++i)
+    {
+        NSSendMessage(msg);
+    }
+
+    while (handledCount() - startCount < (uint64_t) messageCount)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    NSTaskQueueStats stats;
+    NSGetSchedulerStats(NOTIFICATION_SCHEDULER, &stats);
+
+    std::cout << "consumers         : " << consumerCount << std::endl;
+    std::cout << "messages          : " << messageCount << std::endl;
+    std::cout << "elapsed (s)       : " << elapsed.count() << std::endl;
+    std::cout << "messages/s        : " << messageCount / elapsed.count() << std::endl;
+    // no packet is sent, so this is the rate subscribers are walked per message,
+    // not a delivery rate.
+    std::cout << "subscribers/s     : "
+            << (double) messageCount * consumerCount / elapsed.count() << std::endl;
+    std::cout << "max queue depth   : " << stats.maxDepth << std::endl;
+    std::cout << "avg latency (us)  : "
+            << (stats.handledCount ? stats.totalLatency / stats.handledCount : 0) << std::endl;
+    std::cout << "max latency (us)  : " << stats.maxLatency << std::endl;
+
+    NSFreeMessage(msg);
+    NSStopProvider();
+
+    return 0;
+}
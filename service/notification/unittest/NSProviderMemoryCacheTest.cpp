@@ -0,0 +1,252 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "NSProviderMemoryCache.h"
+}
+
+// More consumers than the initial buckets, so the index is resized on the way.
+#define CONSUMER_COUNT 100
+
+namespace
+{
+    std::string consumerId(int i)
+    {
+        char id[NS_UUID_STRING_SIZE];
+        snprintf(id, sizeof(id), "00000000-0000-0000-0000-%012d", i);
+        return id;
+    }
+
+    NSResult writeSubscriber(NSCacheList * list, const std::string & id, int messageObId)
+    {
+        NSCacheElement * element = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+        NSCacheSubData * subData = (NSCacheSubData *) OICMalloc(sizeof(NSCacheSubData));
+        if (!element || !subData)
+        {
+            OICFree(element);
+            OICFree(subData);
+            return NS_ERROR;
+        }
+
+        OICStrcpy(subData->id, sizeof(subData->id), id.c_str());
+        subData->messageObId = messageObId;
+        subData->syncObId = 0;
+        subData->isWhite = true;
+
+        element->data = (NSCacheData *) subData;
+        element->next = NULL;
+
+        return NSProviderStorageWrite(list, element);
+    }
+
+    NSResult writeConsumerTopic(NSCacheList * list, const std::string & id,
+            const std::string & topicName)
+    {
+        NSCacheElement * element = (NSCacheElement *) OICMalloc(sizeof(NSCacheElement));
+        NSCacheTopicSubData * topicData =
+                (NSCacheTopicSubData *) OICMalloc(sizeof(NSCacheTopicSubData));
+        if (!element || !topicData)
+        {
+            OICFree(element);
+            OICFree(topicData);
+            return NS_ERROR;
+        }
+
+        OICStrcpy(topicData->id, sizeof(topicData->id), id.c_str());
+        topicData->topicName = OICStrdup(topicName.c_str());
+
+        element->data = (NSCacheData *) topicData;
+        element->next = NULL;
+
+        return NSProviderStorageWrite(list, element);
+    }
+
+    std::vector<OCObservationId> messageObIds(NSCacheList * subList, NSCacheList * conTopicList,
+            const char * topicName)
+    {
+        size_t count = 0;
+        OCObservationId * ids = NSProviderGetMessageObIds(subList, conTopicList, topicName, &count);
+        std::vector<OCObservationId> result(ids, ids + count);
+        OICFree(ids);
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    size_t listLength(NSCacheList * list)
+    {
+        size_t length = 0;
+        for (NSCacheElement * it = list->head; it; it = it->next)
+        {
+            ++length;
+        }
+        return length;
+    }
+}
+
+class NSProviderMemoryCacheTest : public testing::Test
+{
+protected:
+    NSCacheList * subList;
+    NSCacheList * conTopicList;
+
+    void SetUp()
+    {
+        pthread_rwlock_init(&NSCacheLock, NULL);
+
+        subList = NSProviderStorageCreate();
+        ASSERT_NE(nullptr, subList);
+        subList->cacheType = NS_PROVIDER_CACHE_SUBSCRIBER;
+
+        conTopicList = NSProviderStorageCreate();
+        ASSERT_NE(nullptr, conTopicList);
+        conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
+    }
+
+    void TearDown()
+    {
+        if (subList)
+        {
+            NSProviderStorageDestroy(subList);
+        }
+        if (conTopicList)
+        {
+            NSProviderStorageDestroy(conTopicList);
+        }
+        pthread_rwlock_destroy(&NSCacheLock);
+    }
+};
+
+TEST_F(NSProviderMemoryCacheTest, SubscribersAreFoundAndDeletedThroughIndex)
+{
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        ASSERT_EQ(NS_OK, writeSubscriber(subList, consumerId(i), i + 1));
+    }
+
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        NSCacheElement * element = NSProviderStorageRead(subList, consumerId(i).c_str());
+        ASSERT_NE(nullptr, element);
+        EXPECT_EQ(i + 1, ((NSCacheSubData *) element->data)->messageObId);
+    }
+    EXPECT_EQ(nullptr, NSProviderStorageRead(subList, consumerId(CONSUMER_COUNT).c_str()));
+
+    for (int i = 0; i < CONSUMER_COUNT; i += 2)
+    {
+        EXPECT_EQ(NS_OK, NSProviderStorageDelete(subList, consumerId(i).c_str()));
+    }
+    EXPECT_EQ(NS_FAIL, NSProviderStorageDelete(subList, consumerId(0).c_str()));
+
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        NSCacheElement * element = NSProviderStorageRead(subList, consumerId(i).c_str());
+        EXPECT_EQ(i % 2 != 0, element != nullptr);
+    }
+    EXPECT_EQ((size_t) CONSUMER_COUNT / 2, listLength(subList));
+}
+
+TEST_F(NSProviderMemoryCacheTest, SubscriberWrittenTwiceUpdatesExistingEntry)
+{
+    ASSERT_EQ(NS_OK, writeSubscriber(subList, consumerId(0), 1));
+    ASSERT_EQ(NS_OK, writeSubscriber(subList, consumerId(0), 2));
+
+    NSCacheElement * element = NSProviderStorageRead(subList, consumerId(0).c_str());
+    ASSERT_NE(nullptr, element);
+    EXPECT_EQ(2, ((NSCacheSubData *) element->data)->messageObId);
+    EXPECT_EQ(1u, listLength(subList));
+}
+
+TEST_F(NSProviderMemoryCacheTest, DuplicateConsumerTopicIsRejected)
+{
+    ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(0), "topic1"));
+    ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(0), "topic2"));
+    ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(1), "topic1"));
+
+    EXPECT_EQ(NS_FAIL, writeConsumerTopic(conTopicList, consumerId(0), "topic1"));
+    EXPECT_EQ(NS_FAIL, writeConsumerTopic(conTopicList, consumerId(1), "topic1"));
+    EXPECT_EQ(3u, listLength(conTopicList));
+}
+
+TEST_F(NSProviderMemoryCacheTest, IndexFollowsConsumerTopicRemoval)
+{
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        ASSERT_EQ(NS_OK, writeSubscriber(subList, consumerId(i), i + 1));
+        ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(i), "topic1"));
+        ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(i), "topic2"));
+    }
+    EXPECT_EQ((size_t) CONSUMER_COUNT, messageObIds(subList, conTopicList, "topic1").size());
+
+    std::string id = consumerId(0);
+    NSCacheTopicSubData topicSubData;
+    OICStrcpy(topicSubData.id, sizeof(topicSubData.id), id.c_str());
+    topicSubData.topicName = (char *) "topic1";
+
+    EXPECT_EQ(NS_OK, NSProviderDeleteConsumerTopic(conTopicList, &topicSubData));
+    EXPECT_EQ(NS_FAIL, NSProviderDeleteConsumerTopic(conTopicList, &topicSubData));
+    EXPECT_FALSE(NSProviderIsTopicSubScribed(conTopicList->head, &id[0], (char *) "topic1"));
+    EXPECT_TRUE(NSProviderIsTopicSubScribed(conTopicList->head, &id[0], (char *) "topic2"));
+
+    std::vector<OCObservationId> topic1 = messageObIds(subList, conTopicList, "topic1");
+    EXPECT_EQ((size_t) CONSUMER_COUNT - 1, topic1.size());
+    EXPECT_EQ(topic1.end(), std::find(topic1.begin(), topic1.end(), (OCObservationId) 1));
+    EXPECT_EQ((size_t) CONSUMER_COUNT, messageObIds(subList, conTopicList, "topic2").size());
+
+    // The topic can be subscribed again once it is removed.
+    EXPECT_EQ(NS_OK, writeConsumerTopic(conTopicList, id, "topic1"));
+    EXPECT_EQ((size_t) CONSUMER_COUNT, messageObIds(subList, conTopicList, "topic1").size());
+}
+
+TEST_F(NSProviderMemoryCacheTest, IndexFollowsConsumerRemoval)
+{
+    for (int i = 0; i < CONSUMER_COUNT; ++i)
+    {
+        ASSERT_EQ(NS_OK, writeSubscriber(subList, consumerId(i), i + 1));
+        ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(i), "topic1"));
+        ASSERT_EQ(NS_OK, writeConsumerTopic(conTopicList, consumerId(i), "topic2"));
+    }
+
+    // Removing all topics of a consumer looks them up by consumer id.
+    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID;
+    while (NSProviderStorageDelete(conTopicList, consumerId(1).c_str()) != NS_FAIL)
+    {
+    }
+    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
+    EXPECT_EQ(NS_OK, NSProviderStorageDelete(subList, consumerId(2).c_str()));
+
+    EXPECT_EQ((size_t) CONSUMER_COUNT * 2 - 2, listLength(conTopicList));
+
+    std::vector<OCObservationId> topic1 = messageObIds(subList, conTopicList, "topic1");
+    std::vector<OCObservationId> topic2 = messageObIds(subList, conTopicList, "topic2");
+    std::vector<OCObservationId> all = messageObIds(subList, conTopicList, NULL);
+    EXPECT_EQ((size_t) CONSUMER_COUNT - 2, topic1.size());
+    EXPECT_EQ(topic1, topic2);
+    EXPECT_EQ((size_t) CONSUMER_COUNT - 1, all.size());
+    EXPECT_EQ(topic1.end(), std::find(topic1.begin(), topic1.end(), (OCObservationId) 2));
+    EXPECT_EQ(topic1.end(), std::find(topic1.begin(), topic1.end(), (OCObservationId) 3));
+}
@@ -0,0 +1,259 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "NSTaskQueue.h"
+#include "oic_malloc.h"
+
+#define TASK_QUEUE_COUNT 4
+#define PRODUCER_COUNT 4
+#define TASKS_PER_PRODUCER 5000
+
+namespace
+{
+    std::chrono::milliseconds g_waitForTasks(5000);
+
+    std::condition_variable responseTasksDone;
+    std::mutex responseTasksDoneLock;
+
+    std::atomic_int g_handledCount(0);
+    std::atomic_bool g_isOrdered(true);
+    int g_expectedCount = 0;
+
+    // last sequence number handled per producer, indexed by queue.
+    // each queue is run by one worker at a time, so no lock is needed.
+    int g_lastSequence[TASK_QUEUE_COUNT][PRODUCER_COUNT];
+
+    NSTask * createTask(int producer, int sequence)
+    {
+        NSTask * task = (NSTask *) OICMalloc(sizeof(NSTask));
+        EXPECT_NE((void *)NULL, task);
+        task->taskType = (NSTaskType) producer;
+        task->taskData = (void *)(intptr_t) sequence;
+        task->nextTask = NULL;
+        return task;
+    }
+
+    template <int QUEUE>
+    void orderedTaskHandler(NSTask * task)
+    {
+        int producer = (int) task->taskType;
+        int sequence = (int)(intptr_t) task->taskData;
+
+        if (sequence != g_lastSequence[QUEUE][producer] + 1)
+        {
+            g_isOrdered = false;
+        }
+        g_lastSequence[QUEUE][producer] = sequence;
+        OICFree(task);
+
+        if (++g_handledCount == g_expectedCount)
+        {
+            std::unique_lock< std::mutex > lock{ responseTasksDoneLock };
+            responseTasksDone.notify_all();
+        }
+    }
+
+    const NSTaskHandler g_handlers[TASK_QUEUE_COUNT] =
+    {
+        orderedTaskHandler<0>, orderedTaskHandler<1>,
+        orderedTaskHandler<2>, orderedTaskHandler<3>
+    };
+
+    void resetState(int expectedCount)
+    {
+        g_handledCount = 0;
+        g_isOrdered = true;
+        g_expectedCount = expectedCount;
+        for (int i = 0; i < TASK_QUEUE_COUNT; ++i)
+        {
+            for (int j = 0; j < PRODUCER_COUNT; ++j)
+            {
+                g_lastSequence[i][j] = -1;
+            }
+        }
+    }
+
+    bool waitForTasks()
+    {
+        std::unique_lock< std::mutex > lock{ responseTasksDoneLock };
+        return responseTasksDone.wait_for(lock, g_waitForTasks,
+                [] { return g_handledCount == g_expectedCount; });
+    }
+}
+
+TEST(NotificationTaskQueueTest, CreateWorkerPoolFailWithZeroWorker)
+{
+    EXPECT_EQ((void *)NULL, NSCreateWorkerPool(0));
+}
+
+TEST(NotificationTaskQueueTest, CreateTaskQueueFailWithNullHandler)
+{
+    NSWorkerPool * pool = NSCreateWorkerPool(1);
+    ASSERT_NE((void *)NULL, pool);
+
+    EXPECT_EQ((void *)NULL, NSCreateTaskQueue(pool, NULL));
+    EXPECT_EQ((void *)NULL, NSCreateTaskQueue(NULL, orderedTaskHandler<0>));
+
+    NSDestroyWorkerPool(pool);
+}
+
+TEST(NotificationTaskQueueTest, TasksOfOneQueueAreHandledInPushOrder)
+{
+    resetState(PRODUCER_COUNT * TASKS_PER_PRODUCER);
+
+    NSWorkerPool * pool = NSCreateWorkerPool(3);
+    ASSERT_NE((void *)NULL, pool);
+    NSTaskQueue * queue = NSCreateTaskQueue(pool, g_handlers[0]);
+    ASSERT_NE((void *)NULL, queue);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        producers.push_back(std::thread([queue, producer]
+        {
+            for (int i = 0; i < TASKS_PER_PRODUCER; ++i)
+            {
+                NSPushTaskQueue(queue, createTask(producer, i));
+            }
+        }));
+    }
+    for (auto & producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_TRUE(waitForTasks());
+    EXPECT_TRUE(g_isOrdered);
+
+    NSDestroyWorkerPool(pool);
+    NSDestroyTaskQueue(queue);
+}
+
+TEST(NotificationTaskQueueTest, QueuesShareWorkerPool)
+{
+    resetState(TASK_QUEUE_COUNT * PRODUCER_COUNT * TASKS_PER_PRODUCER);
+
+    NSWorkerPool * pool = NSCreateWorkerPool(2);
+    ASSERT_NE((void *)NULL, pool);
+
+    NSTaskQueue * queues[TASK_QUEUE_COUNT];
+    for (int i = 0; i < TASK_QUEUE_COUNT; ++i)
+    {
+        queues[i] = NSCreateTaskQueue(pool, g_handlers[i]);
+        ASSERT_NE((void *)NULL, queues[i]);
+    }
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        producers.push_back(std::thread([&queues, producer]
+        {
+            for (int i = 0; i < TASKS_PER_PRODUCER; ++i)
+            {
+                for (int queue = 0; queue < TASK_QUEUE_COUNT; ++queue)
+                {
+                    NSPushTaskQueue(queues[queue], createTask(producer, i));
+                }
+            }
+        }));
+    }
+    for (auto & producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_TRUE(waitForTasks());
+    EXPECT_TRUE(g_isOrdered);
+
+    NSDestroyWorkerPool(pool);
+    for (int i = 0; i < TASK_QUEUE_COUNT; ++i)
+    {
+        NSDestroyTaskQueue(queues[i]);
+    }
+}
+
+TEST(NotificationTaskQueueTest, StatsCountHandledTasks)
+{
+    resetState(TASKS_PER_PRODUCER);
+
+    NSWorkerPool * pool = NSCreateWorkerPool(1);
+    ASSERT_NE((void *)NULL, pool);
+    NSTaskQueue * queue = NSCreateTaskQueue(pool, g_handlers[0]);
+    ASSERT_NE((void *)NULL, queue);
+
+    for (int i = 0; i < TASKS_PER_PRODUCER; ++i)
+    {
+        NSPushTaskQueue(queue, createTask(0, i));
+    }
+
+    EXPECT_TRUE(waitForTasks());
+
+    NSTaskQueueStats stats;
+    NSGetTaskQueueStats(queue, &stats);
+
+    EXPECT_EQ((size_t) 0, stats.depth);
+    EXPECT_LE((size_t) 1, stats.maxDepth);
+    EXPECT_EQ((uint64_t) TASKS_PER_PRODUCER, stats.handledCount);
+    EXPECT_LE(stats.maxLatency, stats.totalLatency);
+
+    NSDestroyWorkerPool(pool);
+    NSDestroyTaskQueue(queue);
+}
+
+TEST(NotificationTaskQueueTest, PopRemainingTasksAfterPoolIsDestroyed)
+{
+    resetState(TASKS_PER_PRODUCER);
+
+    NSWorkerPool * pool = NSCreateWorkerPool(1);
+    ASSERT_NE((void *)NULL, pool);
+    NSTaskQueue * queue = NSCreateTaskQueue(pool, g_handlers[0]);
+    ASSERT_NE((void *)NULL, queue);
+
+    for (int i = 0; i < TASKS_PER_PRODUCER; ++i)
+    {
+        NSPushTaskQueue(queue, createTask(0, i));
+    }
+
+    NSDestroyWorkerPool(pool);
+
+    NSTask * task = NSPopTaskQueue(queue);
+    while (task)
+    {
+        orderedTaskHandler<0>(task);
+        task = NSPopTaskQueue(queue);
+    }
+
+    EXPECT_EQ(TASKS_PER_PRODUCER, g_handledCount);
+    EXPECT_TRUE(g_isOrdered);
+
+    NSTaskQueueStats stats;
+    NSGetTaskQueueStats(queue, &stats);
+    EXPECT_EQ((size_t) 0, stats.depth);
+
+    NSDestroyTaskQueue(queue);
+}
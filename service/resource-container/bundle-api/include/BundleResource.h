@@ -27,6 +27,7 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <functional>
 
 
 #include "NotificationReceiver.h"
@@ -49,6 +50,11 @@ namespace OIC
             public:
                 typedef std::shared_ptr< BundleResource > Ptr;
 
+                /**
+                * Function that changes the attributes of the resource in place
+                */
+                typedef std::function< void(RCSResourceAttributes &) > AttributesUpdater;
+
                 /**
                 * Constructor for BundleResource
                 */
@@ -161,6 +167,30 @@ namespace OIC
                 */
                 void setAttribute(const std::string &key, RCSResourceAttributes::Value &value);
 
+                /**
+                * Updates several attributes of the resource at once
+                *
+                * The updater is called with the attributes locked, so the changes are
+                * applied atomically, and OIC clients are notified once for all of them.
+                * The updater must not call other attribute methods of the resource.
+                *
+                * @param updater Function to change the attributes
+                *
+                * @return void
+                */
+                void updateAttributes(const AttributesUpdater &updater);
+
+                /**
+                * Updates several attributes of the resource at once
+                *
+                * @param updater Function to change the attributes
+                *
+                * @param notify Flag to indicate if OIC clients should be notified about an update
+                *
+                * @return void
+                */
+                void updateAttributes(const AttributesUpdater &updater, bool notify);
+
                 /**
                 * This function should be implemented by the according bundle resource
                 * and execute the according business logic (e.g., light switch or sensor resource)
@@ -197,7 +227,7 @@ namespace OIC
                                                         const std::map< std::string, std::string > &queryParams) = 0;
             private:
 
-                void sendNotification(NotificationReceiver *notficiationRecevier, std::string uri);
+                void sendNotification();
 
             public:
                 std::string m_bundleId;
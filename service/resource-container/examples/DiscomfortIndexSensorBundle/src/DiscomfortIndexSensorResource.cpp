@@ -55,12 +55,15 @@ void DiscomfortIndexSensorResource::executeLogic()
 
     m_pDiscomfortIndexSensor->executeDISensorLogic(&m_mapInputData, &strDiscomfortIndex);
 
-    setAttribute("discomfortIndex", RCSResourceAttributes::Value(strDiscomfortIndex.c_str()), true);
-
-    for (auto it : m_mapInputData)
+    updateAttributes([this, &strDiscomfortIndex](RCSResourceAttributes &attributes)
     {
-        setAttribute(it.first, RCSResourceAttributes::Value(it.second.c_str()));
-    }
+        attributes["discomfortIndex"] = RCSResourceAttributes::Value(strDiscomfortIndex.c_str());
+
+        for (auto it : m_mapInputData)
+        {
+            attributes[it.first] = RCSResourceAttributes::Value(it.second.c_str());
+        }
+    });
 }
 
 void DiscomfortIndexSensorResource::onUpdatedInputResource(const std::string attributeName,
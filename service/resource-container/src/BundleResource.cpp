@@ -23,7 +23,6 @@
 #include <list>
 #include <string.h>
 #include <iostream>
-#include <boost/thread.hpp>
 #include "NotificationReceiver.h"
 
 #include "InternalTypes.h"
@@ -72,31 +71,22 @@ namespace OIC
 
         void BundleResource::setAttributes(const RCSResourceAttributes &attrs, bool notify)
         {
-            std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
-
-            for (auto &it : attrs)
             {
-                OIC_LOG_V(INFO, CONTAINER_TAG, "set attribute \(%s)'",
-                           std::string(it.key() + "\', with " + it.value().toString()).c_str());
+                std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
+
+                for (auto &it : attrs)
+                {
+                    OIC_LOG_V(INFO, CONTAINER_TAG, "set attribute \(%s)'",
+                               std::string(it.key() + "\', with " + it.value().toString()).c_str());
 
-                m_resourceAttributes[it.key()] = it.value();
+                    m_resourceAttributes[it.key()] = it.value();
+                }
             }
 
             if(notify)
             {
-                // asynchronous notification
-                auto notifyFunc = [](NotificationReceiver *notificationReceiver,
-                                        std::string uri)
-                {
-                    if (notificationReceiver)
-                    {
-                        notificationReceiver->onNotificationReceived(uri);
-                    }
-                };
-                auto f = std::bind(notifyFunc, m_pNotiReceiver, m_uri);
-                boost::thread notifyThread(f);
+                sendNotification();
             }
-
         }
 
         void BundleResource::setAttribute(const std::string &key,
@@ -104,24 +94,15 @@ namespace OIC
         {
             OIC_LOG_V(INFO, CONTAINER_TAG, "set attribute \(%s)'", std::string(key + "\', with " +
                      value.toString()).c_str());
-            std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
-            m_resourceAttributes[key] = std::move(value);
+            {
+                std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
+                m_resourceAttributes[key] = std::move(value);
+            }
 
             if(notify)
             {
-                // asynchronous notification
-                auto notifyFunc = [](NotificationReceiver *notificationReceiver,
-                                        std::string uri)
-                {
-                    if (notificationReceiver)
-                    {
-                        notificationReceiver->onNotificationReceived(uri);
-                    }
-                };
-                auto f = std::bind(notifyFunc, m_pNotiReceiver, m_uri);
-                boost::thread notifyThread(f);
+                sendNotification();
             }
-
         }
 
         void BundleResource::setAttribute(const std::string &key,
@@ -142,11 +123,38 @@ namespace OIC
             setAttribute(key, value, true);
         }
 
+        void BundleResource::updateAttributes(const AttributesUpdater &updater)
+        {
+            updateAttributes(updater, true);
+        }
+
+        void BundleResource::updateAttributes(const AttributesUpdater &updater, bool notify)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
+                updater(m_resourceAttributes);
+            }
+
+            if(notify)
+            {
+                sendNotification();
+            }
+        }
+
         RCSResourceAttributes::Value BundleResource::getAttribute(const std::string &key)
         {
             OIC_LOG_V(INFO, CONTAINER_TAG, "get attribute \'(%s)" , std::string(key + "\'").c_str());
             std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
             return m_resourceAttributes.at(key);
         }
+
+        void BundleResource::sendNotification()
+        {
+            // the receiver only queues the notification, so it is called on this thread.
+            if (m_pNotiReceiver)
+            {
+                m_pNotiReceiver->onNotificationReceived(m_uri);
+            }
+        }
     }
 }
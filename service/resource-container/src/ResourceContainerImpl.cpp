@@ -33,6 +33,7 @@
 #include "BundleActivator.h"
 #include "SoftSensorResource.h"
 #include "InternalTypes.h"
+#include "RCSException.h"
 
 using namespace OIC::Service;
 using namespace std;
@@ -41,13 +42,14 @@ namespace OIC
 {
     namespace Service
     {
-        ResourceContainerImpl::ResourceContainerImpl()
+        ResourceContainerImpl::ResourceContainerImpl() : m_stopNotification(false)
         {
             m_config = nullptr;
         }
 
         ResourceContainerImpl::~ResourceContainerImpl()
         {
+            stopNotificationDispatcher();
             m_config = nullptr;
         }
 
@@ -134,17 +136,26 @@ namespace OIC
                 it = next_itr;
             }
 
-            if (!m_mapServers.empty())
             {
-                map< std::string, RCSResourceObject::Ptr >::iterator itor = m_mapServers.begin();
+                std::lock_guard< std::mutex > lock(m_notificationMutex);
+                m_pendingNotifications.clear();
+                m_pendingNotificationUris.clear();
+            }
 
-                while (itor != m_mapServers.end())
+            {
+                std::lock_guard< std::mutex > lock(registrationLock);
+                if (!m_mapServers.empty())
                 {
-                    (itor++)->second.reset();
-                }
+                    map< std::string, RCSResourceObject::Ptr >::iterator itor = m_mapServers.begin();
 
-                m_mapResources.clear();
-                m_mapBundleResources.clear();
+                    while (itor != m_mapServers.end())
+                    {
+                        (itor++)->second.reset();
+                    }
+
+                    m_mapResources.clear();
+                    m_mapBundleResources.clear();
+                }
             }
 
             if (m_config)
@@ -377,6 +388,14 @@ namespace OIC
                 undiscoverInputResource(strUri);
             }
 
+            // a notification queued before the unregistration is still delivered.
+            std::lock_guard< std::mutex > dispatchLock(m_dispatchMutex);
+            if (removeNotification(strUri))
+            {
+                dispatchNotification(strUri);
+            }
+
+            std::lock_guard< std::mutex > lock(registrationLock);
             if (m_mapServers.find(strUri) != m_mapServers.end())
             {
                 OIC_LOG_V(INFO, CONTAINER_TAG, "Resetting server (%s)",
@@ -488,9 +507,122 @@ namespace OIC
             OIC_LOG_V(INFO, CONTAINER_TAG,
                      "notification from (%s)", std::string(strResourceUri + ".").c_str());
 
-            if (m_mapServers.find(strResourceUri) != m_mapServers.end())
             {
-                m_mapServers[strResourceUri]->notify();
+                std::lock_guard< std::mutex > lock(m_notificationMutex);
+
+                if (m_stopNotification
+                    || !m_pendingNotificationUris.insert(strResourceUri).second)
+                {
+                    return;
+                }
+
+                m_pendingNotifications.push_back(strResourceUri);
+
+                if (!m_notificationThread.joinable())
+                {
+                    m_notificationThread = std::thread(
+                            &ResourceContainerImpl::runNotificationDispatcher, this);
+                }
+            }
+            m_notificationCond.notify_one();
+        }
+
+        void ResourceContainerImpl::runNotificationDispatcher()
+        {
+            while (waitForNotification())
+            {
+                std::lock_guard< std::mutex > dispatchLock(m_dispatchMutex);
+                std::string strResourceUri;
+
+                // the notification may have been delivered by unregisterResource meanwhile.
+                if (popNotification(strResourceUri))
+                {
+                    dispatchNotification(strResourceUri);
+                }
+            }
+        }
+
+        bool ResourceContainerImpl::waitForNotification()
+        {
+            std::unique_lock< std::mutex > lock(m_notificationMutex);
+            m_notificationCond.wait(lock, [this]()
+            {
+                return !m_pendingNotifications.empty() || m_stopNotification;
+            });
+
+            return !m_stopNotification;
+        }
+
+        bool ResourceContainerImpl::popNotification(std::string &strResourceUri)
+        {
+            std::lock_guard< std::mutex > lock(m_notificationMutex);
+
+            if (m_pendingNotifications.empty())
+            {
+                return false;
+            }
+
+            strResourceUri = std::move(m_pendingNotifications.front());
+            m_pendingNotifications.pop_front();
+            m_pendingNotificationUris.erase(strResourceUri);
+            return true;
+        }
+
+        bool ResourceContainerImpl::removeNotification(const std::string &strResourceUri)
+        {
+            std::lock_guard< std::mutex > lock(m_notificationMutex);
+
+            if (m_pendingNotificationUris.erase(strResourceUri) == 0)
+            {
+                return false;
+            }
+
+            m_pendingNotifications.erase(std::find(m_pendingNotifications.begin(),
+                                                   m_pendingNotifications.end(), strResourceUri));
+            return true;
+        }
+
+        void ResourceContainerImpl::dispatchNotification(const std::string &strResourceUri)
+        {
+            RCSResourceObject::Ptr server;
+            {
+                std::lock_guard< std::mutex > lock(registrationLock);
+                auto it = m_mapServers.find(strResourceUri);
+                if (it != m_mapServers.end())
+                {
+                    server = it->second;
+                }
+            }
+
+            if (!server)
+            {
+                return;
+            }
+
+            try
+            {
+                server->notify();
+            }
+            catch (const RCSException &e)
+            {
+                OIC_LOG_V(ERROR, CONTAINER_TAG, "notification of (%s) failed : %s",
+                          strResourceUri.c_str(), e.what());
+            }
+        }
+
+        void ResourceContainerImpl::stopNotificationDispatcher()
+        {
+            {
+                std::lock_guard< std::mutex > lock(m_notificationMutex);
+                m_stopNotification = true;
+                m_pendingNotifications.clear();
+                m_pendingNotificationUris.clear();
+            }
+            m_notificationCond.notify_all();
+
+            if (m_notificationThread.joinable())
+            {
+                m_notificationThread.join();
             }
         }
 
@@ -39,6 +39,11 @@
 #endif
 
 #include <map>
+#include <deque>
+#include <unordered_set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #define BUNDLE_ACTIVATION_WAIT_SEC 10
 #define BUNDLE_SET_GET_WAIT_SEC 10
@@ -113,6 +118,17 @@ namespace OIC
                 // such as individual bundle activation
                 std::recursive_mutex activationLock;
 
+                // notifications of bundle resources are dispatched by a single thread,
+                // and a resource is queued once until its observers are notified.
+                std::thread m_notificationThread;
+                std::mutex m_notificationMutex;
+                std::condition_variable m_notificationCond;
+                std::deque< std::string > m_pendingNotifications;
+                std::unordered_set< std::string > m_pendingNotificationUris;
+                bool m_stopNotification;
+                // held while a notification is dispatched
+                std::mutex m_dispatchMutex;
+
                 ResourceContainerImpl();
                 virtual ~ResourceContainerImpl();
 
@@ -132,6 +148,13 @@ namespace OIC
                 void undiscoverInputResource(const std::string &outputResourceUri);
                 void activateBundleThread(const std::string &bundleId);
 
+                void runNotificationDispatcher();
+                bool waitForNotification();
+                bool popNotification(std::string &strResourceUri);
+                bool removeNotification(const std::string &strResourceUri);
+                void dispatchNotification(const std::string &strResourceUri);
+                void stopNotificationDispatcher();
+
                 void activateBundle(shared_ptr<RCSBundleInfo> bundleInfo);
                 void deactivateBundle(shared_ptr<RCSBundleInfo> bundleInfo);
                 void activateBundle(const std::string &bundleId);
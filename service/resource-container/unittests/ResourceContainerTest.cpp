@@ -25,6 +25,10 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include <UnitTestHelper.h>
 
@@ -238,6 +242,23 @@ TEST_F(ResourceContainerTest, TestBundleResource)
     EXPECT_EQ(2, testResource.getAttribute("attrib2"));
 }
 
+TEST_F(ResourceContainerTest, TestBundleResourceUpdateAttributes)
+{
+    TestBundleResourceWithAttrs testResource;
+    testResource.initAttributes();
+
+    testResource.updateAttributes([](RCSResourceAttributes &attributes)
+    {
+        attributes["attrib1"] = "test2";
+        attributes["attrib2"] = attributes["attrib2"].get< int >() + 1;
+        attributes["attrib4"] = false;
+    }, false);
+
+    EXPECT_STREQ("\"test2\"", testResource.getAttribute("attrib1").toString().c_str());
+    EXPECT_EQ(2, testResource.getAttribute("attrib2"));
+    EXPECT_EQ((unsigned int) 4, testResource.getAttributeNames().size());
+}
+
 TEST_F(ResourceContainerTest, TestSoftSensorResource)
 {
     TestSoftSensorResource softSensorResource;
@@ -493,6 +514,100 @@ TEST_F(ResourceContainerBundleAPITest,
     m_pResourceContainer->unregisterResource(m_pBundleResource);
 }
 
+TEST_F(ResourceContainerBundleAPITest, NotificationDeliveredByDispatcherThread)
+{
+    std::mutex notifyMutex;
+    std::condition_variable notifyCond;
+    std::thread::id notifyThreadId;
+    int numOfNotifications = 0;
+
+    mocks.OnCallFunc(ResourceContainerImpl::buildResourceObject).Return(
+        RCSResourceObject::Ptr(m_pResourceObject, [](RCSResourceObject *)
+        {
+        }));
+
+    mocks.ExpectCall(m_pResourceObject, RCSResourceObject::setGetRequestHandler);
+    mocks.ExpectCall(m_pResourceObject, RCSResourceObject::setSetRequestHandler);
+
+    m_pResourceContainer->registerResource(m_pBundleResource);
+
+    mocks.OnCall(m_pResourceObject, RCSResourceObject::notify).Do([&]()
+    {
+        std::lock_guard< std::mutex > lock(notifyMutex);
+        notifyThreadId = std::this_thread::get_id();
+        ++numOfNotifications;
+        notifyCond.notify_all();
+    });
+
+    m_pResourceContainer->onNotificationReceived(m_pBundleResource->m_uri);
+
+    {
+        std::unique_lock< std::mutex > lock(notifyMutex);
+        notifyCond.wait_for(lock, std::chrono::seconds(1),
+                            [&]() { return numOfNotifications > 0; });
+        EXPECT_EQ(1, numOfNotifications);
+        EXPECT_NE(std::this_thread::get_id(), notifyThreadId);
+    }
+
+    m_pResourceContainer->unregisterResource(m_pBundleResource);
+}
+
+TEST_F(ResourceContainerBundleAPITest, RepeatedNotificationsCoalescedWhileDispatching)
+{
+    std::mutex notifyMutex;
+    std::condition_variable notifyCond;
+    bool isReleased = false;
+    int numOfNotifications = 0;
+
+    mocks.OnCallFunc(ResourceContainerImpl::buildResourceObject).Return(
+        RCSResourceObject::Ptr(m_pResourceObject, [](RCSResourceObject *)
+        {
+        }));
+
+    mocks.ExpectCall(m_pResourceObject, RCSResourceObject::setGetRequestHandler);
+    mocks.ExpectCall(m_pResourceObject, RCSResourceObject::setSetRequestHandler);
+
+    m_pResourceContainer->registerResource(m_pBundleResource);
+
+    // the first notification holds the dispatcher until the updates below are queued.
+    mocks.OnCall(m_pResourceObject, RCSResourceObject::notify).Do([&]()
+    {
+        std::unique_lock< std::mutex > lock(notifyMutex);
+        ++numOfNotifications;
+        notifyCond.notify_all();
+        notifyCond.wait(lock, [&]() { return isReleased; });
+    });
+
+    m_pResourceContainer->onNotificationReceived(m_pBundleResource->m_uri);
+    {
+        std::unique_lock< std::mutex > lock(notifyMutex);
+        EXPECT_TRUE(notifyCond.wait_for(lock, std::chrono::seconds(1),
+                                        [&]() { return numOfNotifications == 1; }));
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        m_pResourceContainer->onNotificationReceived(m_pBundleResource->m_uri);
+    }
+
+    {
+        std::unique_lock< std::mutex > lock(notifyMutex);
+        isReleased = true;
+        notifyCond.notify_all();
+        notifyCond.wait_for(lock, std::chrono::seconds(1),
+                            [&]() { return numOfNotifications == 2; });
+    }
+
+    // leaves time for a notification which should not have been queued.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        std::lock_guard< std::mutex > lock(notifyMutex);
+        EXPECT_EQ(2, numOfNotifications);
+    }
+
+    m_pResourceContainer->unregisterResource(m_pBundleResource);
+}
+
 TEST_F(ResourceContainerBundleAPITest, BundleConfigurationParsedWithValidBundleId)
 {
     configInfo bundle;
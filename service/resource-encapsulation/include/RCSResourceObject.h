@@ -47,6 +47,7 @@ namespace OIC
         class RCSRequest;
         class RCSRepresentation;
         class InterfaceHandler;
+        class NotificationCoalescer;
 
         /**
          * @brief Thrown when lock has not been acquired.
@@ -126,7 +127,11 @@ namespace OIC
             {
                 NEVER,  /**< Never*/
                 ALWAYS, /**< Always*/
-                UPDATED /**< Only when attributes are changed*/
+                UPDATED, /**< Only when attributes are changed*/
+                COALESCED /**< Only when attributes are changed, at most once per minimum
+                               notification period. Changes within the period are merged
+                               into one notification.
+                               @see RCSResourceObject::setNotificationPeriods */
             };
 
             /**
@@ -490,6 +495,35 @@ namespace OIC
              */
             AutoNotifyPolicy getAutoNotifyPolicy() const;
 
+            /**
+             * Sets the minimum and maximum notification periods used by
+             * AutoNotifyPolicy::COALESCED, as pmin and pmax of CoRE.
+             *
+             * Changes made within the minimum period from the last notification are merged
+             * and notified when the period ends. A LockGuard flushes the merged changes when it
+             * is released. If the maximum period is not zero, observers are notified at least
+             * once every maximum period even if nothing changed.
+             *
+             * Both periods are zero by default.
+             *
+             * @param minPeriodInMilliSec minimum notification period in milliseconds
+             * @param maxPeriodInMilliSec maximum notification period in milliseconds,
+             *        zero for no maximum
+             *
+             * @throws RCSInvalidParameterException If the maximum period is less than
+             *         the minimum period.
+             */
+            void setNotificationPeriods(long long minPeriodInMilliSec,
+                    long long maxPeriodInMilliSec);
+
+            /**
+             * Returns the number of changes that were merged into a later notification
+             * instead of being notified on their own.
+             *
+             * @see AutoNotifyPolicy::COALESCED
+             */
+            unsigned long long getSuppressedNotificationCount() const;
+
             /**
              * Sets the policy for handling a set request.
              *
@@ -607,6 +641,7 @@ namespace OIC
 
             void autoNotify(bool, AutoNotifyPolicy) const;
             void autoNotify(bool) const;
+            void autoNotifyOnRelease(bool, AutoNotifyPolicy) const;
 
             bool testValueUpdated(const std::string&, const RCSResourceAttributes::Value&) const;
 
@@ -635,6 +670,8 @@ namespace OIC
             std::shared_ptr< SetRequestHandler > m_setRequestHandler;
 
             AutoNotifyPolicy m_autoNotifyPolicy;
+            std::shared_ptr< NotificationCoalescer > m_notificationCoalescer;
+
             SetRequestHandlerPolicy m_setRequestHandlerPolicy;
 
             std::unordered_map< std::string, std::shared_ptr< AttributeUpdatedListener > >
@@ -662,6 +699,8 @@ namespace OIC
          *
          * Additionally when it is destructed and only when destructed not by stack unwinding
          * caused by an exception, it tries to notify depending on AutoNotifyPolicy.
+         * With AutoNotifyPolicy::COALESCED, the changes are notified at once together with
+         * the changes merged before.
          *
          * @note The destrcutor can throw an exception if auto notify failed.
          */
@@ -20,6 +20,8 @@
 
 #include "ExpiryTimerImpl.h"
 
+#include <limits>
+
 #include "RCSException.h"
 
 namespace OIC
@@ -30,17 +32,42 @@ namespace OIC
         namespace
         {
             constexpr ExpiryTimerImpl::Id INVALID_ID{ 0U };
+
+            // one rotation of the wheel is about a second.
+            constexpr size_t WHEEL_SIZE{ 1024 };
+
+            // callbacks may block, so more than one thread runs them.
+            constexpr size_t EXECUTOR_THREAD_COUNT{ 4 };
+
+            inline size_t toSlot(long long tick)
+            {
+                return static_cast< size_t >(tick) % WHEEL_SIZE;
+            }
         }
 
         ExpiryTimerImpl::ExpiryTimerImpl() :
-                m_tasks{ },
+                m_startTime{ Clock::now() },
+                m_wheel(WHEEL_SIZE),
+                m_taskPositions{ },
+                m_lastTick{ -1 },
+                m_nextTick{ std::numeric_limits< Tick >::max() },
                 m_thread{ },
                 m_mutex{ },
                 m_cond{ },
                 m_stop{ false },
+                m_executorThreads{ },
+                m_readyCallbacks{ },
+                m_executorMutex{ },
+                m_executorCond{ },
+                m_executorStop{ false },
                 m_mt{ std::random_device{ }() },
                 m_dist{ }
         {
+            for (size_t i = 0; i < EXECUTOR_THREAD_COUNT; ++i)
+            {
+                m_executorThreads.emplace_back(&ExpiryTimerImpl::runCallbacks, this);
+            }
+
             m_thread = std::thread(&ExpiryTimerImpl::run, this);
         }
 
@@ -48,11 +75,24 @@ namespace OIC
         {
             {
                 std::lock_guard< std::mutex > lock{ m_mutex };
-                m_tasks.clear();
+                m_wheel.clear();
+                m_taskPositions.clear();
                 m_stop = true;
             }
             m_cond.notify_all();
             m_thread.join();
+
+            {
+                std::lock_guard< std::mutex > lock{ m_executorMutex };
+                m_readyCallbacks.clear();
+                m_executorStop = true;
+            }
+            m_executorCond.notify_all();
+
+            for (auto& thread : m_executorThreads)
+            {
+                thread.join();
+            }
         }
 
         ExpiryTimerImpl* ExpiryTimerImpl::getInstance()
@@ -73,7 +113,9 @@ namespace OIC
                 throw RCSInvalidParameterException{ "callback is empty." };
             }
 
-            return addTask(convertToTime(Milliseconds{ delay }), std::move(cb), generateId());
+            // the current tick is rounded down, so one more tick keeps a callback from
+            // being invoked before the delay passes.
+            return addTask(getCurrentTick() + delay + 1, std::move(cb));
         }
 
         bool ExpiryTimerImpl::cancel(Id id)
@@ -85,15 +127,7 @@ namespace OIC
 
             std::lock_guard< std::mutex > lock{ m_mutex };
 
-            for(auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
-            {
-                if(it->second->getId() == id)
-                {
-                    m_tasks.erase(it);
-                    return true;
-                }
-            }
-            return false;
+            return removeTask(id);
         }
 
         size_t ExpiryTimerImpl::cancelAll(
@@ -102,57 +136,65 @@ namespace OIC
             std::lock_guard< std::mutex > lock{ m_mutex };
             size_t erased { 0 };
 
-            for(auto it = m_tasks.begin(); it != m_tasks.end();)
+            for (const auto& task : tasks)
             {
-                if(tasks.count(it->second))
+                if (task && removeTask(task->getId()))
                 {
-                    it = m_tasks.erase(it);
                     ++erased;
                 }
-                else
-                {
-                    ++it;
-                }
             }
             return erased;
         }
 
-        ExpiryTimerImpl::Milliseconds ExpiryTimerImpl::convertToTime(Milliseconds delay)
+        size_t ExpiryTimerImpl::getNumOfPending()
         {
-            const auto now = std::chrono::system_clock::now();
-            return std::chrono::duration_cast< Milliseconds >(now.time_since_epoch()) + delay;
+            std::lock_guard< std::mutex > lock{ m_mutex };
+
+            return m_taskPositions.size();
         }
 
-        std::shared_ptr< TimerTask > ExpiryTimerImpl::addTask(
-                Milliseconds delay, Callback cb, Id id)
+        ExpiryTimerImpl::Tick ExpiryTimerImpl::getCurrentTick() const
+        {
+            return std::chrono::duration_cast< Milliseconds >(Clock::now() - m_startTime).count();
+        }
+
+        std::shared_ptr< TimerTask > ExpiryTimerImpl::addTask(Tick expiredTick, Callback cb)
         {
             std::lock_guard< std::mutex > lock{ m_mutex };
 
+            // the id is taken under the same lock, so no other post can take it meanwhile.
+            const Id id = generateId();
+
+            // ticks up to m_lastTick are already swept.
+            if (expiredTick <= m_lastTick)
+            {
+                expiredTick = m_lastTick + 1;
+            }
+
             auto newTask = std::make_shared< TimerTask >(id, std::move(cb));
-            m_tasks.insert({ delay, newTask });
-            m_cond.notify_all();
+
+            const size_t slot = toSlot(expiredTick);
+            m_wheel[slot].push_back({ expiredTick, newTask });
+            m_taskPositions[id] = { slot, std::prev(m_wheel[slot].end()) };
+
+            if (expiredTick < m_nextTick)
+            {
+                m_nextTick = expiredTick;
+                m_cond.notify_all();
+            }
 
             return newTask;
         }
 
         bool ExpiryTimerImpl::containsId(Id id) const
         {
-            for (const auto& info : m_tasks)
-            {
-                if (info.second->getId() == id)
-                {
-                    return true;
-                }
-            }
-            return false;
+            return m_taskPositions.find(id) != m_taskPositions.end();
         }
 
         ExpiryTimerImpl::Id ExpiryTimerImpl::generateId()
         {
             Id newId = m_dist(m_mt);
 
-            std::lock_guard< std::mutex > lock{ m_mutex };
-
             while (newId == INVALID_ID || containsId(newId))
             {
                 newId = m_dist(m_mt);
@@ -160,53 +202,147 @@ namespace OIC
             return newId;
         }
 
-        void ExpiryTimerImpl::executeExpired()
+        bool ExpiryTimerImpl::removeTask(Id id)
         {
-            if (m_tasks.empty())
+            auto it = m_taskPositions.find(id);
+
+            if (it == m_taskPositions.end())
+            {
+                return false;
+            }
+
+            m_wheel[it->second.slot].erase(it->second.entry);
+            m_taskPositions.erase(it);
+            return true;
+        }
+
+        void ExpiryTimerImpl::executeExpired(Tick now)
+        {
+            if (now <= m_lastTick)
             {
                 return;
             }
 
-            auto now = std::chrono::system_clock::now().time_since_epoch();
+            // a slot holds the ticks of every rotation, so one rotation covers all of them.
+            Tick tick = std::max(m_lastTick + 1, now - static_cast< Tick >(WHEEL_SIZE) + 1);
 
-            auto it = m_tasks.begin();
-            for (; it != m_tasks.end() && it->first <= now; ++it)
+            for (; tick <= now; ++tick)
             {
-                it->second->execute();
+                Slot& slot = m_wheel[toSlot(tick)];
+
+                for (auto it = slot.begin(); it != slot.end();)
+                {
+                    if (it->expiredTick > now)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    // dispatch() invalidates the id of the task.
+                    m_taskPositions.erase(it->task->getId());
+                    dispatch(it->task);
+                    it = slot.erase(it);
+                }
             }
 
-            m_tasks.erase(m_tasks.begin(), it);
+            m_lastTick = now;
         }
 
-        ExpiryTimerImpl::Milliseconds ExpiryTimerImpl::remainingTimeForNext() const
+        ExpiryTimerImpl::Tick ExpiryTimerImpl::findNextExpiredTick(Tick now) const
         {
-            const Milliseconds& expiredTime = m_tasks.begin()->first;
+            for (Tick tick = now + 1; tick <= now + static_cast< Tick >(WHEEL_SIZE); ++tick)
+            {
+                for (const auto& entry : m_wheel[toSlot(tick)])
+                {
+                    if (entry.expiredTick <= tick)
+                    {
+                        return tick;
+                    }
+                }
+            }
 
-            return std::chrono::duration_cast< Milliseconds >(expiredTime -
-                    std::chrono::system_clock::now().time_since_epoch()) + Milliseconds{ 1 };
+            // every task is further than one rotation.
+            Tick next = std::numeric_limits< Tick >::max();
+
+            for (const auto& slot : m_wheel)
+            {
+                for (const auto& entry : slot)
+                {
+                    next = std::min(next, entry.expiredTick);
+                }
+            }
+            return next;
         }
 
-        void ExpiryTimerImpl::run()
+        void ExpiryTimerImpl::dispatch(const std::shared_ptr< TimerTask >& task)
         {
-            auto hasTaskOrStop = [this]()
+            ExpiryTimerImpl::Id id { task->m_id };
+            task->m_id = INVALID_ID;
+
             {
-                return !m_tasks.empty() || m_stop;
-            };
+                std::lock_guard< std::mutex > lock{ m_executorMutex };
+                m_readyCallbacks.emplace_back(std::move(task->m_callback), id);
+            }
+            m_executorCond.notify_one();
 
+            task->m_callback = ExpiryTimerImpl::Callback{ };
+        }
+
+        void ExpiryTimerImpl::run()
+        {
             std::unique_lock< std::mutex > lock{ m_mutex };
 
             while(!m_stop)
             {
-                m_cond.wait(lock, hasTaskOrStop);
+                executeExpired(getCurrentTick());
+
+                if (m_taskPositions.empty())
+                {
+                    m_nextTick = std::numeric_limits< Tick >::max();
+                    m_cond.wait(lock, [this]()
+                    {
+                        return !m_taskPositions.empty() || m_stop;
+                    });
+                    continue;
+                }
+
+                m_nextTick = findNextExpiredTick(m_lastTick);
+                if (m_nextTick == std::numeric_limits< Tick >::max())
+                {
+                    // no deadline can be represented, so only a new task wakes the thread.
+                    m_cond.wait(lock);
+                    continue;
+                }
+                m_cond.wait_until(lock, m_startTime + Milliseconds{ m_nextTick });
+            }
+        }
+
+        void ExpiryTimerImpl::runCallbacks()
+        {
+            std::unique_lock< std::mutex > lock{ m_executorMutex };
+
+            while (true)
+            {
+                m_executorCond.wait(lock, [this]()
+                {
+                    return !m_readyCallbacks.empty() || m_executorStop;
+                });
 
-                if (m_stop)
+                if (m_executorStop)
                 {
                     break;
                 }
 
-                m_cond.wait_for(lock, remainingTimeForNext());
+                {
+                    auto ready = std::move(m_readyCallbacks.front());
+                    m_readyCallbacks.pop_front();
 
-                executeExpired();
+                    lock.unlock();
+                    ready.first(ready.second);
+
+                    // the callback is released unlocked, as it may own timers to cancel.
+                }
+                lock.lock();
             }
         }
 
@@ -217,21 +353,6 @@ namespace OIC
         {
         }
 
-        void TimerTask::execute()
-        {
-            if (isExecuted())
-            {
-                return;
-            }
-
-            ExpiryTimerImpl::Id id { m_id };
-            m_id = INVALID_ID;
-
-            std::thread(std::move(m_callback), id).detach();
-
-            m_callback = ExpiryTimerImpl::Callback{ };
-        }
-
         bool TimerTask::isExecuted() const
         {
             return m_id == INVALID_ID;
@@ -22,12 +22,15 @@
 #define _EXPIRY_TIMER_IMPL_H_
 
 #include <functional>
-#include <map>
+#include <list>
+#include <deque>
+#include <vector>
 #include <mutex>
 #include <thread>
 #include <chrono>
 #include <condition_variable>
 #include <random>
+#include <unordered_map>
 #include <unordered_set>
 #include <atomic>
 
@@ -39,6 +42,11 @@ namespace OIC
     {
         class TimerTask;
 
+        /**
+         * Tasks are kept in a hashed timer wheel of one millisecond ticks measured with a
+         * monotonic clock, so wall clock changes neither fire nor stall them.
+         * Expired callbacks are run by a fixed number of executor threads.
+         */
         class ExpiryTimerImpl
         {
         public:
@@ -48,7 +56,23 @@ namespace OIC
             typedef long long DelayInMillis;
 
         private:
+            typedef std::chrono::steady_clock Clock;
             typedef std::chrono::milliseconds Milliseconds;
+            typedef long long Tick;
+
+            struct SlotEntry
+            {
+                Tick expiredTick;
+                std::shared_ptr< TimerTask > task;
+            };
+
+            typedef std::list< SlotEntry > Slot;
+
+            struct TaskPosition
+            {
+                size_t slot;
+                Slot::iterator entry;
+            };
 
         private:
             ExpiryTimerImpl();
@@ -66,38 +90,66 @@ namespace OIC
             bool cancel(Id);
             /** This API is to cancel all */
             size_t cancelAll(const std::unordered_set< std::shared_ptr<TimerTask > >&);
+            /** This API is to get the number of tasks not expired yet */
+            size_t getNumOfPending();
 
         private:
-            static Milliseconds convertToTime(Milliseconds);
+            Tick getCurrentTick() const;
 
-            std::shared_ptr< TimerTask > addTask(Milliseconds, Callback, Id);
+            std::shared_ptr< TimerTask > addTask(Tick, Callback);
 
             /**
              * @pre The lock must be acquired with m_mutex.
              */
             bool containsId(Id) const;
+
+            /**
+             * @pre The lock must be acquired with m_mutex.
+             */
             Id generateId();
 
             /**
              * @pre The lock must be acquired with m_mutex.
              */
-            void executeExpired();
+            bool removeTask(Id);
 
             /**
              * @pre The lock must be acquired with m_mutex.
              */
-            Milliseconds remainingTimeForNext() const;
+            void executeExpired(Tick);
+
+            /**
+             * @pre The lock must be acquired with m_mutex.
+             */
+            Tick findNextExpiredTick(Tick) const;
+
+            /**
+             * @pre The lock must be acquired with m_mutex.
+             */
+            void dispatch(const std::shared_ptr< TimerTask >&);
 
             void run();
+            void runCallbacks();
 
         private:
-            std::multimap< Milliseconds, std::shared_ptr< TimerTask > > m_tasks;
+            const Clock::time_point m_startTime;
+
+            std::vector< Slot > m_wheel;
+            std::unordered_map< Id, TaskPosition > m_taskPositions;
+            Tick m_lastTick;
+            Tick m_nextTick;
 
             std::thread m_thread;
             std::mutex m_mutex;
             std::condition_variable m_cond;
             bool m_stop;
 
+            std::vector< std::thread > m_executorThreads;
+            std::deque< std::pair< Callback, Id > > m_readyCallbacks;
+            std::mutex m_executorMutex;
+            std::condition_variable m_executorCond;
+            bool m_executorStop;
+
             std::mt19937 m_mt;
             std::uniform_int_distribution< Id > m_dist;
 
@@ -119,9 +171,6 @@ namespace OIC
             /** API is to get Id */
             ExpiryTimerImpl::Id getId() const;
 
-        private:
-            void execute();
-
         private:
             std::atomic< ExpiryTimerImpl::Id > m_id;
             ExpiryTimerImpl::Callback m_callback;
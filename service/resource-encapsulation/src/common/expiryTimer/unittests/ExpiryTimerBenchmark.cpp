@@ -0,0 +1,189 @@
+//******************************************************************
+//
+// Copyright 2017 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+// Benchmark of ExpiryTimer.
+// Usage : rcs_expiry_timer_benchmark [number of timers]
+//
+// Measures post and cancel rate, how late callbacks run compared to their
+// expiry (jitter) while all timers are active, and the callback rate when
+// all timers expire at once.
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+
+#include "ExpiryTimer.h"
+
+using namespace OIC::Service;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    constexpr int DEFAULT_NUM_OF_TIMERS{ 10000 };
+    constexpr long long MAX_DELAY_IN_MILLIS{ 1000 };
+    constexpr long long BURST_DELAY_IN_MILLIS{ 100 };
+
+    class Completion
+    {
+    public:
+        Completion(int count) : m_remaining{ count } { }
+
+        void done()
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            if (--m_remaining == 0)
+            {
+                m_cond.notify_all();
+            }
+        }
+
+        bool wait(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock< std::mutex > lock{ m_mutex };
+            return m_cond.wait_for(lock, timeout, [this] { return m_remaining == 0; });
+        }
+
+    private:
+        int m_remaining;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+    };
+
+    double toMillis(Clock::duration duration)
+    {
+        return std::chrono::duration< double, std::milli >(duration).count();
+    }
+
+    void measurePostAndCancel(int numOfTimers)
+    {
+        ExpiryTimer timer;
+        std::vector< ExpiryTimer::Id > ids;
+        ids.reserve(numOfTimers);
+
+        auto start = Clock::now();
+        for (int i = 0; i < numOfTimers; ++i)
+        {
+            ids.push_back(timer.post(60 * 1000, [](ExpiryTimer::Id) { }));
+        }
+        auto posted = Clock::now();
+
+        for (auto id : ids)
+        {
+            timer.cancel(id);
+        }
+        auto cancelled = Clock::now();
+
+        std::cout << "post   : " << numOfTimers / toMillis(posted - start) * 1000
+                << " /s" << std::endl;
+        std::cout << "cancel : " << numOfTimers / toMillis(cancelled - posted) * 1000
+                << " /s" << std::endl;
+    }
+
+    void measureJitter(int numOfTimers)
+    {
+        ExpiryTimer timer;
+        Completion completion{ numOfTimers };
+        std::vector< double > lateness(numOfTimers);
+        std::mt19937 mt{ std::random_device{ }() };
+        std::uniform_int_distribution< long long > dist{ 1, MAX_DELAY_IN_MILLIS };
+
+        for (int i = 0; i < numOfTimers; ++i)
+        {
+            const long long delay = dist(mt);
+            const auto expiry = Clock::now() + std::chrono::milliseconds{ delay };
+
+            timer.post(delay, [i, expiry, &lateness, &completion](ExpiryTimer::Id)
+            {
+                lateness[i] = toMillis(Clock::now() - expiry);
+                completion.done();
+            });
+        }
+
+        if (!completion.wait(std::chrono::milliseconds{ MAX_DELAY_IN_MILLIS * 10 }))
+        {
+            std::cout << "jitter : timed out" << std::endl;
+            return;
+        }
+
+        std::sort(lateness.begin(), lateness.end());
+
+        double sum = 0;
+        for (auto value : lateness)
+        {
+            sum += value;
+        }
+
+        std::cout << "jitter : avg " << sum / numOfTimers << " ms, p50 "
+                << lateness[numOfTimers / 2] << " ms, p99 "
+                << lateness[numOfTimers * 99 / 100] << " ms, max "
+                << lateness.back() << " ms" << std::endl;
+    }
+
+    void measureBurst(int numOfTimers)
+    {
+        ExpiryTimer timer;
+        Completion completion{ numOfTimers };
+
+        const auto expiry = Clock::now() + std::chrono::milliseconds{ BURST_DELAY_IN_MILLIS };
+        for (int i = 0; i < numOfTimers; ++i)
+        {
+            timer.post(BURST_DELAY_IN_MILLIS, [&completion](ExpiryTimer::Id)
+            {
+                completion.done();
+            });
+        }
+
+        if (!completion.wait(std::chrono::milliseconds{ BURST_DELAY_IN_MILLIS * 100 }))
+        {
+            std::cout << "burst  : timed out" << std::endl;
+            return;
+        }
+
+        const auto elapsed = Clock::now() - expiry;
+        std::cout << "burst  : " << numOfTimers << " callbacks done "
+                << toMillis(elapsed) << " ms after expiry, "
+                << numOfTimers / std::max(toMillis(elapsed), 1.0) * 1000 << " /s" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int numOfTimers = argc > 1 ? std::atoi(argv[1]) : DEFAULT_NUM_OF_TIMERS;
+
+    if (numOfTimers <= 0)
+    {
+        std::cout << "Usage : " << argv[0] << " [number of timers]" << std::endl;
+        return -1;
+    }
+
+    std::cout << "timers : " << numOfTimers << std::endl;
+
+    measurePostAndCancel(numOfTimers);
+    measureJitter(numOfTimers);
+    measureBurst(numOfTimers);
+
+    return 0;
+}
@@ -22,6 +22,7 @@
 
 #include <mutex>
 #include <atomic>
+#include <ctime>
 
 #include "RCSException.h"
 #include "ExpiryTimer.h"
@@ -186,6 +187,30 @@ TEST_F(ExpiryTimerImplTest, CallbackBeInvokedWithinToleranceWithMultiplePost)
     ASSERT_EQ(NUM_OF_POST, called);
 }
 
+TEST_F(ExpiryTimerImplTest, ExecutedTaskIsRemovedAndTimerThreadIdles)
+{
+    FunctionObject* functor = mocks.Mock< FunctionObject >();
+
+    mocks.ExpectCall(functor, FunctionObject::execute).Do(
+        [this](ExpiryTimerImpl::Id)
+        {
+            Proceed();
+        }
+    );
+
+    ExpiryTimerImpl::getInstance()->post(1,
+            std::bind(&FunctionObject::execute, functor, std::placeholders::_1));
+    Wait();
+
+    ASSERT_EQ(0U, ExpiryTimerImpl::getInstance()->getNumOfPending());
+
+    const std::clock_t cpuStart = std::clock();
+    Wait(200);
+    const std::clock_t cpuUsedInMillis = (std::clock() - cpuStart) * 1000 / CLOCKS_PER_SEC;
+
+    ASSERT_LT(cpuUsedInMillis, 100);
+}
+
 class ExpiryTimerTest: public TestWithMock
 {
 public:
@@ -43,6 +43,7 @@ namespace OIC
 #define CACHE_TAG  "CACHE"   /*!< cache tag information */
 #define CACHE_DEFAULT_REPORT_MILLITIME 10000 /*!< default report time */
 #define CACHE_DEFAULT_EXPIRED_MILLITIME 15000 /*!< default expired time */
+#define CACHE_POLLING_JITTER_MILLITIME 1000 /*!< maximum deviation of a polling time */
 
         /** enum for report frequency value */
         enum class REPORT_FREQUENCY
@@ -97,6 +98,7 @@ namespace OIC
         typedef PrimitiveResource::ObserveCallback ObserveCB;
 
         typedef std::shared_ptr<DataCache> DataCachePtr;
+        typedef std::shared_ptr<const RCSResourceAttributes> CachedDataPtr;
         typedef std::shared_ptr<PrimitiveResource> PrimitiveResourcePtr;
     } /* namespace Service */
 } /* namespace OIC */
@@ -60,6 +60,8 @@ namespace OIC
                 CACHE_STATE getCacheState() const;
                 /// This method is for get the cache data
                 const RCSResourceAttributes getCachedData() const;
+                /// This method is for get the cache data without copying it
+                CachedDataPtr getCachedDataSnapshot() const;
                 /// This method is for get the primitive resource
                 const PrimitiveResourcePtr getPrimitiveResource() const;
                 /// This method is for get request
@@ -68,16 +70,23 @@ namespace OIC
                 bool isEmptySubscriber() const;
                 /// This method is for check cache data is empty or not
                 bool isCachedData() const;
+                /// This method is for get the number of polling requests waiting to be sent
+                size_t getNumOfPendingPolling() const;
 
             private:
                 // resource instance
                 PrimitiveResourcePtr sResource;
 
                 // cached data info
-                RCSResourceAttributes attributes;
+                // replaced as a whole on update, never modified in place
+                CachedDataPtr attributes;
                 CACHE_STATE state;
                 CACHE_MODE mode;
                 bool isReady;
+                // observation is registered, so the resource is not polled
+                bool isObserving;
+                // a get request is sent to check that an observed resource is alive
+                bool isRevalidating;
 
                 // subscriber info
                 std::unique_ptr<SubscriberInfo> subscriberList;
@@ -100,13 +109,15 @@ namespace OIC
                 void onObserve(const HeaderOptions &_hos,
                                const ResponseStatement &_rep, int _result, unsigned int _seq);
                 void onGet(const HeaderOptions &_hos, const ResponseStatement &_rep, int _result);
-            private:
                 void onTimeOut(const unsigned int timerID);
                 void onPollingOut(const unsigned int timerID);
+            private:
+                void postPolling();
+                void restartNetworkTimer();
 
                 CacheID generateCacheID();
                 SubscriberInfoPair findSubscriber(CacheID id);
-                void notifyObservers(const RCSResourceAttributes Att, int eCode);
+                void notifyObservers(RCSResourceAttributes Att, int eCode);
         };
     } /* namespace Service */
 } /* namespace OIC */
@@ -101,6 +101,14 @@ namespace OIC
                  */
                 RCSResourceAttributes getCachedData() const;
 
+                /**
+                 * Gets cached data without copying it.
+                 * The returned data is never modified; it is replaced on update.
+                 *
+                 * @return cached resource attributes.
+                 */
+                CachedDataPtr getCachedDataSnapshot() const;
+
                 /**
                  * Checks whether cached data is available.
                  *
@@ -124,7 +132,8 @@ namespace OIC
                 weakPrimitiveResource m_wpResource;
 
                 // cached data info
-                RCSResourceAttributes m_attributes;
+                CachedDataPtr m_attributes;
+                mutable std::mutex m_attributesMutex;
                 CACHE_STATE m_state;
 
                 DataCacheCB m_reportCB;
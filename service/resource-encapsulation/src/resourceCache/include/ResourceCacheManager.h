@@ -27,10 +27,11 @@
 #ifndef RCM_RESOURCECACHEMANAGER_H_
 #define RCM_RESOURCECACHEMANAGER_H_
 
-#include <list>
+#include <array>
 #include <string>
 #include <mutex>
-#include <map>
+#include <unordered_map>
+#include <utility>
 
 #include "CacheTypes.h"
 #include "DataCache.h"
@@ -137,6 +138,21 @@ namespace OIC
                  */
                 const RCSResourceAttributes getCachedData(CacheID id) const;
 
+                /**
+                 * Gets cached resource data [attributes] for the given cache id without
+                 * copying it. The returned data is shared and never modified; the cache
+                 * replaces it when the resource is updated.
+                 *
+                 * @param id Cache Id.
+                 *
+                 * @throw InvalidParameterException In case of invalid Cache id.
+                 * @throw HasNoCachedDataException In case of no cached data.
+                 *
+                 * @see getCachedData
+                 * @see CacheID
+                 */
+                CachedDataPtr getCachedDataSnapshot(CacheID id) const;
+
                 /**
                  * Gets cache state for the given cache id.
                  * This method will be called internally by RCSRemoteResourceObject.
@@ -173,14 +189,34 @@ namespace OIC
                 static void stopResourceCacheManager();
 
             private:
+                typedef std::pair<std::string, std::string> ResourceKey;
+
+                struct ResourceKeyHash
+                {
+                    size_t operator()(const ResourceKey &key) const;
+                };
+
+                /*
+                 * Cache ids are spread over the shards, so that lookups of
+                 * different caches do not wait for each other.
+                 */
+                struct CacheShard
+                {
+                    mutable std::mutex mutex;
+                    std::unordered_map<CacheID, DataCachePtr> cacheIDmap;
+                    std::unordered_map<CacheID, ObserveCache::Ptr> observeCacheIDmap;
+                };
+
+                static constexpr size_t CACHE_SHARD_COUNT = 16;
+
                 static ResourceCacheManager *s_instance;
-                static std::mutex s_mutex;
                 static std::mutex s_mutexForCreation;
-                static std::unique_ptr<std::list<DataCachePtr>> s_cacheDataList;
-                std::map<CacheID, DataCachePtr> cacheIDmap;
 
-                std::list<ObserveCache::Ptr> m_observeCacheList;
-                std::map<CacheID, ObserveCache::Ptr> observeCacheIDmap;
+                // guards m_dataCacheMap, taken before the lock of a shard.
+                std::mutex m_dataCacheMutex;
+                std::unordered_map<ResourceKey, DataCachePtr, ResourceKeyHash> m_dataCacheMap;
+
+                std::array<CacheShard, CACHE_SHARD_COUNT> m_shards;
 
                 ResourceCacheManager() = default;
                 ~ResourceCacheManager();
@@ -190,9 +226,16 @@ namespace OIC
                 ResourceCacheManager &operator=(const ResourceCacheManager &) const = delete;
                 ResourceCacheManager &operator=(ResourceCacheManager && ) const = delete;
 
-                static void initializeResourceCacheManager();
-                DataCachePtr findDataCache(PrimitiveResourcePtr pResource) const;
+                static ResourceKey getResourceKey(const PrimitiveResourcePtr &pResource);
+
+                CacheShard &getShard(CacheID id);
+                const CacheShard &getShard(CacheID id) const;
+
+                CacheID requestObserveCache(PrimitiveResourcePtr pResource, CacheCB func);
+                bool insertDataCacheID(CacheID id, const DataCachePtr &dataCache);
+
                 DataCachePtr findDataCache(CacheID id) const;
+                ObserveCache::Ptr findObserveCache(CacheID id) const;
         };
     } // namespace Service
 } // namespace OIC
@@ -40,6 +40,13 @@ namespace OIC
 
         namespace
         {
+            CachedDataPtr getEmptyCachedData()
+            {
+                static const CachedDataPtr emptyData
+                    = std::make_shared<const RCSResourceAttributes>();
+                return emptyData;
+            }
+
             void verifyObserveCB(
                 const HeaderOptions &_hos, const ResponseStatement &_rep,
                 int _result, unsigned int _seq, std::weak_ptr<DataCache> rpPtr)
@@ -75,6 +82,14 @@ namespace OIC
                                  std::placeholders::_1, std::placeholders::_2,
                                  std::placeholders::_3, rpPtr);
             }
+
+            // spreads the polling of caches created at the same time.
+            long long getJitteredPollingTime()
+            {
+                const long long range = 2 * CACHE_POLLING_JITTER_MILLITIME + 1;
+                return CACHE_DEFAULT_REPORT_MILLITIME - CACHE_POLLING_JITTER_MILLITIME
+                       + static_cast<long long>(OCGetRandom() % range);
+            }
         }
 
         DataCache::DataCache()
@@ -82,6 +97,7 @@ namespace OIC
             subscriberList = std::unique_ptr<SubscriberInfo>(new SubscriberInfo());
 
             sResource = nullptr;
+            attributes = getEmptyCachedData();
 
             state = CACHE_STATE::READY_YET;
             mode = CACHE_MODE::FREQUENCY;
@@ -90,6 +106,8 @@ namespace OIC
             pollingHandle = 0;
             lastSequenceNum = 0;
             isReady = false;
+            isObserving = false;
+            isRevalidating = false;
         }
 
         DataCache::~DataCache()
@@ -127,6 +145,7 @@ namespace OIC
             if (sResource->isObservable())
             {
                 sResource->requestObserve(pObserveCB);
+                isObserving = true;
             }
             networkTimeOutHandle = networkTimer.post(CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
         }
@@ -190,11 +209,16 @@ namespace OIC
         }
 
         const RCSResourceAttributes DataCache::getCachedData() const
+        {
+            return *getCachedDataSnapshot();
+        }
+
+        CachedDataPtr DataCache::getCachedDataSnapshot() const
         {
             std::lock_guard<std::mutex> lock(att_mutex);
             if (state != CACHE_STATE::READY)
             {
-                return RCSResourceAttributes();
+                return getEmptyCachedData();
             }
             return attributes;
         }
@@ -204,6 +228,11 @@ namespace OIC
             return isReady;
         }
 
+        size_t DataCache::getNumOfPendingPolling() const
+        {
+            return pollingTimer.getNumOfPending();
+        }
+
         void DataCache::onObserve(const HeaderOptions & /*_hos*/,
                                   const ResponseStatement &_rep, int _result, unsigned int _seq)
         {
@@ -221,8 +250,8 @@ namespace OIC
                 mode = CACHE_MODE::OBSERVE;
             }
 
-            networkTimer.cancel(networkTimeOutHandle);
-            networkTimeOutHandle = networkTimer.post(CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
+            isRevalidating = false;
+            restartNetworkTimer();
 
             notifyObservers(_rep.getAttributes(), _result);
         }
@@ -241,27 +270,30 @@ namespace OIC
                 isReady = true;
             }
 
-            if (mode != CACHE_MODE::OBSERVE)
-            {
-                networkTimer.cancel(networkTimeOutHandle);
-                networkTimeOutHandle = networkTimer.post(
-                                           CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
+            isRevalidating = false;
+            restartNetworkTimer();
 
-                pollingHandle = pollingTimer.post(CACHE_DEFAULT_REPORT_MILLITIME, pPollingCB);
+            // an observed resource reports its changes, so it is polled only
+            // when the observation is lost.
+            if (!isObserving)
+            {
+                postPolling();
             }
 
             notifyObservers(_rep.getAttributes(), _result);
         }
 
-        void DataCache::notifyObservers(const RCSResourceAttributes Att, int eCode)
+        void DataCache::notifyObservers(RCSResourceAttributes Att, int eCode)
         {
+            CachedDataPtr newData;
             {
                 std::lock_guard<std::mutex> lock(att_mutex);
-                if (attributes == Att)
+                if (*attributes == Att)
                 {
                     return;
                 }
-                attributes = Att;
+                newData = std::make_shared<const RCSResourceAttributes>(std::move(Att));
+                attributes = newData;
             }
 
             std::lock_guard<std::mutex> lock(m_mutex);
@@ -269,7 +301,7 @@ namespace OIC
             {
                 if (i.second.first.rf == REPORT_FREQUENCY::UPTODATE)
                 {
-                    i.second.second(this->sResource, Att, eCode);
+                    i.second.second(this->sResource, *newData, eCode);
                 }
             }
         }
@@ -281,31 +313,53 @@ namespace OIC
 
         void DataCache::onTimeOut(unsigned int /*timerID*/)
         {
-            if (mode == CACHE_MODE::OBSERVE)
+            if (isObserving && !isRevalidating)
+            {
+                // an unchanged resource sends no notification, so a get request
+                // checks that it is still alive before the observation is given up.
+                isRevalidating = true;
+                restartNetworkTimer();
+                sResource->requestGet(pGetCB);
+                return;
+            }
+
+            if (isObserving)
             {
                 sResource->cancelObserve();
+                isObserving = false;
+                isRevalidating = false;
                 mode = CACHE_MODE::FREQUENCY;
 
-                networkTimer.cancel(networkTimeOutHandle);
-                networkTimeOutHandle = networkTimer.post(
-                                           CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
-
-                pollingHandle = pollingTimer.post(CACHE_DEFAULT_REPORT_MILLITIME, pPollingCB);
+                restartNetworkTimer();
+                postPolling();
                 return;
             }
 
             state = CACHE_STATE::LOST_SIGNAL;
         }
+
         void DataCache::onPollingOut(const unsigned int /*timerID*/)
         {
             if (sResource != nullptr)
             {
-                mode = CACHE_MODE::FREQUENCY;
                 sResource->requestGet(pGetCB);
             }
             return;
         }
 
+        void DataCache::postPolling()
+        {
+            // a response to requestGet() must not start another series of polling.
+            pollingTimer.cancel(pollingHandle);
+            pollingHandle = pollingTimer.post(getJitteredPollingTime(), pPollingCB);
+        }
+
+        void DataCache::restartNetworkTimer()
+        {
+            networkTimer.cancel(networkTimeOutHandle);
+            networkTimeOutHandle = networkTimer.post(CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
+        }
+
         CacheID DataCache::generateCacheID()
         {
             CacheID retID = 0;
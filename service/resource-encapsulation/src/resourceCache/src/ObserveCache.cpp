@@ -26,7 +26,9 @@ namespace OIC
     namespace Service
     {
         ObserveCache::ObserveCache(std::weak_ptr<PrimitiveResource> pResource)
-        : m_wpResource(pResource), m_attributes(), m_state(CACHE_STATE::NONE),
+        : m_wpResource(pResource),
+          m_attributes(std::make_shared<const RCSResourceAttributes>()),
+          m_attributesMutex(), m_state(CACHE_STATE::NONE),
           m_reportCB(), m_isStart(false), m_id(0)
         {
         }
@@ -86,12 +88,18 @@ namespace OIC
 
         RCSResourceAttributes ObserveCache::getCachedData() const
         {
+            return *getCachedDataSnapshot();
+        }
+
+        CachedDataPtr ObserveCache::getCachedDataSnapshot() const
+        {
+            std::lock_guard<std::mutex> lock(m_attributesMutex);
             return m_attributes;
         }
 
         bool ObserveCache::isCachedData() const
         {
-            return !m_attributes.empty();
+            return !getCachedDataSnapshot()->empty();
         }
 
         bool ObserveCache::isStartCache() const
@@ -104,7 +112,7 @@ namespace OIC
         {
             m_state = CACHE_STATE::READY;
 
-            if (m_attributes == rep.getAttributes() &&
+            if (*getCachedDataSnapshot() == rep.getAttributes() &&
                     convertOCResultToSuccess((OCStackResult)_result))
             {
                 return ;
@@ -112,8 +120,12 @@ namespace OIC
 
             if (m_reportCB)
             {
-                m_attributes = rep.getAttributes();
-                m_reportCB(m_wpResource.lock(), m_attributes, _result);
+                auto newData = std::make_shared<const RCSResourceAttributes>(rep.getAttributes());
+                {
+                    std::lock_guard<std::mutex> lock(m_attributesMutex);
+                    m_attributes = newData;
+                }
+                m_reportCB(m_wpResource.lock(), *newData, _result);
             }
         }
 
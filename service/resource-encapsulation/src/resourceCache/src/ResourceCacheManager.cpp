@@ -28,8 +28,13 @@ namespace OIC
     {
         ResourceCacheManager *ResourceCacheManager::s_instance = nullptr;
         std::mutex ResourceCacheManager::s_mutexForCreation;
-        std::mutex ResourceCacheManager::s_mutex;
-        std::unique_ptr<std::list<DataCachePtr>> ResourceCacheManager::s_cacheDataList(nullptr);
+        constexpr size_t ResourceCacheManager::CACHE_SHARD_COUNT;
+
+        size_t ResourceCacheManager::ResourceKeyHash::operator()(const ResourceKey &key) const
+        {
+            return std::hash<std::string>()(key.first) * 31
+                   + std::hash<std::string>()(key.second);
+        }
 
         void ResourceCacheManager::stopResourceCacheManager()
         {
@@ -39,12 +44,8 @@ namespace OIC
 
         ResourceCacheManager::~ResourceCacheManager()
         {
-            std::lock_guard<std::mutex> lock(s_mutex);
-            if (s_cacheDataList != nullptr)
-            {
-                s_cacheDataList->clear();
-                s_cacheDataList.reset();
-            }
+            std::lock_guard<std::mutex> lock(m_dataCacheMutex);
+            m_dataCacheMap.clear();
         }
 
         ResourceCacheManager *ResourceCacheManager::getInstance()
@@ -55,7 +56,6 @@ namespace OIC
                 if (s_instance == nullptr)
                 {
                     s_instance = new ResourceCacheManager();
-                    s_instance->initializeResourceCacheManager();
                 }
                 s_mutexForCreation.unlock();
             }
@@ -71,8 +71,6 @@ namespace OIC
                 throw RCSInvalidParameterException {"[requestResourceCache] Primitive Resource is invaild"};
             }
 
-            CacheID retID = 0;
-
             if (cm == CACHE_METHOD::OBSERVE_ONLY)
             {
                 if (func == nullptr)
@@ -80,19 +78,7 @@ namespace OIC
                     throw RCSInvalidParameterException {"[requestResourceCache] CacheCB is invaild"};
                 }
 
-                std::lock_guard<std::mutex> lock(s_mutex);
-                retID = OCGetRandom();
-                while(observeCacheIDmap.find(retID) != observeCacheIDmap.end())
-                {
-                    retID = OCGetRandom();
-                }
-
-                auto newHandler = std::make_shared<ObserveCache>(pResource);
-                newHandler->startCache(std::move(func));
-                m_observeCacheList.push_back(newHandler);
-
-                observeCacheIDmap.insert(std::make_pair(retID, newHandler));
-                return retID;
+                return requestObserveCache(pResource, std::move(func));
             }
 
             if (rf != REPORT_FREQUENCY::NONE)
@@ -108,60 +94,85 @@ namespace OIC
                 }
             }
 
-            DataCachePtr newHandler = findDataCache(pResource);
-            if (newHandler == nullptr)
+            std::lock_guard<std::mutex> lock(m_dataCacheMutex);
+
+            ResourceKey key = getResourceKey(pResource);
+            DataCachePtr newHandler;
+
+            auto found = m_dataCacheMap.find(key);
+            if (found == m_dataCacheMap.end())
             {
-                std::lock_guard<std::mutex> lock(s_mutex);
                 newHandler.reset(new DataCache());
                 newHandler->initializeDataCache(pResource);
-                s_cacheDataList->push_back(newHandler);
+                m_dataCacheMap.insert(std::make_pair(std::move(key), newHandler));
+            }
+            else
+            {
+                newHandler = found->second;
             }
-            retID = newHandler->addSubscriber(func, rf, reportTime);
 
-            cacheIDmap.insert(std::make_pair(retID, newHandler));
+            CacheID retID = newHandler->addSubscriber(func, rf, reportTime);
+
+            // subscriber ids are unique only in their data cache.
+            while (!insertDataCacheID(retID, newHandler))
+            {
+                CacheID usedID = retID;
+                retID = newHandler->addSubscriber(func, rf, reportTime);
+                newHandler->deleteSubscriber(usedID);
+            }
 
             return retID;
         }
 
         void ResourceCacheManager::cancelResourceCache(CacheID id)
         {
-            auto observeIns = observeCacheIDmap.find(id);
-            auto dataCacheIns = cacheIDmap.find(id);
-            if ((dataCacheIns == cacheIDmap.end() && observeIns == observeCacheIDmap.end())
-                || id == 0)
+            if (id == 0)
             {
                 throw RCSInvalidParameterException {"[cancelResourceCache] CacheID is invaild"};
             }
 
-            if (observeIns != observeCacheIDmap.end())
+            ObserveCache::Ptr observeCache;
+            DataCachePtr dataCache;
             {
-                try
+                CacheShard &shard = getShard(id);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                auto observeIns = shard.observeCacheIDmap.find(id);
+                if (observeIns != shard.observeCacheIDmap.end())
                 {
-                    (observeIns->second)->stopCache();
+                    observeCache = std::move(observeIns->second);
+                    shard.observeCacheIDmap.erase(observeIns);
                 }
-                catch (...)
+                else
                 {
-                    (observeIns->second).reset();
-                    observeCacheIDmap.erase(observeIns);
-                    throw;
+                    auto dataCacheIns = shard.cacheIDmap.find(id);
+                    if (dataCacheIns != shard.cacheIDmap.end())
+                    {
+                        dataCache = std::move(dataCacheIns->second);
+                        shard.cacheIDmap.erase(dataCacheIns);
+                    }
                 }
-                (observeIns->second).reset();
-                observeCacheIDmap.erase(observeIns);
+            }
+
+            if (observeCache != nullptr)
+            {
+                observeCache->stopCache();
                 return;
             }
 
-            DataCachePtr foundCacheHandler = findDataCache(id);
-            if (foundCacheHandler != nullptr)
+            if (dataCache == nullptr)
             {
-                CacheID retID = foundCacheHandler->deleteSubscriber(id);
-                if (retID == id)
-                {
-                    cacheIDmap.erase(id);
-                }
-                std::lock_guard<std::mutex> lock(s_mutex);
-                if (foundCacheHandler->isEmptySubscriber())
+                throw RCSInvalidParameterException {"[cancelResourceCache] CacheID is invaild"};
+            }
+
+            std::lock_guard<std::mutex> lock(m_dataCacheMutex);
+            dataCache->deleteSubscriber(id);
+            if (dataCache->isEmptySubscriber())
+            {
+                auto found = m_dataCacheMap.find(getResourceKey(dataCache->getPrimitiveResource()));
+                if (found != m_dataCacheMap.end() && found->second == dataCache)
                 {
-                    s_cacheDataList->remove(foundCacheHandler);
+                    m_dataCacheMap.erase(found);
                 }
             }
         }
@@ -182,16 +193,21 @@ namespace OIC
         }
 
         const RCSResourceAttributes ResourceCacheManager::getCachedData(CacheID id) const
+        {
+            return *getCachedDataSnapshot(id);
+        }
+
+        CachedDataPtr ResourceCacheManager::getCachedDataSnapshot(CacheID id) const
         {
             if (id == 0)
             {
                 throw RCSInvalidParameterException {"[getCachedData] CacheID is NULL"};
             }
 
-            auto observePtr = observeCacheIDmap.find(id);
-            if (observePtr != observeCacheIDmap.end())
+            ObserveCache::Ptr observeCache = findObserveCache(id);
+            if (observeCache != nullptr)
             {
-                return (observePtr->second)->getCachedData();
+                return observeCache->getCachedDataSnapshot();
             }
 
             DataCachePtr handler = findDataCache(id);
@@ -205,7 +221,7 @@ namespace OIC
                 throw HasNoCachedDataException {"[getCachedData] Cached Data is not stored"};
             }
 
-            return handler->getCachedData();
+            return handler->getCachedDataSnapshot();
         }
 
         CACHE_STATE ResourceCacheManager::getResourceCacheState(CacheID id) const
@@ -215,10 +231,10 @@ namespace OIC
                 throw RCSInvalidParameterException {"[getResourceCacheState] CacheID is NULL"};
             }
 
-            auto observePtr = observeCacheIDmap.find(id);
-            if (observePtr != observeCacheIDmap.end())
+            ObserveCache::Ptr observeCache = findObserveCache(id);
+            if (observeCache != nullptr)
             {
-                return (observePtr->second)->getCacheState();
+                return observeCache->getCacheState();
             }
 
             DataCachePtr handler = findDataCache(id);
@@ -236,10 +252,10 @@ namespace OIC
                 throw RCSInvalidParameterException {"[isCachedData] CacheID is NULL"};
             }
 
-            auto observePtr = observeCacheIDmap.find(id);
-            if (observePtr != observeCacheIDmap.end())
+            ObserveCache::Ptr observeCache = findObserveCache(id);
+            if (observeCache != nullptr)
             {
-                return (observePtr->second)->isCachedData();
+                return observeCache->isCachedData();
             }
 
             DataCachePtr handler = findDataCache(id);
@@ -250,45 +266,74 @@ namespace OIC
             return handler->isCachedData();
         }
 
-        void ResourceCacheManager::initializeResourceCacheManager()
+        ResourceCacheManager::ResourceKey ResourceCacheManager::getResourceKey(
+            const PrimitiveResourcePtr &pResource)
         {
-            std::lock_guard<std::mutex> lock(s_mutex);
-            if (s_cacheDataList == nullptr)
-            {
-                s_cacheDataList
-                    = std::unique_ptr<std::list<DataCachePtr>>(new std::list<DataCachePtr>);
-            }
+            return ResourceKey(pResource->getHost(), pResource->getUri());
+        }
+
+        ResourceCacheManager::CacheShard &ResourceCacheManager::getShard(CacheID id)
+        {
+            return m_shards[static_cast<unsigned int>(id) % CACHE_SHARD_COUNT];
+        }
+
+        const ResourceCacheManager::CacheShard &ResourceCacheManager::getShard(CacheID id) const
+        {
+            return m_shards[static_cast<unsigned int>(id) % CACHE_SHARD_COUNT];
         }
 
-        DataCachePtr ResourceCacheManager::findDataCache(PrimitiveResourcePtr pResource) const
+        CacheID ResourceCacheManager::requestObserveCache(
+            PrimitiveResourcePtr pResource, CacheCB func)
         {
-            DataCachePtr retHandler = nullptr;
-            std::lock_guard<std::mutex> lock(s_mutex);
-            for (auto &i : * s_cacheDataList)
+            auto newHandler = std::make_shared<ObserveCache>(pResource);
+            newHandler->startCache(std::move(func));
+
+            while (true)
             {
-                if (i->getPrimitiveResource()->getUri() == pResource->getUri() &&
-                    i->getPrimitiveResource()->getHost() == pResource->getHost())
+                CacheID retID = OCGetRandom();
+                if (retID == 0)
                 {
-                    retHandler = i;
-                    break;
+                    continue;
+                }
+
+                CacheShard &shard = getShard(retID);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (shard.cacheIDmap.find(retID) == shard.cacheIDmap.end() &&
+                    shard.observeCacheIDmap.insert(std::make_pair(retID, newHandler)).second)
+                {
+                    return retID;
                 }
             }
-            return retHandler;
         }
 
-        DataCachePtr ResourceCacheManager::findDataCache(CacheID id) const
+        bool ResourceCacheManager::insertDataCacheID(CacheID id, const DataCachePtr &dataCache)
         {
-            DataCachePtr retHandler = nullptr;
-            for (auto it : cacheIDmap)
+            CacheShard &shard = getShard(id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            if (shard.observeCacheIDmap.find(id) != shard.observeCacheIDmap.end())
             {
-                if (it.first == id)
-                {
-                    retHandler = it.second;
-                    break;
-                }
+                return false;
             }
+            return shard.cacheIDmap.insert(std::make_pair(id, dataCache)).second;
+        }
+
+        DataCachePtr ResourceCacheManager::findDataCache(CacheID id) const
+        {
+            const CacheShard &shard = getShard(id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto found = shard.cacheIDmap.find(id);
+            return found != shard.cacheIDmap.end() ? found->second : nullptr;
+        }
+
+        ObserveCache::Ptr ResourceCacheManager::findObserveCache(CacheID id) const
+        {
+            const CacheShard &shard = getShard(id);
+            std::lock_guard<std::mutex> lock(shard.mutex);
 
-            return retHandler;
+            auto found = shard.observeCacheIDmap.find(id);
+            return found != shard.observeCacheIDmap.end() ? found->second : nullptr;
         }
     } // namespace Service
 } // namespace OIC
@@ -267,6 +267,143 @@ TEST_F(DataCacheTest, isEmptySubscriber_normalCase)
     ASSERT_EQ(cacheHandler->isEmptySubscriber(), true);
 }
 
+namespace
+{
+    void respondWithAttributes(DataCacheTest::GetCallback callback)
+    {
+        OIC::Service::HeaderOptions hos;
+        OIC::Service::RCSResourceAttributes attr;
+        attr["power"] = "on";
+        OIC::Service::ResponseStatement rep(attr);
+        callback(hos, rep, OC_STACK_OK);
+    }
+}
+
+TEST_F(DataCacheTest, onTimeOut_revalidatesObservationWithGet)
+{
+    auto numOfGets = std::make_shared<int>(0);
+    auto numOfCancels = std::make_shared<int>(0);
+
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [numOfGets](GetCallback callback)
+    {
+        ++*numOfGets;
+        respondWithAttributes(callback);
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(true);
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestObserve);
+    mocks.OnCall(pResource.get(), PrimitiveResource::cancelObserve).Do(
+        [numOfCancels]()
+    {
+        ++*numOfCancels;
+    });
+
+    cacheHandler->initializeDataCache(pResource);
+    ASSERT_EQ(1, *numOfGets);
+
+    cacheHandler->onTimeOut(0);
+    cacheHandler->onTimeOut(0);
+
+    ASSERT_EQ(3, *numOfGets);
+    ASSERT_EQ(0, *numOfCancels);
+    ASSERT_EQ(CACHE_STATE::READY, cacheHandler->getCacheState());
+}
+
+TEST_F(DataCacheTest, onTimeOut_startsPollingIfRevalidationFails)
+{
+    auto numOfGets = std::make_shared<int>(0);
+    auto numOfCancels = std::make_shared<int>(0);
+
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [numOfGets](GetCallback)
+    {
+        ++*numOfGets;
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(true);
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestObserve);
+    mocks.OnCall(pResource.get(), PrimitiveResource::cancelObserve).Do(
+        [numOfCancels]()
+    {
+        ++*numOfCancels;
+    });
+
+    cacheHandler->initializeDataCache(pResource);
+
+    cacheHandler->onTimeOut(0);
+    ASSERT_EQ(2, *numOfGets);
+    ASSERT_EQ(0, *numOfCancels);
+    ASSERT_EQ(0u, cacheHandler->getNumOfPendingPolling());
+
+    cacheHandler->onTimeOut(0);
+    ASSERT_EQ(1, *numOfCancels);
+    ASSERT_EQ(1u, cacheHandler->getNumOfPendingPolling());
+}
+
+TEST_F(DataCacheTest, onGet_pollsNonObservableResource)
+{
+    auto numOfGets = std::make_shared<int>(0);
+
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [numOfGets](GetCallback callback)
+    {
+        ++*numOfGets;
+        respondWithAttributes(callback);
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(false);
+
+    cacheHandler->initializeDataCache(pResource);
+    ASSERT_EQ(1u, cacheHandler->getNumOfPendingPolling());
+
+    cacheHandler->onPollingOut(0);
+    ASSERT_EQ(2, *numOfGets);
+    ASSERT_EQ(1u, cacheHandler->getNumOfPendingPolling());
+}
+
+TEST_F(DataCacheTest, onGet_keepsOnePollingTimer)
+{
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [](GetCallback callback)
+    {
+        respondWithAttributes(callback);
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(false);
+
+    cacheHandler->initializeDataCache(pResource);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        cacheHandler->requestGet();
+        cacheHandler->onPollingOut(0);
+    }
+
+    ASSERT_EQ(1u, cacheHandler->getNumOfPendingPolling());
+}
+
+TEST_F(DataCacheTest, onGet_doesNotPollObservedResource)
+{
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [](GetCallback callback)
+    {
+        respondWithAttributes(callback);
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(true);
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestObserve).Do(
+        [](ObserveCallback callback)
+    {
+        OIC::Service::HeaderOptions hos;
+        OIC::Service::RCSResourceAttributes attr;
+        attr["power"] = "off";
+        OIC::Service::ResponseStatement rep(attr);
+        callback(hos, rep, OC_STACK_OK, 1);
+    });
+    mocks.OnCall(pResource.get(), PrimitiveResource::cancelObserve);
+
+    cacheHandler->initializeDataCache(pResource);
+    cacheHandler->requestGet();
+
+    ASSERT_EQ(0u, cacheHandler->getNumOfPendingPolling());
+}
+
 TEST_F(DataCacheTest, requestGet_normalCasetest)
 {
 
@@ -51,6 +51,8 @@ class ResourceCacheManagerTest : public TestWithMock
                 pResource = PrimitiveResource::Ptr(mocks.Mock< PrimitiveResource >(), deleter);
             });
             mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(false);
+            mocks.OnCall(pResource.get(), PrimitiveResource::getUri).Return("testUri");
+            mocks.OnCall(pResource.get(), PrimitiveResource::getHost).Return("testHost");
             cb = ([](std::shared_ptr<PrimitiveResource >,
                     const RCSResourceAttributes &, int) -> OCStackResult
                     {
@@ -203,6 +205,43 @@ TEST_F(ResourceCacheManagerTest, getCachedDataCachID_handlerIsNULL)
     ASSERT_THROW(cacheInstance->getCachedData(id), RCSInvalidParameterException);
 }
 
+TEST_F(ResourceCacheManagerTest, getCachedDataSnapshotCachID_cacheIDIsZero)
+{
+
+    ASSERT_THROW(cacheInstance->getCachedDataSnapshot(0), RCSInvalidParameterException);
+}
+
+TEST_F(ResourceCacheManagerTest, getCachedDataSnapshotCachID_handlerIsNULL)
+{
+
+    id = 1;
+    ASSERT_THROW(cacheInstance->getCachedDataSnapshot(id), RCSInvalidParameterException);
+}
+
+TEST_F(ResourceCacheManagerTest, requestResourceCache_sameResourceSharesCache)
+{
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet);
+    mocks.OnCall(pResource.get(), PrimitiveResource::isObservable).Return(true);
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestObserve);
+    mocks.OnCall(pResource.get(), PrimitiveResource::cancelObserve);
+
+    CacheCB func = cb;
+    REPORT_FREQUENCY rf = REPORT_FREQUENCY::UPTODATE;
+    CACHE_METHOD cm = CACHE_METHOD::ITERATED_GET;
+    long reportTime = 20l;
+
+    id = cacheInstance->requestResourceCache(pResource, func, cm, rf, reportTime);
+    CacheID otherId = cacheInstance->requestResourceCache(pResource, func, cm, rf, reportTime);
+
+    cacheInstance->cancelResourceCache(id);
+    CACHE_STATE state = cacheInstance->getResourceCacheState(otherId);
+    cacheInstance->cancelResourceCache(otherId);
+
+    ASSERT_NE(id, otherId);
+    ASSERT_EQ(state, CACHE_STATE::READY_YET);
+    ASSERT_EQ(cacheInstance->getResourceCacheState(otherId), CACHE_STATE::NONE);
+}
+
 TEST_F(ResourceCacheManagerTest, getResourceCacheStateCacheID_cacheIDIsZero)
 {
 
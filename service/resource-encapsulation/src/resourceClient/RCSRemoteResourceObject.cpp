@@ -396,7 +396,17 @@ namespace OIC
         {
             SCOPE_LOG_F(DEBUG, TAG);
 
-            return getCachedAttributes().at(key);
+            if (!isCaching())
+            {
+                throw RCSBadRequestException{ "Caching not started." };
+            }
+
+            if (!isCachedAvailable())
+            {
+                throw RCSBadRequestException{ "Cache data is not available." };
+            }
+
+            return ResourceCacheManager::getInstance()->getCachedDataSnapshot(m_cacheId)->at(key);
         }
 
         std::string RCSRemoteResourceObject::getUri() const
@@ -0,0 +1,127 @@
+/******************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef SERVERBUILDER_NOTIFICATIONCOALESCER_H
+#define SERVERBUILDER_NOTIFICATIONCOALESCER_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "ExpiryTimer.h"
+
+/** OIC namespace */
+namespace OIC
+{
+    /** service namespace */
+    namespace Service
+    {
+
+        /**
+         * Rate control of the notifications of a resource, following the CoRE
+         * pmin/pmax semantics.
+         *
+         * Changes reported within the minimum period from the last notification are
+         * merged into one notification sent when the period ends. When the maximum
+         * period is set, observers are notified at least once every maximum period.
+         *
+         * The notifier is never invoked with the internal lock held, since notifying
+         * observers calls the entity handler of the resource back.
+         */
+        class NotificationCoalescer:
+                public std::enable_shared_from_this< NotificationCoalescer >
+        {
+        public:
+            typedef std::shared_ptr< NotificationCoalescer > Ptr;
+            typedef std::function< void() > Notifier;
+            typedef ExpiryTimer::DelayInMilliSec DelayInMilliSec;
+
+        public:
+            NotificationCoalescer(Notifier notifier);
+            ~NotificationCoalescer();
+
+            NotificationCoalescer(const NotificationCoalescer&) = delete;
+            NotificationCoalescer& operator=(const NotificationCoalescer&) = delete;
+
+            /**
+             * Enables or disables the rate control. A merged notification left
+             * when it is disabled is sent at once.
+             */
+            void setEnabled(bool enabled);
+
+            void setPeriods(DelayInMilliSec minPeriod, DelayInMilliSec maxPeriod);
+
+            /**
+             * Reports a change.
+             *
+             * @return true if the change must be notified now, false if it is merged
+             *         into a later notification.
+             */
+            bool requestNotify();
+
+            /**
+             * Notifies observers at once, including merged changes.
+             */
+            void notify();
+
+            bool hasPendingNotification() const;
+
+            unsigned long long getSuppressedCount() const;
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            void onNotified();
+
+            void onMinPeriodExpired(ExpiryTimer::Id);
+            void onMaxPeriodExpired(ExpiryTimer::Id);
+
+            void notifyFromTimer();
+
+            void cancelTimer(ExpiryTimer::Id&);
+            void postMaxPeriodTimer();
+
+            ExpiryTimer::Callback createTimerCallback(
+                    void (NotificationCoalescer::*)(ExpiryTimer::Id));
+
+        private:
+            const Notifier m_notifier;
+
+            bool m_isEnabled;
+            DelayInMilliSec m_minPeriod;
+            DelayInMilliSec m_maxPeriod;
+
+            bool m_hasNotified;
+            Clock::time_point m_lastNotified;
+
+            bool m_isPending;
+            unsigned long long m_suppressedCount;
+
+            ExpiryTimer m_timer;
+            ExpiryTimer::Id m_minTimerId;
+            ExpiryTimer::Id m_maxTimerId;
+
+            mutable std::mutex m_mutex;
+        };
+    }
+}
+
+#endif // SERVERBUILDER_NOTIFICATIONCOALESCER_H
@@ -0,0 +1,252 @@
+/******************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "NotificationCoalescer.h"
+
+#include "RCSException.h"
+
+#include "experimental/logger.h"
+
+#define LOG_TAG "NotificationCoalescer"
+
+namespace OIC
+{
+    namespace Service
+    {
+
+        namespace
+        {
+            constexpr ExpiryTimer::Id INVALID_TIMER_ID{ 0U };
+        }
+
+        NotificationCoalescer::NotificationCoalescer(Notifier notifier) :
+                m_notifier{ std::move(notifier) },
+                m_isEnabled{ false },
+                m_minPeriod{ 0 },
+                m_maxPeriod{ 0 },
+                m_hasNotified{ false },
+                m_lastNotified{ },
+                m_isPending{ false },
+                m_suppressedCount{ 0 },
+                m_timer{ },
+                m_minTimerId{ INVALID_TIMER_ID },
+                m_maxTimerId{ INVALID_TIMER_ID },
+                m_mutex{ }
+        {
+        }
+
+        NotificationCoalescer::~NotificationCoalescer()
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            m_timer.cancelAll();
+        }
+
+        void NotificationCoalescer::setEnabled(bool enabled)
+        {
+            bool needToNotify = false;
+            {
+                std::lock_guard< std::mutex > lock{ m_mutex };
+
+                if (m_isEnabled == enabled)
+                {
+                    return;
+                }
+
+                m_isEnabled = enabled;
+
+                if (enabled)
+                {
+                    postMaxPeriodTimer();
+                    return;
+                }
+
+                cancelTimer(m_minTimerId);
+                cancelTimer(m_maxTimerId);
+                needToNotify = m_isPending;
+            }
+
+            if (needToNotify)
+            {
+                notify();
+            }
+        }
+
+        void NotificationCoalescer::setPeriods(DelayInMilliSec minPeriod,
+                DelayInMilliSec maxPeriod)
+        {
+            if (minPeriod < 0 || maxPeriod < 0 || (maxPeriod != 0 && maxPeriod < minPeriod))
+            {
+                throw RCSInvalidParameterException{ "Invalid notification periods!" };
+            }
+
+            std::lock_guard< std::mutex > lock{ m_mutex };
+
+            m_minPeriod = minPeriod;
+            m_maxPeriod = maxPeriod;
+
+            if (m_isEnabled)
+            {
+                postMaxPeriodTimer();
+            }
+        }
+
+        bool NotificationCoalescer::requestNotify()
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+
+            const auto elapsed = Clock::now() - m_lastNotified;
+            const std::chrono::milliseconds minPeriod{ m_minPeriod };
+
+            if (!m_isEnabled || !m_hasNotified || elapsed >= minPeriod)
+            {
+                return true;
+            }
+
+            ++m_suppressedCount;
+
+            if (!m_isPending)
+            {
+                m_isPending = true;
+                m_minTimerId = m_timer.post(
+                        std::chrono::duration_cast< std::chrono::milliseconds >(
+                                minPeriod - elapsed).count(),
+                        createTimerCallback(&NotificationCoalescer::onMinPeriodExpired));
+            }
+
+            return false;
+        }
+
+        void NotificationCoalescer::notify()
+        {
+            m_notifier();
+            onNotified();
+        }
+
+        bool NotificationCoalescer::hasPendingNotification() const
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            return m_isPending;
+        }
+
+        unsigned long long NotificationCoalescer::getSuppressedCount() const
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            return m_suppressedCount;
+        }
+
+        void NotificationCoalescer::onNotified()
+        {
+            std::lock_guard< std::mutex > lock{ m_mutex };
+
+            m_hasNotified = true;
+            m_lastNotified = Clock::now();
+            m_isPending = false;
+
+            cancelTimer(m_minTimerId);
+
+            if (m_isEnabled)
+            {
+                postMaxPeriodTimer();
+            }
+        }
+
+        void NotificationCoalescer::onMinPeriodExpired(ExpiryTimer::Id id)
+        {
+            {
+                std::lock_guard< std::mutex > lock{ m_mutex };
+
+                if (id != m_minTimerId || !m_isPending)
+                {
+                    return;
+                }
+
+                m_minTimerId = INVALID_TIMER_ID;
+            }
+
+            notifyFromTimer();
+        }
+
+        void NotificationCoalescer::onMaxPeriodExpired(ExpiryTimer::Id id)
+        {
+            {
+                std::lock_guard< std::mutex > lock{ m_mutex };
+
+                if (id != m_maxTimerId || !m_isEnabled)
+                {
+                    return;
+                }
+
+                m_maxTimerId = INVALID_TIMER_ID;
+            }
+
+            notifyFromTimer();
+        }
+
+        void NotificationCoalescer::notifyFromTimer()
+        {
+            try
+            {
+                notify();
+            }
+            catch (const RCSException& e)
+            {
+                OIC_LOG_V(WARNING, LOG_TAG, "Failed to notify : %s", e.what());
+
+                // keeps the periods running; the failed notification is not retried.
+                onNotified();
+            }
+        }
+
+        void NotificationCoalescer::cancelTimer(ExpiryTimer::Id& id)
+        {
+            if (id != INVALID_TIMER_ID)
+            {
+                m_timer.cancel(id);
+                id = INVALID_TIMER_ID;
+            }
+        }
+
+        void NotificationCoalescer::postMaxPeriodTimer()
+        {
+            cancelTimer(m_maxTimerId);
+
+            if (m_maxPeriod > 0)
+            {
+                m_maxTimerId = m_timer.post(m_maxPeriod,
+                        createTimerCallback(&NotificationCoalescer::onMaxPeriodExpired));
+            }
+        }
+
+        ExpiryTimer::Callback NotificationCoalescer::createTimerCallback(
+                void (NotificationCoalescer::*handler)(ExpiryTimer::Id))
+        {
+            std::weak_ptr< NotificationCoalescer > weakCoalescer{ shared_from_this() };
+
+            return [weakCoalescer, handler](ExpiryTimer::Id id)
+            {
+                if (auto coalescer = weakCoalescer.lock())
+                {
+                    ((*coalescer).*handler)(id);
+                }
+            };
+        }
+
+    }
+}
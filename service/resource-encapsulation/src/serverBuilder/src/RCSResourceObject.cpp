@@ -30,6 +30,7 @@
 #include "RCSRequest.h"
 #include "RCSRepresentation.h"
 #include "InterfaceHandler.h"
+#include "NotificationCoalescer.h"
 
 #include "experimental/logger.h"
 #include "OCPlatform.h"
@@ -104,7 +105,8 @@ namespace
             const RCSResourceAttributes& resourceAttributes,
             RCSResourceObject::AutoNotifyPolicy autoNotifyPolicy)
     {
-        if(autoNotifyPolicy == RCSResourceObject::AutoNotifyPolicy::UPDATED)
+        if(autoNotifyPolicy == RCSResourceObject::AutoNotifyPolicy::UPDATED ||
+                autoNotifyPolicy == RCSResourceObject::AutoNotifyPolicy::COALESCED)
         {
             auto&& compareAttributesFunc =
                     std::bind(std::not_equal_to<RCSResourceAttributes>(),
@@ -121,6 +123,15 @@ namespace
         return {};
     }
 
+    void notifyAllObservers(OCResourceHandle handle)
+    {
+        typedef OCStackResult (*NotifyAllObservers)(OCResourceHandle);
+
+        invokeOCFuncWithResultExpect({ OC_STACK_OK, OC_STACK_NO_OBSERVERS },
+                static_cast< NotifyAllObservers >(OC::OCPlatform::notifyAllObservers),
+                handle);
+    }
+
     void insertValue(std::vector<std::string>& container, std::string value)
     {
             if (value.empty())
@@ -265,6 +276,7 @@ namespace OIC
                 m_getRequestHandler{ },
                 m_setRequestHandler{ },
                 m_autoNotifyPolicy{ AutoNotifyPolicy::UPDATED },
+                m_notificationCoalescer{ },
                 m_setRequestHandlerPolicy{ SetRequestHandlerPolicy::NEVER },
                 m_attributeUpdatedListeners{ },
                 m_lockOwner{ },
@@ -284,6 +296,9 @@ namespace OIC
             m_types = types;
             m_defaultInterface = defaultInterface;
 
+            m_notificationCoalescer = std::make_shared< NotificationCoalescer >(
+                    std::bind(::notifyAllObservers, handle));
+
             for (const auto& itf : interfaces)
             {
                 m_interfaceHandlers.insert({ itf, getDefaultInterfaceHandler(itf,
@@ -293,6 +308,8 @@ namespace OIC
 
         RCSResourceObject::~RCSResourceObject()
         {
+            m_notificationCoalescer.reset();
+
             if (m_resourceHandle)
             {
                 try
@@ -440,11 +457,7 @@ namespace OIC
 
         void RCSResourceObject::notify() const
         {
-            typedef OCStackResult (*NotifyAllObservers)(OCResourceHandle);
-
-            invokeOCFuncWithResultExpect({ OC_STACK_OK, OC_STACK_NO_OBSERVERS },
-                    static_cast< NotifyAllObservers >(OC::OCPlatform::notifyAllObservers),
-                    m_resourceHandle);
+            m_notificationCoalescer->notify();
         }
 
         void RCSResourceObject::addAttributeUpdatedListener(const std::string& key,
@@ -482,6 +495,7 @@ namespace OIC
         void RCSResourceObject::setAutoNotifyPolicy(AutoNotifyPolicy policy)
         {
             m_autoNotifyPolicy = policy;
+            m_notificationCoalescer->setEnabled(policy == AutoNotifyPolicy::COALESCED);
         }
 
         RCSResourceObject::AutoNotifyPolicy RCSResourceObject::getAutoNotifyPolicy() const
@@ -489,6 +503,17 @@ namespace OIC
             return m_autoNotifyPolicy;
         }
 
+        void RCSResourceObject::setNotificationPeriods(long long minPeriodInMilliSec,
+                long long maxPeriodInMilliSec)
+        {
+            m_notificationCoalescer->setPeriods(minPeriodInMilliSec, maxPeriodInMilliSec);
+        }
+
+        unsigned long long RCSResourceObject::getSuppressedNotificationCount() const
+        {
+            return m_notificationCoalescer->getSuppressedCount();
+        }
+
         void RCSResourceObject::setSetRequestHandlerPolicy(SetRequestHandlerPolicy policy)
         {
             m_setRequestHandlerPolicy = policy;
@@ -589,15 +614,37 @@ namespace OIC
                 return;
             }
 
-            if(autoNotifyPolicy == AutoNotifyPolicy::UPDATED &&
+            if((autoNotifyPolicy == AutoNotifyPolicy::UPDATED ||
+                    autoNotifyPolicy == AutoNotifyPolicy::COALESCED) &&
                     isAttributesChanged == false)
             {
                 return;
             }
 
+            if(autoNotifyPolicy == AutoNotifyPolicy::COALESCED &&
+                    !m_notificationCoalescer->requestNotify())
+            {
+                return;
+            }
+
             notify();
         }
 
+        void RCSResourceObject::autoNotifyOnRelease(
+                        bool isAttributesChanged, AutoNotifyPolicy autoNotifyPolicy) const
+        {
+            if(autoNotifyPolicy != AutoNotifyPolicy::COALESCED)
+            {
+                autoNotify(isAttributesChanged, autoNotifyPolicy);
+                return;
+            }
+
+            if(isAttributesChanged || m_notificationCoalescer->hasPendingNotification())
+            {
+                notify();
+            }
+        }
+
         OCEntityHandlerResult RCSResourceObject::entityHandler(
                 const std::weak_ptr< RCSResourceObject >& weakRes,
                 const std::shared_ptr< OC::OCResourceRequest >& request)
@@ -848,7 +895,7 @@ namespace OIC
                 m_resourceObject.setLockOwner(std::this_thread::get_id());
                 m_isOwningLock = true;
             }
-            m_autoNotifyFunc = ::createAutoNotifyInvoker(&RCSResourceObject::autoNotify,
+            m_autoNotifyFunc = ::createAutoNotifyInvoker(&RCSResourceObject::autoNotifyOnRelease,
                     m_resourceObject, m_resourceObject.m_resourceAttributes, m_autoNotifyPolicy);
         }
 
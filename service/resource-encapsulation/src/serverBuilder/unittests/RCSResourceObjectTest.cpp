@@ -18,6 +18,10 @@
 //
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "UnitTestHelperWithFakeOCPlatform.h"
@@ -404,6 +408,105 @@ TEST_F(AutoNotifyWithGuardTest, GuardInvokesNotifyWhenDestroyed)
     server->setAttribute(KEY, VALUE);
 }
 
+class CoalescedAutoNotifyTest: public AutoNotifyTest
+{
+protected:
+    virtual void initResourceObject()
+    {
+        server->setAutoNotifyPolicy(RCSResourceObject::AutoNotifyPolicy::COALESCED);
+        server->setNotificationPeriods(MIN_PERIOD, 0);
+    }
+
+protected:
+    static constexpr long long MIN_PERIOD{ 60 * 1000 };
+};
+
+TEST_F(CoalescedAutoNotifyTest, ThrowIfMaxPeriodIsLessThanMinPeriod)
+{
+    ASSERT_THROW(server->setNotificationPeriods(100, 10), RCSInvalidParameterException);
+}
+
+TEST_F(CoalescedAutoNotifyTest, FirstChangeIsNotifiedAtOnce)
+{
+    mocks.ExpectCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers)
+                    .Return(OC_STACK_OK);
+
+    server->setAttribute(KEY, VALUE);
+
+    ASSERT_EQ(0U, server->getSuppressedNotificationCount());
+}
+
+TEST_F(CoalescedAutoNotifyTest, ChangesWithinMinPeriodAreMerged)
+{
+    server->setAttribute(KEY, VALUE);
+
+    mocks.NeverCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers);
+
+    server->setAttribute(KEY, VALUE + 1);
+    server->setAttribute(KEY, VALUE + 2);
+
+    ASSERT_EQ(2U, server->getSuppressedNotificationCount());
+}
+
+TEST_F(CoalescedAutoNotifyTest, NeverBeNotifiedIfAttributeIsNotChanged)
+{
+    server->setAttribute(KEY, VALUE);
+
+    mocks.NeverCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers);
+
+    server->setAttribute(KEY, VALUE);
+
+    ASSERT_EQ(0U, server->getSuppressedNotificationCount());
+}
+
+TEST_F(CoalescedAutoNotifyTest, GuardFlushesMergedChangesWhenDestroyed)
+{
+    server->setAttribute(KEY, VALUE);
+    server->setAttribute(KEY, VALUE + 1);
+
+    mocks.ExpectCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers)
+                    .Return(OC_STACK_OK);
+
+    {
+        RCSResourceObject::LockGuard guard{ server };
+    }
+
+    mocks.NeverCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers);
+
+    server->setAttribute(KEY, VALUE + 2);
+}
+
+TEST_F(CoalescedAutoNotifyTest, MergedChangesAreNotifiedWhenMinPeriodEnds)
+{
+    std::condition_variable notifyCond;
+    std::mutex notifyMutex;
+    bool isNotified = false;
+
+    server->setNotificationPeriods(100, 0);
+    server->setAttribute(KEY, VALUE);
+
+    mocks.OnCall(
+            mockFakePlatform, FakeOCPlatform::notifyAllObservers).Do(
+            [&](OCResourceHandle) -> OCStackResult
+            {
+                std::lock_guard< std::mutex > lock{ notifyMutex };
+                isNotified = true;
+                notifyCond.notify_all();
+                return OC_STACK_OK;
+            });
+
+    server->setAttribute(KEY, VALUE + 1);
+
+    std::unique_lock< std::mutex > lock{ notifyMutex };
+    ASSERT_TRUE(notifyCond.wait_for(lock, std::chrono::milliseconds(1000),
+            [&isNotified] { return isNotified; }));
+}
+
 class ResourceObjectHandlingRequestTest: public ResourceObjectTest
 {
 public:
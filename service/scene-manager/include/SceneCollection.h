@@ -106,6 +106,16 @@ namespace OIC
              */
             std::string getId() const;
 
+            /**
+             * Sets the maximum number of requests to scene members in flight while a
+             * Scene of this SceneCollection is executed. It is 16 by default.
+             *
+             * @param windowSize              A number of requests
+             *
+             * @throw RCSInvalidParameterException if windowSize is zero
+             */
+            void setExecutionWindow(unsigned int windowSize);
+
         private:
             std::shared_ptr< SceneCollectionResource > m_sceneCollectionResource;
 
@@ -82,6 +82,11 @@ namespace OIC
             return m_sceneCollectionResource->getId();
         }
 
+        void SceneCollection::setExecutionWindow(unsigned int windowSize)
+        {
+            m_sceneCollectionResource->setExecutionWindow(windowSize);
+        }
+
     } /* namespace Service */
 } /* namespace OIC */
 
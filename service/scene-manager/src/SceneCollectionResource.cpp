@@ -36,7 +36,8 @@ namespace OIC
 
         SceneCollectionResource::SceneCollectionResource()
         : m_uri(PREFIX_SCENE_COLLECTION_URI + "/" + std::to_string(g_numOfSceneCollection++)),
-          m_address(), m_sceneCollectionResourceObject(), m_requestHandler()
+          m_address(), m_sceneCollectionResourceObject(), m_sceneMembers(),
+          m_executionWindow(SceneExecutor::DEFAULT_WINDOW_SIZE), m_requestHandler()
         {
             m_sceneCollectionResourceObject = createResourceObject();
         }
@@ -178,29 +179,48 @@ namespace OIC
             auto sceneValues = m_sceneCollectionResourceObject->getAttributeValue(
                     SCENE_KEY_SCENEVALUES).get< std::vector< std::string > >();
 
+            std::vector<SceneMemberResource::Ptr> members;
+            size_t executionWindow = 0;
+            {
+                std::lock_guard<std::mutex> memberlock(m_sceneMemberLock);
+                members = m_sceneMembers;
+                executionWindow = m_executionWindow;
+            }
+
             auto foundSceneValue
                 = std::find(sceneValues.begin(), sceneValues.end(), sceneName);
-            if (foundSceneValue == sceneValues.end() && executeCB && !m_sceneMembers.size())
+            if (foundSceneValue == sceneValues.end() && executeCB && members.empty())
             {
-                std::thread(std::move(executeCB), SCENE_CLIENT_BADREQUEST).detach();
+                SceneExecutor::reject(SCENE_CLIENT_BADREQUEST,
+                        [executeCB](int eCode, const std::vector<SceneExecutor::MemberResult> &)
+                        {
+                            executeCB(eCode);
+                        });
                 return;
             }
 
             m_sceneCollectionResourceObject->setAttribute(
                     SCENE_KEY_LAST_SCENE, sceneName);
 
+            SceneExecutor::create(members, sceneName, executionWindow)->execute(
+                    [executeCB](int eCode, const std::vector<SceneExecutor::MemberResult> &)
+                    {
+                        if (executeCB)
+                        {
+                            executeCB(eCode);
+                        }
+                    });
+        }
+
+        void SceneCollectionResource::setExecutionWindow(size_t executionWindow)
+        {
+            if (executionWindow == 0)
             {
-                std::lock_guard<std::mutex> memberlock(m_sceneMemberLock);
-                auto executeHandler
-                    = SceneExecuteResponseHandler::createExecuteHandler(
-                            shared_from_this(), std::move(executeCB));
-                for (auto & it : m_sceneMembers)
-                {
-                    it->execute(std::move(sceneName), std::bind(
-                            &SceneExecuteResponseHandler::onResponse, executeHandler,
-                            std::placeholders::_1, std::placeholders::_2));
-                }
+                throw RCSInvalidParameterException("Execution window must be greater than zero!");
             }
+
+            std::lock_guard<std::mutex> memberlock(m_sceneMemberLock);
+            m_executionWindow = executionWindow;
         }
 
         std::string SceneCollectionResource::getId() const
@@ -428,49 +448,5 @@ namespace OIC
                     });
         }
 
-        void SceneCollectionResource::SceneExecuteResponseHandler::
-        onResponse(const RCSResourceAttributes & /*attributes*/, int errorCode)
-        {
-            std::unique_lock<std::mutex> responseLock(m_responseMutex);
-            m_responseMembers++;
-            if (errorCode != SCENE_RESPONSE_SUCCESS && m_errorCode != errorCode)
-            {
-                m_errorCode = errorCode;
-            }
-            if (m_responseMembers == m_numOfMembers)
-            {
-               /* Explicitly unlocking the unique_lock.
-                * Reason:- As we are using the scope lock using unique_lock,
-                * it will be released once it goes out of scope,
-                * In this case, lock will be acquired till application callback
-                * returns. So, its better to release the lock explicitly.
-                */
-                responseLock.unlock();
-                m_cb(m_errorCode);
-            }
-        }
-
-        SceneCollectionResource::SceneExecuteResponseHandler::Ptr
-        SceneCollectionResource::SceneExecuteResponseHandler::createExecuteHandler(
-                const SceneCollectionResource::Ptr ptr, SceneExecuteCallback executeCB)
-        {
-            auto executeHandler = std::make_shared<SceneExecuteResponseHandler>();
-
-            executeHandler->m_numOfMembers = ptr->m_sceneMembers.size();
-            executeHandler->m_responseMembers = 0;
-
-            executeHandler->m_cb =
-                    [executeCB](int eCode)
-                    {
-                        std::thread(std::move(executeCB), eCode).detach();
-                    };
-
-            executeHandler->m_owner
-                = std::weak_ptr<SceneCollectionResource>(ptr);
-            executeHandler->m_errorCode  = SCENE_RESPONSE_SUCCESS;
-
-            return executeHandler;
-        }
-
     }
 }
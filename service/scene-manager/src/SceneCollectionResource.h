@@ -25,6 +25,7 @@
 
 #include "RCSResourceObject.h"
 #include "SceneCommons.h"
+#include "SceneExecutor.h"
 #include "SceneMemberResource.h"
 
 /** OIC namespace */
@@ -67,6 +68,12 @@ namespace OIC
             void execute(std::string &&, SceneExecuteCallback);
             void execute(const std::string &, SceneExecuteCallback);
 
+            /**
+             * set the maximum number of member requests in flight while executing a scene
+             * @param number of requests, SceneExecutor::DEFAULT_WINDOW_SIZE by default
+             */
+            void setExecutionWindow(size_t);
+
             /**
              * set the scene name
              * @param string name to set
@@ -98,29 +105,6 @@ namespace OIC
             RCSResourceObject::Ptr getRCSResourceObject() const;
 
         private:
-            class SceneExecuteResponseHandler
-            {
-            public:
-                typedef std::shared_ptr<SceneExecuteResponseHandler> Ptr;
-
-                SceneExecuteResponseHandler()
-                : m_numOfMembers(0), m_responseMembers(0), m_errorCode(0)
-                {
-                }
-                ~SceneExecuteResponseHandler() = default;
-
-                int m_numOfMembers;
-                int m_responseMembers;
-                int m_errorCode;
-                std::weak_ptr<SceneCollectionResource> m_owner;
-                SceneExecuteCallback m_cb;
-                std::mutex m_responseMutex;
-
-                static SceneExecuteResponseHandler::Ptr createExecuteHandler(
-                        const SceneCollectionResource::Ptr, SceneExecuteCallback);
-                void onResponse(const RCSResourceAttributes &, int);
-            };
-
             class SceneCollectionRequestHandler
             {
             public:
@@ -152,6 +136,7 @@ namespace OIC
             RCSResourceObject::Ptr m_sceneCollectionResourceObject;
             mutable std::mutex m_sceneMemberLock;
             std::vector<SceneMemberResource::Ptr> m_sceneMembers;
+            size_t m_executionWindow;
 
             SceneCollectionRequestHandler m_requestHandler;
 
@@ -0,0 +1,230 @@
+/******************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "SceneExecutor.h"
+
+#include <unordered_map>
+
+#include "RCSException.h"
+#include "experimental/logger.h"
+
+#define SCENE_EXECUTOR_TAG "[SCENE_EXECUTOR]"
+
+namespace OIC
+{
+    namespace Service
+    {
+        constexpr size_t SceneExecutor::DEFAULT_WINDOW_SIZE;
+
+        SceneExecutor::SceneExecutor(size_t windowSize)
+        : m_windowSize(windowSize), m_numOfInFlight(0), m_numOfRemaining(0),
+          m_errorCode(SCENE_RESPONSE_SUCCESS), m_pendingRequests(), m_results(), m_cb(),
+          m_timer(), m_mutex()
+        {
+        }
+
+        SceneExecutor::Ptr SceneExecutor::create(
+                const std::vector<SceneMemberResource::Ptr> & members,
+                const std::string & sceneName, size_t windowSize)
+        {
+            if (windowSize == 0)
+            {
+                throw RCSInvalidParameterException("Window size must be greater than zero!");
+            }
+
+            SceneExecutor::Ptr executor(new SceneExecutor(windowSize));
+            executor->addRequests(members, sceneName);
+
+            return executor;
+        }
+
+        void SceneExecutor::reject(int eCode, ExecuteCallback executeCB)
+        {
+            SceneExecutor::Ptr executor(new SceneExecutor(DEFAULT_WINDOW_SIZE));
+            executor->m_errorCode = eCode;
+            executor->execute(std::move(executeCB));
+        }
+
+        void SceneExecutor::execute(ExecuteCallback executeCB)
+        {
+            std::vector<MemberRequest> requests;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cb = std::move(executeCB);
+
+                if (m_numOfRemaining > 0)
+                {
+                    requests = popRequests();
+                }
+            }
+
+            if (requests.empty())
+            {
+                complete();
+                return;
+            }
+
+            sendRequests(std::move(requests));
+        }
+
+        void SceneExecutor::addRequests(const std::vector<SceneMemberResource::Ptr> & members,
+                const std::string & sceneName)
+        {
+            std::vector<std::string> devices;
+            std::unordered_map<std::string, std::deque<MemberRequest>> requestsOfDevice;
+
+            m_results.reserve(members.size());
+            for (const auto & member : members)
+            {
+                m_results.push_back(MemberResult{ member->getTargetUri(),
+                        SCENE_RESPONSE_SUCCESS, std::chrono::milliseconds(0) });
+
+                auto attributes = member->getExecutionAttributes(sceneName);
+                if (attributes.empty())
+                {
+                    continue;
+                }
+
+                auto address = member->getRemoteResourceObject()->getAddress();
+                if (requestsOfDevice.find(address) == requestsOfDevice.end())
+                {
+                    devices.push_back(address);
+                }
+
+                requestsOfDevice[address].push_back(MemberRequest{ member,
+                        std::move(attributes), m_results.size() - 1, Clock::time_point() });
+            }
+
+            // takes a request of each device in turn, so that the window is shared
+            // by the devices instead of being filled by the members of one device.
+            bool hasRequest = true;
+            while (hasRequest)
+            {
+                hasRequest = false;
+                for (const auto & device : devices)
+                {
+                    auto & requests = requestsOfDevice[device];
+                    if (!requests.empty())
+                    {
+                        m_pendingRequests.push_back(std::move(requests.front()));
+                        requests.pop_front();
+                        hasRequest = true;
+                    }
+                }
+            }
+
+            m_numOfRemaining = m_pendingRequests.size();
+        }
+
+        std::vector<SceneExecutor::MemberRequest> SceneExecutor::popRequests()
+        {
+            std::vector<MemberRequest> requests;
+            while (m_numOfInFlight < m_windowSize && !m_pendingRequests.empty())
+            {
+                requests.push_back(std::move(m_pendingRequests.front()));
+                m_pendingRequests.pop_front();
+                ++m_numOfInFlight;
+            }
+            return requests;
+        }
+
+        void SceneExecutor::sendRequests(std::vector<MemberRequest> && requests)
+        {
+            auto executor = shared_from_this();
+
+            for (auto & request : requests)
+            {
+                request.sentTime = Clock::now();
+
+                auto resultIndex = request.resultIndex;
+                auto sentTime = request.sentTime;
+
+                try
+                {
+                    request.member->getRemoteResourceObject()->setRemoteAttributes(
+                            request.attributes,
+                            [executor, resultIndex, sentTime](
+                                    const RCSResourceAttributes &, int eCode)
+                            {
+                                executor->onResponse(resultIndex, sentTime, eCode);
+                            });
+                }
+                catch (const RCSException & e)
+                {
+                    OIC_LOG_V(ERROR, SCENE_EXECUTOR_TAG, "Failed to send request : %s",
+                            e.what());
+                    onResponse(resultIndex, sentTime, SCENE_SERVER_INTERNALSERVERERROR);
+                }
+            }
+        }
+
+        void SceneExecutor::onResponse(size_t resultIndex, Clock::time_point sentTime, int eCode)
+        {
+            std::vector<MemberRequest> requests;
+            bool isCompleted = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                auto & result = m_results[resultIndex];
+                result.errorCode = eCode;
+                result.latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        Clock::now() - sentTime);
+
+                OIC_LOG_V(DEBUG, SCENE_EXECUTOR_TAG, "%s responded %d in %lld ms",
+                        result.targetUri.c_str(), eCode,
+                        static_cast<long long>(result.latency.count()));
+
+                if (eCode != SCENE_RESPONSE_SUCCESS && m_errorCode != eCode)
+                {
+                    m_errorCode = eCode;
+                }
+
+                --m_numOfInFlight;
+                isCompleted = (--m_numOfRemaining == 0);
+
+                requests = popRequests();
+            }
+
+            if (isCompleted)
+            {
+                complete();
+                return;
+            }
+
+            sendRequests(std::move(requests));
+        }
+
+        void SceneExecutor::complete()
+        {
+            // the stack does not wait for the application callback in its response
+            // callback, and execute() never invokes it.
+            auto executor = shared_from_this();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_timer.post(0, [executor](ExpiryTimer::Id)
+                    {
+                        if (executor->m_cb)
+                        {
+                            executor->m_cb(executor->m_errorCode, executor->m_results);
+                        }
+                    });
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/******************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef SCENE_EXECUTOR_H
+#define SCENE_EXECUTOR_H
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+#include "ExpiryTimer.h"
+#include "SceneCommons.h"
+#include "SceneMemberResource.h"
+
+namespace OIC
+{
+    namespace Service
+    {
+        /**
+         * Executes a scene over scene members.
+         *
+         * Requests are grouped by the device hosting the target resource and sent
+         * to the devices in turn, keeping at most a window of requests in flight.
+         * A request is sent as soon as a response frees a slot of the window, so a
+         * slow member delays only its own response.
+         *
+         * The callback is invoked once, with the result of every member.
+         */
+        class SceneExecutor : public std::enable_shared_from_this<SceneExecutor>
+        {
+        public:
+            typedef std::shared_ptr< SceneExecutor > Ptr;
+
+            /**
+             * Result of a scene member. The latency is zero for a member without
+             * an action of the scene, to which no request is sent.
+             */
+            struct MemberResult
+            {
+                std::string targetUri;
+                int errorCode;
+                std::chrono::milliseconds latency;
+            };
+
+            typedef std::function< void(int eCode, const std::vector< MemberResult > &) >
+                ExecuteCallback;
+
+            static constexpr size_t DEFAULT_WINDOW_SIZE = 16;
+
+            ~SceneExecutor() = default;
+
+            static SceneExecutor::Ptr create(const std::vector<SceneMemberResource::Ptr> &,
+                    const std::string & sceneName, size_t windowSize);
+
+            /**
+             * Invokes the callback with the given error code, without any request.
+             */
+            static void reject(int eCode, ExecuteCallback);
+
+            /**
+             * Sends the requests. The callback is invoked on a timer thread, never
+             * in this call.
+             */
+            void execute(ExecuteCallback);
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct MemberRequest
+            {
+                SceneMemberResource::Ptr member;
+                RCSResourceAttributes attributes;
+                size_t resultIndex;
+                Clock::time_point sentTime;
+            };
+
+            SceneExecutor(size_t windowSize);
+
+            SceneExecutor(const SceneExecutor &) = delete;
+            SceneExecutor & operator = (const SceneExecutor &) = delete;
+
+            SceneExecutor(SceneExecutor &&) = delete;
+            SceneExecutor & operator = (SceneExecutor &&) = delete;
+
+            void addRequests(const std::vector<SceneMemberResource::Ptr> &,
+                    const std::string & sceneName);
+
+            /** pops the requests to send while the window has a free slot */
+            std::vector<MemberRequest> popRequests();
+            void sendRequests(std::vector<MemberRequest> &&);
+
+            void onResponse(size_t resultIndex, Clock::time_point sentTime, int eCode);
+            void complete();
+
+            size_t m_windowSize;
+            size_t m_numOfInFlight;
+            size_t m_numOfRemaining;
+            int m_errorCode;
+
+            std::deque<MemberRequest> m_pendingRequests;
+            std::vector<MemberResult> m_results;
+            ExecuteCallback m_cb;
+
+            ExpiryTimer m_timer;
+            std::mutex m_mutex;
+        };
+    }
+}
+
+#endif // SCENE_EXECUTOR_H
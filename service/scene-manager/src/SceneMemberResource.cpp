@@ -197,21 +197,15 @@ namespace OIC
 
         void SceneMemberResource::execute(std::string && sceneName, MemberexecuteCallback executeCB)
         {
-            RCSResourceAttributes setAtt;
-
-            auto mInfo = getMappingInfos();
-            std::for_each(mInfo.begin(), mInfo.end(),
-                    [& setAtt, & sceneName](const MappingInfo & info)
-                    {
-                        if(info.sceneName == sceneName)
-                        {
-                            setAtt[info.key] = info.value;
-                        }
-                    });
+            RCSResourceAttributes setAtt = getExecutionAttributes(sceneName);
 
-            if (setAtt.empty() && executeCB != nullptr)
+            if (setAtt.empty())
             {
-                executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                if (executeCB != nullptr)
+                {
+                    executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                }
+                return;
             }
 
             m_remoteMemberObj->setRemoteAttributes(setAtt, executeCB);
@@ -269,6 +263,23 @@ namespace OIC
             return false;
         }
 
+        RCSResourceAttributes SceneMemberResource::getExecutionAttributes(
+                const std::string & sceneValue) const
+        {
+            RCSResourceAttributes setAtt;
+
+            auto mInfo = getMappingInfos();
+            std::for_each(mInfo.begin(), mInfo.end(),
+                    [& setAtt, & sceneValue](const MappingInfo & info)
+                    {
+                        if(info.sceneName == sceneValue)
+                        {
+                            setAtt[info.key] = info.value;
+                        }
+                    });
+            return setAtt;
+        }
+
         SceneMemberResource::MappingInfo
         SceneMemberResource::MappingInfo::create(const RCSResourceAttributes & att)
         {
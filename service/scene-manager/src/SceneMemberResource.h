@@ -122,6 +122,14 @@ namespace OIC
 
             bool hasSceneValue(const std::string &) const;
 
+            /**
+             * Returns the attributes to set at the target resource to execute the scene value.
+             * They are empty if the scene member has no action of the scene value.
+             *
+             * @param sceneValue scene value to execute
+             */
+            RCSResourceAttributes getExecutionAttributes(const std::string & sceneValue) const;
+
             /**
              * Returns ID of a Scene member resource.
              */
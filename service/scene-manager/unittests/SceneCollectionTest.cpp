@@ -77,3 +77,10 @@ TEST_F(SceneCollectionTest, setAndGetSceneCollectionResourceName)
 
     EXPECT_EQ("Kitchen", sceneCollectionName);
 }
+
+TEST_F(SceneCollectionTest, setExecutionWindowThrowsIfWindowIsZero)
+{
+    pSceneCollection = pSceneList->addNewSceneCollection();
+
+    ASSERT_THROW(pSceneCollection->setExecutionWindow(0), RCSInvalidParameterException);
+}
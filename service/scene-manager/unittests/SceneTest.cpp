@@ -24,12 +24,17 @@
 
 #include "RCSResourceObject.h"
 #include "RCSRemoteResourceObject.h"
+#include "RCSRequest.h"
+#include "RCSSeparateResponse.h"
 #include "SceneCommons.h"
 #include "OCPlatform.h"
 
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <iostream>
+#include <thread>
 
 using namespace std;
 using namespace OIC::Service;
@@ -94,6 +99,56 @@ protected:
                         pResource2->getTypes(), pResource2->getInterfaces());
         pRemoteResource2 = RCSRemoteResourceObject::fromOCResource(ocResourcePtr);
     }
+    RCSRemoteResourceObject::Ptr createDelayingServer(const std::string& host,
+            const std::string& resourceUri)
+    {
+        auto pResource = RCSResourceObject::Builder(
+                resourceUri, RESOURCE_TYPE, DEFAULT_INTERFACE).build();
+        pResource->setAttribute(KEY, VALUE);
+        pResource->setSetRequestHandler(
+                [this](const RCSRequest& request, RCSResourceAttributes&)
+                {
+                    std::lock_guard< std::mutex > lock{ requestMutex };
+                    delayedRequests.push_back(request);
+                    requestedUris.push_back(request.getResourceUri());
+                    maxNumOfDelayedRequests =
+                            std::max(maxNumOfDelayedRequests, delayedRequests.size());
+                    requestCond.notify_all();
+                    return RCSSetResponse::separate();
+                });
+        delayingServers.push_back(pResource);
+
+        auto ocResourcePtr = OC::OCPlatform::constructResourceObject(
+                "coap://" + host, resourceUri,
+                OCConnectivityType::CT_ADAPTER_IP, false,
+                pResource->getTypes(), pResource->getInterfaces());
+        return RCSRemoteResourceObject::fromOCResource(ocResourcePtr);
+    }
+    void respondToDelayedRequests(size_t numOfRequests)
+    {
+        for (size_t i = 0; i < numOfRequests; ++i)
+        {
+            {
+                std::unique_lock< std::mutex > lock{ requestMutex };
+                if (!requestCond.wait_for(lock, std::chrono::milliseconds{ 3000 },
+                        [this]{ return !delayedRequests.empty(); }))
+                {
+                    return;
+                }
+            }
+
+            // leaves time for requests beyond the window to arrive, if any is sent.
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+
+            RCSRequest request;
+            {
+                std::lock_guard< std::mutex > lock{ requestMutex };
+                request = delayedRequests.front();
+                delayedRequests.pop_front();
+            }
+            RCSSeparateResponse(request).set();
+        }
+    }
 
 public:
     SceneList* pSceneList;
@@ -103,9 +158,17 @@ public:
     RCSRemoteResourceObject::Ptr pRemoteResource1;
     RCSRemoteResourceObject::Ptr pRemoteResource2;
 
+    std::vector<std::string> requestedUris;
+    size_t maxNumOfDelayedRequests = 0;
+
 private:
     std::condition_variable cond;
     std::mutex mutex;
+
+    std::condition_variable requestCond;
+    std::mutex requestMutex;
+    std::deque<RCSRequest> delayedRequests;
+    std::vector<RCSResourceObject::Ptr> delayingServers;
 };
 void executeCallback(int /*code*/)
 {
@@ -201,6 +264,78 @@ TEST_F(SceneTest, executeScene)
     waitForCb(3000);
 }
 
+TEST_F(SceneTest, executeSceneWithExecutionWindowOfOne)
+{
+    mocks.ExpectCallFunc(executeCallback).Do([this](int)
+    {
+        proceed();
+    });
+
+    createServer("/a/testuri4_1", "/a/testuri4_2");
+    createSceneCollection();
+    createScene();
+    pSceneCollection->setExecutionWindow(1);
+    pScene1->addNewSceneAction(pRemoteResource1, KEY, "on");
+    pScene1->addNewSceneAction(pRemoteResource2, KEY_2, VALUE_2);
+
+    pScene1->execute(executeCallback);
+    waitForCb(3000);
+}
+
+TEST_F(SceneTest, executeSceneKeepsRequestsWithinExecutionWindow)
+{
+    mocks.ExpectCallFunc(executeCallback).Do([this](int)
+    {
+        proceed();
+    });
+
+    createSceneCollection();
+    createScene();
+    pSceneCollection->setExecutionWindow(2);
+    for (int i = 1; i <= 4; ++i)
+    {
+        pScene1->addNewSceneAction(createDelayingServer(SceneUtils::getNetAddress(),
+                "/a/testuri5_" + std::to_string(i)), KEY, "on");
+    }
+
+    pScene1->execute(executeCallback);
+    respondToDelayedRequests(4);
+    waitForCb(3000);
+
+    ASSERT_EQ(4u, requestedUris.size());
+    ASSERT_EQ(2u, maxNumOfDelayedRequests);
+}
+
+TEST_F(SceneTest, executeSceneTakesRequestOfEachDeviceInTurn)
+{
+    mocks.ExpectCallFunc(executeCallback).Do([this](int)
+    {
+        proceed();
+    });
+
+    // the loopback address reaches the same server, but the members are grouped
+    // as if they were on another device.
+    auto address = SceneUtils::getNetAddress();
+    auto loopback = "127.0.0.1" + address.substr(address.rfind(':'));
+
+    createSceneCollection();
+    createScene();
+    pSceneCollection->setExecutionWindow(1);
+    pScene1->addNewSceneAction(createDelayingServer(address, "/a/testuri6_1"), KEY, "on");
+    pScene1->addNewSceneAction(createDelayingServer(address, "/a/testuri6_2"), KEY, "on");
+    pScene1->addNewSceneAction(createDelayingServer(address, "/a/testuri6_3"), KEY, "on");
+    pScene1->addNewSceneAction(createDelayingServer(loopback, "/a/testuri6_4"), KEY, "on");
+
+    pScene1->execute(executeCallback);
+    respondToDelayedRequests(4);
+    waitForCb(3000);
+
+    std::vector<std::string> expectedUris
+        { "/a/testuri6_1", "/a/testuri6_4", "/a/testuri6_2", "/a/testuri6_3" };
+    ASSERT_EQ(expectedUris, requestedUris);
+    ASSERT_EQ(1u, maxNumOfDelayedRequests);
+}
+
 TEST_F(SceneTest, executeSceneUsingEmptyCallback)
 {
     createServer("/a/testuri3_1", "/a/testuri3_2");